@@ -378,6 +378,9 @@ class Cube : public BaseCube< eT, Cube<eT> >
   inline arma_cold bool quiet_load(const hdf5_name&    spec, const file_type type = hdf5_binary);
   inline arma_cold bool quiet_load(      std::istream& is,   const file_type type = auto_detect);
   
+  inline arma_cold save_handle save_async(const std::string name, const file_type type = arma_binary) const;
+  inline arma_cold save_handle save_async(const hdf5_name&  spec, const file_type type = hdf5_binary) const;
+  
   
   // iterators
   
@@ -429,10 +432,13 @@ class Cube : public BaseCube< eT, Cube<eT> >
   inline void delete_mat();
   inline void create_mat();
   
+  inline arma_cold bool save_hdf5(const hdf5_name& spec, const file_type type, std::string& err_msg) const;
+  
   friend class glue_join;
   friend class op_reshape;
   friend class op_resize;
   friend class subview_cube<eT>;
+  friend class save_handle;
   
   
   public:
@@ -4367,6 +4367,10 @@ Cube<eT>::save(const std::string name, const file_type type, const bool print_st
       save_okay = diskio::save_arma_binary(*this, name);
       break;
     
+    case arma_compact:
+      save_okay = diskio::save_arma_compact(*this, name);
+      break;
+    
     case ppm_binary:
       save_okay = diskio::save_ppm_binary(*this, name);
       break;
@@ -4399,6 +4403,36 @@ Cube<eT>::save(const hdf5_name& spec, const file_type type, const bool print_sta
   {
   arma_extra_debug_sigprint();
   
+  std::string err_msg;
+  
+  const bool save_okay = (*this).save_hdf5(spec, type, err_msg);
+  
+  if((print_status == true) && (save_okay == false))
+    {
+    if(err_msg.length() > 0)
+      {
+      arma_debug_warn("Cube::save(): ", err_msg, spec.filename);
+      }
+    else
+      {
+      arma_debug_warn("Cube::save(): couldn't write to ", spec.filename);
+      }
+    }
+  
+  return save_okay;
+  }
+
+
+
+//! save in HDF5 format; the description of a failure (if any) is stored in err_msg rather than printed
+template<typename eT>
+inline
+arma_cold
+bool
+Cube<eT>::save_hdf5(const hdf5_name& spec, const file_type type, std::string& err_msg) const
+  {
+  arma_extra_debug_sigprint();
+  
   // handling of hdf5_binary_trans kept for compatibility with earlier versions of Armadillo
   
   if( (type != hdf5_binary) && (type != hdf5_binary_trans) )
@@ -4410,15 +4444,15 @@ Cube<eT>::save(const hdf5_name& spec, const file_type type, const bool print_sta
   const bool do_trans = bool(spec.opts.flags & hdf5_opts::flag_trans  ) || (type == hdf5_binary_trans);
   const bool append   = bool(spec.opts.flags & hdf5_opts::flag_append );
   const bool replace  = bool(spec.opts.flags & hdf5_opts::flag_replace);
+  const bool extend   = bool(spec.opts.flags & hdf5_opts::flag_extend );
   
-  if(append && replace)
+  if( (uword(append) + uword(replace) + uword(extend)) > 1 )
     {
-    arma_debug_check(true, "Cube::save(): only one of 'append' or 'replace' options can be used");
+    arma_debug_check(true, "Cube::save(): only one of 'append', 'replace' or 'extend' options can be used");
     return false;
     }
   
   bool save_okay = false;
-  std::string err_msg;
   
   if(do_trans)
     {
@@ -4433,18 +4467,6 @@ Cube<eT>::save(const hdf5_name& spec, const file_type type, const bool print_sta
     save_okay = diskio::save_hdf5_binary(*this, spec, err_msg);
     }
   
-  if((print_status == true) && (save_okay == false))
-    {
-    if(err_msg.length() > 0)
-      {
-      arma_debug_warn("Cube::save(): ", err_msg, spec.filename);
-      }
-    else
-      {
-      arma_debug_warn("Cube::save(): couldn't write to ", spec.filename);
-      }
-    }
-  
   return save_okay;
   }
 
@@ -4479,6 +4501,10 @@ Cube<eT>::save(std::ostream& os, const file_type type, const bool print_status)
       save_okay = diskio::save_arma_binary(*this, os);
       break;
     
+    case arma_compact:
+      save_okay = diskio::save_arma_compact(*this, os);
+      break;
+    
     case ppm_binary:
       save_okay = diskio::save_ppm_binary(*this, os);
       break;
@@ -4529,6 +4555,10 @@ Cube<eT>::load(const std::string name, const file_type type, const bool print_st
       load_okay = diskio::load_arma_binary(*this, name, err_msg);
       break;
     
+    case arma_compact:
+      load_okay = diskio::load_arma_compact(*this, name, err_msg);
+      break;
+    
     case ppm_binary:
       load_okay = diskio::load_ppm_binary(*this, name, err_msg);
       break;
@@ -4658,6 +4688,10 @@ Cube<eT>::load(std::istream& is, const file_type type, const bool print_status)
       load_okay = diskio::load_arma_binary(*this, is, err_msg);
       break;
     
+    case arma_compact:
+      load_okay = diskio::load_arma_compact(*this, is, err_msg);
+      break;
+    
     case ppm_binary:
       load_okay = diskio::load_ppm_binary(*this, is, err_msg);
       break;
@@ -4771,6 +4805,34 @@ Cube<eT>::quiet_load(std::istream& is, const file_type type)
 
 
 
+//! save the object in the background;
+//! the object is copied before returning, so it can be modified or destroyed while the save is in progress
+template<typename eT>
+inline
+arma_cold
+save_handle
+Cube<eT>::save_async(const std::string name, const file_type type) const
+  {
+  arma_extra_debug_sigprint();
+  
+  return save_handle::launch( Cube<eT>(*this), name, type );
+  }
+
+
+
+template<typename eT>
+inline
+arma_cold
+save_handle
+Cube<eT>::save_async(const hdf5_name& spec, const file_type type) const
+  {
+  arma_extra_debug_sigprint();
+  
+  return save_handle::launch( Cube<eT>(*this), spec, type );
+  }
+
+
+
 template<typename eT>
 inline
 typename Cube<eT>::iterator
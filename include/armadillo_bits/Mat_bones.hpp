@@ -538,6 +538,9 @@ class Mat : public Base< eT, Mat<eT> >
   inline arma_cold bool quiet_load(const  csv_name&    spec, const file_type type =   csv_ascii);
   inline arma_cold bool quiet_load(      std::istream& is,   const file_type type = auto_detect);
   
+  inline arma_cold save_handle save_async(const std::string name, const file_type type = arma_binary) const;
+  inline arma_cold save_handle save_async(const hdf5_name&  spec, const file_type type = hdf5_binary) const;
+  
   
   // for container-like functionality
   
@@ -764,6 +767,8 @@ class Mat : public Base< eT, Mat<eT> >
   
   inline Mat(const arma_fixed_indicator&, const uword in_n_rows, const uword in_n_cols, const uhword in_vec_state, const eT* in_mem);
   
+  inline arma_cold bool save_hdf5(const hdf5_name& spec, const file_type type, std::string& err_msg) const;
+  
   
   friend class Cube<eT>;
   friend class subview_cube<eT>;
@@ -774,6 +779,7 @@ class Mat : public Base< eT, Mat<eT> >
   friend class op_mean;
   friend class op_max;
   friend class op_min;
+  friend class save_handle;
 
   
   public:
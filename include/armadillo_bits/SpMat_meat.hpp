@@ -4740,10 +4740,18 @@ SpMat<eT>::save(const std::string name, const file_type type, const bool print_s
       save_okay = diskio::save_arma_binary(*this, name);
       break;
     
+    case arma_compact:
+      save_okay = diskio::save_arma_compact(*this, name);
+      break;
+    
     case coord_ascii:
       save_okay = diskio::save_coord_ascii(*this, name);
       break;
     
+    case mtx_ascii:
+      save_okay = diskio::save_mtx_ascii(*this, name);
+      break;
+    
     default:
       if(print_status)  { arma_debug_warn("SpMat::save(): unsupported file type"); }
       save_okay = false;
@@ -4856,10 +4864,18 @@ SpMat<eT>::save(std::ostream& os, const file_type type, const bool print_status)
       save_okay = diskio::save_arma_binary(*this, os);
       break;
     
+    case arma_compact:
+      save_okay = diskio::save_arma_compact(*this, os);
+      break;
+    
     case coord_ascii:
       save_okay = diskio::save_coord_ascii(*this, os);
       break;
     
+    case mtx_ascii:
+      save_okay = diskio::save_mtx_ascii(*this, os);
+      break;
+    
     default:
       if(print_status)  { arma_debug_warn("SpMat::save(): unsupported file type"); }
       save_okay = false;
@@ -4900,10 +4916,18 @@ SpMat<eT>::load(const std::string name, const file_type type, const bool print_s
       load_okay = diskio::load_arma_binary(*this, name, err_msg);
       break;
     
+    case arma_compact:
+      load_okay = diskio::load_arma_compact(*this, name, err_msg);
+      break;
+    
     case coord_ascii:
       load_okay = diskio::load_coord_ascii(*this, name, err_msg);
       break;
     
+    case mtx_ascii:
+      load_okay = diskio::load_mtx_ascii(*this, name, err_msg);
+      break;
+    
     default:
       if(print_status)  { arma_debug_warn("SpMat::load(): unsupported file type"); }
       load_okay = false;
@@ -5046,10 +5070,18 @@ SpMat<eT>::load(std::istream& is, const file_type type, const bool print_status)
       load_okay = diskio::load_arma_binary(*this, is, err_msg);
       break;
     
+    case arma_compact:
+      load_okay = diskio::load_arma_compact(*this, is, err_msg);
+      break;
+    
     case coord_ascii:
       load_okay = diskio::load_coord_ascii(*this, is, err_msg);
       break;
     
+    case mtx_ascii:
+      load_okay = diskio::load_mtx_ascii(*this, is, err_msg);
+      break;
+    
     default:
       if(print_status)  { arma_debug_warn("SpMat::load(): unsupported file type"); }
       load_okay = false;
@@ -57,6 +57,13 @@ template<typename eT> class MapMat_val;
 template<typename eT> class SpMat_MapMat_val;
 template<typename eT> class SpSubview_MapMat_val;
 
+template<typename eT> struct arma_sort_index_packet;
+
+template<typename eT> class compact_reader;
+
+template<typename eT> class shm_mat;
+template<typename eT> class shm_cube;
+
 template<typename eT, typename T1>              class subview_elem1;
 template<typename eT, typename T1, typename T2> class subview_elem2;
 
@@ -76,6 +83,7 @@ class SizeCube;
 class arma_empty_class {};
 
 class diskio;
+class save_handle;
 
 class op_strans;
 class op_htrans;
@@ -363,7 +371,9 @@ enum struct file_type : unsigned int
   ppm_binary,         //!< Portable Pixel Map (colour image), used by the field and cube classes
   hdf5_binary,        //!< HDF5: open binary format, not specific to Armadillo, which can store arbitrary data
   hdf5_binary_trans,  //!< [DO NOT USE - deprecated] as per hdf5_binary, but save/load the data with columns transposed to rows
-  coord_ascii         //!< simple co-ordinate format for sparse matrices (indices start at zero)
+  coord_ascii,        //!< simple co-ordinate format for sparse matrices (indices start at zero)
+  mtx_ascii,          //!< Matrix Market co-ordinate format for sparse matrices (indices start at one)
+  arma_compact        //!< Armadillo binary format with a header, with the data stored as compressed and checksummed blocks
   };
 
 
@@ -379,6 +389,8 @@ static constexpr file_type ppm_binary         = file_type::ppm_binary;
 static constexpr file_type hdf5_binary        = file_type::hdf5_binary;
 static constexpr file_type hdf5_binary_trans  = file_type::hdf5_binary_trans;
 static constexpr file_type coord_ascii        = file_type::coord_ascii;
+static constexpr file_type mtx_ascii          = file_type::mtx_ascii;
+static constexpr file_type arma_compact       = file_type::arma_compact;
 
 
 struct hdf5_name;
@@ -20,6 +20,12 @@
 
 #if defined(ARMA_RNG_ALT)
   #undef ARMA_USE_EXTERN_RNG
+  #undef ARMA_RNG_PHILOX
+#endif
+
+
+#if defined(ARMA_RNG_PHILOX)
+  #undef ARMA_USE_EXTERN_RNG
 #endif
 
 
@@ -35,6 +41,8 @@ class arma_rng
   
   #if   defined(ARMA_RNG_ALT)
     typedef arma_rng_alt::seed_type   seed_type;
+  #elif defined(ARMA_RNG_PHILOX)
+    typedef arma_rng_philox::seed_type seed_type;
   #elif defined(ARMA_USE_EXTERN_RNG)
     typedef arma_rng_cxx11::seed_type seed_type;
   #else
@@ -43,6 +51,8 @@ class arma_rng
   
   #if   defined(ARMA_RNG_ALT)
     static constexpr int rng_method = 2;
+  #elif defined(ARMA_RNG_PHILOX)
+    static constexpr int rng_method = 3;
   #elif defined(ARMA_USE_EXTERN_RNG)
     static constexpr int rng_method = 1;
   #else
@@ -67,6 +77,10 @@ arma_rng::set_seed(const arma_rng::seed_type val)
     {
     arma_rng_alt::set_seed(val);
     }
+  #elif defined(ARMA_RNG_PHILOX)
+    {
+    arma_rng_philox::instance().set_seed(val);
+    }
   #elif defined(ARMA_USE_EXTERN_RNG)
     {
     arma_rng_cxx11_instance.set_seed(val);
@@ -171,6 +185,10 @@ struct arma_rng::randi
       {
       return eT( arma_rng_alt::randi_val() );
       }
+    #elif defined(ARMA_RNG_PHILOX)
+      {
+      return eT( arma_rng_philox::instance().randi_val() );
+      }
     #elif defined(ARMA_USE_EXTERN_RNG)
       {
       return eT( arma_rng_cxx11_instance.randi_val() );
@@ -192,6 +210,10 @@ struct arma_rng::randi
       {
       return arma_rng_alt::randi_max_val();
       }
+    #elif defined(ARMA_RNG_PHILOX)
+      {
+      return arma_rng_philox::randi_max_val();
+      }
     #elif defined(ARMA_USE_EXTERN_RNG)
       {
       return arma_rng_cxx11::randi_max_val();
@@ -213,6 +235,10 @@ struct arma_rng::randi
       {
       arma_rng_alt::randi_fill(mem, N, a, b);
       }
+    #elif defined(ARMA_RNG_PHILOX)
+      {
+      arma_rng_philox::instance().randi_fill(mem, N, a, b);
+      }
     #elif defined(ARMA_USE_EXTERN_RNG)
       {
       arma_rng_cxx11_instance.randi_fill(mem, N, a, b);
@@ -237,6 +263,10 @@ struct arma_rng::randu
       {
       return eT( arma_rng_alt::randu_val() );
       }
+    #elif defined(ARMA_RNG_PHILOX)
+      {
+      return eT( arma_rng_philox::instance().randu_val() );
+      }
     #elif defined(ARMA_USE_EXTERN_RNG)
       {
       return eT( arma_rng_cxx11_instance.randu_val() );
@@ -254,6 +284,14 @@ struct arma_rng::randu
   void
   fill(eT* mem, const uword N)
     {
+    #if defined(ARMA_RNG_PHILOX)
+      {
+      arma_rng_philox::instance().randu_fill(mem, N);
+      
+      return;
+      }
+    #endif
+    
     uword j;
     
     for(j=1; j < N; j+=2)
@@ -292,6 +330,16 @@ struct arma_rng::randu< std::complex<T> >
   void
   fill(std::complex<T>* mem, const uword N)
     {
+    #if defined(ARMA_RNG_PHILOX)
+      {
+      // std::complex<T> is layout compatible with T[2]
+      
+      arma_rng_philox::instance().randu_fill(reinterpret_cast<T*>(mem), 2*N);
+      
+      return;
+      }
+    #endif
+    
     for(uword i=0; i < N; ++i)
       {
       const T a = T( arma_rng::randu<T>() );
@@ -314,6 +362,10 @@ struct arma_rng::randn
       {
       return eT( arma_rng_alt::randn_val() );
       }
+    #elif defined(ARMA_RNG_PHILOX)
+      {
+      return eT( arma_rng_philox::instance().randn_val() );
+      }
     #elif defined(ARMA_USE_EXTERN_RNG)
       {
       return eT( arma_rng_cxx11_instance.randn_val() );
@@ -335,6 +387,10 @@ struct arma_rng::randn
       {
       arma_rng_alt::randn_dual_val(out1, out2);
       }
+    #elif defined(ARMA_RNG_PHILOX)
+      {
+      arma_rng_philox::instance().randn_dual_val(out1, out2);
+      }
     #elif defined(ARMA_USE_EXTERN_RNG)
       {
       arma_rng_cxx11_instance.randn_dual_val(out1, out2);
@@ -366,12 +422,35 @@ struct arma_rng::randn
     }
   
   
+  inline
+  static
+  void
+  fill_engine(eT* mem, const uword N, std::mt19937_64& engine, std::normal_distribution<double>& distr)
+    {
+    #if defined(ARMA_OPTIMISE_RNG)
+      {
+      arma_ignore(distr);
+      
+      arma_rng_ziggurat::get_tables().fill(mem, N, engine);
+      }
+    #else
+      {
+      for(uword i=0; i < N; ++i)  { mem[i] = eT( distr(engine) ); }
+      }
+    #endif
+    }
+  
+  
   inline
   static
   void
   fill(eT* mem, const uword N)
     {
-    #if defined(ARMA_USE_OPENMP)
+    #if   defined(ARMA_RNG_PHILOX)
+      {
+      arma_rng_philox::instance().randn_fill(mem, N);
+      }
+    #elif defined(ARMA_USE_OPENMP)
       {
       if((N < 1024) || omp_in_parallel())  { arma_rng::randn<eT>::fill_simple(mem, N); return; }
       
@@ -397,16 +476,12 @@ struct arma_rng::randn
         const uword start = (t+0) * chunk_size;
         const uword endp1 = (t+1) * chunk_size;
         
-        std::mt19937_64&                  t_engine = engine[t];
-        std::normal_distribution<double>& t_distr  =  distr[t];
-        
-        for(uword i=start; i < endp1; ++i)  { mem[i] = eT( t_distr(t_engine)); }
+        arma_rng::randn<eT>::fill_engine(&(mem[start]), (endp1 - start), engine[t], distr[t]);
         }
       
-      std::mt19937_64&                  t0_engine = engine[0];
-      std::normal_distribution<double>& t0_distr  =  distr[0];
+      const uword start = n_threads * chunk_size;
       
-      for(uword i=(n_threads*chunk_size); i < N; ++i)  { mem[i] = eT( t0_distr(t0_engine)); }
+      arma_rng::randn<eT>::fill_engine(&(mem[start]), (N - start), engine[0], distr[0]);
       }
     #else
       {
@@ -458,7 +533,11 @@ struct arma_rng::randn< std::complex<T> >
   void
   fill(std::complex<T>* mem, const uword N)
     {
-    #if defined(ARMA_USE_OPENMP)
+    #if   defined(ARMA_RNG_PHILOX)
+      {
+      arma_rng_philox::instance().randn_fill(reinterpret_cast<T*>(mem), 2*N);
+      }
+    #elif defined(ARMA_USE_OPENMP)
       {
       if((N < 512) || omp_in_parallel())  { arma_rng::randn< std::complex<T> >::fill_simple(mem, N); return; }
       
@@ -484,28 +563,14 @@ struct arma_rng::randn< std::complex<T> >
         const uword start = (t+0) * chunk_size;
         const uword endp1 = (t+1) * chunk_size;
         
-        std::mt19937_64&                  t_engine = engine[t];
-        std::normal_distribution<double>& t_distr  =  distr[t];
+        // std::complex<T> is layout compatible with T[2]
         
-        for(uword i=start; i < endp1; ++i)
-          {
-          const T val1 = T( t_distr(t_engine) );
-          const T val2 = T( t_distr(t_engine) );
-          
-          mem[i] = std::complex<T>(val1, val2);
-          }
+        arma_rng::randn<T>::fill_engine(reinterpret_cast<T*>(&(mem[start])), 2*(endp1 - start), engine[t], distr[t]);
         }
       
-      std::mt19937_64&                  t0_engine = engine[0];
-      std::normal_distribution<double>& t0_distr  =  distr[0];
+      const uword start = n_threads * chunk_size;
       
-      for(uword i=(n_threads*chunk_size); i < N; ++i)
-        {
-        const T val1 = T( t0_distr(t0_engine) );
-        const T val2 = T( t0_distr(t0_engine) );
-        
-        mem[i] = std::complex<T>(val1, val2);
-        }
+      arma_rng::randn<T>::fill_engine(reinterpret_cast<T*>(&(mem[start])), 2*(N - start), engine[0], distr[0]);
       }
     #else
       {
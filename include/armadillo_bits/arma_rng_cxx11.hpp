@@ -84,7 +84,15 @@ arma_inline
 double
 arma_rng_cxx11::randu_val()
   {
-  return u_distr(engine);
+  #if defined(ARMA_OPTIMISE_RNG)
+    {
+    return arma_rng_ziggurat::to_double_co( u64(engine()) );
+    }
+  #else
+    {
+    return u_distr(engine);
+    }
+  #endif
   }
 
 
@@ -93,7 +101,15 @@ arma_inline
 double
 arma_rng_cxx11::randn_val()
   {
-  return n_distr(engine);
+  #if defined(ARMA_OPTIMISE_RNG)
+    {
+    return arma_rng_ziggurat::get_tables().sample(engine);
+    }
+  #else
+    {
+    return n_distr(engine);
+    }
+  #endif
   }
 
 
@@ -103,8 +119,19 @@ arma_inline
 void
 arma_rng_cxx11::randn_dual_val(eT& out1, eT& out2)
   {
-  out1 = eT( n_distr(engine) );
-  out2 = eT( n_distr(engine) );
+  #if defined(ARMA_OPTIMISE_RNG)
+    {
+    const arma_rng_ziggurat& zig = arma_rng_ziggurat::get_tables();
+    
+    out1 = eT( zig.sample(engine) );
+    out2 = eT( zig.sample(engine) );
+    }
+  #else
+    {
+    out1 = eT( n_distr(engine) );
+    out2 = eT( n_distr(engine) );
+    }
+  #endif
   }
 
 
@@ -0,0 +1,560 @@
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+//! \addtogroup arma_rng_philox
+//! @{
+
+
+//! Philox4x32-10 counter-based generator (Salmon et al, "Parallel Random Numbers: As Easy as 1, 2, 3", SC 2011).
+//! Block b of the stream is a pure function of the key (seed) and the counter b,
+//! so fills are split across threads without changing the generated values.
+class arma_rng_philox
+  {
+  public:
+  
+  typedef u64 seed_type;
+  
+  static constexpr uword batch_size = 8;   //!< number of blocks generated together; allows vectorisation of the rounds
+  
+  inline static arma_rng_philox& instance();
+  
+  inline arma_rng_philox();
+  
+  inline void set_seed(const seed_type val);
+  
+  inline int    randi_val();
+  inline double randu_val();
+  inline double randn_val();
+  
+  template<typename eT>
+  inline void randn_dual_val(eT& out1, eT& out2);
+  
+  template<typename eT> inline void randu_fill(eT* mem, const uword N);
+  template<typename eT> inline void randn_fill(eT* mem, const uword N);
+  template<typename eT> inline void randi_fill(eT* mem, const uword N, const int a, const int b);
+  
+  inline static int randi_max_val();
+  
+  inline static void generate(u32* out, const u32* key, const u32* ctr, const uword n_blocks);
+  
+  
+  private:
+  
+  u32   key[2];     //!< derived from the seed
+  u64   counter;    //!< index of the next unused block
+  u32   buf[4];     //!< block used by the single value functions
+  uword buf_pos;    //!< position of the next unused word in buf
+  
+  //! further blocks for a value that needs more random bits than its share of the main stream;
+  //! uses the counters (block, 1+slot, 0), (block, 1+slot, 1), ... which are disjoint from the main stream
+  struct substream
+    {
+    const u32* key;
+    u32        ctr[4];
+    u32        words[4];
+    uword      pos;
+    
+    inline substream(const u32* in_key, const u64 block, const uword slot);
+    
+    inline u64 operator()();
+    };
+  
+  inline void next_block(u32* out);
+  inline u64  next_u64();
+  
+  template<typename eT, uword kind> inline void fill(eT* mem, const uword N, const int a, const int b);
+  
+  template<typename eT, uword kind> inline static void fill_range(eT* mem, const uword N, const u32* key, const u64 block_base, const uword block_start, const uword block_end, const int a, const int b);
+  
+  template<typename eT, uword kind> arma_inline static uword values_per_block();
+  
+  arma_inline static double to_double_co(const u32 lo, const u32 hi);
+  arma_inline static double to_double_oc(const u32 lo, const u32 hi);
+  arma_inline static float  to_float_co(const u32 x);
+  };
+
+
+
+inline
+arma_rng_philox&
+arma_rng_philox::instance()
+  {
+  // each thread has its own stream, in the same manner as arma_rng_cxx11_instance
+  
+  static thread_local arma_rng_philox philox_instance;
+  
+  return philox_instance;
+  }
+
+
+
+inline
+arma_rng_philox::arma_rng_philox()
+  {
+  set_seed(seed_type(0));
+  }
+
+
+
+inline
+void
+arma_rng_philox::set_seed(const arma_rng_philox::seed_type val)
+  {
+  key[0] = u32(val      );
+  key[1] = u32(val >> 32);
+  
+  counter = 0;
+  buf_pos = 4;
+  }
+
+
+
+//! Philox4x32-10 for n_blocks consecutive counters, starting at ctr;
+//! the first two words of the counter form a 64 bit number which is incremented for each block
+inline
+void
+arma_rng_philox::generate(u32* out, const u32* key, const u32* ctr, const uword n_blocks)
+  {
+  const u32 M0 = u32(0xD2511F53);
+  const u32 M1 = u32(0xCD9E8D57);
+  const u32 W0 = u32(0x9E3779B9);
+  const u32 W1 = u32(0xBB67AE85);
+  
+  const u64 ctr_lo = u64(ctr[0]) | (u64(ctr[1]) << 32);
+  
+  for(uword block=0; block < n_blocks; block += batch_size)
+    {
+    // the state is kept as separate arrays for each word, so that the rounds can be vectorised across blocks
+    
+    u32 x0[batch_size];
+    u32 x1[batch_size];
+    u32 x2[batch_size];
+    u32 x3[batch_size];
+    
+    for(uword k=0; k < batch_size; ++k)
+      {
+      const u64 c = ctr_lo + u64(block + k);
+      
+      x0[k] = u32(c      );
+      x1[k] = u32(c >> 32);
+      x2[k] = ctr[2];
+      x3[k] = ctr[3];
+      }
+    
+    u32 k0 = key[0];
+    u32 k1 = key[1];
+    
+    for(uword round=0; round < 10; ++round)
+      {
+      for(uword k=0; k < batch_size; ++k)
+        {
+        const u64 p0 = u64(M0) * u64(x0[k]);
+        const u64 p1 = u64(M1) * u64(x2[k]);
+        
+        const u32 y0 = u32(p1 >> 32) ^ x1[k] ^ k0;
+        const u32 y2 = u32(p0 >> 32) ^ x3[k] ^ k1;
+        
+        x0[k] = y0;
+        x1[k] = u32(p1);
+        x2[k] = y2;
+        x3[k] = u32(p0);
+        }
+      
+      k0 += W0;
+      k1 += W1;
+      }
+    
+    const uword n = (std::min)(uword(batch_size), n_blocks - block);
+    
+    for(uword k=0; k < n; ++k)
+      {
+      u32* out_k = &(out[4*(block+k)]);
+      
+      out_k[0] = x0[k];
+      out_k[1] = x1[k];
+      out_k[2] = x2[k];
+      out_k[3] = x3[k];
+      }
+    }
+  }
+
+
+
+inline
+arma_rng_philox::substream::substream(const u32* in_key, const u64 block, const uword slot)
+  : key(in_key)
+  , pos(4)
+  {
+  ctr[0] = u32(block      );
+  ctr[1] = u32(block >> 32);
+  ctr[2] = u32(1 + slot);
+  ctr[3] = u32(0);
+  }
+
+
+
+inline
+u64
+arma_rng_philox::substream::operator()()
+  {
+  if(pos >= 4)
+    {
+    generate(words, key, ctr, 1);
+    
+    ++ctr[3];
+    
+    pos = 0;
+    }
+  
+  const u64 val = u64(words[pos]) | (u64(words[pos+1]) << 32);
+  
+  pos += 2;
+  
+  return val;
+  }
+
+
+
+inline
+void
+arma_rng_philox::next_block(u32* out)
+  {
+  const u32 ctr[4] = { u32(counter), u32(counter >> 32), u32(0), u32(0) };
+  
+  generate(out, key, ctr, 1);
+  
+  ++counter;
+  }
+
+
+
+inline
+u64
+arma_rng_philox::next_u64()
+  {
+  if(buf_pos >= 4)  { next_block(buf); buf_pos = 0; }
+  
+  const u64 val = u64(buf[buf_pos]) | (u64(buf[buf_pos+1]) << 32);
+  
+  buf_pos += 2;
+  
+  return val;
+  }
+
+
+
+//! uniform in [0,1) with 53 bits of resolution
+arma_inline
+double
+arma_rng_philox::to_double_co(const u32 lo, const u32 hi)
+  {
+  const u64 val = u64(lo) | (u64(hi) << 32);
+  
+  return double(val >> 11) * (1.0 / 9007199254740992.0);
+  }
+
+
+
+//! uniform in (0,1] with 53 bits of resolution
+arma_inline
+double
+arma_rng_philox::to_double_oc(const u32 lo, const u32 hi)
+  {
+  const u64 val = u64(lo) | (u64(hi) << 32);
+  
+  return double((val >> 11) + u64(1)) * (1.0 / 9007199254740992.0);
+  }
+
+
+
+//! uniform in [0,1) with 24 bits of resolution
+arma_inline
+float
+arma_rng_philox::to_float_co(const u32 x)
+  {
+  return float(x >> 8) * (1.0f / 16777216.0f);
+  }
+
+
+
+inline
+int
+arma_rng_philox::randi_val()
+  {
+  return int( next_u64() >> 33 );
+  }
+
+
+
+inline
+double
+arma_rng_philox::randu_val()
+  {
+  const u64 val = next_u64();
+  
+  return to_double_co( u32(val), u32(val >> 32) );
+  }
+
+
+
+inline
+double
+arma_rng_philox::randn_val()
+  {
+  double out1;
+  double out2;
+  
+  randn_dual_val(out1, out2);
+  
+  return out1;
+  }
+
+
+
+template<typename eT>
+inline
+void
+arma_rng_philox::randn_dual_val(eT& out1, eT& out2)
+  {
+  u32 w[4];
+  
+  #if defined(ARMA_OPTIMISE_RNG)
+    {
+    const u64 block = counter;
+    
+    next_block(w);
+    
+    const arma_rng_ziggurat& zig = arma_rng_ziggurat::get_tables();
+    
+    const u64 bits1 = u64(w[0]) | (u64(w[1]) << 32);
+    const u64 bits2 = u64(w[2]) | (u64(w[3]) << 32);
+    
+    double val1;
+    double val2;
+    
+    if(zig.fast(bits1, val1) == false)  { substream gen(key, block, 0);  val1 = zig.slow(bits1, gen); }
+    if(zig.fast(bits2, val2) == false)  { substream gen(key, block, 1);  val2 = zig.slow(bits2, gen); }
+    
+    out1 = eT(val1);
+    out2 = eT(val2);
+    }
+  #else
+    {
+    next_block(w);
+    
+    // Box-Muller transform
+    
+    const double r     = std::sqrt( -2.0 * std::log( to_double_oc(w[0], w[1]) ) );
+    const double theta = 2.0 * Datum<double>::pi * to_double_co(w[2], w[3]);
+    
+    out1 = eT( r * std::cos(theta) );
+    out2 = eT( r * std::sin(theta) );
+    }
+  #endif
+  }
+
+
+
+inline
+int
+arma_rng_philox::randi_max_val()
+  {
+  return std::numeric_limits<int>::max();
+  }
+
+
+
+// kind = 0: uniform in [0,1)
+// kind = 1: normal
+// kind = 2: integers in [a,b]
+
+template<typename eT, uword kind>
+arma_inline
+uword
+arma_rng_philox::values_per_block()
+  {
+  return ( (kind == 0) && is_float<eT>::value ) ? uword(4) : uword(2);
+  }
+
+
+
+template<typename eT>
+inline
+void
+arma_rng_philox::randu_fill(eT* mem, const uword N)
+  {
+  (*this).template fill<eT,0>(mem, N, 0, 0);
+  }
+
+
+
+template<typename eT>
+inline
+void
+arma_rng_philox::randn_fill(eT* mem, const uword N)
+  {
+  (*this).template fill<eT,1>(mem, N, 0, 0);
+  }
+
+
+
+template<typename eT>
+inline
+void
+arma_rng_philox::randi_fill(eT* mem, const uword N, const int a, const int b)
+  {
+  (*this).template fill<eT,2>(mem, N, a, b);
+  }
+
+
+
+template<typename eT, uword kind>
+inline
+void
+arma_rng_philox::fill(eT* mem, const uword N, const int a, const int b)
+  {
+  if(N == 0)  { return; }
+  
+  const uword vpb = values_per_block<eT,kind>();
+  
+  const uword n_blocks = (N + vpb - 1) / vpb;
+  
+  // element i is always generated from block (counter + i/vpb),
+  // so the output does not depend on how the blocks are split across threads
+  
+  const u64 block_base = counter;
+  
+  counter += u64(n_blocks);
+  buf_pos  = 4;
+  
+  #if defined(ARMA_USE_OPENMP)
+    {
+    if( (n_blocks >= 1024) && mp_gate<eT>::eval(N) )
+      {
+      const uword n_threads = (std::min)( uword(mp_thread_limit::get()), n_blocks / batch_size );
+      
+      #pragma omp parallel for schedule(static) num_threads(int(n_threads))
+      for(uword t=0; t < n_threads; ++t)
+        {
+        const uword start = (t    * n_blocks) / n_threads;
+        const uword end   = ((t+1) * n_blocks) / n_threads;
+        
+        fill_range<eT,kind>(mem, N, key, block_base, start, end, a, b);
+        }
+      
+      return;
+      }
+    }
+  #endif
+  
+  fill_range<eT,kind>(mem, N, key, block_base, 0, n_blocks, a, b);
+  }
+
+
+
+template<typename eT, uword kind>
+inline
+void
+arma_rng_philox::fill_range(eT* mem, const uword N, const u32* key, const u64 block_base, const uword block_start, const uword block_end, const int a, const int b)
+  {
+  const uword vpb = values_per_block<eT,kind>();
+  
+  const double range = double(b) - double(a) + 1.0;
+  
+  #if defined(ARMA_OPTIMISE_RNG)
+    const arma_rng_ziggurat& zig = arma_rng_ziggurat::get_tables();
+  #endif
+  
+  u32 words[4*batch_size];
+  
+  for(uword block=block_start; block < block_end; block += batch_size)
+    {
+    const uword n = (std::min)(uword(batch_size), block_end - block);
+    
+    const u64 c = block_base + u64(block);
+    
+    const u32 ctr[4] = { u32(c), u32(c >> 32), u32(0), u32(0) };
+    
+    generate(words, key, ctr, n);
+    
+    for(uword k=0; k < n; ++k)
+      {
+      const u32* w = &(words[4*k]);
+      
+      const uword i = (block + k) * vpb;
+      
+      eT val[4];
+      
+      if( (kind == 0) && (vpb == 4) )
+        {
+        val[0] = eT( to_float_co(w[0]) );
+        val[1] = eT( to_float_co(w[1]) );
+        val[2] = eT( to_float_co(w[2]) );
+        val[3] = eT( to_float_co(w[3]) );
+        }
+      else
+      if(kind == 0)
+        {
+        val[0] = eT( to_double_co(w[0], w[1]) );
+        val[1] = eT( to_double_co(w[2], w[3]) );
+        }
+      else
+      if(kind == 1)
+        {
+        #if defined(ARMA_OPTIMISE_RNG)
+          {
+          for(uword j=0; j < 2; ++j)
+            {
+            const u64 bits = u64(w[2*j]) | (u64(w[2*j+1]) << 32);
+            
+            double out;
+            
+            if(zig.fast(bits, out) == false)
+              {
+              substream gen(key, block_base + u64(block + k), j);
+              
+              out = zig.slow(bits, gen);
+              }
+            
+            val[j] = eT(out);
+            }
+          }
+        #else
+          {
+          const double r     = std::sqrt( -2.0 * std::log( to_double_oc(w[0], w[1]) ) );
+          const double theta = 2.0 * Datum<double>::pi * to_double_co(w[2], w[3]);
+          
+          val[0] = eT( r * std::cos(theta) );
+          val[1] = eT( r * std::sin(theta) );
+          }
+        #endif
+        }
+      else
+        {
+        val[0] = eT( (std::min)( double(a) + std::floor(range * to_double_co(w[0], w[1])), double(b) ) );
+        val[1] = eT( (std::min)( double(a) + std::floor(range * to_double_co(w[2], w[3])), double(b) ) );
+        }
+      
+      const uword n_vals = (std::min)(vpb, N - i);
+      
+      for(uword j=0; j < n_vals; ++j)  { mem[i+j] = val[j]; }
+      }
+    }
+  }
+
+
+
+//! @}
@@ -0,0 +1,198 @@
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+//! \addtogroup arma_rng_ziggurat
+//! @{
+
+
+//! Ziggurat method for standard normal variates (Marsaglia and Tsang, 2000; Doornik, 2005),
+//! using 256 layers and 64 random bits per attempt:
+//! the lower 8 bits select the layer and the upper 53 bits form the uniform variate.
+//! About 99% of attempts are accepted by the fast path, which needs one multiplication and one comparison.
+class arma_rng_ziggurat
+  {
+  public:
+  
+  static constexpr uword n_layers = 256;
+  
+  inline static const arma_rng_ziggurat& get_tables();
+  
+  arma_inline bool fast(const u64 bits, double& out) const;
+  
+  template<typename gen_type> inline double slow(u64 bits, gen_type& gen) const;
+  
+  template<typename gen_type> inline double sample(gen_type& gen) const;
+  
+  template<typename eT, typename gen_type> inline void fill(eT* mem, const uword N, gen_type& gen) const;
+  
+  arma_inline static double to_double_co(const u64 bits);
+  arma_inline static double to_double_oc(const u64 bits);
+  
+  
+  private:
+  
+  double x[n_layers+1];   //!< right edges of the layers; x[0] is the width of the base layer's rectangle
+  double r[n_layers  ];   //!< x[i+1]/x[i]
+  double f[n_layers+1];   //!< exp(-x[i]^2/2)
+  
+  inline arma_rng_ziggurat();
+  };
+
+
+
+inline
+const arma_rng_ziggurat&
+arma_rng_ziggurat::get_tables()
+  {
+  static const arma_rng_ziggurat tables;
+  
+  return tables;
+  }
+
+
+
+inline
+arma_rng_ziggurat::arma_rng_ziggurat()
+  {
+  const double R = 3.6541528853610088;      // start of the tail
+  const double V = 0.00492867323399;        // area of each layer
+  
+  const double fR = std::exp(-0.5*R*R);
+  
+  x[0] = V / fR;
+  x[1] = R;
+  
+  for(uword i=2; i < n_layers; ++i)
+    {
+    x[i] = std::sqrt( -2.0 * std::log( V/x[i-1] + std::exp(-0.5*x[i-1]*x[i-1]) ) );
+    }
+  
+  x[n_layers] = 0.0;
+  
+  for(uword i=0; i < n_layers;  ++i)  { r[i] = x[i+1] / x[i]; }
+  for(uword i=0; i <= n_layers; ++i)  { f[i] = std::exp(-0.5*x[i]*x[i]); }
+  }
+
+
+
+//! uniform in [0,1) from the upper 53 bits
+arma_inline
+double
+arma_rng_ziggurat::to_double_co(const u64 bits)
+  {
+  return double(bits >> 11) * (1.0 / 9007199254740992.0);
+  }
+
+
+
+//! uniform in (0,1] from the upper 53 bits
+arma_inline
+double
+arma_rng_ziggurat::to_double_oc(const u64 bits)
+  {
+  return double((bits >> 11) + u64(1)) * (1.0 / 9007199254740992.0);
+  }
+
+
+
+arma_inline
+bool
+arma_rng_ziggurat::fast(const u64 bits, double& out) const
+  {
+  const uword  i = uword(bits & u64(0xFF));
+  const double u = 2.0 * to_double_co(bits) - 1.0;
+  
+  out = u * x[i];
+  
+  return (std::abs(u) < r[i]);
+  }
+
+
+
+//! continue sampling after the fast path rejected the given bits
+template<typename gen_type>
+inline
+double
+arma_rng_ziggurat::slow(u64 bits, gen_type& gen) const
+  {
+  const double R = x[1];
+  
+  while(true)
+    {
+    const uword  i = uword(bits & u64(0xFF));
+    const double u = 2.0 * to_double_co(bits) - 1.0;
+    
+    if(i == 0)
+      {
+      // tail beyond R
+      
+      double a;
+      double b;
+      
+      do
+        {
+        a = -std::log( to_double_oc(u64(gen())) ) / R;
+        b = -std::log( to_double_oc(u64(gen())) );
+        }
+      while( (b+b) < (a*a) );
+      
+      return (u < 0.0) ? -(R + a) : (R + a);
+      }
+    
+    // wedge between the layer's rectangle and the curve
+    
+    const double val = u * x[i];
+    
+    const double y = f[i] + to_double_co(u64(gen())) * (f[i+1] - f[i]);
+    
+    if( y < std::exp(-0.5*val*val) )  { return val; }
+    
+    bits = u64(gen());
+    
+    double out;
+    
+    if(fast(bits, out))  { return out; }
+    }
+  }
+
+
+
+//! gen() must provide 64 random bits
+template<typename gen_type>
+inline
+double
+arma_rng_ziggurat::sample(gen_type& gen) const
+  {
+  const u64 bits = u64(gen());
+  
+  double out;
+  
+  return (fast(bits, out)) ? out : slow(bits, gen);
+  }
+
+
+
+template<typename eT, typename gen_type>
+inline
+void
+arma_rng_ziggurat::fill(eT* mem, const uword N, gen_type& gen) const
+  {
+  for(uword i=0; i < N; ++i)  { mem[i] = eT( sample(gen) ); }
+  }
+
+
+
+//! @}
@@ -0,0 +1,403 @@
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+//! \addtogroup block_codec
+//! @{
+
+
+//! lossless codec used by the arma_compact file format;
+//! each block is byte-shuffled (bytes of equal significance are grouped together)
+//! and then compressed with zlib (if enabled) or a small built-in LZ77 compressor
+class block_codec
+  {
+  public:
+  
+  static constexpr u32 codec_raw      = 0;  //!< block stored as is
+  static constexpr u32 codec_shuf_lz  = 1;  //!< byte shuffle + built-in LZ
+  static constexpr u32 codec_shuf_zl  = 2;  //!< byte shuffle + zlib
+  
+  inline static u32 checksum(const unsigned char* mem, const uword n_bytes);
+  
+  inline static void   shuffle(unsigned char* out, const unsigned char* in, const uword n_bytes, const uword elem_size);
+  inline static void unshuffle(unsigned char* out, const unsigned char* in, const uword n_bytes, const uword elem_size);
+  
+  inline static uword lz_compress  (unsigned char* out, const uword out_cap, const unsigned char* in, const uword n_in);
+  inline static bool  lz_decompress(unsigned char* out, const uword n_out,   const unsigned char* in, const uword n_in);
+  
+  inline static u32  encode(std::vector<unsigned char>& out, const unsigned char* in, const uword n_bytes, const uword elem_size);
+  inline static bool decode(unsigned char* out, const uword n_bytes, const unsigned char* in, const uword n_in, const u32 codec, const uword elem_size);
+  
+  
+  private:
+  
+  static constexpr uword lz_hash_bits  = 14;
+  static constexpr uword lz_min_match  = 4;
+  static constexpr uword lz_max_offset = 65535;
+  
+  arma_inline static u32  lz_read32(const unsigned char* mem)  { u32 val; std::memcpy(&val, mem, 4); return val; }
+  arma_inline static uword lz_hash(const u32 val)  { return uword( (val * u32(2654435761U)) >> (32 - lz_hash_bits) ); }
+  
+  inline static bool lz_put_length(unsigned char*& op, const unsigned char* op_end, uword len);
+  };
+
+
+
+//! Adler-32
+inline
+u32
+block_codec::checksum(const unsigned char* mem, const uword n_bytes)
+  {
+  const u32 mod_adler = 65521;
+  
+  u32 a = 1;
+  u32 b = 0;
+  
+  uword i = 0;
+  
+  while(i < n_bytes)
+    {
+    // 5552 is the largest n such that the sums don't overflow 32 bits before the modulo
+    const uword n = (std::min)(n_bytes - i, uword(5552));
+    
+    for(uword j=0; j < n; ++j)  { a += mem[i+j]; b += a; }
+    
+    a %= mod_adler;
+    b %= mod_adler;
+    
+    i += n;
+    }
+  
+  return (b << 16) | a;
+  }
+
+
+
+inline
+void
+block_codec::shuffle(unsigned char* out, const unsigned char* in, const uword n_bytes, const uword elem_size)
+  {
+  const uword n_elem = n_bytes / elem_size;
+  const uword n_tail = n_bytes - n_elem*elem_size;
+  
+  for(uword j=0; j < elem_size; ++j)
+    {
+    unsigned char* out_j = &(out[j*n_elem]);
+    
+    for(uword i=0; i < n_elem; ++i)  { out_j[i] = in[i*elem_size + j]; }
+    }
+  
+  if(n_tail > 0)  { std::memcpy(&(out[n_elem*elem_size]), &(in[n_elem*elem_size]), n_tail); }
+  }
+
+
+
+inline
+void
+block_codec::unshuffle(unsigned char* out, const unsigned char* in, const uword n_bytes, const uword elem_size)
+  {
+  const uword n_elem = n_bytes / elem_size;
+  const uword n_tail = n_bytes - n_elem*elem_size;
+  
+  for(uword j=0; j < elem_size; ++j)
+    {
+    const unsigned char* in_j = &(in[j*n_elem]);
+    
+    for(uword i=0; i < n_elem; ++i)  { out[i*elem_size + j] = in_j[i]; }
+    }
+  
+  if(n_tail > 0)  { std::memcpy(&(out[n_elem*elem_size]), &(in[n_elem*elem_size]), n_tail); }
+  }
+
+
+
+inline
+bool
+block_codec::lz_put_length(unsigned char*& op, const unsigned char* op_end, uword len)
+  {
+  while(len >= 255)
+    {
+    if(op >= op_end)  { return false; }
+    
+    *op++ = 255;
+    len -= 255;
+    }
+  
+  if(op >= op_end)  { return false; }
+  
+  *op++ = (unsigned char)(len);
+  
+  return true;
+  }
+
+
+
+//! compress n_in bytes into at most out_cap bytes;
+//! returns the compressed size, or 0 if the output doesn't fit.
+//! the format is a sequence of (token, literals, offset, match) records:
+//! the token holds the literal length (high nibble) and match length minus 4 (low nibble),
+//! with 15 meaning that further length bytes follow;
+//! the final record only holds literals
+inline
+uword
+block_codec::lz_compress(unsigned char* out, const uword out_cap, const unsigned char* in, const uword n_in)
+  {
+  const uword hash_size = uword(1) << lz_hash_bits;
+  
+  podarray<uword> table(hash_size);
+  
+  // position + 1, so that zero means "empty"
+  arrayops::fill_zeros(table.memptr(), hash_size);
+  
+  unsigned char*       op     = out;
+  const unsigned char* op_end = out + out_cap;
+  
+  uword anchor = 0;
+  uword pos    = 0;
+  
+  const uword match_limit = (n_in >= lz_min_match) ? (n_in - lz_min_match) : 0;
+  
+  while( (n_in >= lz_min_match) && (pos <= match_limit) )
+    {
+    const u32   seq = lz_read32(&in[pos]);
+    const uword h   = lz_hash(seq);
+    const uword ref = table[h];
+    
+    table[h] = pos + 1;
+    
+    if( (ref == 0) || ((pos - (ref-1)) > lz_max_offset) || (lz_read32(&in[ref-1]) != seq) )  { ++pos; continue; }
+    
+    const uword match_pos = ref - 1;
+    
+    uword match_len = lz_min_match;
+    
+    while( ((pos + match_len) < n_in) && (in[match_pos + match_len] == in[pos + match_len]) )  { ++match_len; }
+    
+    const uword lit_len = pos - anchor;
+    const uword offset  = pos - match_pos;
+    const uword ml_code = match_len - lz_min_match;
+    
+    if(op >= op_end)  { return 0; }
+    
+    *op++ = (unsigned char)( ((lit_len >= 15) ? 15 : lit_len) << 4 | ((ml_code >= 15) ? 15 : ml_code) );
+    
+    if( (lit_len >= 15) && (lz_put_length(op, op_end, lit_len - 15) == false) )  { return 0; }
+    
+    if( (op + lit_len + 2) > op_end )  { return 0; }
+    
+    std::memcpy(op, &in[anchor], lit_len);  op += lit_len;
+    
+    *op++ = (unsigned char)(offset & 0xFF);
+    *op++ = (unsigned char)(offset >> 8);
+    
+    if( (ml_code >= 15) && (lz_put_length(op, op_end, ml_code - 15) == false) )  { return 0; }
+    
+    pos   += match_len;
+    anchor = pos;
+    
+    // seed the table with a position inside the match, which improves the ratio for periodic data
+    if( (pos >= 2) && ((pos-2) <= match_limit) )  { table[ lz_hash(lz_read32(&in[pos-2])) ] = pos - 1; }
+    }
+  
+  // final record: literals only
+  
+  const uword lit_len = n_in - anchor;
+  
+  if(op >= op_end)  { return 0; }
+  
+  *op++ = (unsigned char)( ((lit_len >= 15) ? 15 : lit_len) << 4 );
+  
+  if( (lit_len >= 15) && (lz_put_length(op, op_end, lit_len - 15) == false) )  { return 0; }
+  
+  if( (op + lit_len) > op_end )  { return 0; }
+  
+  std::memcpy(op, &in[anchor], lit_len);  op += lit_len;
+  
+  return uword(op - out);
+  }
+
+
+
+//! decompress exactly n_out bytes; all reads and writes are bounds checked,
+//! so corrupt input results in a return value of false
+inline
+bool
+block_codec::lz_decompress(unsigned char* out, const uword n_out, const unsigned char* in, const uword n_in)
+  {
+  uword ip = 0;
+  uword op = 0;
+  
+  while(ip < n_in)
+    {
+    const uword token = in[ip++];
+    
+    uword lit_len = token >> 4;
+    
+    if(lit_len == 15)
+      {
+      uword byte = 255;
+      
+      while(byte == 255)
+        {
+        if(ip >= n_in)  { return false; }
+        
+        byte = in[ip++];  lit_len += byte;
+        }
+      }
+    
+    if( (lit_len > (n_in - ip)) || (lit_len > (n_out - op)) )  { return false; }
+    
+    std::memcpy(&out[op], &in[ip], lit_len);
+    
+    ip += lit_len;
+    op += lit_len;
+    
+    if(ip == n_in)  { break; }  // final record
+    
+    if((ip + 2) > n_in)  { return false; }
+    
+    const uword offset = uword(in[ip]) | (uword(in[ip+1]) << 8);
+    
+    ip += 2;
+    
+    uword match_len = (token & 15);
+    
+    if(match_len == 15)
+      {
+      uword byte = 255;
+      
+      while(byte == 255)
+        {
+        if(ip >= n_in)  { return false; }
+        
+        byte = in[ip++];  match_len += byte;
+        }
+      }
+    
+    match_len += lz_min_match;
+    
+    if( (offset == 0) || (offset > op) || (match_len > (n_out - op)) )  { return false; }
+    
+    const unsigned char* src = &out[op - offset];
+          unsigned char* dst = &out[op];
+    
+    if(offset >= match_len)
+      {
+      std::memcpy(dst, src, match_len);
+      }
+    else
+      {
+      for(uword i=0; i < match_len; ++i)  { dst[i] = src[i]; }
+      }
+    
+    op += match_len;
+    }
+  
+  return (op == n_out);
+  }
+
+
+
+//! compress one block; returns the codec used.
+//! blocks which don't compress are stored as is
+inline
+u32
+block_codec::encode(std::vector<unsigned char>& out, const unsigned char* in, const uword n_bytes, const uword elem_size)
+  {
+  podarray<unsigned char> shuffled(n_bytes);
+  
+  block_codec::shuffle(shuffled.memptr(), in, n_bytes, elem_size);
+  
+  out.resize(n_bytes);
+  
+  u32 codec = codec_raw;
+  
+  uword n_out = 0;
+  
+  #if defined(ARMA_USE_ZLIB)
+    {
+    uLongf dest_len = uLongf( compressBound(uLong(n_bytes)) );
+    
+    out.resize(dest_len);
+    
+    const int status = compress2(&out[0], &dest_len, shuffled.memptr(), uLong(n_bytes), Z_BEST_SPEED);
+    
+    if( (status == Z_OK) && (uword(dest_len) < n_bytes) )  { codec = codec_shuf_zl; n_out = uword(dest_len); }
+    }
+  #else
+    {
+    if(n_bytes > 0)  { n_out = block_codec::lz_compress(&out[0], n_bytes, shuffled.memptr(), n_bytes); }
+    
+    if( (n_out > 0) && (n_out < n_bytes) )  { codec = codec_shuf_lz; }
+    }
+  #endif
+  
+  if(codec == codec_raw)
+    {
+    out.resize(n_bytes);
+    
+    if(n_bytes > 0)  { std::memcpy(&out[0], in, n_bytes); }
+    }
+  else
+    {
+    out.resize(n_out);
+    }
+  
+  return codec;
+  }
+
+
+
+inline
+bool
+block_codec::decode(unsigned char* out, const uword n_bytes, const unsigned char* in, const uword n_in, const u32 codec, const uword elem_size)
+  {
+  if(codec == codec_raw)
+    {
+    if(n_in != n_bytes)  { return false; }
+    
+    if(n_bytes > 0)  { std::memcpy(out, in, n_bytes); }
+    
+    return true;
+    }
+  
+  podarray<unsigned char> shuffled(n_bytes);
+  
+  bool status = false;
+  
+  if(codec == codec_shuf_lz)
+    {
+    status = block_codec::lz_decompress(shuffled.memptr(), n_bytes, in, n_in);
+    }
+  else
+  if(codec == codec_shuf_zl)
+    {
+    #if defined(ARMA_USE_ZLIB)
+      {
+      uLongf dest_len = uLongf(n_bytes);
+      
+      status = (uncompress(shuffled.memptr(), &dest_len, in, uLong(n_in)) == Z_OK) && (uword(dest_len) == n_bytes);
+      }
+    #endif
+    }
+  
+  if(status)  { block_codec::unshuffle(out, shuffled.memptr(), n_bytes, elem_size); }
+  
+  return status;
+  }
+
+
+
+//! @}
@@ -0,0 +1,65 @@
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+//! \addtogroup compact_reader
+//! @{
+
+
+//! Random access to the blocks of a matrix saved in arma_compact format;
+//! each block holds a set of whole columns and is decompressed independently,
+//! so ranges of columns can be streamed without reading the entire file
+template<typename eT>
+class compact_reader
+  {
+  public:
+  
+  inline  compact_reader();
+  inline  compact_reader(const std::string& name);
+  inline ~compact_reader();
+  
+  inline bool open(const std::string& name);
+  inline void close();
+  
+  inline bool is_open() const;
+  
+  inline uword n_rows()   const;
+  inline uword n_cols()   const;
+  inline uword n_blocks() const;
+  
+  inline uword block_n_cols() const;  //!< number of columns in each block (the last block may have fewer)
+  
+  inline bool read_block(Mat<eT>& out, const uword block_id);
+  inline bool read_cols (Mat<eT>& out, const uword in_col1, const uword in_col2);
+  
+  
+  private:
+  
+  std::ifstream f;
+  
+  bool  valid    = false;
+  uword f_n_rows = 0;
+  uword f_n_cols = 0;
+  uword f_block_bytes = 0;
+  
+  std::streampos  payload_pos;
+  podarray<u64>   table;     //!< (stored size, codec|checksum) for each block
+  podarray<uword> offsets;   //!< start of each block within the payload
+  
+  inline bool decode_block(eT* out, const uword block_id);
+  };
+
+
+//! @}
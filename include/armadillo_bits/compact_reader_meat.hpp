@@ -0,0 +1,298 @@
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+//! \addtogroup compact_reader
+//! @{
+
+
+template<typename eT>
+inline
+compact_reader<eT>::compact_reader()
+  {
+  arma_extra_debug_sigprint();
+  }
+
+
+
+template<typename eT>
+inline
+compact_reader<eT>::compact_reader(const std::string& name)
+  {
+  arma_extra_debug_sigprint();
+  
+  (*this).open(name);
+  }
+
+
+
+template<typename eT>
+inline
+compact_reader<eT>::~compact_reader()
+  {
+  arma_extra_debug_sigprint();
+  }
+
+
+
+template<typename eT>
+inline
+bool
+compact_reader<eT>::open(const std::string& name)
+  {
+  arma_extra_debug_sigprint();
+  
+  (*this).close();
+  
+  f.open(name.c_str(), std::fstream::binary);
+  
+  if(f.is_open() == false)
+    {
+    arma_debug_warn("compact_reader::open(): couldn't open ", name);
+    return false;
+    }
+  
+  std::string f_header;
+  
+  f >> f_header;
+  f >> f_n_rows;
+  f >> f_n_cols;
+  
+  if( (f_header != diskio::gen_compact_header(diskio::gen_bin_header(Mat<eT>()))) || (f.good() == false) )
+    {
+    arma_debug_warn("compact_reader::open(): incorrect header in ", name);
+    (*this).close();
+    return false;
+    }
+  
+  f.get();
+  
+  std::string err_msg;
+  
+  if(diskio::load_compact_table(f, f_n_rows*f_n_cols*sizeof(eT), f_block_bytes, table, err_msg) == false)
+    {
+    arma_debug_warn("compact_reader::open(): ", err_msg, name);
+    (*this).close();
+    return false;
+    }
+  
+  const uword col_bytes = f_n_rows*sizeof(eT);
+  
+  if( (col_bytes > 0) && ((f_block_bytes % col_bytes) != 0) )
+    {
+    arma_debug_warn("compact_reader::open(): blocks don't hold whole columns in ", name);
+    (*this).close();
+    return false;
+    }
+  
+  payload_pos = f.tellg();
+  
+  const uword N = table.n_elem / 2;
+  
+  offsets.set_size(N+1);
+  
+  offsets[0] = 0;
+  
+  for(uword i=0; i < N; ++i)  { offsets[i+1] = offsets[i] + uword(table[2*i]); }
+  
+  valid = true;
+  
+  return true;
+  }
+
+
+
+template<typename eT>
+inline
+void
+compact_reader<eT>::close()
+  {
+  arma_extra_debug_sigprint();
+  
+  if(f.is_open())  { f.close(); }
+  
+  f.clear();
+  
+  valid         = false;
+  f_n_rows      = 0;
+  f_n_cols      = 0;
+  f_block_bytes = 0;
+  
+  table.reset();
+  offsets.reset();
+  }
+
+
+
+template<typename eT>
+inline
+bool
+compact_reader<eT>::is_open() const
+  {
+  return valid;
+  }
+
+
+
+template<typename eT>
+inline
+uword
+compact_reader<eT>::n_rows() const
+  {
+  return f_n_rows;
+  }
+
+
+
+template<typename eT>
+inline
+uword
+compact_reader<eT>::n_cols() const
+  {
+  return f_n_cols;
+  }
+
+
+
+template<typename eT>
+inline
+uword
+compact_reader<eT>::n_blocks() const
+  {
+  return (valid) ? (table.n_elem / 2) : uword(0);
+  }
+
+
+
+template<typename eT>
+inline
+uword
+compact_reader<eT>::block_n_cols() const
+  {
+  const uword col_bytes = f_n_rows*sizeof(eT);
+  
+  return (col_bytes > 0) ? (f_block_bytes / col_bytes) : f_n_cols;
+  }
+
+
+
+template<typename eT>
+inline
+bool
+compact_reader<eT>::decode_block(eT* out, const uword block_id)
+  {
+  arma_extra_debug_sigprint();
+  
+  typedef typename get_pod_type<eT>::result pod_type;
+  
+  if(block_id >= n_blocks())  { return false; }
+  
+  const uword n_bytes = f_n_rows*f_n_cols*sizeof(eT);
+  const uword start   = block_id*f_block_bytes;
+  const uword len     = (std::min)(f_block_bytes, n_bytes - start);
+  
+  podarray<unsigned char> payload( uword(table[2*block_id]) );
+  
+  f.clear();
+  f.seekg(payload_pos + std::streamoff(offsets[block_id]));
+  f.read( reinterpret_cast<char*>(payload.memptr()), std::streamsize(payload.n_elem) );
+  
+  if(f.good() == false)  { return false; }
+  
+  return diskio::load_compact_block(reinterpret_cast<unsigned char*>(out), len, payload.memptr(), table[2*block_id], table[2*block_id+1], sizeof(pod_type));
+  }
+
+
+
+//! read the columns held by the given block
+template<typename eT>
+inline
+bool
+compact_reader<eT>::read_block(Mat<eT>& out, const uword block_id)
+  {
+  arma_extra_debug_sigprint();
+  
+  arma_debug_check( (block_id >= n_blocks()), "compact_reader::read_block(): block index out of bounds" );
+  
+  // files with no elements have no blocks
+  if(n_blocks() == 0)  { out.set_size(f_n_rows, f_n_cols); return valid; }
+  
+  const uword B = block_n_cols();
+  
+  const uword col1 = block_id * B;
+  const uword col2 = (std::min)(col1 + B, f_n_cols) - 1;
+  
+  out.set_size(f_n_rows, col2 - col1 + 1);
+  
+  const bool status = (*this).decode_block(out.memptr(), block_id);
+  
+  if(status == false)  { out.soft_reset(); arma_debug_warn("compact_reader::read_block(): corrupted data"); }
+  
+  return status;
+  }
+
+
+
+//! read columns in_col1 to in_col2 (inclusive), decompressing only the blocks which overlap them
+template<typename eT>
+inline
+bool
+compact_reader<eT>::read_cols(Mat<eT>& out, const uword in_col1, const uword in_col2)
+  {
+  arma_extra_debug_sigprint();
+  
+  arma_debug_check
+    (
+    (in_col1 > in_col2) || (in_col2 >= f_n_cols) || (valid == false),
+    "compact_reader::read_cols(): indices out of bounds or incorrectly used"
+    );
+  
+  if(f_n_rows == 0)  { out.set_size(f_n_rows, in_col2 - in_col1 + 1); return true; }
+  
+  const uword B = block_n_cols();
+  
+  const uword block1 = in_col1 / B;
+  const uword block2 = in_col2 / B;
+  
+  out.set_size(f_n_rows, in_col2 - in_col1 + 1);
+  
+  Mat<eT> tmp;
+  
+  for(uword block_id = block1; block_id <= block2; ++block_id)
+    {
+    const uword block_col1 = block_id * B;
+    const uword block_col2 = (std::min)(block_col1 + B, f_n_cols) - 1;
+    
+    const uword col1 = (std::max)(block_col1, in_col1);
+    const uword col2 = (std::min)(block_col2, in_col2);
+    
+    tmp.set_size(f_n_rows, block_col2 - block_col1 + 1);
+    
+    if((*this).decode_block(tmp.memptr(), block_id) == false)
+      {
+      out.soft_reset();
+      arma_debug_warn("compact_reader::read_cols(): corrupted data");
+      return false;
+      }
+    
+    out.cols(col1 - in_col1, col2 - in_col1) = tmp.cols(col1 - block_col1, col2 - block_col1);
+    }
+  
+  return true;
+  }
+
+
+
+//! @}
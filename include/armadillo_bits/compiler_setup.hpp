@@ -109,6 +109,13 @@
 #endif
 
 
+// shm_open() and mmap() are also part of IEEE standard 1003.1
+#if ( defined(_POSIX_SHARED_MEMORY_OBJECTS) && (_POSIX_SHARED_MEMORY_OBJECTS > 0) )
+  #undef  ARMA_HAVE_POSIX_SHM
+  #define ARMA_HAVE_POSIX_SHM
+#endif
+
+
 #if defined(__APPLE__) || defined(__apple_build_version__)
   #undef  ARMA_BLAS_SDOT_BUG
   #define ARMA_BLAS_SDOT_BUG
@@ -120,6 +127,7 @@
 
 #if defined(__MINGW32__) || defined(__CYGWIN__) || defined(_MSC_VER)
   #undef ARMA_HAVE_POSIX_MEMALIGN
+  #undef ARMA_HAVE_POSIX_SHM
 #endif
 
 
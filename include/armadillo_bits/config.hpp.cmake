@@ -118,6 +118,19 @@
 //// and you will need to link with the hdf5 library (eg. -lhdf5)
 #endif
 
+#if !defined(ARMA_USE_ZLIB)
+// #define ARMA_USE_ZLIB
+//// Uncomment the above line to compress arma_compact files with zlib instead of the built-in codec;
+//// the zlib.h header file must be available on your system,
+//// and you will need to link with the zlib library (eg. -lz)
+#endif
+
+#if !defined(ARMA_RNG_PHILOX)
+// #define ARMA_RNG_PHILOX
+//// Uncomment the above line to use the Philox4x32-10 counter-based random number generator;
+//// randu(), randn() and randi() then produce the same values regardless of the number of OpenMP threads.
+#endif
+
 #if !defined(ARMA_OPTIMISE_BAND)
   #define ARMA_OPTIMISE_BAND
   //// Comment out the above line if you don't want automatically optimised handling
@@ -131,6 +144,13 @@
   //// solve(), inv(), expmat(), logmat(), sqrtmat(), rcond()
 #endif
 
+#if !defined(ARMA_OPTIMISE_RNG)
+// #define ARMA_OPTIMISE_RNG
+//// Uncomment the above line to use the ziggurat method for normally distributed random numbers
+//// and the direct conversion of random bits to uniformly distributed floating point numbers;
+//// this changes the random values obtained after arma_rng::set_seed() compared to earlier versions
+#endif
+
 #cmakedefine ARMA_USE_HDF5_ALT
 #if defined(ARMA_USE_HDF5_ALT) && defined(ARMA_USE_WRAPPER)
   #undef  ARMA_USE_HDF5
@@ -283,6 +303,10 @@
   #undef ARMA_USE_HDF5_ALT
 #endif
 
+#if defined(ARMA_DONT_USE_ZLIB)
+  #undef ARMA_USE_ZLIB
+#endif
+
 #if defined(ARMA_DONT_OPTIMISE_BAND) || defined(ARMA_DONT_OPTIMISE_SOLVE_BAND)
   #undef ARMA_OPTIMISE_BAND
 #endif
@@ -33,11 +33,13 @@
   #define arma_H5Dget_space H5Dget_space
   #define arma_H5Dread      H5Dread
   #define arma_H5Dcreate    H5Dcreate
+  #define arma_H5Dset_extent  H5Dset_extent
 
   #define arma_H5Sget_simple_extent_ndims   H5Sget_simple_extent_ndims
   #define arma_H5Sget_simple_extent_dims    H5Sget_simple_extent_dims
   #define arma_H5Sclose                     H5Sclose
   #define arma_H5Screate_simple             H5Screate_simple
+  #define arma_H5Sselect_hyperslab          H5Sselect_hyperslab
 
   #define arma_H5Ovisit     H5Ovisit
 
@@ -56,6 +58,13 @@
   #define arma_H5Lexists    H5Lexists
   #define arma_H5Ldelete    H5Ldelete
   
+  #define arma_H5Pcreate       H5Pcreate
+  #define arma_H5Pset_chunk    H5Pset_chunk
+  #define arma_H5Pset_deflate  H5Pset_deflate
+  #define arma_H5Pclose        H5Pclose
+  
+  #define arma_H5P_DATASET_CREATE H5P_DATASET_CREATE
+  
   #define arma_H5T_NATIVE_UCHAR   H5T_NATIVE_UCHAR
   #define arma_H5T_NATIVE_CHAR    H5T_NATIVE_CHAR
   #define arma_H5T_NATIVE_SHORT   H5T_NATIVE_SHORT
@@ -89,11 +98,13 @@ extern "C"
   herr_t arma_H5Dwrite(hid_t dataset_id, hid_t mem_type_id, hid_t mem_space_id, hid_t file_space_id, hid_t xfer_plist_id, const void* buf);
   hid_t  arma_H5Dget_space(hid_t dataset_id);
   herr_t arma_H5Dread(hid_t dataset_id, hid_t mem_type_id, hid_t mem_space_id, hid_t file_space_id, hid_t xfer_plist_id, void* buf);
+  herr_t arma_H5Dset_extent(hid_t dataset_id, const hsize_t* size);
   
   int    arma_H5Sget_simple_extent_ndims(hid_t space_id);
   int    arma_H5Sget_simple_extent_dims(hid_t space_id, hsize_t* dims, hsize_t* maxdims);
   herr_t arma_H5Sclose(hid_t space_id);
   hid_t  arma_H5Screate_simple(int rank, const hsize_t* current_dims, const hsize_t* maximum_dims);
+  herr_t arma_H5Sselect_hyperslab(hid_t space_id, H5S_seloper_t op, const hsize_t* start, const hsize_t* stride, const hsize_t* count, const hsize_t* block);
   
   herr_t arma_H5Ovisit(hid_t object_id, H5_index_t index_type, H5_iter_order_t order, H5O_iterate_t op, void* op_data);
   
@@ -112,6 +123,11 @@ extern "C"
   htri_t arma_H5Lexists(hid_t loc_id, const char* name, hid_t lapl_id);
   herr_t arma_H5Ldelete(hid_t loc_id, const char* name, hid_t lapl_id);
   
+  hid_t  arma_H5Pcreate(hid_t cls_id);
+  herr_t arma_H5Pset_chunk(hid_t plist_id, int ndims, const hsize_t* dim);
+  herr_t arma_H5Pset_deflate(hid_t plist_id, unsigned level);
+  herr_t arma_H5Pclose(hid_t plist_id);
+  
   // Wrapper variables that represent the hid_t values for the H5T_NATIVE_*
   // types.  Note that H5T_NATIVE_UCHAR itself is a macro that resolves to about
   // forty other macros, and we definitely don't want to hijack those,
@@ -129,6 +145,9 @@ extern "C"
   extern hid_t arma_H5T_NATIVE_FLOAT;
   extern hid_t arma_H5T_NATIVE_DOUBLE;
   
+  // property list class for dataset creation; H5P_DATASET_CREATE is also a macro
+  extern hid_t arma_H5P_DATASET_CREATE;
+  
   }
   
   // Lastly, we have to hijack H5open() and H5check_version(), which are called
@@ -33,6 +33,10 @@ class diskio
   template<typename eT> friend class SpMat;
   template<typename oT> friend class field;
   
+  template<typename eT> friend class compact_reader;
+  template<typename eT> friend class shm_mat;
+  template<typename eT> friend class shm_cube;
+  
   friend class   Mat_aux;
   friend class  Cube_aux;
   friend class SpMat_aux;
@@ -52,6 +56,16 @@ class diskio
   
   inline arma_cold static bool safe_rename(const std::string& old_name, const std::string& new_name);
   
+  inline arma_cold static std::string gen_compact_header(const std::string& bin_header);
+  inline arma_cold static std::string gen_shm_header    (const std::string& bin_header);
+  
+  inline static uword compact_block_bytes(const uword unit_bytes);
+  
+  inline static bool save_compact_blocks(std::ostream& f, const unsigned char* mem, const uword n_bytes, const uword elem_size, const uword block_bytes);
+  inline static bool load_compact_table (std::istream& f, const uword n_bytes, uword& block_bytes, podarray<u64>& table, std::string& err_msg);
+  inline static bool load_compact_block (unsigned char* out, const uword n_out, const unsigned char* in, const u64 n_in, const u64 codec_check, const uword elem_size);
+  inline static bool load_compact_blocks(std::istream& f, unsigned char* mem, const uword n_bytes, const uword elem_size, std::string& err_msg);
+  
   template<typename eT> inline static bool convert_token(eT&              val, const std::string& token);
   template<typename  T> inline static bool convert_token(std::complex<T>& val, const std::string& token);
   
@@ -66,6 +80,7 @@ class diskio
   template<typename eT> inline static bool save_arma_ascii (const Mat<eT>&                x, const std::string& final_name);
   template<typename eT> inline static bool save_csv_ascii  (const Mat<eT>&                x, const std::string& final_name, const field<std::string>& header, const bool with_header);
   template<typename eT> inline static bool save_arma_binary(const Mat<eT>&                x, const std::string& final_name);
+  template<typename eT> inline static bool save_arma_compact(const Mat<eT>&                x, const std::string& final_name);
   template<typename eT> inline static bool save_pgm_binary (const Mat<eT>&                x, const std::string& final_name);
   template<typename  T> inline static bool save_pgm_binary (const Mat< std::complex<T> >& x, const std::string& final_name);
   template<typename eT> inline static bool save_hdf5_binary(const Mat<eT>&                x, const   hdf5_name& spec, std::string& err_msg);
@@ -76,6 +91,7 @@ class diskio
   template<typename eT> inline static bool save_csv_ascii  (const Mat<eT>&                x, std::ostream& f);
   template<typename  T> inline static bool save_csv_ascii  (const Mat< std::complex<T> >& x, std::ostream& f);
   template<typename eT> inline static bool save_arma_binary(const Mat<eT>&                x, std::ostream& f);
+  template<typename eT> inline static bool save_arma_compact(const Mat<eT>&                x, std::ostream& f);
   template<typename eT> inline static bool save_pgm_binary (const Mat<eT>&                x, std::ostream& f);
   template<typename  T> inline static bool save_pgm_binary (const Mat< std::complex<T> >& x, std::ostream& f);
   
@@ -88,6 +104,7 @@ class diskio
   template<typename eT> inline static bool load_arma_ascii (Mat<eT>&                x, const std::string& name, std::string& err_msg);
   template<typename eT> inline static bool load_csv_ascii  (Mat<eT>&                x, const std::string& name, std::string& err_msg, field<std::string>& header, const bool with_header);
   template<typename eT> inline static bool load_arma_binary(Mat<eT>&                x, const std::string& name, std::string& err_msg);
+  template<typename eT> inline static bool load_arma_compact(Mat<eT>&                x, const std::string& name, std::string& err_msg);
   template<typename eT> inline static bool load_pgm_binary (Mat<eT>&                x, const std::string& name, std::string& err_msg);
   template<typename  T> inline static bool load_pgm_binary (Mat< std::complex<T> >& x, const std::string& name, std::string& err_msg);
   template<typename eT> inline static bool load_hdf5_binary(Mat<eT>&                x, const   hdf5_name& spec, std::string& err_msg);
@@ -99,6 +116,7 @@ class diskio
   template<typename eT> inline static bool load_csv_ascii  (Mat<eT>&                x, std::istream& f,  std::string& err_msg);
   template<typename  T> inline static bool load_csv_ascii  (Mat< std::complex<T> >& x, std::istream& f,  std::string& err_msg);
   template<typename eT> inline static bool load_arma_binary(Mat<eT>&                x, std::istream& f,  std::string& err_msg);
+  template<typename eT> inline static bool load_arma_compact(Mat<eT>&                x, std::istream& f,  std::string& err_msg);
   template<typename eT> inline static bool load_pgm_binary (Mat<eT>&                x, std::istream& is, std::string& err_msg);
   template<typename  T> inline static bool load_pgm_binary (Mat< std::complex<T> >& x, std::istream& is, std::string& err_msg);
   template<typename eT> inline static bool load_auto_detect(Mat<eT>&                x, std::istream& f,  std::string& err_msg);
@@ -111,13 +129,20 @@ class diskio
   
   template<typename eT> inline static bool save_csv_ascii  (const SpMat<eT>& x, const std::string& final_name, const field<std::string>& header, const bool with_header);
   template<typename eT> inline static bool save_coord_ascii(const SpMat<eT>& x, const std::string& final_name);
+  template<typename eT> inline static bool save_mtx_ascii  (const SpMat<eT>& x, const std::string& final_name);
   template<typename eT> inline static bool save_arma_binary(const SpMat<eT>& x, const std::string& final_name);
+  template<typename eT> inline static bool save_arma_compact(const SpMat<eT>& x, const std::string& final_name);
   
   template<typename eT> inline static bool save_csv_ascii  (const SpMat<eT>& x,                std::ostream& f);
   template<typename  T> inline static bool save_csv_ascii  (const SpMat< std::complex<T> >& x, std::ostream& f);
   template<typename eT> inline static bool save_coord_ascii(const SpMat<eT>& x,                std::ostream& f);
   template<typename  T> inline static bool save_coord_ascii(const SpMat< std::complex<T> >& x, std::ostream& f);
+  template<typename eT> inline static bool save_mtx_ascii  (const SpMat<eT>& x,                std::ostream& f);
   template<typename eT> inline static bool save_arma_binary(const SpMat<eT>& x,                std::ostream& f);
+  template<typename eT> inline static bool save_arma_compact(const SpMat<eT>& x,                std::ostream& f);
+  
+  template<typename eT> inline static void mtx_print_val(std::ostream& f, const eT&              val);
+  template<typename  T> inline static void mtx_print_val(std::ostream& f, const std::complex<T>& val);
   
   
   //
@@ -125,13 +150,23 @@ class diskio
   
   template<typename eT> inline static bool load_csv_ascii  (SpMat<eT>& x, const std::string& name, std::string& err_msg, field<std::string>& header, const bool with_header);
   template<typename eT> inline static bool load_coord_ascii(SpMat<eT>& x, const std::string& name, std::string& err_msg);
+  template<typename eT> inline static bool load_mtx_ascii  (SpMat<eT>& x, const std::string& name, std::string& err_msg);
   template<typename eT> inline static bool load_arma_binary(SpMat<eT>& x, const std::string& name, std::string& err_msg);
+  template<typename eT> inline static bool load_arma_compact(SpMat<eT>& x, const std::string& name, std::string& err_msg);
   
   template<typename eT> inline static bool load_csv_ascii  (SpMat<eT>& x,                std::istream& f, std::string& err_msg);
   template<typename  T> inline static bool load_csv_ascii  (SpMat< std::complex<T> >& x, std::istream& f, std::string& err_msg);
   template<typename eT> inline static bool load_coord_ascii(SpMat<eT>& x,                std::istream& f, std::string& err_msg);
   template<typename  T> inline static bool load_coord_ascii(SpMat< std::complex<T> >& x, std::istream& f, std::string& err_msg);
+  template<typename eT> inline static bool load_mtx_ascii  (SpMat<eT>& x,                std::istream& f, std::string& err_msg);
   template<typename eT> inline static bool load_arma_binary(SpMat<eT>& x,                std::istream& f, std::string& err_msg);
+  template<typename eT> inline static bool load_arma_compact(SpMat<eT>& x,                std::istream& f, std::string& err_msg);
+  
+  template<typename eT> inline static uword mtx_parse_chunk(std::vector<uword>& rows, std::vector<uword>& cols, std::vector<eT>& vals, uword& n_ent, const char* mem_start, const char* mem_end, const uword field, const uword symmetry, const uword f_n_rows, const uword f_n_cols);
+  template<typename eT> inline static uword mtx_sort_column(arma_sort_index_packet<uword>* packets, const eT* vals, const uword start, const uword end, uword* out_rows, eT* out_vals);
+  
+  template<typename eT> inline static void mtx_convert_val(eT&              out, const double val_real, const double val_imag);
+  template<typename  T> inline static void mtx_convert_val(std::complex<T>& out, const double val_real, const double val_imag);
   
   
   
@@ -142,12 +177,14 @@ class diskio
   template<typename eT> inline static bool save_raw_binary (const Cube<eT>& x, const std::string& name);
   template<typename eT> inline static bool save_arma_ascii (const Cube<eT>& x, const std::string& name);
   template<typename eT> inline static bool save_arma_binary(const Cube<eT>& x, const std::string& name);
+  template<typename eT> inline static bool save_arma_compact(const Cube<eT>& x, const std::string& final_name);
   template<typename eT> inline static bool save_hdf5_binary(const Cube<eT>& x, const   hdf5_name& spec, std::string& err_msg);
   
   template<typename eT> inline static bool save_raw_ascii  (const Cube<eT>& x, std::ostream& f);
   template<typename eT> inline static bool save_raw_binary (const Cube<eT>& x, std::ostream& f);
   template<typename eT> inline static bool save_arma_ascii (const Cube<eT>& x, std::ostream& f);
   template<typename eT> inline static bool save_arma_binary(const Cube<eT>& x, std::ostream& f);
+  template<typename eT> inline static bool save_arma_compact(const Cube<eT>& x, std::ostream& f);
   
   
   //
@@ -157,6 +194,7 @@ class diskio
   template<typename eT> inline static bool load_raw_binary (Cube<eT>& x, const std::string& name, std::string& err_msg);
   template<typename eT> inline static bool load_arma_ascii (Cube<eT>& x, const std::string& name, std::string& err_msg);
   template<typename eT> inline static bool load_arma_binary(Cube<eT>& x, const std::string& name, std::string& err_msg);
+  template<typename eT> inline static bool load_arma_compact(Cube<eT>& x, const std::string& name, std::string& err_msg);
   template<typename eT> inline static bool load_hdf5_binary(Cube<eT>& x, const   hdf5_name& spec, std::string& err_msg);
   template<typename eT> inline static bool load_auto_detect(Cube<eT>& x, const std::string& name, std::string& err_msg);
   
@@ -164,6 +202,7 @@ class diskio
   template<typename eT> inline static bool load_raw_binary (Cube<eT>& x, std::istream& f, std::string& err_msg);
   template<typename eT> inline static bool load_arma_ascii (Cube<eT>& x, std::istream& f, std::string& err_msg);
   template<typename eT> inline static bool load_arma_binary(Cube<eT>& x, std::istream& f, std::string& err_msg);
+  template<typename eT> inline static bool load_arma_compact(Cube<eT>& x, std::istream& f, std::string& err_msg);
   template<typename eT> inline static bool load_auto_detect(Cube<eT>& x, std::istream& f, std::string& err_msg);
   
   
@@ -402,6 +402,236 @@ diskio::safe_rename(const std::string& old_name, const std::string& new_name)
 
 
 
+//! header for the arma_compact format, derived from the arma_binary header (eg. ARMA_MAT_BIN_FN008 -> ARMA_MAT_CPT_FN008)
+inline
+std::string
+diskio::gen_compact_header(const std::string& bin_header)
+  {
+  std::string header = bin_header;
+  
+  header.replace(9, 3, "CPT");
+  
+  return header;
+  }
+
+
+
+//! header for shared memory segments (eg. ARMA_MAT_BIN_FN008 -> ARMA_MAT_SHM_FN008)
+inline
+std::string
+diskio::gen_shm_header(const std::string& bin_header)
+  {
+  std::string header = bin_header;
+  
+  header.replace(9, 3, "SHM");
+  
+  return header;
+  }
+
+
+
+//! number of raw bytes per block: a multiple of unit_bytes (eg. one column), close to 1 MB
+inline
+uword
+diskio::compact_block_bytes(const uword unit_bytes)
+  {
+  const uword target = uword(1) << 20;
+  
+  if(unit_bytes == 0)  { return target; }
+  
+  return unit_bytes * (std::max)( uword(1), target / unit_bytes );
+  }
+
+
+
+//! write n_bytes as a series of independently compressed and checksummed blocks:
+//! n_blocks, block_bytes, a table with (stored size, codec|checksum) for each block, followed by the payload;
+//! the blocks are compressed in parallel
+inline
+bool
+diskio::save_compact_blocks(std::ostream& f, const unsigned char* mem, const uword n_bytes, const uword elem_size, const uword block_bytes)
+  {
+  arma_extra_debug_sigprint();
+  
+  const uword n_blocks = (n_bytes + block_bytes - 1) / block_bytes;
+  
+  std::vector< std::vector<unsigned char> > payload(n_blocks);
+  
+  podarray<u64> table(2 + 2*n_blocks);
+  
+  table[0] = u64(n_blocks);
+  table[1] = u64(block_bytes);
+  
+  #if defined(ARMA_USE_OPENMP)
+    {
+    const int n_threads = ( (n_blocks > 1) && (mp_thread_limit::in_parallel() == false) ) ? mp_thread_limit::get() : int(1);
+    
+    #pragma omp parallel for schedule(dynamic) num_threads(n_threads)
+    for(uword i=0; i < n_blocks; ++i)
+      {
+      const uword start = i*block_bytes;
+      const uword len   = (std::min)(block_bytes, n_bytes - start);
+      
+      const u32 codec = block_codec::encode(payload[i], &mem[start], len, elem_size);
+      const u32 check = block_codec::checksum(&mem[start], len);
+      
+      table[2 + 2*i    ] = u64(payload[i].size());
+      table[2 + 2*i + 1] = (u64(codec) << 32) | u64(check);
+      }
+    }
+  #else
+    {
+    for(uword i=0; i < n_blocks; ++i)
+      {
+      const uword start = i*block_bytes;
+      const uword len   = (std::min)(block_bytes, n_bytes - start);
+      
+      const u32 codec = block_codec::encode(payload[i], &mem[start], len, elem_size);
+      const u32 check = block_codec::checksum(&mem[start], len);
+      
+      table[2 + 2*i    ] = u64(payload[i].size());
+      table[2 + 2*i + 1] = (u64(codec) << 32) | u64(check);
+      }
+    }
+  #endif
+  
+  f.write( reinterpret_cast<const char*>(table.memptr()), std::streamsize(table.n_elem*sizeof(u64)) );
+  
+  for(uword i=0; i < n_blocks; ++i)
+    {
+    if(payload[i].size() > 0)  { f.write( reinterpret_cast<const char*>(&(payload[i][0])), std::streamsize(payload[i].size()) ); }
+    }
+  
+  return f.good();
+  }
+
+
+
+//! read the block table written by save_compact_blocks();
+//! afterwards the stream is positioned at the start of the payload
+inline
+bool
+diskio::load_compact_table(std::istream& f, const uword n_bytes, uword& block_bytes, podarray<u64>& table, std::string& err_msg)
+  {
+  arma_extra_debug_sigprint();
+  
+  u64 header[2] = { 0, 0 };
+  
+  f.read( reinterpret_cast<char*>(&header[0]), std::streamsize(2*sizeof(u64)) );
+  
+  const uword n_blocks = uword(header[0]);
+  
+  block_bytes = uword(header[1]);
+  
+  const bool check = f.good() && (block_bytes > 0) && (u64(n_blocks) == header[0]) && (n_blocks == ((n_bytes + block_bytes - 1) / block_bytes));
+  
+  if(check == false)  { err_msg = "incorrect block table in "; return false; }
+  
+  table.set_size(2*n_blocks);
+  
+  f.read( reinterpret_cast<char*>(table.memptr()), std::streamsize(table.n_elem*sizeof(u64)) );
+  
+  if(f.good() == false)  { err_msg = "incorrect block table in "; return false; }
+  
+  // a block is never stored with more bytes than its raw size
+  for(uword i=0; i < n_blocks; ++i)
+    {
+    const uword len = (std::min)(block_bytes, n_bytes - i*block_bytes);
+    
+    if(table[2*i] > u64(len))  { err_msg = "incorrect block table in "; return false; }
+    }
+  
+  return true;
+  }
+
+
+
+//! decode one block; the checksum is verified against the decoded data
+inline
+bool
+diskio::load_compact_block(unsigned char* out, const uword n_out, const unsigned char* in, const u64 n_in, const u64 codec_check, const uword elem_size)
+  {
+  const u32 codec = u32(codec_check >> 32);
+  const u32 check = u32(codec_check & u64(0xFFFFFFFF));
+  
+  if(block_codec::decode(out, n_out, in, uword(n_in), codec, elem_size) == false)  { return false; }
+  
+  return (block_codec::checksum(out, n_out) == check);
+  }
+
+
+
+//! read all blocks written by save_compact_blocks(); the blocks are decompressed in parallel
+inline
+bool
+diskio::load_compact_blocks(std::istream& f, unsigned char* mem, const uword n_bytes, const uword elem_size, std::string& err_msg)
+  {
+  arma_extra_debug_sigprint();
+  
+  uword         block_bytes = 0;
+  podarray<u64> table;
+  
+  if(diskio::load_compact_table(f, n_bytes, block_bytes, table, err_msg) == false)  { return false; }
+  
+  const uword n_blocks = table.n_elem / 2;
+  
+  podarray<uword> offsets(n_blocks+1);
+  
+  offsets[0] = 0;
+  
+  for(uword i=0; i < n_blocks; ++i)  { offsets[i+1] = offsets[i] + uword(table[2*i]); }
+  
+  podarray<unsigned char> payload(offsets[n_blocks]);
+  
+  f.read( reinterpret_cast<char*>(payload.memptr()), std::streamsize(payload.n_elem) );
+  
+  if(f.good() == false)  { err_msg = "truncated data in "; return false; }
+  
+  podarray<uword> status(n_blocks);
+  
+  #if defined(ARMA_USE_OPENMP)
+    {
+    const int n_threads = ( (n_blocks > 1) && (mp_thread_limit::in_parallel() == false) ) ? mp_thread_limit::get() : int(1);
+    
+    #pragma omp parallel for schedule(dynamic) num_threads(n_threads)
+    for(uword i=0; i < n_blocks; ++i)
+      {
+      const uword start = i*block_bytes;
+      const uword len   = (std::min)(block_bytes, n_bytes - start);
+      
+      status[i] = diskio::load_compact_block(&mem[start], len, &payload[offsets[i]], table[2*i], table[2*i+1], elem_size) ? uword(1) : uword(0);
+      }
+    }
+  #else
+    {
+    for(uword i=0; i < n_blocks; ++i)
+      {
+      const uword start = i*block_bytes;
+      const uword len   = (std::min)(block_bytes, n_bytes - start);
+      
+      status[i] = diskio::load_compact_block(&mem[start], len, &payload[offsets[i]], table[2*i], table[2*i+1], elem_size) ? uword(1) : uword(0);
+      }
+    }
+  #endif
+  
+  for(uword i=0; i < n_blocks; ++i)
+    {
+    if(status[i] == 0)
+      {
+      #if !defined(ARMA_USE_ZLIB)
+        if(u32(table[2*i+1] >> 32) == block_codec::codec_shuf_zl)  { err_msg = "zlib support not enabled (ARMA_USE_ZLIB); can't decompress "; return false; }
+      #endif
+      
+      err_msg = "corrupted data in ";
+      return false;
+      }
+    }
+  
+  return true;
+  }
+
+
+
 template<typename eT>
 inline
 bool
@@ -934,6 +1164,55 @@ diskio::save_arma_binary(const Mat<eT>& x, std::ostream& f)
 
 
 
+//! Save a matrix in the compact binary format:
+//! a header as per arma_binary, followed by compressed and checksummed blocks of whole columns
+template<typename eT>
+inline
+bool
+diskio::save_arma_compact(const Mat<eT>& x, const std::string& final_name)
+  {
+  arma_extra_debug_sigprint();
+  
+  const std::string tmp_name = diskio::gen_tmp_name(final_name);
+  
+  std::ofstream f(tmp_name.c_str(), std::fstream::binary);
+  
+  bool save_okay = f.is_open();
+  
+  if(save_okay)
+    {
+    save_okay = diskio::save_arma_compact(x, f);
+    
+    f.flush();
+    f.close();
+    
+    if(save_okay)  { save_okay = diskio::safe_rename(tmp_name, final_name); }
+    }
+  
+  return save_okay;
+  }
+
+
+
+//! Save a matrix in the compact binary format:
+//! a header as per arma_binary, followed by compressed and checksummed blocks of whole columns
+template<typename eT>
+inline
+bool
+diskio::save_arma_compact(const Mat<eT>& x, std::ostream& f)
+  {
+  arma_extra_debug_sigprint();
+  
+  typedef typename get_pod_type<eT>::result pod_type;
+  
+  f << diskio::gen_compact_header(diskio::gen_bin_header(x)) << '\n';
+  f << x.n_rows << ' ' << x.n_cols << '\n';
+  
+  return diskio::save_compact_blocks(f, reinterpret_cast<const unsigned char*>(x.mem), x.n_elem*sizeof(eT), sizeof(pod_type), diskio::compact_block_bytes(x.n_rows*sizeof(eT)));
+  }
+
+
+
 //! Save a matrix as a PGM greyscale image
 template<typename eT>
 inline
@@ -1039,14 +1318,17 @@ diskio::save_hdf5_binary(const Mat<eT>& x, const hdf5_name& spec, std::string& e
   
   #if defined(ARMA_USE_HDF5)
     {
+    hdf5_misc::hdf5_lock hdf5_locker;
+    
     hdf5_misc::hdf5_suspend_printing_errors hdf5_print_suspender;
     
     bool save_okay = false;
     
     const bool append  = bool(spec.opts.flags & hdf5_opts::flag_append);
     const bool replace = bool(spec.opts.flags & hdf5_opts::flag_replace);
+    const bool extend  = bool(spec.opts.flags & hdf5_opts::flag_extend);
     
-    const bool use_existing_file = ((append || replace) && (arma_H5Fis_hdf5(spec.filename.c_str()) > 0));
+    const bool use_existing_file = ((append || replace || extend) && (arma_H5Fis_hdf5(spec.filename.c_str()) > 0));
     
     const std::string tmp_name = (use_existing_file) ? std::string() : diskio::gen_tmp_name(spec.filename);
     
@@ -1055,17 +1337,11 @@ diskio::save_hdf5_binary(const Mat<eT>& x, const hdf5_name& spec, std::string& e
     
     if(file < 0)  { return false; }
     
-    // We need to create a dataset, datatype, and dataspace
+    // treat the matrix as a 2d array dataspace
     hsize_t dims[2];
     dims[1] = x.n_rows;
     dims[0] = x.n_cols;
     
-    hid_t dataspace = arma_H5Screate_simple(2, dims, NULL);   // treat the matrix as a 2d array dataspace
-    hid_t datatype  = hdf5_misc::get_hdf5_type<eT>();
-    
-    // If this returned something invalid, well, it's time to crash.
-    arma_check(datatype == -1, "Mat::save(): unknown datatype for HDF5");
-    
     // MATLAB forces the users to specify a name at save time for HDF5;
     // Octave will use the default of 'dataset' unless otherwise specified.
     // If the user hasn't specified a dataset name, we will use 'dataset'
@@ -1104,23 +1380,8 @@ diskio::save_hdf5_binary(const Mat<eT>& x, const hdf5_name& spec, std::string& e
       // NOTE: https://lists.hdfgroup.org/pipermail/hdf-forum_lists.hdfgroup.org/2017-August/010486.html
       }
     
-    hid_t dataset = arma_H5Dcreate(last_group, dataset_name.c_str(), datatype, dataspace, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
-    
-    if(dataset < 0)
-      {
-      save_okay = false;
-      
-      err_msg = "couldn't create dataset in ";
-      }
-    else
-      {
-      save_okay = (arma_H5Dwrite(dataset, datatype, H5S_ALL, H5S_ALL, H5P_DEFAULT, x.mem) >= 0);
-      
-      arma_H5Dclose(dataset);
-      }
+    save_okay = hdf5_misc::write_dataset(last_group, dataset_name, 2, dims, x.mem, spec.opts, err_msg);
     
-    arma_H5Tclose(datatype);
-    arma_H5Sclose(dataspace);
     for(size_t i = 0; i < groups.size(); ++i)  { arma_H5Gclose(groups[i]); }
     arma_H5Fclose(file);
     
@@ -1899,6 +2160,62 @@ diskio::load_arma_binary(Mat<eT>& x, std::istream& f, std::string& err_msg)
 
 
 
+//! Load a matrix in the compact binary format
+template<typename eT>
+inline
+bool
+diskio::load_arma_compact(Mat<eT>& x, const std::string& name, std::string& err_msg)
+  {
+  arma_extra_debug_sigprint();
+  
+  std::ifstream f;
+  f.open(name.c_str(), std::fstream::binary);
+  
+  bool load_okay = f.is_open();
+  
+  if(load_okay)
+    {
+    load_okay = diskio::load_arma_compact(x, f, err_msg);
+    f.close();
+    }
+  
+  return load_okay;
+  }
+
+
+
+template<typename eT>
+inline
+bool
+diskio::load_arma_compact(Mat<eT>& x, std::istream& f, std::string& err_msg)
+  {
+  arma_extra_debug_sigprint();
+  
+  typedef typename get_pod_type<eT>::result pod_type;
+  
+  std::string f_header;
+  uword       f_n_rows = 0;
+  uword       f_n_cols = 0;
+  
+  f >> f_header;
+  f >> f_n_rows;
+  f >> f_n_cols;
+  
+  if( (f_header != diskio::gen_compact_header(diskio::gen_bin_header(x))) || (f.good() == false) )
+    {
+    err_msg = "incorrect header in ";
+    return false;
+    }
+  
+  f.get();
+  
+  x.set_size(f_n_rows, f_n_cols);
+  
+  return diskio::load_compact_blocks(f, reinterpret_cast<unsigned char*>(x.memptr()), x.n_elem*sizeof(eT), sizeof(pod_type), err_msg);
+  }
+
+
+
 inline
 void
 diskio::pnm_skip_comments(std::istream& f)
@@ -2074,10 +2391,14 @@ diskio::load_hdf5_binary(Mat<eT>& x, const hdf5_name& spec, std::string& err_msg
   
   #if defined(ARMA_USE_HDF5)
     {
+    hdf5_misc::hdf5_lock hdf5_locker;
+    
     hdf5_misc::hdf5_suspend_printing_errors hdf5_print_suspender;
     
     bool load_okay = false;
     
+    const bool use_subset = bool(spec.opts.flags & hdf5_opts::flag_subset);
+    
     hid_t fid = arma_H5Fopen(spec.filename.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
     
     if(fid >= 0)
@@ -2127,6 +2448,27 @@ diskio::load_hdf5_binary(Mat<eT>& x, const hdf5_name& spec, std::string& err_msg
         
         if(ndims == 1) { dims[1] = 1; }  // Vector case; fake second dimension (one column).
         
+        hid_t memspace = H5S_ALL;
+        hid_t selspace = H5S_ALL;
+        
+        if(use_subset)
+          {
+          // restrict loading to a hyperslab; dims is changed to the size of the hyperslab
+          memspace = hdf5_misc::select_subset(filespace, ndims, dims, 2, spec.opts.sel_rows, spec.opts.sel_cols, span());
+          selspace = filespace;
+          
+          if(memspace < 0)
+            {
+            err_msg = "requested subset is out of bounds of HDF5 dataset in ";
+            
+            arma_H5Sclose(filespace);
+            arma_H5Dclose(dataset);
+            arma_H5Fclose(fid);
+            
+            return false;
+            }
+          }
+        
         x.set_size(dims[1], dims[0]);
         
         // Now we have to see what type is stored to figure out how to load it.
@@ -2136,15 +2478,15 @@ diskio::load_hdf5_binary(Mat<eT>& x, const hdf5_name& spec, std::string& err_msg
         // If these are the same type, it is simple.
         if(arma_H5Tequal(datatype, mat_type) > 0)
           {
-          // Load directly; H5S_ALL used so that we load the entire dataset.
-          hid_t read_status = arma_H5Dread(dataset, datatype, H5S_ALL, H5S_ALL, H5P_DEFAULT, void_ptr(x.memptr()));
+          // Load directly; H5S_ALL used so that we load the entire dataset, unless a subset was requested.
+          hid_t read_status = arma_H5Dread(dataset, datatype, memspace, selspace, H5P_DEFAULT, void_ptr(x.memptr()));
           
           if(read_status >= 0) { load_okay = true; }
           }
         else
           {
           // Load into another array and convert its type accordingly.
-          hid_t read_status = hdf5_misc::load_and_convert_hdf5(x.memptr(), dataset, datatype, x.n_elem);
+          hid_t read_status = hdf5_misc::load_and_convert_hdf5(x.memptr(), dataset, datatype, x.n_elem, memspace, selspace);
           
           if(read_status >= 0) { load_okay = true; }
           }
@@ -2153,6 +2495,8 @@ diskio::load_hdf5_binary(Mat<eT>& x, const hdf5_name& spec, std::string& err_msg
         arma_H5Tclose(datatype);
         arma_H5Tclose(mat_type);
         arma_H5Sclose(filespace);
+        
+        if(use_subset)  { arma_H5Sclose(memspace); }
         }
       
       arma_H5Dclose(dataset);
@@ -2225,10 +2569,12 @@ diskio::load_auto_detect(Mat<eT>& x, std::istream& f, std::string& err_msg)
   
   const char* ARMA_MAT_TXT_str = "ARMA_MAT_TXT";
   const char* ARMA_MAT_BIN_str = "ARMA_MAT_BIN";
+  const char* ARMA_MAT_CPT_str = "ARMA_MAT_CPT";
   const char*           P5_str = "P5";
   
   const uword ARMA_MAT_TXT_len = uword(12);
   const uword ARMA_MAT_BIN_len = uword(12);
+  const uword ARMA_MAT_CPT_len = uword(12);
   const uword           P5_len = uword(2);
   
   podarray<char> header(ARMA_MAT_TXT_len + 1);
@@ -2253,6 +2599,11 @@ diskio::load_auto_detect(Mat<eT>& x, std::istream& f, std::string& err_msg)
     return load_arma_binary(x, f, err_msg);
     }
   else
+  if( std::strncmp(ARMA_MAT_CPT_str, header_mem, size_t(ARMA_MAT_CPT_len)) == 0 )
+    {
+    return load_arma_compact(x, f, err_msg);
+    }
+  else
   if( std::strncmp(P5_str, header_mem, size_t(P5_len)) == 0 )
     {
     return load_pgm_binary(x, f, err_msg);
@@ -2512,24 +2863,23 @@ diskio::save_coord_ascii(const SpMat< std::complex<T> >& x, std::ostream& f)
 
 
 
-//! Save a matrix in binary format,
-//! with a header that stores the matrix type as well as its dimensions
+//! Save a matrix in Matrix Market coordinate format (indices start at one)
 template<typename eT>
 inline
 bool
-diskio::save_arma_binary(const SpMat<eT>& x, const std::string& final_name)
+diskio::save_mtx_ascii(const SpMat<eT>& x, const std::string& final_name)
   {
   arma_extra_debug_sigprint();
   
   const std::string tmp_name = diskio::gen_tmp_name(final_name);
   
-  std::ofstream f(tmp_name.c_str(), std::fstream::binary);
+  std::ofstream f(tmp_name.c_str());
   
   bool save_okay = f.is_open();
   
   if(save_okay)
     {
-    save_okay = diskio::save_arma_binary(x, f);
+    save_okay = diskio::save_mtx_ascii(x, f);
     
     f.flush();
     f.close();
@@ -2542,19 +2892,111 @@ diskio::save_arma_binary(const SpMat<eT>& x, const std::string& final_name)
 
 
 
-//! Save a matrix in binary format,
-//! with a header that stores the matrix type as well as its dimensions
+//! Save a matrix in Matrix Market coordinate format (indices start at one)
 template<typename eT>
 inline
 bool
-diskio::save_arma_binary(const SpMat<eT>& x, std::ostream& f)
+diskio::save_mtx_ascii(const SpMat<eT>& x, std::ostream& f)
   {
   arma_extra_debug_sigprint();
   
-  f << diskio::gen_bin_header(x) << '\n';
-  f << x.n_rows << ' ' << x.n_cols << ' ' << x.n_nonzero << '\n';
+  const arma_ostream_state stream_state(f);
   
-  f.write( reinterpret_cast<const char*>(x.values),      std::streamsize(x.n_nonzero*sizeof(eT))     );
+  diskio::prepare_stream<eT>(f);
+  
+  const char* field_name = (is_cx<eT>::yes) ? "complex" : ( (is_real<eT>::value) ? "real" : "integer" );
+  
+  f << "%%MatrixMarket matrix coordinate " << field_name << " general" << '\n';
+  f << x.n_rows << ' ' << x.n_cols << ' ' << x.n_nonzero << '\n';
+  
+  typename SpMat<eT>::const_iterator iter     = x.begin();
+  typename SpMat<eT>::const_iterator iter_end = x.end();
+  
+  for(; iter != iter_end; ++iter)
+    {
+    f << (iter.row() + 1) << ' ' << (iter.col() + 1) << ' ';
+    
+    diskio::mtx_print_val(f, eT(*iter));
+    
+    f << '\n';
+    }
+  
+  const bool save_okay = f.good();
+  
+  stream_state.restore(f);
+  
+  return save_okay;
+  }
+
+
+
+template<typename eT>
+inline
+void
+diskio::mtx_print_val(std::ostream& f, const eT& val)
+  {
+  arma_ostream::raw_print_elem(f, val);
+  }
+
+
+
+template<typename T>
+inline
+void
+diskio::mtx_print_val(std::ostream& f, const std::complex<T>& val)
+  {
+  arma_ostream::raw_print_elem(f, val.real());
+  
+  f << ' ';
+  
+  arma_ostream::raw_print_elem(f, val.imag());
+  }
+
+
+
+//! Save a matrix in binary format,
+//! with a header that stores the matrix type as well as its dimensions
+template<typename eT>
+inline
+bool
+diskio::save_arma_binary(const SpMat<eT>& x, const std::string& final_name)
+  {
+  arma_extra_debug_sigprint();
+  
+  const std::string tmp_name = diskio::gen_tmp_name(final_name);
+  
+  std::ofstream f(tmp_name.c_str(), std::fstream::binary);
+  
+  bool save_okay = f.is_open();
+  
+  if(save_okay)
+    {
+    save_okay = diskio::save_arma_binary(x, f);
+    
+    f.flush();
+    f.close();
+    
+    if(save_okay)  { save_okay = diskio::safe_rename(tmp_name, final_name); }
+    }
+  
+  return save_okay;
+  }
+
+
+
+//! Save a matrix in binary format,
+//! with a header that stores the matrix type as well as its dimensions
+template<typename eT>
+inline
+bool
+diskio::save_arma_binary(const SpMat<eT>& x, std::ostream& f)
+  {
+  arma_extra_debug_sigprint();
+  
+  f << diskio::gen_bin_header(x) << '\n';
+  f << x.n_rows << ' ' << x.n_cols << ' ' << x.n_nonzero << '\n';
+  
+  f.write( reinterpret_cast<const char*>(x.values),      std::streamsize(x.n_nonzero*sizeof(eT))     );
   f.write( reinterpret_cast<const char*>(x.row_indices), std::streamsize(x.n_nonzero*sizeof(uword))  );
   f.write( reinterpret_cast<const char*>(x.col_ptrs),    std::streamsize((x.n_cols+1)*sizeof(uword)) );
   
@@ -2563,6 +3005,62 @@ diskio::save_arma_binary(const SpMat<eT>& x, std::ostream& f)
 
 
 
+//! Save a sparse matrix in the compact binary format;
+//! the values, row indices and column pointers are stored as three separate block sequences
+template<typename eT>
+inline
+bool
+diskio::save_arma_compact(const SpMat<eT>& x, const std::string& final_name)
+  {
+  arma_extra_debug_sigprint();
+  
+  const std::string tmp_name = diskio::gen_tmp_name(final_name);
+  
+  std::ofstream f(tmp_name.c_str(), std::fstream::binary);
+  
+  bool save_okay = f.is_open();
+  
+  if(save_okay)
+    {
+    save_okay = diskio::save_arma_compact(x, f);
+    
+    f.flush();
+    f.close();
+    
+    if(save_okay)  { save_okay = diskio::safe_rename(tmp_name, final_name); }
+    }
+  
+  return save_okay;
+  }
+
+
+
+template<typename eT>
+inline
+bool
+diskio::save_arma_compact(const SpMat<eT>& x, std::ostream& f)
+  {
+  arma_extra_debug_sigprint();
+  
+  typedef typename get_pod_type<eT>::result pod_type;
+  
+  // a multiple of both sizeof(eT) and sizeof(uword)
+  const uword block_bytes = diskio::compact_block_bytes(sizeof(eT) * sizeof(uword));
+  
+  f << diskio::gen_compact_header(diskio::gen_bin_header(x)) << '\n';
+  f << x.n_rows << ' ' << x.n_cols << ' ' << x.n_nonzero << '\n';
+  
+  bool save_okay = true;
+  
+  save_okay = save_okay && diskio::save_compact_blocks(f, reinterpret_cast<const unsigned char*>(x.values),      x.n_nonzero*sizeof(eT),      sizeof(pod_type), block_bytes);
+  save_okay = save_okay && diskio::save_compact_blocks(f, reinterpret_cast<const unsigned char*>(x.row_indices), x.n_nonzero*sizeof(uword),   sizeof(uword),    block_bytes);
+  save_okay = save_okay && diskio::save_compact_blocks(f, reinterpret_cast<const unsigned char*>(x.col_ptrs),    (x.n_cols+1)*sizeof(uword), sizeof(uword),    block_bytes);
+  
+  return save_okay;
+  }
+
+
+
 template<typename eT>
 inline
 bool
@@ -2891,76 +3389,585 @@ diskio::load_coord_ascii(SpMat< std::complex<T> >& x, std::istream& f, std::stri
     line_stream.clear();
     line_stream.str(line_string);
     
-    uword line_row = 0;
-    uword line_col = 0;
+    uword line_row = 0;
+    uword line_col = 0;
+    
+    // a valid line in co-ord format has at least 2 entries
+    
+    line_stream >> line_row;
+    
+    if(line_stream.good() == false)  { load_okay = false; break; }
+    
+    line_stream >> line_col;
+    
+    size_found = true;
+    
+    if(f_n_rows < line_row)  f_n_rows = line_row;
+    if(f_n_cols < line_col)  f_n_cols = line_col;
+    }
+  
+  // take into account that indices start at 0
+  if(size_found)  { ++f_n_rows;  ++f_n_cols; }
+  
+  if(load_okay)
+    {
+    f.clear();
+    f.seekg(pos1);
+    
+    MapMat< std::complex<T> > tmp(f_n_rows, f_n_cols);
+    
+    while(f.good())
+      {
+      std::getline(f, line_string);
+      
+      if(line_string.size() == 0)  { break; }
+      
+      line_stream.clear();
+      line_stream.str(line_string);
+      
+      uword line_row = 0;
+      uword line_col = 0;
+      
+      line_stream >> line_row;
+      line_stream >> line_col;
+      
+      T val_real = T(0);
+      T val_imag = T(0);
+      
+      line_stream >> token_real;
+      
+      if(line_stream.fail() == false)
+        {
+        diskio::convert_token( val_real, token_real );
+        }
+      
+      
+      line_stream >> token_imag;
+      
+      if(line_stream.fail() == false)
+        {
+        diskio::convert_token( val_imag, token_imag );
+        }
+      
+      if( (val_real != T(0)) || (val_imag != T(0)) )
+        {
+        tmp(line_row,line_col) = std::complex<T>(val_real, val_imag);
+        }
+      }
+    
+    x = tmp;
+    }
+  
+  return load_okay;
+  }
+
+
+
+//! Load a matrix in Matrix Market coordinate format;
+//! the entries are parsed in parallel and the CSC layout is built directly (no intermediate map)
+template<typename eT>
+inline
+bool
+diskio::load_mtx_ascii(SpMat<eT>& x, const std::string& name, std::string& err_msg)
+  {
+  arma_extra_debug_sigprint();
+  
+  std::fstream f;
+  f.open(name.c_str(), std::fstream::in | std::fstream::binary);
+  
+  bool load_okay = f.is_open();
+  
+  if(load_okay)
+    {
+    load_okay = diskio::load_mtx_ascii(x, f, err_msg);
+    f.close();
+    }
+  
+  return load_okay;
+  }
+
+
+
+template<typename eT>
+inline
+bool
+diskio::load_mtx_ascii(SpMat<eT>& x, std::istream& f, std::string& err_msg)
+  {
+  arma_extra_debug_sigprint();
+  
+  // banner: %%MatrixMarket object format field symmetry
+  
+  std::string line_string;
+  std::getline(f, line_string);
+  
+  std::stringstream line_stream(line_string);
+  
+  std::string tok_banner;
+  std::string tok_object;
+  std::string tok_format;
+  std::string tok_field;
+  std::string tok_symmetry;
+  
+  line_stream >> tok_banner >> tok_object >> tok_format >> tok_field >> tok_symmetry;
+  
+  for(uword i=0; i < tok_object.length();   ++i)  { if( (tok_object[i] >= 'A') && (tok_object[i] <= 'Z') )  { tok_object[i] = char(tok_object[i] - 'A' + 'a'); } }
+  for(uword i=0; i < tok_format.length();   ++i)  { if( (tok_format[i] >= 'A') && (tok_format[i] <= 'Z') )  { tok_format[i] = char(tok_format[i] - 'A' + 'a'); } }
+  for(uword i=0; i < tok_field.length();    ++i)  { if( (tok_field[i] >= 'A') && (tok_field[i] <= 'Z') )  { tok_field[i] = char(tok_field[i] - 'A' + 'a'); } }
+  for(uword i=0; i < tok_symmetry.length(); ++i)  { if( (tok_symmetry[i] >= 'A') && (tok_symmetry[i] <= 'Z') )  { tok_symmetry[i] = char(tok_symmetry[i] - 'A' + 'a'); } }
+  
+  if( (tok_banner != "%%MatrixMarket") || (tok_object != "matrix") )  { err_msg = "incorrect header in "; return false; }
+  
+  if(tok_format != "coordinate")  { err_msg = "only the coordinate variant of Matrix Market is supported; problem with "; return false; }
+  
+  // field: 0 = pattern, 1 = real, 2 = integer, 3 = complex
+  
+  uword field = 0;
+  
+       if( (tok_field == "real") || (tok_field == "double") )  { field = 1; }
+  else if(  tok_field == "integer"                          )  { field = 2; }
+  else if(  tok_field == "complex"                          )  { field = 3; }
+  else if(  tok_field == "pattern"                          )  { field = 0; }
+  else  { err_msg = "unsupported Matrix Market field in "; return false; }
+  
+  if( (field == 3) && (is_cx<eT>::no) )  { err_msg = "complex data cannot be loaded into a real matrix; problem with "; return false; }
+  
+  // symmetry: 0 = general, 1 = symmetric, 2 = skew-symmetric, 3 = hermitian
+  
+  uword symmetry = 0;
+  
+       if(tok_symmetry == "general"       )  { symmetry = 0; }
+  else if(tok_symmetry == "symmetric"     )  { symmetry = 1; }
+  else if(tok_symmetry == "skew-symmetric")  { symmetry = 2; }
+  else if(tok_symmetry == "hermitian"     )  { symmetry = 3; }
+  else  { err_msg = "unsupported Matrix Market symmetry in "; return false; }
+  
+  // skip comments and read the size line
+  
+  bool size_found = false;
+  
+  uword f_n_rows = 0;
+  uword f_n_cols = 0;
+  uword f_n_ent  = 0;
+  
+  while(f.good())
+    {
+    std::getline(f, line_string);
+    
+    const std::string::size_type first = line_string.find_first_not_of(" \t\r");
+    
+    if( (first == std::string::npos) || (line_string[first] == '%') )  { continue; }
+    
+    line_stream.clear();
+    line_stream.str(line_string);
+    
+    line_stream >> f_n_rows >> f_n_cols >> f_n_ent;
+    
+    size_found = (line_stream.fail() == false);
+    
+    break;
+    }
+  
+  if(size_found == false)  { err_msg = "incorrect size line in "; return false; }
+  
+  if( (symmetry != 0) && (f_n_rows != f_n_cols) )  { err_msg = "symmetric Matrix Market data must be square; problem with "; return false; }
+  
+  // slurp the rest of the stream; the entry lines are parsed from memory
+  
+  std::string buffer;
+  
+  f.clear();
+  const std::streampos pos1 = f.tellg();
+  f.seekg(0, std::ios::end);
+  const std::streampos pos2 = f.tellg();
+  
+  if( f.good() && (pos1 >= std::streampos(0)) && (pos2 >= pos1) )
+    {
+    f.seekg(pos1);
+    
+    buffer.resize( std::size_t(pos2 - pos1) );
+    
+    if(buffer.size() > 0)  { f.read(&buffer[0], std::streamsize(buffer.size())); }
+    
+    if(f.gcount() != std::streamsize(buffer.size()))  { buffer.resize( std::size_t(f.gcount()) ); }
+    }
+  else
+    {
+    f.clear();
+    f.seekg(pos1);
+    
+    buffer.assign( (std::istreambuf_iterator<char>(f)), std::istreambuf_iterator<char>() );
+    }
+  
+  const char* buf_mem = buffer.c_str();
+  const uword buf_len = uword(buffer.size());
+  
+  // split the buffer into chunks at line boundaries; one chunk per thread
+  
+  uword n_chunks = 1;
+  
+  #if defined(ARMA_USE_OPENMP)
+    {
+    const uword min_chunk_len = uword(1) << 18;
+    
+    if( (buf_len >= 2*min_chunk_len) && (mp_thread_limit::in_parallel() == false) )
+      {
+      n_chunks = (std::min)( uword(mp_thread_limit::get()), buf_len / min_chunk_len );
+      }
+    }
+  #endif
+  
+  podarray<uword> chunk_bounds(n_chunks+1);
+  
+  chunk_bounds[0]        = 0;
+  chunk_bounds[n_chunks] = buf_len;
+  
+  for(uword c=1; c < n_chunks; ++c)
+    {
+    uword pos = (std::max)( (buf_len / n_chunks) * c, chunk_bounds[c-1] );
+    
+    while( (pos < buf_len) && (buf_mem[pos] != '\n') )  { ++pos; }
+    
+    chunk_bounds[c] = (pos < buf_len) ? (pos+1) : buf_len;
+    }
+  
+  std::vector< std::vector<uword> > chunk_rows(n_chunks);
+  std::vector< std::vector<uword> > chunk_cols(n_chunks);
+  std::vector< std::vector<eT>    > chunk_vals(n_chunks);
+  
+  podarray<uword> chunk_n_ent(n_chunks);
+  podarray<uword> chunk_status(n_chunks);  // 0 = ok, 1 = parse error, 2 = index out of bounds
+  
+  #if defined(ARMA_USE_OPENMP)
+    {
+    const int n_threads = int(n_chunks);
+    
+    #pragma omp parallel for schedule(static) num_threads(n_threads)
+    for(uword c=0; c < n_chunks; ++c)
+      {
+      chunk_status[c] = diskio::mtx_parse_chunk(chunk_rows[c], chunk_cols[c], chunk_vals[c], chunk_n_ent[c], buf_mem + chunk_bounds[c], buf_mem + chunk_bounds[c+1], field, symmetry, f_n_rows, f_n_cols);
+      }
+    }
+  #else
+    {
+    chunk_status[0] = diskio::mtx_parse_chunk(chunk_rows[0], chunk_cols[0], chunk_vals[0], chunk_n_ent[0], buf_mem, buf_mem + buf_len, field, symmetry, f_n_rows, f_n_cols);
+    }
+  #endif
+  
+  // release the memory used by the buffer before the matrix is built; clear() would keep the capacity
+  
+  std::string().swap(buffer);
+  
+  uword n_ent = 0;
+  
+  for(uword c=0; c < n_chunks; ++c)
+    {
+    if(chunk_status[c] == 1)  { err_msg = "couldn't interpret data in ";  return false; }
+    if(chunk_status[c] == 2)  { err_msg = "index out of bounds in ";      return false; }
+    
+    n_ent += chunk_n_ent[c];
+    }
+  
+  if(n_ent != f_n_ent)  { err_msg = "inconsistent number of entries in "; return false; }
+  
+  // bulk CSC build: count entries per column, scatter, then sort each column by row index
+  
+  podarray<uword> col_offsets(f_n_cols+1);
+  col_offsets.zeros();
+  
+  for(uword c=0; c < n_chunks; ++c)
+    {
+    const std::vector<uword>& cols = chunk_cols[c];
+    
+    const uword N = uword(cols.size());
+    
+    for(uword i=0; i < N; ++i)  { ++col_offsets[ cols[i] + 1 ]; }
+    }
+  
+  for(uword col=0; col < f_n_cols; ++col)  { col_offsets[col+1] += col_offsets[col]; }
+  
+  const uword n_triplets = col_offsets[f_n_cols];
+  
+  podarray< arma_sort_index_packet<uword> > packets(n_triplets);
+  podarray<eT>                              scatter_vals(n_triplets);
+  
+  podarray<uword> col_pos(col_offsets.memptr(), f_n_cols+1);
+  
+  for(uword c=0; c < n_chunks; ++c)
+    {
+    const std::vector<uword>& rows = chunk_rows[c];
+    const std::vector<uword>& cols = chunk_cols[c];
+    const std::vector<eT>&    vals = chunk_vals[c];
+    
+    const uword N = uword(cols.size());
+    
+    for(uword i=0; i < N; ++i)
+      {
+      const uword pos = col_pos[ cols[i] ]++;
+      
+      packets[pos].val   = rows[i];
+      packets[pos].index = pos;
+      scatter_vals[pos]  = vals[i];
+      }
+    
+    std::vector<uword>().swap(chunk_rows[c]);
+    std::vector<uword>().swap(chunk_cols[c]);
+    std::vector<eT>   ().swap(chunk_vals[c]);
+    }
+  
+  // first pass: sort each column and count the unique non-zero entries (duplicates are summed)
+  
+  podarray<uword> col_nnz(f_n_cols);
+  
+  #if defined(ARMA_USE_OPENMP)
+    {
+    const bool use_mp = (n_chunks > 1) && (f_n_cols > 1);
+    
+    const int n_threads = (use_mp) ? int(n_chunks) : int(1);
+    
+    #pragma omp parallel for schedule(dynamic, 64) num_threads(n_threads)
+    for(uword col=0; col < f_n_cols; ++col)
+      {
+      col_nnz[col] = diskio::mtx_sort_column<eT>(packets.memptr(), scatter_vals.memptr(), col_offsets[col], col_offsets[col+1], NULL, NULL);
+      }
+    }
+  #else
+    {
+    for(uword col=0; col < f_n_cols; ++col)
+      {
+      col_nnz[col] = diskio::mtx_sort_column<eT>(packets.memptr(), scatter_vals.memptr(), col_offsets[col], col_offsets[col+1], NULL, NULL);
+      }
+    }
+  #endif
+  
+  uword n_nonzero = 0;
+  
+  for(uword col=0; col < f_n_cols; ++col)  { n_nonzero += col_nnz[col]; }
+  
+  x.reserve(f_n_rows, f_n_cols, n_nonzero);
+  
+  uword* x_col_ptrs = access::rwp(x.col_ptrs);
+  
+  x_col_ptrs[0] = 0;
+  
+  for(uword col=0; col < f_n_cols; ++col)  { x_col_ptrs[col+1] = x_col_ptrs[col] + col_nnz[col]; }
+  
+  // second pass: write the (already sorted) columns into place
+  
+  eT*    x_values      = access::rwp(x.values);
+  uword* x_row_indices = access::rwp(x.row_indices);
+  
+  #if defined(ARMA_USE_OPENMP)
+    {
+    const bool use_mp = (n_chunks > 1) && (f_n_cols > 1);
+    
+    const int n_threads = (use_mp) ? int(n_chunks) : int(1);
+    
+    #pragma omp parallel for schedule(dynamic, 64) num_threads(n_threads)
+    for(uword col=0; col < f_n_cols; ++col)
+      {
+      const uword offset = x_col_ptrs[col];
+      
+      diskio::mtx_sort_column<eT>(packets.memptr(), scatter_vals.memptr(), col_offsets[col], col_offsets[col+1], &(x_row_indices[offset]), &(x_values[offset]));
+      }
+    }
+  #else
+    {
+    for(uword col=0; col < f_n_cols; ++col)
+      {
+      const uword offset = x_col_ptrs[col];
+      
+      diskio::mtx_sort_column<eT>(packets.memptr(), scatter_vals.memptr(), col_offsets[col], col_offsets[col+1], &(x_row_indices[offset]), &(x_values[offset]));
+      }
+    }
+  #endif
+  
+  return true;
+  }
+
+
+
+//! parse the entry lines in [mem_start, mem_end);
+//! returns 0 if all is well, 1 for unparseable data, 2 for indices out of bounds
+template<typename eT>
+inline
+uword
+diskio::mtx_parse_chunk(std::vector<uword>& rows, std::vector<uword>& cols, std::vector<eT>& vals, uword& n_ent, const char* mem_start, const char* mem_end, const uword field, const uword symmetry, const uword f_n_rows, const uword f_n_cols)
+  {
+  arma_extra_debug_sigprint();
+  
+  n_ent = 0;
+  
+  // rough guess of the number of entries, to reduce reallocations
+  const uword n_guess = uword(mem_end - mem_start) / ( (field == 0) ? uword(8) : uword(16) );
+  
+  rows.reserve(n_guess);
+  cols.reserve(n_guess);
+  vals.reserve(n_guess);
+  
+  const bool parse_int = (field == 2) && (is_real<eT>::value == false) && (is_cx<eT>::no);
+  
+  const char* ptr = mem_start;
+  
+  while(ptr < mem_end)
+    {
+    const char* line_end = static_cast<const char*>( std::memchr(ptr, '\n', std::size_t(mem_end - ptr)) );
+    
+    if(line_end == NULL)  { line_end = mem_end; }
+    
+    while( (ptr < line_end) && ( (*ptr == ' ') || (*ptr == '\t') || (*ptr == '\r') ) )  { ++ptr; }
+    
+    if( (ptr == line_end) || (*ptr == '%') )  { ptr = line_end + 1; continue; }
+    
+    // strto*() functions skip leading newlines, so each result must be checked against line_end
+    
+    char* endp = NULL;
+    
+    const unsigned long long in_row = std::strtoull(ptr, &endp, 10);
+    
+    if( (endp == ptr) || (endp > line_end) )  { return 1; }
+    
+    ptr = endp;
+    
+    const unsigned long long in_col = std::strtoull(ptr, &endp, 10);
+    
+    if( (endp == ptr) || (endp > line_end) )  { return 1; }
+    
+    ptr = endp;
+    
+    eT val = eT(1);
+    
+    if(field != 0)
+      {
+      double val_real = 0.0;
+      double val_imag = 0.0;
+      
+      if(parse_int)
+        {
+        const long long tmp = std::strtoll(ptr, &endp, 10);
+        
+        if( (endp == ptr) || (endp > line_end) )  { return 1; }
+        
+        val = eT(tmp);
+        }
+      else
+        {
+        val_real = std::strtod(ptr, &endp);
+        
+        if( (endp == ptr) || (endp > line_end) )  { return 1; }
+        
+        if(field == 3)
+          {
+          ptr = endp;
+          
+          val_imag = std::strtod(ptr, &endp);
+          
+          if( (endp == ptr) || (endp > line_end) )  { return 1; }
+          }
+        
+        diskio::mtx_convert_val(val, val_real, val_imag);
+        }
+      
+      ptr = endp;
+      }
+    
+    ptr = line_end + 1;
+    
+    if( (in_row < 1) || (in_col < 1) || (in_row > f_n_rows) || (in_col > f_n_cols) )  { return 2; }
+    
+    const uword row = uword(in_row - 1);
+    const uword col = uword(in_col - 1);
+    
+    ++n_ent;
     
-    // a valid line in co-ord format has at least 2 entries
+    if( (symmetry == 2) && (row == col) )  { continue; }  // diagonal of a skew-symmetric matrix is zero
     
-    line_stream >> line_row;
+    rows.push_back(row);
+    cols.push_back(col);
+    vals.push_back(val);
     
-    if(line_stream.good() == false)  { load_okay = false; break; }
+    if( (symmetry != 0) && (row != col) )
+      {
+      rows.push_back(col);
+      cols.push_back(row);
+      vals.push_back( (symmetry == 1) ? val : ( (symmetry == 2) ? eT(eT(0) - val) : eT(access::alt_conj(val)) ) );
+      }
+    }
+  
+  return 0;
+  }
+
+
+
+//! sort the packets in [start, end) by row index and merge duplicates;
+//! if out_rows and out_vals are given the unique non-zero entries are also written out;
+//! returns the number of unique non-zero entries
+template<typename eT>
+inline
+uword
+diskio::mtx_sort_column(arma_sort_index_packet<uword>* packets, const eT* vals, const uword start, const uword end, uword* out_rows, eT* out_vals)
+  {
+  if(start == end)  { return 0; }
+  
+  if(out_rows == NULL)
+    {
+    arma_sort_index_helper_ascend<uword> comparator;
     
-    line_stream >> line_col;
+    bool is_sorted = true;
     
-    size_found = true;
+    for(uword i=start+1; i < end; ++i)  { if(packets[i].val < packets[i-1].val)  { is_sorted = false; break; } }
     
-    if(f_n_rows < line_row)  f_n_rows = line_row;
-    if(f_n_cols < line_col)  f_n_cols = line_col;
+    if(is_sorted == false)  { std::sort( &(packets[start]), &(packets[end]), comparator ); }
     }
   
-  // take into account that indices start at 0
-  if(size_found)  { ++f_n_rows;  ++f_n_cols; }
+  uword count = 0;
   
-  if(load_okay)
+  uword i = start;
+  
+  while(i < end)
     {
-    f.clear();
-    f.seekg(pos1);
+    const uword row = packets[i].val;
     
-    MapMat< std::complex<T> > tmp(f_n_rows, f_n_cols);
+    eT acc = vals[ packets[i].index ];
     
-    while(f.good())
+    ++i;
+    
+    while( (i < end) && (packets[i].val == row) )  { acc += vals[ packets[i].index ]; ++i; }
+    
+    if(acc != eT(0))
       {
-      std::getline(f, line_string);
-      
-      if(line_string.size() == 0)  { break; }
-      
-      line_stream.clear();
-      line_stream.str(line_string);
-      
-      uword line_row = 0;
-      uword line_col = 0;
-      
-      line_stream >> line_row;
-      line_stream >> line_col;
-      
-      T val_real = T(0);
-      T val_imag = T(0);
-      
-      line_stream >> token_real;
-      
-      if(line_stream.fail() == false)
-        {
-        diskio::convert_token( val_real, token_real );
-        }
-      
-      
-      line_stream >> token_imag;
-      
-      if(line_stream.fail() == false)
+      if(out_rows != NULL)
         {
-        diskio::convert_token( val_imag, token_imag );
+        out_rows[count] = row;
+        out_vals[count] = acc;
         }
       
-      if( (val_real != T(0)) || (val_imag != T(0)) )
-        {
-        tmp(line_row,line_col) = std::complex<T>(val_real, val_imag);
-        }
+      ++count;
       }
-    
-    x = tmp;
     }
   
-  return load_okay;
+  return count;
+  }
+
+
+
+template<typename eT>
+inline
+void
+diskio::mtx_convert_val(eT& out, const double val_real, const double val_imag)
+  {
+  arma_ignore(val_imag);
+  
+  out = eT(val_real);
+  }
+
+
+
+template<typename T>
+inline
+void
+diskio::mtx_convert_val(std::complex<T>& out, const double val_real, const double val_imag)
+  {
+  out = std::complex<T>( T(val_real), T(val_imag) );
   }
 
 
@@ -3087,6 +4094,84 @@ diskio::load_arma_binary(SpMat<eT>& x, std::istream& f, std::string& err_msg)
 
 
 
+template<typename eT>
+inline
+bool
+diskio::load_arma_compact(SpMat<eT>& x, const std::string& name, std::string& err_msg)
+  {
+  arma_extra_debug_sigprint();
+  
+  std::ifstream f;
+  f.open(name.c_str(), std::fstream::binary);
+  
+  bool load_okay = f.is_open();
+  
+  if(load_okay)
+    {
+    load_okay = diskio::load_arma_compact(x, f, err_msg);
+    f.close();
+    }
+  
+  return load_okay;
+  }
+
+
+
+template<typename eT>
+inline
+bool
+diskio::load_arma_compact(SpMat<eT>& x, std::istream& f, std::string& err_msg)
+  {
+  arma_extra_debug_sigprint();
+  
+  typedef typename get_pod_type<eT>::result pod_type;
+  
+  std::string f_header;
+  uword       f_n_rows = 0;
+  uword       f_n_cols = 0;
+  uword       f_n_nz   = 0;
+  
+  f >> f_header;
+  f >> f_n_rows;
+  f >> f_n_cols;
+  f >> f_n_nz;
+  
+  if( (f_header != diskio::gen_compact_header(diskio::gen_bin_header(x))) || (f.good() == false) )
+    {
+    err_msg = "incorrect header in ";
+    return false;
+    }
+  
+  f.get();
+  
+  x.reserve(f_n_rows, f_n_cols, f_n_nz);
+  
+  bool load_okay = true;
+  
+  load_okay = load_okay && diskio::load_compact_blocks(f, reinterpret_cast<unsigned char*>(access::rwp(x.values)),      x.n_nonzero*sizeof(eT),      sizeof(pod_type), err_msg);
+  load_okay = load_okay && diskio::load_compact_blocks(f, reinterpret_cast<unsigned char*>(access::rwp(x.row_indices)), x.n_nonzero*sizeof(uword),   sizeof(uword),    err_msg);
+  load_okay = load_okay && diskio::load_compact_blocks(f, reinterpret_cast<unsigned char*>(access::rwp(x.col_ptrs)),    (x.n_cols+1)*sizeof(uword), sizeof(uword),    err_msg);
+  
+  if(load_okay)
+    {
+    bool check1 = true;  for(uword i=0; i < x.n_nonzero; ++i)  { if(x.row_indices[i] >= x.n_rows)     { check1 = false; break; } }
+    bool check2 = true;  for(uword i=0; i < x.n_cols;    ++i)  { if(x.col_ptrs[i+1] < x.col_ptrs[i])  { check2 = false; break; } }
+    bool check3 = (x.col_ptrs[0] == 0) && (x.col_ptrs[x.n_cols] == x.n_nonzero);
+    
+    if( (check1 == false) || (check2 == false) || (check3 == false) )
+      {
+      err_msg   = "inconsistent data in ";
+      load_okay = false;
+      }
+    }
+  
+  if(load_okay == false)  { x.reset(); }
+  
+  return load_okay;
+  }
+
+
+
 // cubes
 
 
@@ -3322,6 +4407,53 @@ diskio::save_arma_binary(const Cube<eT>& x, std::ostream& f)
 
 
 
+//! Save a cube in the compact binary format
+template<typename eT>
+inline
+bool
+diskio::save_arma_compact(const Cube<eT>& x, const std::string& final_name)
+  {
+  arma_extra_debug_sigprint();
+  
+  const std::string tmp_name = diskio::gen_tmp_name(final_name);
+  
+  std::ofstream f(tmp_name.c_str(), std::fstream::binary);
+  
+  bool save_okay = f.is_open();
+  
+  if(save_okay)
+    {
+    save_okay = diskio::save_arma_compact(x, f);
+    
+    f.flush();
+    f.close();
+    
+    if(save_okay)  { save_okay = diskio::safe_rename(tmp_name, final_name); }
+    }
+  
+  return save_okay;
+  }
+
+
+
+//! Save a cube in the compact binary format
+template<typename eT>
+inline
+bool
+diskio::save_arma_compact(const Cube<eT>& x, std::ostream& f)
+  {
+  arma_extra_debug_sigprint();
+  
+  typedef typename get_pod_type<eT>::result pod_type;
+  
+  f << diskio::gen_compact_header(diskio::gen_bin_header(x)) << '\n';
+  f << x.n_rows << ' ' << x.n_cols << ' ' << x.n_slices << '\n';
+  
+  return diskio::save_compact_blocks(f, reinterpret_cast<const unsigned char*>(x.mem), x.n_elem*sizeof(eT), sizeof(pod_type), diskio::compact_block_bytes(x.n_rows*sizeof(eT)));
+  }
+
+
+
 //! Save a cube as part of a HDF5 file
 template<typename eT>
 inline
@@ -3332,14 +4464,17 @@ diskio::save_hdf5_binary(const Cube<eT>& x, const hdf5_name& spec, std::string&
   
   #if defined(ARMA_USE_HDF5)
     {
+    hdf5_misc::hdf5_lock hdf5_locker;
+    
     hdf5_misc::hdf5_suspend_printing_errors hdf5_print_suspender;
     
     bool save_okay = false;
     
     const bool append  = bool(spec.opts.flags & hdf5_opts::flag_append);
     const bool replace = bool(spec.opts.flags & hdf5_opts::flag_replace);
+    const bool extend  = bool(spec.opts.flags & hdf5_opts::flag_extend);
     
-    const bool use_existing_file = ((append || replace) && (arma_H5Fis_hdf5(spec.filename.c_str()) > 0));
+    const bool use_existing_file = ((append || replace || extend) && (arma_H5Fis_hdf5(spec.filename.c_str()) > 0));
     
     const std::string tmp_name = (use_existing_file) ? std::string() : diskio::gen_tmp_name(spec.filename);
     
@@ -3348,18 +4483,12 @@ diskio::save_hdf5_binary(const Cube<eT>& x, const hdf5_name& spec, std::string&
     
     if(file < 0)  { return false; }
     
-    // We need to create a dataset, datatype, and dataspace
+    // treat the cube as a 3d array dataspace
     hsize_t dims[3];
     dims[2] = x.n_rows;
     dims[1] = x.n_cols;
     dims[0] = x.n_slices;
     
-    hid_t dataspace = arma_H5Screate_simple(3, dims, NULL);   // treat the cube as a 3d array dataspace
-    hid_t datatype  = hdf5_misc::get_hdf5_type<eT>();
-    
-    // If this returned something invalid, well, it's time to crash.
-    arma_check(datatype == -1, "Cube::save(): unknown datatype for HDF5");
-    
     // MATLAB forces the users to specify a name at save time for HDF5;
     // Octave will use the default of 'dataset' unless otherwise specified.
     // If the user hasn't specified a dataset name, we will use 'dataset'
@@ -3398,23 +4527,8 @@ diskio::save_hdf5_binary(const Cube<eT>& x, const hdf5_name& spec, std::string&
       // NOTE: https://lists.hdfgroup.org/pipermail/hdf-forum_lists.hdfgroup.org/2017-August/010486.html
       }
     
-    hid_t dataset = arma_H5Dcreate(last_group, dataset_name.c_str(), datatype, dataspace, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
-    
-    if(dataset < 0)
-      {
-      save_okay = false;
-      
-      err_msg = "couldn't create dataset in ";
-      }
-    else
-      {
-      save_okay = (arma_H5Dwrite(dataset, datatype, H5S_ALL, H5S_ALL, H5P_DEFAULT, x.mem) >= 0);
-      
-      arma_H5Dclose(dataset);
-      }
+    save_okay = hdf5_misc::write_dataset(last_group, dataset_name, 3, dims, x.mem, spec.opts, err_msg);
     
-    arma_H5Tclose(datatype);
-    arma_H5Sclose(dataspace);
     for(size_t i = 0; i < groups.size(); ++i)  { arma_H5Gclose(groups[i]); }
     arma_H5Fclose(file);
     
@@ -3759,6 +4873,64 @@ diskio::load_arma_binary(Cube<eT>& x, std::istream& f, std::string& err_msg)
 
 
 
+//! Load a cube in the compact binary format
+template<typename eT>
+inline
+bool
+diskio::load_arma_compact(Cube<eT>& x, const std::string& name, std::string& err_msg)
+  {
+  arma_extra_debug_sigprint();
+  
+  std::ifstream f;
+  f.open(name.c_str(), std::fstream::binary);
+  
+  bool load_okay = f.is_open();
+  
+  if(load_okay)
+    {
+    load_okay = diskio::load_arma_compact(x, f, err_msg);
+    f.close();
+    }
+  
+  return load_okay;
+  }
+
+
+
+template<typename eT>
+inline
+bool
+diskio::load_arma_compact(Cube<eT>& x, std::istream& f, std::string& err_msg)
+  {
+  arma_extra_debug_sigprint();
+  
+  typedef typename get_pod_type<eT>::result pod_type;
+  
+  std::string f_header;
+  uword       f_n_rows   = 0;
+  uword       f_n_cols   = 0;
+  uword       f_n_slices = 0;
+  
+  f >> f_header;
+  f >> f_n_rows;
+  f >> f_n_cols;
+  f >> f_n_slices;
+  
+  if( (f_header != diskio::gen_compact_header(diskio::gen_bin_header(x))) || (f.good() == false) )
+    {
+    err_msg = "incorrect header in ";
+    return false;
+    }
+  
+  f.get();
+  
+  x.set_size(f_n_rows, f_n_cols, f_n_slices);
+  
+  return diskio::load_compact_blocks(f, reinterpret_cast<unsigned char*>(x.memptr()), x.n_elem*sizeof(eT), sizeof(pod_type), err_msg);
+  }
+
+
+
 //! Load a HDF5 file as a cube
 template<typename eT>
 inline
@@ -3769,10 +4941,14 @@ diskio::load_hdf5_binary(Cube<eT>& x, const hdf5_name& spec, std::string& err_ms
   
   #if defined(ARMA_USE_HDF5)
     {
+    hdf5_misc::hdf5_lock hdf5_locker;
+    
     hdf5_misc::hdf5_suspend_printing_errors hdf5_print_suspender;
     
     bool load_okay = false;
     
+    const bool use_subset = bool(spec.opts.flags & hdf5_opts::flag_subset);
+    
     hid_t fid = arma_H5Fopen(spec.filename.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
     
     if(fid >= 0)
@@ -3823,6 +4999,27 @@ diskio::load_hdf5_binary(Cube<eT>& x, const hdf5_name& spec, std::string& err_ms
         if(ndims == 1) { dims[1] = 1; dims[2] = 1; }  // Vector case; one row/colum, several slices
         if(ndims == 2) {              dims[2] = 1; }  // Matrix case; one column, several rows/slices
         
+        hid_t memspace = H5S_ALL;
+        hid_t selspace = H5S_ALL;
+        
+        if(use_subset)
+          {
+          // restrict loading to a hyperslab; dims is changed to the size of the hyperslab
+          memspace = hdf5_misc::select_subset(filespace, ndims, dims, 3, spec.opts.sel_rows, spec.opts.sel_cols, spec.opts.sel_slices);
+          selspace = filespace;
+          
+          if(memspace < 0)
+            {
+            err_msg = "requested subset is out of bounds of HDF5 dataset in ";
+            
+            arma_H5Sclose(filespace);
+            arma_H5Dclose(dataset);
+            arma_H5Fclose(fid);
+            
+            return false;
+            }
+          }
+        
         x.set_size(dims[2], dims[1], dims[0]);
         
         // Now we have to see what type is stored to figure out how to load it.
@@ -3832,15 +5029,15 @@ diskio::load_hdf5_binary(Cube<eT>& x, const hdf5_name& spec, std::string& err_ms
         // If these are the same type, it is simple.
         if(arma_H5Tequal(datatype, mat_type) > 0)
           {
-          // Load directly; H5S_ALL used so that we load the entire dataset.
-          hid_t read_status = arma_H5Dread(dataset, datatype, H5S_ALL, H5S_ALL, H5P_DEFAULT, void_ptr(x.memptr()));
+          // Load directly; H5S_ALL used so that we load the entire dataset, unless a subset was requested.
+          hid_t read_status = arma_H5Dread(dataset, datatype, memspace, selspace, H5P_DEFAULT, void_ptr(x.memptr()));
           
           if(read_status >= 0) { load_okay = true; }
           }
         else
           {
           // Load into another array and convert its type accordingly.
-          hid_t read_status = hdf5_misc::load_and_convert_hdf5(x.memptr(), dataset, datatype, x.n_elem);
+          hid_t read_status = hdf5_misc::load_and_convert_hdf5(x.memptr(), dataset, datatype, x.n_elem, memspace, selspace);
           
           if(read_status >= 0) { load_okay = true; }
           }
@@ -3849,6 +5046,8 @@ diskio::load_hdf5_binary(Cube<eT>& x, const hdf5_name& spec, std::string& err_ms
         arma_H5Tclose(datatype);
         arma_H5Tclose(mat_type);
         arma_H5Sclose(filespace);
+        
+        if(use_subset)  { arma_H5Sclose(memspace); }
         }
       
       arma_H5Dclose(dataset);
@@ -3921,10 +5120,12 @@ diskio::load_auto_detect(Cube<eT>& x, std::istream& f, std::string& err_msg)
   
   const char* ARMA_CUB_TXT_str = "ARMA_CUB_TXT";
   const char* ARMA_CUB_BIN_str = "ARMA_CUB_BIN";
+  const char* ARMA_CUB_CPT_str = "ARMA_CUB_CPT";
   const char*           P6_str = "P6";
   
   const uword ARMA_CUB_TXT_len = uword(12);
   const uword ARMA_CUB_BIN_len = uword(12);
+  const uword ARMA_CUB_CPT_len = uword(12);
   const uword           P6_len = uword(2);
   
   podarray<char> header(ARMA_CUB_TXT_len + 1);
@@ -3949,6 +5150,11 @@ diskio::load_auto_detect(Cube<eT>& x, std::istream& f, std::string& err_msg)
     return load_arma_binary(x, f, err_msg);
     }
   else
+  if( std::strncmp(ARMA_CUB_CPT_str, header_mem, size_t(ARMA_CUB_CPT_len)) == 0 )
+    {
+    return load_arma_compact(x, f, err_msg);
+    }
+  else
   if( std::strncmp(P6_str, header_mem, size_t(P6_len)) == 0 )
     {
     return load_ppm_binary(x, f, err_msg);
@@ -101,7 +101,15 @@ class fft_engine : public fft_store<cx_type, fixed_N, (fixed_N > 0)>
   podarray<uword>   residue;
   podarray<uword>   radix;
   
-  podarray<cx_type> tmp_array;
+  podarray<cx_type> twiddles;         //!< per stage twiddle factors for the specialised butterflies, stored contiguously
+  podarray<uword>   twiddles_offset;  //!< start of the twiddle factors for each stage
+  
+  // Bluestein (chirp-z) algorithm, used for lengths with large prime factors
+  
+  uword                                              M;           //!< length of the padded convolution; zero if not used
+  podarray<cx_type>                                  chirp;       //!< exp(+-i*pi*n^2/N), n = 0 .. N-1
+  podarray<cx_type>                                  chirp_fft;   //!< scaled transform of the conjugated chirp, length M
+  std::shared_ptr< const fft_engine<cx_type,false> > sub_engine;  //!< engine of length M (power of 2)
   
   
   template<bool fill>
@@ -111,18 +119,21 @@ class fft_engine : public fft_store<cx_type, fixed_N, (fixed_N > 0)>
     {
     uword i = 0;
     
-    for(uword n = N, r=4; n >= 2; ++i)
+    for(uword n = N, r=8; n >= 2; ++i)
       {
-      while( (n % r) > 0 )
+      // a remaining factor of 16 is done as two radix 4 stages rather than radix 8 and radix 2 stages
+      
+      while( ((n % r) > 0) || ((r == 8) && ((n % 16) == 0) && ((n % 32) > 0)) )
         {
         switch(r)
           {
           case 2:  r  = 3; break;
           case 4:  r  = 2; break;
+          case 8:  r  = 4; break;
           default: r += 2; break;
           }
         
-        if(r*r > n) { r = n; }
+        if( ((r % 2) == 1) && (r*r > n) ) { r = n; }
         }
       
       n /= r;
@@ -139,9 +150,114 @@ class fft_engine : public fft_store<cx_type, fixed_N, (fixed_N > 0)>
   
   
   
+  //! approximate cost of processing one element in a stage with radix r (arbitrary units, empirically determined)
+  inline
+  static
+  double
+  stage_cost(const uword r)
+    {
+    switch(r)
+      {
+      case 2:  return 1.2;
+      case 3:  return 1.0;
+      case 4:  return 1.65;
+      case 5:  return 2.6;
+      case 8:  return 3.0;
+      default: return 1.2 * double(r) + 2.0;   // butterfly_N() is O(r) per element
+      }
+    }
+  
+  
+  
+  //! decide whether the Bluestein algorithm is expected to be quicker than direct use of the butterflies,
+  //! and return the length of the padded convolution if so; otherwise return zero
+  inline
+  uword
+  calc_bluestein_length() const
+    {
+    if( (fixed_N > 0) || (N <= 1) )  { return 0; }
+    
+    double direct_cost = 0.0;
+    
+    for(uword i=0; i < radix.n_elem; ++i)  { direct_cost += stage_cost(radix[i]); }
+    
+    direct_cost *= double(N);
+    
+    uword len      = 1;
+    uword len_log2 = 0;
+    
+    while(len < (2*N - 1))  { len *= 2; ++len_log2; }
+    
+    // two transforms of length len (radix 8 stages plus possibly one radix 2 or radix 4 stage),
+    // plus the element-wise multiplications and scratch memory
+    const uword  len_rem  = len_log2 % 3;
+    const double len_cost = double(len_log2/3) * stage_cost(8) + ( (len_rem == 2) ? stage_cost(4) : ( (len_rem == 1) ? stage_cost(2) : 0.0 ) );
+    
+    const double bluestein_cost = double(len) * ( 2.0 * len_cost + 12.5 );
+    
+    return (bluestein_cost < direct_cost) ? len : uword(0);
+    }
+  
+  
+  
+  inline
+  void
+  init_bluestein()
+    {
+    arma_extra_debug_sigprint();
+    
+    chirp.set_size(N);
+    
+    cx_type* chirp_mem = chirp.memptr();
+    
+    // n^2 is tracked modulo 2N to keep the angles small and accurate
+    
+    const uword N2 = 2*N;
+    
+    const T k = T( (inverse) ? +1 : -1 ) * std::acos( T(-1) ) / T(N);
+    
+    uword sq = 0;
+    
+    for(uword n=0; n < N; ++n)
+      {
+      chirp_mem[n] = std::exp( cx_type(T(0), T(sq) * k) );
+      
+      sq += 2*n + 1;
+      
+      while(sq >= N2)  { sq -= N2; }
+      }
+    
+    sub_engine = std::make_shared< const fft_engine<cx_type,false> >(M);
+    
+    podarray<cx_type> b(M);
+    
+    cx_type* b_mem = b.memptr();
+    
+    arrayops::fill_zeros(b_mem, M);
+    
+    b_mem[0] = std::conj(chirp_mem[0]);
+    
+    for(uword n=1; n < N; ++n)  { b_mem[n] = b_mem[M-n] = std::conj(chirp_mem[n]); }
+    
+    chirp_fft.set_size(M);
+    
+    sub_engine->run(chirp_fft.memptr(), b_mem);
+    
+    // include the scaling of the inverse transform used for the convolution
+    
+    const T scale = T(1) / T(M);
+    
+    cx_type* chirp_fft_mem = chirp_fft.memptr();
+    
+    for(uword i=0; i < M; ++i)  { chirp_fft_mem[i] *= scale; }
+    }
+  
+  
+  
   inline
   fft_engine(const uword in_N)
     : fft_store< cx_type, fixed_N, (fixed_N > 0) >(in_N)
+    , M(0)
     {
     arma_extra_debug_sigprint();
     
@@ -152,6 +268,16 @@ class fft_engine : public fft_store<cx_type, fixed_N, (fixed_N > 0)>
     
     calc_radix<true>();
     
+    M = calc_bluestein_length();
+    
+    if(M > 0)
+      {
+      arma_extra_debug_print("fft_engine: using Bluestein algorithm");
+      
+      init_bluestein();
+      
+      return;
+      }
     
     // calculate the constant coefficients
     
@@ -160,71 +286,189 @@ class fft_engine : public fft_store<cx_type, fixed_N, (fixed_N > 0)>
     const T k = T( (inverse) ? +2 : -2 ) * std::acos( T(-1) ) / T(N);
     
     for(uword i=0; i < N; ++i)  { coeffs[i] = std::exp( cx_type(T(0), i*k) ); }
+    
+    init_twiddles();
     }
   
   
   
-  arma_hot
+  //! approximate amount of memory held by the engine, including the engine used by the Bluestein algorithm
+  inline
+  uword
+  n_bytes() const
+    {
+    uword out = (N + twiddles.n_elem + chirp.n_elem + chirp_fft.n_elem) * uword(sizeof(cx_type));
+    
+    out += (residue.n_elem + radix.n_elem + twiddles_offset.n_elem) * uword(sizeof(uword));
+    
+    if(sub_engine)  { out += sub_engine->n_bytes(); }
+    
+    return out;
+    }
+  
+  
+  
+  //! gather the twiddle factors used by each stage, so that the butterflies read them contiguously
   inline
   void
-  butterfly_2(cx_type* Y, const uword stride, const uword m)
+  init_twiddles()
     {
     arma_extra_debug_sigprint();
     
+    const uword n_stages = radix.n_elem;
+    
+    twiddles_offset.set_size(n_stages);
+    
+    uword n_twiddles = 0;
+    
+    for(uword stage=0; stage < n_stages; ++stage)
+      {
+      twiddles_offset[stage] = n_twiddles;
+      
+      const uword r = radix[stage];
+      
+      if( (r <= 5) || (r == 8) )  { n_twiddles += residue[stage] * (r-1); }
+      }
+    
+    twiddles.set_size(n_twiddles);
+    
     const cx_type* coeffs = coeffs_ptr();
     
-    for(uword i=0; i < m; ++i)
+    cx_type* tw = twiddles.memptr();
+    
+    uword stride = 1;
+    
+    for(uword stage=0; stage < n_stages; ++stage)
       {
-      const cx_type t = Y[i+m] * coeffs[i*stride];
+      const uword r = radix[stage];
+      const uword m = residue[stage];
       
-      Y[i+m] =  Y[i] - t;
-      Y[i  ] += t;
+      if( (r <= 5) || (r == 8) )
+        {
+        cx_type* tw_stage = &tw[ twiddles_offset[stage] ];
+        
+        for(uword i=0; i < m; ++i)
+        for(uword j=1; j < r; ++j)
+          {
+          tw_stage[i*(r-1) + (j-1)] = coeffs[i*j*stride];
+          }
+        }
+      
+      stride *= r;
       }
     }
   
   
   
+  //! complex multiplication without the checks for infinities and NaNs done by std::complex
+  arma_inline
+  static
+  cx_type
+  cx_mul(const cx_type& a, const cx_type& b)
+    {
+    return cx_type( (a.real()*b.real() - a.imag()*b.imag()), (a.real()*b.imag() + a.imag()*b.real()) );
+    }
+  
+  
+  
+  //! multiplication by -i for the forward transform, or by +i for the inverse transform
+  arma_inline
+  static
+  cx_type
+  cx_rot(const cx_type& a)
+    {
+    return (inverse) ? cx_type( -a.imag(), a.real() ) : cx_type( a.imag(), -a.real() );
+    }
+  
+  
+  
+  
   arma_hot
   inline
   void
-  butterfly_3(cx_type* Y, const uword stride, const uword m)
+  butterfly_2(cx_type* Y, const cx_type* tw, const uword m) const
     {
     arma_extra_debug_sigprint();
     
-    arma_aligned cx_type tmp[5];
-    
-    cx_type* coeffs1 = coeffs_ptr();
-    cx_type* coeffs2 = coeffs1;
+    cx_type* Y0 = Y;
+    cx_type* Y1 = Y + m;
     
-    const T coeff_sm_imag = coeffs1[stride*m].imag();
+    for(uword i=0; i < m; ++i)
+      {
+      const cx_type a0 = Y0[i];
+      const cx_type a1 = cx_mul(Y1[i], tw[i]);
+      
+      Y0[i] = a0 + a1;
+      Y1[i] = a0 - a1;
+      }
+    }
+  
+  
+  
+  arma_hot
+  inline
+  void
+  butterfly_3(cx_type* Y, const cx_type* tw, const uword m) const
+    {
+    arma_extra_debug_sigprint();
     
-    const uword n = m*2;
+    // imaginary part of exp(-+2*pi*i/3)
+    const T sc = T( (inverse) ? +1 : -1 ) * T(0.86602540378443864676372317075294);
     
-    // TODO: rearrange the indices within tmp[] into a more sane order
+    cx_type* Y0 = Y;
+    cx_type* Y1 = Y + m;
+    cx_type* Y2 = Y + 2*m;
     
-    for(uword i = m; i > 0; --i)
+    for(uword i=0; i < m; ++i)
       {
-      tmp[1] = Y[m] * (*coeffs1);
-      tmp[2] = Y[n] * (*coeffs2);
-      
-      tmp[0]  = tmp[1] - tmp[2];
-      tmp[0] *= coeff_sm_imag;
-      
-      tmp[3] = tmp[1] + tmp[2];
-      
-      Y[m] = cx_type( (Y[0].real() - (T(0.5)*tmp[3].real())), (Y[0].imag() - (T(0.5)*tmp[3].imag())) );
+      const cx_type a0 = Y0[i];
+      const cx_type a1 = cx_mul(Y1[i], tw[2*i  ]);
+      const cx_type a2 = cx_mul(Y2[i], tw[2*i+1]);
       
-      Y[0] += tmp[3];
+      const cx_type s = a1 + a2;
+      const cx_type d = a1 - a2;
       
+      const cx_type t = a0 - T(0.5)*s;
+      const cx_type u = cx_type( -(sc * d.imag()), (sc * d.real()) );   // i*sc*d
       
-      Y[n] = cx_type( (Y[m].real() + tmp[0].imag()), (Y[m].imag() - tmp[0].real()) );
+      Y0[i] = a0 + s;
+      Y1[i] = t + u;
+      Y2[i] = t - u;
+      }
+    }
+  
+  
+  
+  arma_hot
+  inline
+  void
+  butterfly_4(cx_type* Y, const cx_type* tw, const uword m) const
+    {
+    arma_extra_debug_sigprint();
+    
+    cx_type* Y0 = Y;
+    cx_type* Y1 = Y + m;
+    cx_type* Y2 = Y + 2*m;
+    cx_type* Y3 = Y + 3*m;
+    
+    for(uword i=0; i < m; ++i)
+      {
+      const cx_type* w = &tw[3*i];
       
-      Y[m] += cx_type( -tmp[0].imag(), tmp[0].real() );
+      const cx_type a0 = Y0[i];
+      const cx_type a1 = cx_mul(Y1[i], w[0]);
+      const cx_type a2 = cx_mul(Y2[i], w[1]);
+      const cx_type a3 = cx_mul(Y3[i], w[2]);
       
-      Y++;
+      const cx_type b0 = a0 + a2;
+      const cx_type b1 = a0 - a2;
+      const cx_type b2 = a1 + a3;
+      const cx_type b3 = cx_rot(a1 - a3);
       
-      coeffs1 += stride;
-      coeffs2 += stride*2;
+      Y0[i] = b0 + b2;
+      Y1[i] = b1 + b3;
+      Y2[i] = b0 - b2;
+      Y3[i] = b1 - b3;
       }
     }
   
@@ -233,105 +477,125 @@ class fft_engine : public fft_store<cx_type, fixed_N, (fixed_N > 0)>
   arma_hot
   inline
   void
-  butterfly_4(cx_type* Y, const uword stride, const uword m)
+  butterfly_5(cx_type* Y, const cx_type* tw, const uword m) const
     {
     arma_extra_debug_sigprint();
     
-    arma_aligned cx_type tmp[7];
+    // exp(-+2*pi*i/5) and exp(-+4*pi*i/5)
+    const T s = T( (inverse) ? +1 : -1 );
     
-    const cx_type* coeffs = coeffs_ptr();
-    
-    const uword m2 = m*2;
-    const uword m3 = m*3;
+    const T a_real =     T(0.30901699437494742410229341718282);
+    const T a_imag = s * T(0.95105651629515357211643933337938);
+    const T b_real =    -T(0.80901699437494742410229341718282);
+    const T b_imag = s * T(0.58778525229247312916870595463907);
     
-    // TODO: rearrange the indices within tmp[] into a more sane order
+    cx_type* Y0 = Y;
+    cx_type* Y1 = Y + 1*m;
+    cx_type* Y2 = Y + 2*m;
+    cx_type* Y3 = Y + 3*m;
+    cx_type* Y4 = Y + 4*m;
     
     for(uword i=0; i < m; ++i)
       {
-      tmp[0] = Y[i + m ] * coeffs[i*stride  ];
-      tmp[2] = Y[i + m3] * coeffs[i*stride*3];
-      tmp[3] = tmp[0] + tmp[2];
+      const cx_type* w = &tw[4*i];
+      
+      const cx_type a0 = Y0[i];
+      const cx_type a1 = cx_mul(Y1[i], w[0]);
+      const cx_type a2 = cx_mul(Y2[i], w[1]);
+      const cx_type a3 = cx_mul(Y3[i], w[2]);
+      const cx_type a4 = cx_mul(Y4[i], w[3]);
       
-      //tmp[4] = tmp[0] - tmp[2];
-      //tmp[4] = (inverse) ? cx_type( -(tmp[4].imag()), tmp[4].real() ) : cx_type( tmp[4].imag(), -tmp[4].real() );
+      const cx_type s14 = a1 + a4;
+      const cx_type s23 = a2 + a3;
+      const cx_type d14 = a1 - a4;
+      const cx_type d23 = a2 - a3;
       
-      tmp[4] = (inverse)
-                 ? cx_type( (tmp[2].imag() - tmp[0].imag()), (tmp[0].real() - tmp[2].real()) )
-                 : cx_type( (tmp[0].imag() - tmp[2].imag()), (tmp[2].real() - tmp[0].real()) );
+      Y0[i] = a0 + s14 + s23;
       
-      tmp[1] = Y[i + m2] * coeffs[i*stride*2];
-      tmp[5] = Y[i] - tmp[1];
+      const cx_type t1 = a0 + a_real*s14 + b_real*s23;
+      const cx_type t2 = a0 + b_real*s14 + a_real*s23;
       
+      const cx_type u1 = cx_type( -(a_imag*d14.imag() + b_imag*d23.imag()),  (a_imag*d14.real() + b_imag*d23.real()) );   // i*(a_imag*d14 + b_imag*d23)
+      const cx_type u2 = cx_type( -(b_imag*d14.imag() - a_imag*d23.imag()),  (b_imag*d14.real() - a_imag*d23.real()) );   // i*(b_imag*d14 - a_imag*d23)
       
-      Y[i     ] += tmp[1];
-      Y[i + m2]  = Y[i] - tmp[3];
-      Y[i     ] += tmp[3];
-      Y[i + m ]  = tmp[5] + tmp[4];
-      Y[i + m3]  = tmp[5] - tmp[4];
+      Y1[i] = t1 + u1;
+      Y4[i] = t1 - u1;
+      Y2[i] = t2 + u2;
+      Y3[i] = t2 - u2;
       }
     }
   
   
   
-  inline
   arma_hot
+  inline
   void
-  butterfly_5(cx_type* Y, const uword stride, const uword m)
+  butterfly_8(cx_type* Y, const cx_type* tw, const uword m) const
     {
     arma_extra_debug_sigprint();
     
-    arma_aligned cx_type tmp[13];
-    
-    const cx_type* coeffs = coeffs_ptr();
-    
-    const T a_real = coeffs[stride*1*m].real();
-    const T a_imag = coeffs[stride*1*m].imag();
-    
-    const T b_real = coeffs[stride*2*m].real();
-    const T b_imag = coeffs[stride*2*m].imag();
+    const T c = T(0.70710678118654752440084436210485);   // 1/sqrt(2)
     
     cx_type* Y0 = Y;
     cx_type* Y1 = Y + 1*m;
     cx_type* Y2 = Y + 2*m;
     cx_type* Y3 = Y + 3*m;
     cx_type* Y4 = Y + 4*m;
+    cx_type* Y5 = Y + 5*m;
+    cx_type* Y6 = Y + 6*m;
+    cx_type* Y7 = Y + 7*m;
     
     for(uword i=0; i < m; ++i)
       {
-      tmp[0] = (*Y0);
+      const cx_type* w = &tw[7*i];
       
-      tmp[1] = (*Y1) * coeffs[stride*1*i];
-      tmp[2] = (*Y2) * coeffs[stride*2*i];
-      tmp[3] = (*Y3) * coeffs[stride*3*i];
-      tmp[4] = (*Y4) * coeffs[stride*4*i];
+      const cx_type a0 = Y0[i];
+      const cx_type a1 = cx_mul(Y1[i], w[0]);
+      const cx_type a2 = cx_mul(Y2[i], w[1]);
+      const cx_type a3 = cx_mul(Y3[i], w[2]);
+      const cx_type a4 = cx_mul(Y4[i], w[3]);
+      const cx_type a5 = cx_mul(Y5[i], w[4]);
+      const cx_type a6 = cx_mul(Y6[i], w[5]);
+      const cx_type a7 = cx_mul(Y7[i], w[6]);
       
-      tmp[7]  = tmp[1] + tmp[4];
-      tmp[8]  = tmp[2] + tmp[3];
-      tmp[9]  = tmp[2] - tmp[3];
-      tmp[10] = tmp[1] - tmp[4];
+      // radix 4 transforms of the even and odd elements
       
-      (*Y0) += tmp[7];
-      (*Y0) += tmp[8];
+      const cx_type e0 = a0 + a4;
+      const cx_type e1 = a0 - a4;
+      const cx_type e2 = a2 + a6;
+      const cx_type e3 = cx_rot(a2 - a6);
       
-      tmp[5] = tmp[0] + cx_type( ( (tmp[7].real() * a_real) + (tmp[8].real() * b_real) ), ( (tmp[7].imag() * a_real) + (tmp[8].imag() * b_real) ) );
+      const cx_type E0 = e0 + e2;
+      const cx_type E1 = e1 + e3;
+      const cx_type E2 = e0 - e2;
+      const cx_type E3 = e1 - e3;
       
-      tmp[6] =  cx_type( ( (tmp[10].imag() * a_imag) + (tmp[9].imag() * b_imag) ), ( -(tmp[10].real() * a_imag) - (tmp[9].real() * b_imag) ) );
+      const cx_type o0 = a1 + a5;
+      const cx_type o1 = a1 - a5;
+      const cx_type o2 = a3 + a7;
+      const cx_type o3 = cx_rot(a3 - a7);
       
-      (*Y1) = tmp[5] - tmp[6];
-      (*Y4) = tmp[5] + tmp[6];
+      const cx_type O0 = o0 + o2;
+      const cx_type O1 = o1 + o3;
+      const cx_type O2 = cx_rot(o0 - o2);
+      const cx_type O3 = o1 - o3;
       
-      tmp[11] = tmp[0] +  cx_type( ( (tmp[7].real() * b_real) + (tmp[8].real() * a_real) ), ( (tmp[7].imag() * b_real) + (tmp[8].imag() * a_real) ) );
+      // multiply by exp(-+2*pi*i*k/8), k = 1, 3 (k = 2 is included in O2 above)
       
-      tmp[12] = cx_type( ( -(tmp[10].imag() * b_imag) + (tmp[9].imag() * a_imag) ), (  (tmp[10].real() * b_imag) - (tmp[9].real() * a_imag) ) );
+      const cx_type O1r = cx_rot(O1);
+      const cx_type O3r = cx_rot(O3);
       
-      (*Y2) = tmp[11] + tmp[12];
-      (*Y3) = tmp[11] - tmp[12];
+      const cx_type P1 = c * (O1 + O1r);
+      const cx_type P3 = c * (O3r - O3);
       
-      Y0++;
-      Y1++;
-      Y2++;
-      Y3++;
-      Y4++;
+      Y0[i] = E0 + O0;
+      Y4[i] = E0 - O0;
+      Y1[i] = E1 + P1;
+      Y5[i] = E1 - P1;
+      Y2[i] = E2 + O2;
+      Y6[i] = E2 - O2;
+      Y3[i] = E3 + P3;
+      Y7[i] = E3 - P3;
       }
     }
   
@@ -340,13 +604,15 @@ class fft_engine : public fft_store<cx_type, fixed_N, (fixed_N > 0)>
   arma_hot
   inline
   void
-  butterfly_N(cx_type* Y, const uword stride, const uword m, const uword r)
+  butterfly_N(cx_type* Y, const uword stride, const uword m, const uword r) const
     {
     arma_extra_debug_sigprint();
     
     const cx_type* coeffs = coeffs_ptr();
     
-    tmp_array.set_min_size(r);
+    // local scratch, so that a single engine can be shared between threads;
+    // podarray uses preallocated storage for small radices
+    podarray<cx_type> tmp_array(r);
     cx_type* tmp = tmp_array.memptr();
     
     for(uword u=0; u < m; ++u)
@@ -373,7 +639,7 @@ class fft_engine : public fft_store<cx_type, fixed_N, (fixed_N > 0)>
           
           if(j >= N) { j -= N; }
           
-          Y[k] += tmp[w] * coeffs[j];
+          Y[k] += cx_mul(tmp[w], coeffs[j]);
           }
         
         k += m;
@@ -383,9 +649,62 @@ class fft_engine : public fft_store<cx_type, fixed_N, (fixed_N > 0)>
   
   
   
+  //! Bluestein algorithm: express the transform as a convolution with a chirp,
+  //! which is evaluated via transforms of power of 2 length
   inline
   void
-  run(cx_type* Y, const cx_type* X, const uword stage = 0, const uword stride = 1)
+  run_bluestein(cx_type* Y, const cx_type* X) const
+    {
+    arma_extra_debug_sigprint();
+    
+    podarray<cx_type> tmp_a(M);
+    podarray<cx_type> tmp_b(M);
+    
+    cx_type* a = tmp_a.memptr();
+    cx_type* b = tmp_b.memptr();
+    
+    const cx_type* chirp_mem     = chirp.memptr();
+    const cx_type* chirp_fft_mem = chirp_fft.memptr();
+    
+    for(uword n=0; n < N; ++n)  { a[n] = X[n] * chirp_mem[n]; }
+    
+    arrayops::fill_zeros(&a[N], M-N);
+    
+    sub_engine->run(b, a);
+    
+    // inverse transform via conjugation: ifft(x) = conj(fft(conj(x))) / M;
+    // the 1/M factor is included in chirp_fft
+    
+    for(uword i=0; i < M; ++i)  { b[i] = std::conj(b[i] * chirp_fft_mem[i]); }
+    
+    sub_engine->run(a, b);
+    
+    for(uword k=0; k < N; ++k)  { Y[k] = std::conj(a[k]) * chirp_mem[k]; }
+    }
+  
+  
+  
+  inline
+  void
+  run(cx_type* Y, const cx_type* X) const
+    {
+    arma_extra_debug_sigprint();
+    
+    if(M > 0)
+      {
+      run_bluestein(Y, X);
+      }
+    else
+      {
+      run_direct(Y, X, 0, 1);
+      }
+    }
+  
+  
+  
+  inline
+  void
+  run_direct(cx_type* Y, const cx_type* X, const uword stage, const uword stride) const
     {
     arma_extra_debug_sigprint();
     
@@ -403,15 +722,18 @@ class fft_engine : public fft_store<cx_type, fixed_N, (fixed_N > 0)>
       const uword next_stage  = stage + 1;
       const uword next_stride = stride * r;
       
-      for(cx_type* Yi = Y; Yi != Y_end; Yi += m, X += stride)  { run(Yi, X, next_stage, next_stride); }
+      for(cx_type* Yi = Y; Yi != Y_end; Yi += m, X += stride)  { run_direct(Yi, X, next_stage, next_stride); }
       }
     
+    const cx_type* tw = twiddles.memptr() + twiddles_offset[stage];
+    
     switch(r)
       {
-      case 2:  butterfly_2(Y, stride, m   );  break;
-      case 3:  butterfly_3(Y, stride, m   );  break;
-      case 4:  butterfly_4(Y, stride, m   );  break;
-      case 5:  butterfly_5(Y, stride, m   );  break;
+      case 2:  butterfly_2(Y, tw,     m   );  break;
+      case 3:  butterfly_3(Y, tw,     m   );  break;
+      case 4:  butterfly_4(Y, tw,     m   );  break;
+      case 5:  butterfly_5(Y, tw,     m   );  break;
+      case 8:  butterfly_8(Y, tw,     m   );  break;
       default: butterfly_N(Y, stride, m, r);  break;
       }
     }
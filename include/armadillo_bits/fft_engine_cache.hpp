@@ -0,0 +1,166 @@
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+//! \addtogroup fft_engine_cache
+//! @{
+
+
+//! cache of recently used FFT engines (plans), keyed by transform length;
+//! the element type, direction of the transform and type of engine are template parameters,
+//! so each combination has its own cache.
+//! engines are immutable once constructed and can be shared between threads.
+//! each cache holds at most max_n_entries engines, using at most max_n_bytes of memory in total;
+//! least recently used engines are evicted first, and engines larger than max_n_bytes are not cached.
+
+template<typename cx_type, bool inverse, typename engine_type = fft_engine<cx_type,inverse> >
+class fft_engine_cache
+  {
+  public:
+  
+  static constexpr uword max_n_entries = 16;
+  static constexpr uword max_n_bytes   = uword(64) * uword(1024) * uword(1024);
+  
+  
+  inline
+  static
+  std::shared_ptr<const engine_type>
+  get(const uword N)
+    {
+    arma_extra_debug_sigprint();
+    
+    #if defined(ARMA_DONT_USE_STD_MUTEX)
+      {
+      return std::make_shared<const engine_type>(N);
+      }
+    #else
+      {
+      std::vector<entry_type>& entries = get_entries();
+      
+        {
+        const std::lock_guard<std::mutex> lock( get_mutex() );
+        
+        const std::shared_ptr<const engine_type> engine = find(entries, N);
+        
+        if(engine)  { return engine; }
+        }
+      
+      // construct outside of the lock, so that plans for other lengths are not held up
+      
+      arma_extra_debug_print("fft_engine_cache::get(): constructing new engine");
+      
+      std::shared_ptr<const engine_type> new_engine = std::make_shared<const engine_type>(N);
+      
+      const std::lock_guard<std::mutex> lock( get_mutex() );
+      
+      // another thread may have inserted the same length in the meantime
+      
+      const std::shared_ptr<const engine_type> engine = find(entries, N);
+      
+      if(engine)  { return engine; }
+      
+      const uword new_n_bytes = new_engine->n_bytes();
+      
+      if(new_n_bytes > max_n_bytes)  { return new_engine; }
+      
+      uword total_n_bytes = new_n_bytes;
+      
+      for(size_t i=0; i < entries.size(); ++i)  { total_n_bytes += entries[i].n_bytes; }
+      
+      while( (entries.size() > 0) && ( (entries.size() >= max_n_entries) || (total_n_bytes > max_n_bytes) ) )
+        {
+        total_n_bytes -= entries.back().n_bytes;
+        
+        entries.pop_back();
+        }
+      
+      entry_type new_entry;
+      
+      new_entry.N       = N;
+      new_entry.n_bytes = new_n_bytes;
+      new_entry.engine  = new_engine;
+      
+      entries.insert(entries.begin(), new_entry);
+      
+      return new_engine;
+      }
+    #endif
+    }
+  
+  
+  
+  private:
+  
+  struct entry_type
+    {
+    uword                              N;
+    uword                              n_bytes;
+    std::shared_ptr<const engine_type> engine;
+    };
+  
+  
+  //! find engine for length N and move it to the front of the list (most recently used);
+  //! the caller must hold the mutex
+  inline
+  static
+  std::shared_ptr<const engine_type>
+  find(std::vector<entry_type>& entries, const uword N)
+    {
+    const uword n_entries = uword(entries.size());
+    
+    for(uword i=0; i < n_entries; ++i)
+      {
+      if(entries[i].N == N)
+        {
+        if(i > 0)  { std::rotate(entries.begin(), entries.begin() + i, entries.begin() + i + 1); }
+        
+        return entries[0].engine;
+        }
+      }
+    
+    return std::shared_ptr<const engine_type>();
+    }
+  
+  
+  
+  #if !defined(ARMA_DONT_USE_STD_MUTEX)
+  
+  inline
+  static
+  std::mutex&
+  get_mutex()
+    {
+    static std::mutex cache_mutex;
+    
+    return cache_mutex;
+    }
+  
+  #endif
+  
+  
+  
+  inline
+  static
+  std::vector<entry_type>&
+  get_entries()
+    {
+    static std::vector<entry_type> entries;
+    
+    return entries;
+    }
+  };
+
+
+//! @}
@@ -0,0 +1,186 @@
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+//! \addtogroup fft_engine_real
+//! @{
+
+
+//! FFT engine for real signals (forward transform) and real-valued results (inverse transform).
+//! for even N, the N real values are packed into N/2 complex values and transformed via an engine of length N/2,
+//! followed (or preceded, for the inverse transform) by a post-processing step with the twiddle factors exp(-+2*pi*i*k/N).
+//! for odd N (and N = 2), an engine of length N is used directly.
+
+template<typename cx_type, bool inverse>
+class fft_engine_real
+  {
+  public:
+  
+  typedef typename get_pod_type<cx_type>::result T;
+  
+  const uword N;
+  const uword N_half;
+  const bool  use_half;
+  
+  std::shared_ptr< const fft_engine<cx_type,inverse> > sub_engine;
+  
+  podarray<cx_type> coeffs;   //!< exp(-+2*pi*i*k/N), k = 0 .. N/2-1
+  
+  
+  inline
+  fft_engine_real(const uword in_N)
+    : N       (in_N                        )
+    , N_half  (in_N/2                      )
+    , use_half( (in_N >= 4) && ((in_N % 2) == 0) )
+    {
+    arma_extra_debug_sigprint();
+    
+    sub_engine = fft_engine_cache<cx_type,inverse>::get( (use_half) ? N_half : N );
+    
+    if(use_half == false)  { return; }
+    
+    coeffs.set_size(N_half);
+    
+    cx_type* coeffs_mem = coeffs.memptr();
+    
+    const T k = T( (inverse) ? +2 : -2 ) * std::acos( T(-1) ) / T(N);
+    
+    for(uword i=0; i < N_half; ++i)  { coeffs_mem[i] = std::exp( cx_type(T(0), i*k) ); }
+    }
+  
+  
+  
+  //! approximate amount of memory held by the engine;
+  //! the complex engine is included, as it is kept alive even if evicted from its own cache
+  inline
+  uword
+  n_bytes() const
+    {
+    return coeffs.n_elem * uword(sizeof(cx_type)) + ( (sub_engine) ? sub_engine->n_bytes() : uword(0) );
+    }
+  
+  
+  
+  //! forward transform of N real values in X; the full spectrum (N complex values) is written to Y;
+  //! buf is scratch space for N complex values
+  inline
+  void
+  run_r2c(cx_type* Y, const T* X, cx_type* buf) const
+    {
+    arma_extra_debug_sigprint();
+    
+    if(use_half == false)
+      {
+      for(uword i=0; i < N; ++i)  { buf[i] = cx_type(X[i], T(0)); }
+      
+      sub_engine->run(Y, buf);
+      
+      return;
+      }
+    
+    for(uword i=0; i < N_half; ++i)  { buf[i] = cx_type(X[2*i], X[2*i+1]); }
+    
+    sub_engine->run(Y, buf);
+    
+    // separate the transforms of the even and odd elements (E and O) and combine them;
+    // element k and element N/2-k of the half length transform are used by both outputs k and N/2-k
+    
+    const cx_type* w = coeffs.memptr();
+    
+    const cx_type Z0 = Y[0];
+    
+    Y[0     ] = cx_type( (Z0.real() + Z0.imag()), T(0) );
+    Y[N_half] = cx_type( (Z0.real() - Z0.imag()), T(0) );
+    
+    for(uword k=1; k <= (N_half/2); ++k)
+      {
+      const uword j = N_half - k;
+      
+      const cx_type a = Y[k];
+      const cx_type b = Y[j];
+      
+      const cx_type E = T(0.5) * (a + std::conj(b));
+      const cx_type D = T(0.5) * (a - std::conj(b));
+      const cx_type O = cx_type( D.imag(), -D.real() );   // O = -i*D
+      
+      Y[k] = E            + w[k] * O;
+      Y[j] = std::conj(E) + w[j] * std::conj(O);
+      }
+    
+    // the second half of the spectrum is the conjugate of the first half
+    
+    for(uword k=N_half+1; k < N; ++k)  { Y[k] = std::conj(Y[N-k]); }
+    }
+  
+  
+  
+  //! inverse transform (without the 1/N scaling) of the conjugate symmetric spectrum in X, writing N real values to Y;
+  //! only the first N/2+1 elements of X are used, and the imaginary parts of X[0] and X[N/2] (for even N) are ignored;
+  //! X has N elements and is used as scratch space; buf is scratch space for N complex values
+  inline
+  void
+  run_c2r(T* Y, cx_type* X, cx_type* buf) const
+    {
+    arma_extra_debug_sigprint();
+    
+    if(use_half == false)
+      {
+      X[0] = cx_type( X[0].real(), T(0) );
+      
+      for(uword k=(N/2)+1; k < N; ++k)  { X[k] = std::conj(X[N-k]); }
+      
+      sub_engine->run(buf, X);
+      
+      for(uword i=0; i < N; ++i)  { Y[i] = buf[i].real(); }
+      
+      return;
+      }
+    
+    // recombine into the transform of the packed even and odd elements: Z_k = E_k + i*O_k,
+    // with the scaling by 2 of the half length inverse transform folded in
+    
+    const cx_type* w = coeffs.memptr();
+    
+    const T x0 = X[0     ].real();
+    const T xh = X[N_half].real();
+    
+    X[0] = cx_type( (x0 + xh), (x0 - xh) );
+    
+    for(uword k=1; k <= (N_half/2); ++k)
+      {
+      const uword j = N_half - k;
+      
+      const cx_type a = X[k];
+      const cx_type b = X[j];
+      
+      const cx_type Dk = w[k] * (a - std::conj(b));
+      const cx_type Dj = w[j] * (b - std::conj(a));
+      
+      X[k] = (a + std::conj(b)) + cx_type( -Dk.imag(), Dk.real() );   // + i*Dk
+      X[j] = (b + std::conj(a)) + cx_type( -Dj.imag(), Dj.real() );   // + i*Dj
+      }
+    
+    sub_engine->run(buf, X);
+    
+    for(uword i=0; i < N_half; ++i)
+      {
+      Y[2*i  ] = buf[i].real();
+      Y[2*i+1] = buf[i].imag();
+      }
+    }
+  };
+
+
+//! @}
@@ -204,6 +204,8 @@ class field
   inline arma_cold bool quiet_load(const std::string   name, const file_type type = auto_detect);
   inline arma_cold bool quiet_load(      std::istream& is,   const file_type type = auto_detect);
   
+  inline arma_cold save_handle save_async(const std::string name, const file_type type = arma_binary) const;
+  
   
   // for container-like functionality
   
@@ -1874,6 +1874,21 @@ field<oT>::quiet_load(std::istream& is, const file_type type)
 
 
 
+//! save the object in the background;
+//! the object is copied before returning, so it can be modified or destroyed while the save is in progress
+template<typename oT>
+inline
+arma_cold
+save_handle
+field<oT>::save_async(const std::string name, const file_type type) const
+  {
+  arma_extra_debug_sigprint();
+  
+  return save_handle::launch( field<oT>(*this), name, type );
+  }
+
+
+
 //! construct a field from a given field
 template<typename oT>
 inline
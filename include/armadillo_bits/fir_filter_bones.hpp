@@ -0,0 +1,59 @@
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+//! \addtogroup fir_filter
+//! @{
+
+
+
+//! FIR filter with internal state, for processing a stream of samples in blocks.
+//! each column of the input is a separate channel; the state of each channel
+//! (the last n_taps-1 input samples) is kept between calls to process().
+template<typename eT>
+class fir_filter
+  {
+  public:
+  
+  inline ~fir_filter();
+  inline  fir_filter();
+  
+  template<typename T1> inline explicit fir_filter(const Base<eT,T1>& in_coeffs);
+  
+  template<typename T1> inline void set_coeffs(const Base<eT,T1>& in_coeffs);
+  
+  template<typename T1> inline void process(Mat<eT>& out, const Base<eT,T1>& in);
+  
+  inline void reset();
+  
+  inline const Col<eT>& coeffs()     const;
+  inline uword          n_channels() const;
+  
+  
+  private:
+  
+  arma_aligned Col<eT> h;       //!< filter coefficients (taps)
+  arma_aligned Col<eT> hh;      //!< flipped filter coefficients
+  arma_aligned Mat<eT> state;   //!< last n_taps-1 input samples of each channel, oldest first
+  arma_aligned Mat<eT> buf;     //!< work buffer for each channel, allocated once per number of channels
+  
+  static constexpr uword chunk_size = 1024;
+  
+  inline void process_cols(Mat<eT>& out, const Mat<eT>& in, const uword col_start, const uword col_end);
+  };
+
+
+
+//! @}
@@ -0,0 +1,239 @@
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+//! \addtogroup fir_filter
+//! @{
+
+
+
+template<typename eT>
+inline
+fir_filter<eT>::~fir_filter()
+  {
+  arma_extra_debug_sigprint_this(this);
+  }
+
+
+
+template<typename eT>
+inline
+fir_filter<eT>::fir_filter()
+  {
+  arma_extra_debug_sigprint_this(this);
+  }
+
+
+
+template<typename eT>
+template<typename T1>
+inline
+fir_filter<eT>::fir_filter(const Base<eT,T1>& in_coeffs)
+  {
+  arma_extra_debug_sigprint_this(this);
+  
+  set_coeffs(in_coeffs);
+  }
+
+
+
+//! set the filter coefficients and clear the state
+template<typename eT>
+template<typename T1>
+inline
+void
+fir_filter<eT>::set_coeffs(const Base<eT,T1>& in_coeffs)
+  {
+  arma_extra_debug_sigprint();
+  
+  const quasi_unwrap<T1> U(in_coeffs.get_ref());
+  
+  arma_debug_check( ((U.M.is_vec() == false) && (U.M.is_empty() == false)), "fir_filter::set_coeffs(): given object is not a vector" );
+  
+  h = vectorise(U.M);
+  
+  hh = flipud(h);
+  
+  reset();
+  }
+
+
+
+//! filter the given block of samples, continuing from the state left by the previous block;
+//! each column is a separate channel; out may be the same matrix as in
+template<typename eT>
+template<typename T1>
+inline
+void
+fir_filter<eT>::process(Mat<eT>& out, const Base<eT,T1>& in)
+  {
+  arma_extra_debug_sigprint();
+  
+  const quasi_unwrap<T1> U(in.get_ref());
+  
+  const Mat<eT>& X = U.M;
+  
+  // each chunk of input samples is copied to the work buffer before the corresponding outputs are written,
+  // so out can be the same matrix as the input; a temporary is only needed for a partial overlap
+  
+  const bool in_place = (X.memptr() == out.memptr()) && (X.n_rows == out.n_rows) && (X.n_cols == out.n_cols);
+  
+  if(U.is_alias(out) && (in_place == false))
+    {
+    Mat<eT> tmp;
+    
+    process(tmp, X);
+    
+    out.steal_mem(tmp);
+    
+    return;
+    }
+  
+  arma_debug_check( (h.n_elem == 0), "fir_filter::process(): filter coefficients not set" );
+  
+  if(state.n_cols != X.n_cols)
+    {
+    arma_debug_check( (state.n_cols > 0), "fir_filter::process(): number of channels differs from previous call" );
+    
+    const uword n_hist = h.n_elem - 1;
+    
+    state.zeros(n_hist, X.n_cols);
+    
+    buf.set_size(n_hist + (std::max)(uword(chunk_size), 4*n_hist), X.n_cols);
+    }
+  
+  if(in_place == false)  { out.set_size(X.n_rows, X.n_cols); }
+  
+  if(X.is_empty())  { return; }
+  
+  const uword n_cols = X.n_cols;
+  
+  #if defined(ARMA_USE_OPENMP)
+    {
+    if( (n_cols > 1) && mp_gate<eT>::eval(X.n_elem * h.n_elem) )
+      {
+      const uword n_threads = (std::min)( uword(mp_thread_limit::get()), n_cols );
+      
+      #pragma omp parallel for schedule(static) num_threads(int(n_threads))
+      for(uword t=0; t < n_threads; ++t)
+        {
+        const uword col_start = (t    * n_cols) / n_threads;
+        const uword col_end   = ((t+1) * n_cols) / n_threads;
+        
+        process_cols(out, X, col_start, col_end);
+        }
+      
+      return;
+      }
+    }
+  #endif
+  
+  process_cols(out, X, 0, n_cols);
+  }
+
+
+
+//! clear the state, as if all previous input samples were zero
+template<typename eT>
+inline
+void
+fir_filter<eT>::reset()
+  {
+  arma_extra_debug_sigprint();
+  
+  state.reset();
+  buf.reset();
+  }
+
+
+
+template<typename eT>
+inline
+const Col<eT>&
+fir_filter<eT>::coeffs() const
+  {
+  return h;
+  }
+
+
+
+template<typename eT>
+inline
+uword
+fir_filter<eT>::n_channels() const
+  {
+  return state.n_cols;
+  }
+
+
+
+template<typename eT>
+inline
+void
+fir_filter<eT>::process_cols(Mat<eT>& out, const Mat<eT>& in, const uword col_start, const uword col_end)
+  {
+  arma_extra_debug_sigprint();
+  
+  const uword n_taps    = hh.n_elem;
+  const uword n_hist    = n_taps - 1;
+  const uword n_samples = in.n_rows;
+  
+  const uword chunk_len = buf.n_rows - n_hist;
+  
+  const eT* hh_mem = hh.memptr();
+  
+  for(uword col=col_start; col < col_end; ++col)
+    {
+    const eT* x = in.colptr(col);
+          eT* y = out.colptr(col);
+          eT* s = state.colptr(col);
+    
+    // the buffer holds the n_hist samples preceding the current chunk, followed by the chunk,
+    // so that each output is a dot product with contiguous memory
+    
+    eT* buf_mem = buf.colptr(col);
+    
+    arrayops::copy(buf_mem, s, n_hist);
+    
+    uword n_last = 0;
+    
+    for(uword chunk_start=0; chunk_start < n_samples; chunk_start += chunk_len)
+      {
+      const uword n = (std::min)(chunk_len, n_samples - chunk_start);
+      
+      if(chunk_start > 0)
+        {
+        // keep the last n_hist samples of the previous chunk; chunk_len >= n_hist, hence no overlap
+        arrayops::copy(buf_mem, &buf_mem[n_last], n_hist);
+        }
+      
+      arrayops::copy(&buf_mem[n_hist], &x[chunk_start], n);
+      
+      eT* y_chunk = &y[chunk_start];
+      
+      for(uword i=0; i < n; ++i)  { y_chunk[i] = op_dot::direct_dot(n_taps, hh_mem, &buf_mem[i]); }
+      
+      n_last = n;
+      }
+    
+    // keep the last n_hist input samples
+    
+    arrayops::copy(s, &buf_mem[n_last], n_hist);
+    }
+  }
+
+
+
+//! @}
@@ -131,4 +131,40 @@ ifft(const T1& A, const uword N)
 
 
 
+template<typename T1>
+arma_warn_unused
+inline
+typename
+enable_if2
+  <
+  (is_arma_type<T1>::value && (is_cx_float<typename T1::elem_type>::yes || is_cx_double<typename T1::elem_type>::yes)),
+  const mtOp<typename T1::pod_type, T1, op_ifft_real>
+  >::result
+ifft_real(const T1& A)
+  {
+  arma_extra_debug_sigprint();
+  
+  return mtOp<typename T1::pod_type, T1, op_ifft_real>(A, uword(0), uword(1));
+  }
+
+
+
+template<typename T1>
+arma_warn_unused
+inline
+typename
+enable_if2
+  <
+  (is_arma_type<T1>::value && (is_cx_float<typename T1::elem_type>::yes || is_cx_double<typename T1::elem_type>::yes)),
+  const mtOp<typename T1::pod_type, T1, op_ifft_real>
+  >::result
+ifft_real(const T1& A, const uword N)
+  {
+  arma_extra_debug_sigprint();
+  
+  return mtOp<typename T1::pod_type, T1, op_ifft_real>(A, N, uword(0));
+  }
+
+
+
 //! @}
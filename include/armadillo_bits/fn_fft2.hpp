@@ -36,18 +36,13 @@ fft2(const T1& A)
   {
   arma_extra_debug_sigprint();
   
-  // not exactly efficient, but "better-than-nothing" implementation
-  
   typedef typename T1::pod_type T;
   
-  Mat< std::complex<T> > B = fft(A);
-  
-  // for square matrices, strans() will work out that an inplace transpose can be done,
-  // hence we can potentially avoid creating a temporary matrix
+  Mat< std::complex<T> > out;
   
-  B = strans(B);
+  op_fft_dim::apply_fft2(out, A);
   
-  return strans( fft(B) );
+  return out;
   }
 
 
@@ -90,18 +85,13 @@ ifft2(const T1& A)
   {
   arma_extra_debug_sigprint();
   
-  // not exactly efficient, but "better-than-nothing" implementation
-  
   typedef typename T1::pod_type T;
   
-  Mat< std::complex<T> > B = ifft(A);
-  
-  // for square matrices, strans() will work out that an inplace transpose can be done,
-  // hence we can potentially avoid creating a temporary matrix
+  Mat< std::complex<T> > out;
   
-  B = strans(B);
+  op_fft_dim::apply_ifft2(out, A);
   
-  return strans( ifft(B) );
+  return out;
   }
 
 
@@ -0,0 +1,74 @@
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+//! \addtogroup fn_fft3
+//! @{
+
+
+
+// 3D FFT & 3D IFFT
+
+
+
+template<typename T1>
+arma_warn_unused
+inline
+typename
+enable_if2
+  <
+  (is_real<typename T1::elem_type>::value || is_cx_float<typename T1::elem_type>::yes || is_cx_double<typename T1::elem_type>::yes),
+  Cube< std::complex<typename T1::pod_type> >
+  >::result
+fft3(const BaseCube<typename T1::elem_type,T1>& A)
+  {
+  arma_extra_debug_sigprint();
+  
+  typedef typename T1::pod_type T;
+  
+  Cube< std::complex<T> > out;
+  
+  op_fft_dim::apply_fft3(out, A.get_ref());
+  
+  return out;
+  }
+
+
+
+template<typename T1>
+arma_warn_unused
+inline
+typename
+enable_if2
+  <
+  (is_cx_float<typename T1::elem_type>::yes || is_cx_double<typename T1::elem_type>::yes),
+  Cube< std::complex<typename T1::pod_type> >
+  >::result
+ifft3(const BaseCube<typename T1::elem_type,T1>& A)
+  {
+  arma_extra_debug_sigprint();
+  
+  typedef typename T1::pod_type T;
+  
+  Cube< std::complex<T> > out;
+  
+  op_fft_dim::apply_ifft3(out, A.get_ref());
+  
+  return out;
+  }
+
+
+
+//! @}
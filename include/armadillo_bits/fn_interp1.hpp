@@ -19,148 +19,388 @@
 
 
 
+//! search structure for a grid of strictly increasing values;
+//! locates the interval [ XG[j], XG[j+1] ] containing a given value within the span of the grid
+template<typename eT>
+struct interp1_grid
+  {
+  const eT*   mem;
+  const uword N;
+  const eT    min_val;
+  const eT    max_val;
+  
+  bool uniform;     //!< grid is (approximately) uniformly spaced
+  eT   inv_delta;   //!< inverse of the spacing of a uniform grid
+  
+  
+  inline
+  interp1_grid(const eT* in_mem, const uword in_N)
+    : mem      (in_mem         )
+    , N        (in_N           )
+    , min_val  (in_mem[0]      )
+    , max_val  (in_mem[in_N-1] )
+    , uniform  (false          )
+    , inv_delta(eT(0)          )
+    {
+    arma_extra_debug_sigprint();
+    
+    // for a uniform grid, the position of a value can be computed directly;
+    // a deviation of up to 1% of the spacing means that at most one further step is needed
+    
+    const eT delta = (max_val - min_val) / eT(N-1);
+    
+    if(delta <= eT(0))  { return; }
+    
+    const eT tol = eT(0.01) * delta;
+    
+    for(uword i=1; i < N-1; ++i)
+      {
+      if( std::abs(mem[i] - (min_val + eT(i)*delta)) > tol )  { return; }
+      }
+    
+    uniform   = true;
+    inv_delta = eT(1) / delta;
+    }
+  
+  
+  //! position for a value of arbitrary order
+  arma_inline
+  uword
+  locate(const eT x) const
+    {
+    if(uniform)
+      {
+      uword j = (std::min)( uword( sword((x - min_val) * inv_delta) ), uword(N-2) );
+      
+      while( (j > 0) && (mem[j] > x) )  { --j; }
+      
+      return locate_from(x, j);
+      }
+    
+    // branch-free binary search for the last grid value not greater than x;
+    // x is not smaller than mem[0], so the search range never becomes empty
+    
+    const eT* base = mem;
+    
+    uword n = N;
+    
+    while(n > 1)
+      {
+      const uword half = n / 2;
+      
+      base = (base[half] <= x) ? (base + half) : base;
+      
+      n -= half;
+      }
+    
+    return (std::min)( uword(base - mem), uword(N-2) );
+    }
+  
+  
+  //! position for a value that is not smaller than mem[j]; used when the values are processed in ascending order
+  arma_inline
+  uword
+  locate_from(const eT x, uword j) const
+    {
+    while( ((j+2) < N) && (mem[j+1] <= x) )  { ++j; }
+    
+    return j;
+    }
+  };
+
+
+
+//! slopes (first derivatives) at the grid points XG, for the series stored in the columns of YG;
+//! method = 3: shape-preserving piecewise cubic Hermite (pchip);
+//! method = 4: cubic spline with not-a-knot end conditions
 template<typename eT>
 inline
 void
-interp1_helper_nearest(const Mat<eT>& XG, const Mat<eT>& YG, const Mat<eT>& XI, Mat<eT>& YI, const eT extrap_val)
+interp1_helper_slopes(Mat<eT>& D, const Mat<eT>& XG, const Mat<eT>& YG, const uword method)
   {
   arma_extra_debug_sigprint();
   
-  const eT XG_min = XG.min();
-  const eT XG_max = XG.max();
+  const uword N = XG.n_elem;
   
-  YI.copy_size(XI);
+  const eT* X = XG.memptr();
   
-  const eT* XG_mem = XG.memptr();
-  const eT* YG_mem = YG.memptr();
-  const eT* XI_mem = XI.memptr();
-        eT* YI_mem = YI.memptr();
+  D.set_size(YG.n_rows, YG.n_cols);
   
-  const uword NG = XG.n_elem;
-  const uword NI = XI.n_elem;
+  Col<eT> dx (N-1);
+  Col<eT> del(N-1);
   
-  uword best_j = 0;
+  for(uword k=0; k < N-1; ++k)  { dx[k] = X[k+1] - X[k]; }
   
-  for(uword i=0; i<NI; ++i)
+  if( (N == 2) || ((method == 4) && (N == 3)) )
     {
-    eT best_err = Datum<eT>::inf;
-    
-    const eT XI_val = XI_mem[i];
+    // line through 2 points, or parabola through 3 points
     
-    if((XI_val < XG_min) || (XI_val > XG_max))
+    for(uword c=0; c < YG.n_cols; ++c)
       {
-      YI_mem[i] = extrap_val;
+      const eT* Y = YG.colptr(c);
+            eT* S = D.colptr(c);
+      
+      const eT del0 = (Y[1] - Y[0]) / dx[0];
+      
+      if(N == 2)  { S[0] = del0;  S[1] = del0;  continue; }
+      
+      const eT del1 = (Y[2] - Y[1]) / dx[1];
+      
+      const eT a = (del1 - del0) / (X[2] - X[0]);
+      
+      S[0] = del0 - a*dx[0];
+      S[1] = del0 + a*dx[0];
+      S[2] = del0 + a*(dx[0] + eT(2)*dx[1]);
       }
-    else
+    
+    return;
+    }
+  
+  if(method == 3)
+    {
+    for(uword c=0; c < YG.n_cols; ++c)
       {
-      // XG and XI are guaranteed to be sorted in ascending manner,
-      // so start searching XG from last known optimum position 
+      const eT* Y = YG.colptr(c);
+            eT* S = D.colptr(c);
+      
+      for(uword k=0; k < N-1; ++k)  { del[k] = (Y[k+1] - Y[k]) / dx[k]; }
       
-      for(uword j=best_j; j<NG; ++j)
+      // interior points: weighted harmonic mean of the neighbouring secants, or zero at local extrema
+      
+      for(uword k=1; k < N-1; ++k)
         {
-        const eT tmp = XG_mem[j] - XI_val;
-        const eT err = (tmp >= eT(0)) ? tmp : -tmp;
+        const eT w1 = eT(2)*dx[k] + dx[k-1];
+        const eT w2 = dx[k] + eT(2)*dx[k-1];
         
-        if(err >= best_err)
+        S[k] = ( (del[k-1] * del[k]) > eT(0) ) ? ( (w1 + w2) / (w1/del[k-1] + w2/del[k]) ) : eT(0);
+        }
+      
+      // end points: three-point formula, adjusted to preserve shape
+      
+      for(uword end=0; end < 2; ++end)
+        {
+        const uword k  = (end == 0) ? uword(0) : (N-1);
+        const eT    h0 = (end == 0) ? dx [0]   : dx [N-2];
+        const eT    h1 = (end == 0) ? dx [1]   : dx [N-3];
+        const eT    d0 = (end == 0) ? del[0]   : del[N-2];
+        const eT    d1 = (end == 0) ? del[1]   : del[N-3];
+        
+        eT val = ( (eT(2)*h0 + h1)*d0 - h0*d1 ) / (h0 + h1);
+        
+        if( (val * d0) <= eT(0) )
           {
-          // error is going up, so we have found the optimum position
-          break;
+          val = eT(0);
           }
         else
+        if( ((d0 * d1) <= eT(0)) && (std::abs(val) > std::abs(eT(3)*d0)) )
           {
-          best_err = err;
-          best_j   = j;   // remember the optimum position
+          val = eT(3)*d0;
           }
+        
+        S[k] = val;
         }
+      }
+    
+    return;
+    }
+  
+  // cubic spline: solve the tridiagonal system for the slopes, with all series as right hand sides
+  
+  #if defined(ARMA_USE_LAPACK)
+    {
+    Col<eT> dl(N-1);
+    Col<eT> dd(N  );
+    Col<eT> du(N-1);
+    
+    const eT x31 = X[2]   - X[0];
+    const eT xn  = X[N-1] - X[N-3];
+    
+    dd[0] = dx[1];
+    du[0] = x31;
+    
+    for(uword k=1; k < N-1; ++k)
+      {
+      dl[k-1] = dx[k];
+      dd[k  ] = eT(2)*(dx[k-1] + dx[k]);
+      du[k  ] = dx[k-1];
+      }
+    
+    dl[N-2] = xn;
+    dd[N-1] = dx[N-3];
+    
+    for(uword c=0; c < YG.n_cols; ++c)
+      {
+      const eT* Y = YG.colptr(c);
+            eT* S = D.colptr(c);
+      
+      for(uword k=0; k < N-1; ++k)  { del[k] = (Y[k+1] - Y[k]) / dx[k]; }
+      
+      S[0] = ( (dx[0] + eT(2)*x31)*dx[1]*del[0] + dx[0]*dx[0]*del[1] ) / x31;
       
-      YI_mem[i] = YG_mem[best_j];
+      for(uword k=1; k < N-1; ++k)  { S[k] = eT(3)*(dx[k]*del[k-1] + dx[k-1]*del[k]); }
+      
+      S[N-1] = ( dx[N-2]*dx[N-2]*del[N-3] + (eT(2)*xn + dx[N-2])*dx[N-3]*del[N-2] ) / xn;
       }
+    
+    arma_debug_assert_blas_size(D);
+    
+    blas_int n    = blas_int(N);
+    blas_int nrhs = blas_int(D.n_cols);
+    blas_int ldb  = blas_int(D.n_rows);
+    blas_int info = blas_int(0);
+    
+    arma_extra_debug_print("lapack::gtsv()");
+    lapack::gtsv<eT>(&n, &nrhs, dl.memptr(), dd.memptr(), du.memptr(), D.memptr(), &ldb, &info);
+    
+    if(info != 0)  { D.fill(Datum<eT>::nan); }
+    }
+  #else
+    {
+    arma_stop_logic_error("interp1(): use of LAPACK must be enabled for spline interpolation");
     }
+  #endif
   }
 
 
 
+//! interpolation weights for position x within interval j of the grid:
+//! the interpolated value is w[0]*Y[j] + w[1]*Y[j+1] + w[2]*D[j] + w[3]*D[j+1]
+template<typename eT>
+arma_inline
+void
+interp1_helper_weights(eT* w, const eT* XG_mem, const uword j, const eT x, const uword method)
+  {
+  const eT x0 = XG_mem[j  ];
+  const eT x1 = XG_mem[j+1];
+  
+  if(method == 1)
+    {
+    const bool left = ( (x - x0) <= (x1 - x) );
+    
+    w[0] = (left) ? eT(1) : eT(0);
+    w[1] = (left) ? eT(0) : eT(1);
+    w[2] = eT(0);
+    w[3] = eT(0);
+    
+    return;
+    }
+  
+  const eT h = x1 - x0;
+  const eT t = (x - x0) / h;
+  
+  if(method == 2)
+    {
+    w[0] = eT(1) - t;
+    w[1] = t;
+    w[2] = eT(0);
+    w[3] = eT(0);
+    
+    return;
+    }
+  
+  // cubic Hermite basis
+  
+  const eT s = eT(1) - t;
+  
+  w[0] = (eT(1) + eT(2)*t) * s * s;
+  w[1] = t * t * (eT(3) - eT(2)*t);
+  w[2] = h * t * s * s;
+  w[3] = -h * t * t * s;
+  }
+
+
+
+//! interpolate the queries [start, end)
 template<typename eT>
 inline
 void
-interp1_helper_linear(const Mat<eT>& XG, const Mat<eT>& YG, const Mat<eT>& XI, Mat<eT>& YI, const eT extrap_val)
+interp1_helper_range(const interp1_grid<eT>& grid, const eT* YG_mem, const eT* DG_mem, const eT* XI_mem, eT* YI_mem, const uword method, const bool XI_is_sorted, const eT extrap_val, const uword start, const uword end)
   {
   arma_extra_debug_sigprint();
   
-  const eT XG_min = XG.min();
-  const eT XG_max = XG.max();
+  uword j = 0;
+  bool  j_valid = false;
+  
+  eT w[4];
+  
+  for(uword i=start; i < end; ++i)
+    {
+    const eT x = XI_mem[i];
+    
+    if(arma_isnan(x))  { YI_mem[i] = Datum<eT>::nan; continue; }
+    
+    if( (x < grid.min_val) || (x > grid.max_val) )  { YI_mem[i] = extrap_val; continue; }
+    
+    // for sorted queries, the grid is traversed once (merge);
+    // otherwise each query is located via direct computation (uniform grid) or binary search
+    
+    j = (XI_is_sorted && j_valid && (x >= grid.mem[j])) ? grid.locate_from(x, j) : grid.locate(x);
+    
+    j_valid = true;
+    
+    interp1_helper_weights(w, grid.mem, j, x, method);
+    
+    eT val = w[0]*YG_mem[j] + w[1]*YG_mem[j+1];
+    
+    if(method >= 3)  { val += w[2]*DG_mem[j] + w[3]*DG_mem[j+1]; }
+    
+    YI_mem[i] = val;
+    }
+  }
+
+
+
+//! XG must be strictly increasing
+template<typename eT>
+inline
+void
+interp1_helper_eval(const Mat<eT>& XG, const Mat<eT>& YG, const Mat<eT>& XI, Mat<eT>& YI, const uword method, const eT extrap_val)
+  {
+  arma_extra_debug_sigprint();
+  
+  const interp1_grid<eT> grid(XG.memptr(), XG.n_elem);
+  
+  Mat<eT> DG;
+  
+  if(method >= 3)
+    {
+    const Mat<eT> YG_col(const_cast<eT*>(YG.memptr()), YG.n_elem, 1, false, true);
+    
+    interp1_helper_slopes(DG, XG, YG_col, method);
+    }
   
   YI.copy_size(XI);
   
-  const eT* XG_mem = XG.memptr();
+  const uword NI = XI.n_elem;
+  
+  const bool XI_is_sorted = XI.is_sorted();
+  
   const eT* YG_mem = YG.memptr();
+  const eT* DG_mem = DG.memptr();
   const eT* XI_mem = XI.memptr();
         eT* YI_mem = YI.memptr();
   
-  const uword NG = XG.n_elem;
-  const uword NI = XI.n_elem;
-  
-  uword a_best_j = 0;
-  uword b_best_j = 0;
-  
-  for(uword i=0; i<NI; ++i)
+  #if defined(ARMA_USE_OPENMP)
     {
-    const eT XI_val = XI_mem[i];
-    
-    if((XI_val < XG_min) || (XI_val > XG_max))
-      {
-      YI_mem[i] = extrap_val;
-      }
-    else
+    if( (NI > 1) && mp_gate<eT>::eval(NI) )
       {
-      // XG and XI are guaranteed to be sorted in ascending manner,
-      // so start searching XG from last known optimum position 
-      
-      eT a_best_err = Datum<eT>::inf;
-      eT b_best_err = Datum<eT>::inf;
-      
-      for(uword j=a_best_j; j<NG; ++j)
-        {
-        const eT tmp = XG_mem[j] - XI_val;
-        const eT err = (tmp >= eT(0)) ? tmp : -tmp;
-        
-        if(err >= a_best_err)
-          {
-          break;
-          }
-        else
-          {
-          a_best_err = err;
-          a_best_j   = j;
-          }
-        }
+      const uword n_threads = (std::min)( uword(mp_thread_limit::get()), NI );
       
-      if( (XG_mem[a_best_j] - XI_val) <= eT(0) )
+      #pragma omp parallel for schedule(static) num_threads(int(n_threads))
+      for(uword t=0; t < n_threads; ++t)
         {
-        // a_best_j is to the left of the interpolated position
+        const uword start = (t    * NI) / n_threads;
+        const uword end   = ((t+1) * NI) / n_threads;
         
-        b_best_j = ( (a_best_j+1) < NG) ? (a_best_j+1) : a_best_j; 
-        }
-      else
-        {
-        // a_best_j is to the right of the interpolated position
-        
-        b_best_j = (a_best_j >= 1) ? (a_best_j-1) : a_best_j; 
-        }
-      
-      b_best_err = std::abs( XG_mem[b_best_j] - XI_val );
-      
-      if(a_best_j > b_best_j)
-        {
-        std::swap(a_best_j,   b_best_j  );
-        std::swap(a_best_err, b_best_err);
+        interp1_helper_range(grid, YG_mem, DG_mem, XI_mem, YI_mem, method, XI_is_sorted, extrap_val, start, end);
         }
       
-      const eT weight = (a_best_err > eT(0)) ? (a_best_err / (a_best_err + b_best_err)) : eT(0);
-      
-      YI_mem[i] = (eT(1) - weight)*YG_mem[a_best_j] + (weight)*YG_mem[b_best_j];
+      return;
       }
     }
+  #endif
+  
+  interp1_helper_range(grid, YG_mem, DG_mem, XI_mem, YI_mem, method, XI_is_sorted, extrap_val, 0, NI);
   }
 
 
@@ -179,13 +419,27 @@ interp1_helper(const Mat<eT>& X, const Mat<eT>& Y, const Mat<eT>& XI, Mat<eT>& Y
   arma_debug_check( (X.n_elem < 2), "interp1(): X must have at least two unique elements" );
   
   // sig = 10: nearest neighbour
-  // sig = 11: nearest neighbour, assume monotonic increase in X and XI
+  // sig = 11: nearest neighbour, assume monotonic increase in X
   // 
   // sig = 20: linear
-  // sig = 21: linear, assume monotonic increase in X and XI
+  // sig = 21: linear, assume monotonic increase in X
+  // 
+  // sig = 30: cubic (pchip)
+  // sig = 31: cubic (pchip), assume monotonic increase in X
+  // 
+  // sig = 40: spline
+  // sig = 41: spline, assume monotonic increase in X
+  
+  const uword method = sig / 10;
+  
+  // is_sorted() doesn't detect NaN, as comparisons with NaN are always false
   
-  if(sig == 11)  { interp1_helper_nearest(X, Y, XI, YI, extrap_val); return; }
-  if(sig == 21)  { interp1_helper_linear (X, Y, XI, YI, extrap_val); return; }
+  if( ((sig % 10) == 1) || ((X.has_nan() == false) && X.is_sorted("strictascend")) )
+    {
+    interp1_helper_eval(X, Y, XI, YI, method, extrap_val);
+    
+    return;
+    }
   
   uvec X_indices;
   
@@ -217,57 +471,7 @@ interp1_helper(const Mat<eT>& X, const Mat<eT>& Y, const Mat<eT>& XI, Mat<eT>& Y
     Y_sanitised_mem[i] = Y_mem[j];
     }
   
-  
-  Mat<eT> XI_tmp;
-  uvec    XI_indices;
-  
-  const bool XI_is_sorted = XI.is_sorted();
-  
-  if(XI_is_sorted == false)
-    {
-    XI_indices = sort_index(XI);
-    
-    const uword N = XI.n_elem;
-    
-    XI_tmp.copy_size(XI);
-    
-    const uword* XI_indices_mem = XI_indices.memptr();
-    
-    const eT* XI_mem     = XI.memptr();
-          eT* XI_tmp_mem = XI_tmp.memptr();
-    
-    for(uword i=0; i<N; ++i)
-      {
-      XI_tmp_mem[i] = XI_mem[ XI_indices_mem[i] ];
-      }
-    }
-  
-  const Mat<eT>& XI_sorted = (XI_is_sorted) ? XI : XI_tmp;
-  
-  
-       if(sig == 10)  { interp1_helper_nearest(X_sanitised, Y_sanitised, XI_sorted, YI, extrap_val); }
-  else if(sig == 20)  { interp1_helper_linear (X_sanitised, Y_sanitised, XI_sorted, YI, extrap_val); }
-  
-  
-  if( (XI_is_sorted == false) && (YI.n_elem > 0) )
-    {
-    Mat<eT> YI_unsorted;
-    
-    YI_unsorted.copy_size(YI);
-    
-    const eT* YI_mem          = YI.memptr();
-          eT* YI_unsorted_mem = YI_unsorted.memptr();
-    
-    const uword  N              = XI_sorted.n_elem;
-    const uword* XI_indices_mem = XI_indices.memptr();
-    
-    for(uword i=0; i<N; ++i)
-      {
-      YI_unsorted_mem[ XI_indices_mem[i] ] = YI_mem[i];
-      }
-    
-    YI.steal_mem(YI_unsorted);
-    }
+  interp1_helper_eval(X_sanitised, Y_sanitised, XI, YI, method, extrap_val);
   }
 
 
@@ -305,10 +509,16 @@ interp1
     
          if(c1 == 'n')  { sig = 10; }  // nearest neighbour
     else if(c1 == 'l')  { sig = 20; }  // linear
+    else if(c1 == 'c')  { sig = 30; }  // cubic
+    else if(c1 == 'p')  { sig = 30; }  // pchip (same as cubic)
+    else if(c1 == 's')  { sig = 40; }  // spline
     else
       {
-      if( (c1 == '*') && (c2 == 'n') )  { sig = 11; }  // nearest neighour, assume monotonic increase in X and XI
-      if( (c1 == '*') && (c2 == 'l') )  { sig = 21; }  // linear, assume monotonic increase in X and XI
+      if( (c1 == '*') && (c2 == 'n') )  { sig = 11; }  // nearest neighour, assume monotonic increase in X
+      if( (c1 == '*') && (c2 == 'l') )  { sig = 21; }  // linear, assume monotonic increase in X
+      if( (c1 == '*') && (c2 == 'c') )  { sig = 31; }  // cubic, assume monotonic increase in X
+      if( (c1 == '*') && (c2 == 'p') )  { sig = 31; }  // pchip, assume monotonic increase in X
+      if( (c1 == '*') && (c2 == 's') )  { sig = 41; }  // spline, assume monotonic increase in X
       }
     }
   
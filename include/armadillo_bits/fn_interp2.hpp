@@ -19,65 +19,78 @@
 
 
 
+//! mode 0: interpolate columns [start, end) of ZG
 template<typename eT>
 inline
 void
-interp2_helper_nearest(const Mat<eT>& XG, const Mat<eT>& ZG, const Mat<eT>& XI, Mat<eT>& ZI, const eT extrap_val, const uword mode)
+interp2_helper_mode0_range(const Mat<eT>& ZG, const Mat<eT>& D, Mat<eT>& ZI, const uvec& pos, const Mat<eT>& W, const eT* XI_mem, const uword N, const uword method, const eT extrap_val, const uword start, const uword end)
   {
   arma_extra_debug_sigprint();
   
-  const eT XG_min = XG.min();
-  const eT XG_max = XG.max();
+  const uword NI = ZI.n_rows;
   
-  // mode = 0: interpolate across rows     (eg. expand in vertical   direction)
-  // mode = 1: interpolate across columns  (eg. expand in horizontal direction)
-  
-  if(mode == 0)  { ZI.set_size(XI.n_elem, ZG.n_cols); }
-  if(mode == 1)  { ZI.set_size(ZG.n_rows, XI.n_elem); }
-  
-  const eT* XG_mem = XG.memptr();
-  const eT* XI_mem = XI.memptr();
-  
-  const uword NG = XG.n_elem;
-  const uword NI = XI.n_elem;
+  for(uword c=start; c < end; ++c)
+    {
+    const eT* Z_mem = ZG.colptr(c);
+    const eT* D_mem = (method >= 3) ? D.colptr(c) : nullptr;
+          eT* out   = ZI.colptr(c);
+    
+    for(uword i=0; i < NI; ++i)
+      {
+      const uword j = pos[i];
+      
+      if(j == N)  { out[i] = (arma_isnan(XI_mem[i])) ? Datum<eT>::nan : extrap_val; continue; }
+      
+      const eT* w = W.colptr(i);
+      
+      eT val = w[0]*Z_mem[j] + w[1]*Z_mem[j+1];
+      
+      if(method >= 3)  { val += w[2]*D_mem[j] + w[3]*D_mem[j+1]; }
+      
+      out[i] = val;
+      }
+    }
+  }
+
+
+
+//! mode 1: interpolate columns [start, end) of ZI
+template<typename eT>
+inline
+void
+interp2_helper_mode1_range(const Mat<eT>& ZG, const Mat<eT>& D, Mat<eT>& ZI, const uvec& pos, const Mat<eT>& W, const eT* XI_mem, const uword N, const uword method, const eT extrap_val, const uword start, const uword end)
+  {
+  arma_extra_debug_sigprint();
   
-  uword best_j = 0;
+  const uword n_rows = ZI.n_rows;
   
-  for(uword i=0; i<NI; ++i)
+  for(uword i=start; i < end; ++i)
     {
-    eT best_err = Datum<eT>::inf;
+    const uword j = pos[i];
     
-    const eT XI_val = XI_mem[i];
+    eT* out = ZI.colptr(i);
     
-    if((XI_val < XG_min) || (XI_val > XG_max))
+    if(j == N)
       {
-      if(mode == 0)  { ZI.row(i).fill(extrap_val); }
-      if(mode == 1)  { ZI.col(i).fill(extrap_val); }
+      arrayops::inplace_set(out, ((arma_isnan(XI_mem[i])) ? Datum<eT>::nan : extrap_val), n_rows);
+      continue;
       }
-    else
+    
+    const eT* w = W.colptr(i);
+    
+    const eT* Z0 = ZG.colptr(j  );
+    const eT* Z1 = ZG.colptr(j+1);
+    
+    if(method >= 3)
       {
-      // XG and XI are guaranteed to be sorted in ascending manner,
-      // so start searching XG from last known optimum position 
-      
-      for(uword j=best_j; j<NG; ++j)
-        {
-        const eT tmp = XG_mem[j] - XI_val;
-        const eT err = (tmp >= eT(0)) ? tmp : -tmp;
-        
-        if(err >= best_err)
-          {
-          // error is going up, so we have found the optimum position
-          break;
-          }
-        else
-          {
-          best_err = err;
-          best_j   = j;   // remember the optimum position
-          }
-        }
+      const eT* D0 = D.colptr(j  );
+      const eT* D1 = D.colptr(j+1);
       
-      if(mode == 0)  { ZI.row(i) = ZG.row(best_j); }
-      if(mode == 1)  { ZI.col(i) = ZG.col(best_j); }
+      for(uword r=0; r < n_rows; ++r)  { out[r] = w[0]*Z0[r] + w[1]*Z1[r] + w[2]*D0[r] + w[3]*D1[r]; }
+      }
+    else
+      {
+      for(uword r=0; r < n_rows; ++r)  { out[r] = w[0]*Z0[r] + w[1]*Z1[r]; }
       }
     }
   }
@@ -87,88 +100,95 @@ interp2_helper_nearest(const Mat<eT>& XG, const Mat<eT>& ZG, const Mat<eT>& XI,
 template<typename eT>
 inline
 void
-interp2_helper_linear(const Mat<eT>& XG, const Mat<eT>& ZG, const Mat<eT>& XI, Mat<eT>& ZI, const eT extrap_val, const uword mode)
+interp2_helper(const Mat<eT>& XG, const Mat<eT>& ZG, const Mat<eT>& XI, Mat<eT>& ZI, const uword method, const eT extrap_val, const uword mode)
   {
   arma_extra_debug_sigprint();
   
-  const eT XG_min = XG.min();
-  const eT XG_max = XG.max();
-  
   // mode = 0: interpolate across rows     (eg. expand in vertical   direction)
   // mode = 1: interpolate across columns  (eg. expand in horizontal direction)
   
-  if(mode == 0)  { ZI.set_size(XI.n_elem, ZG.n_cols); }
-  if(mode == 1)  { ZI.set_size(ZG.n_rows, XI.n_elem); }
+  // method = 1: nearest neighbour
+  // method = 2: linear
+  // method = 3: cubic (pchip)
+  // method = 4: spline
   
-  const eT* XG_mem = XG.memptr();
-  const eT* XI_mem = XI.memptr();
-  
-  const uword NG = XG.n_elem;
   const uword NI = XI.n_elem;
   
-  uword a_best_j = 0;
-  uword b_best_j = 0;
+  const interp1_grid<eT> grid(XG.memptr(), XG.n_elem);
+  
+  // the position and weights of each query depend only on XI, so they are shared by all rows or columns
+  
+  uvec    pos(NI);
+  Mat<eT> W(4, NI);
+  
+  const eT* XI_mem = XI.memptr();
   
-  for(uword i=0; i<NI; ++i)
+  for(uword i=0; i < NI; ++i)
     {
-    const eT XI_val = XI_mem[i];
+    const eT x = XI_mem[i];
     
-    if((XI_val < XG_min) || (XI_val > XG_max))
+    if( arma_isnan(x) || (x < grid.min_val) || (x > grid.max_val) )
       {
-      if(mode == 0)  { ZI.row(i).fill(extrap_val); }
-      if(mode == 1)  { ZI.col(i).fill(extrap_val); }
+      pos[i] = grid.N;  // marker for out of range
+      
+      continue;
+      }
+    
+    const bool use_prev = (i > 0) && (pos[i-1] < grid.N) && (x >= grid.mem[pos[i-1]]);
+    
+    pos[i] = (use_prev) ? grid.locate_from(x, pos[i-1]) : grid.locate(x);
+    
+    interp1_helper_weights(W.colptr(i), grid.mem, pos[i], x, method);
+    }
+  
+  Mat<eT> D;
+  
+  if(method >= 3)
+    {
+    if(mode == 0)
+      {
+      interp1_helper_slopes(D, XG, ZG, method);
       }
     else
       {
-      // XG and XI are guaranteed to be sorted in ascending manner,
-      // so start searching XG from last known optimum position 
+      Mat<eT> DT;
       
-      eT a_best_err = Datum<eT>::inf;
-      eT b_best_err = Datum<eT>::inf;
+      interp1_helper_slopes(DT, XG, Mat<eT>(ZG.t()), method);
       
-      for(uword j=a_best_j; j<NG; ++j)
-        {
-        const eT tmp = XG_mem[j] - XI_val;
-        const eT err = (tmp >= eT(0)) ? tmp : -tmp;
-        
-        if(err >= a_best_err)
-          {
-          break;
-          }
-        else
-          {
-          a_best_err = err;
-          a_best_j   = j;
-          }
-        }
+      op_strans::apply_mat_noalias(D, DT);
+      }
+    }
+  
+  if(mode == 0)  { ZI.set_size(NI, ZG.n_cols); }
+  if(mode == 1)  { ZI.set_size(ZG.n_rows, NI); }
+  
+  // mode 0 is split across the columns of ZG; mode 1 is split across the queries
+  
+  const uword n_tasks = (mode == 0) ? ZG.n_cols : NI;
+  
+  #if defined(ARMA_USE_OPENMP)
+    {
+    if( (n_tasks > 1) && mp_gate<eT>::eval(ZI.n_elem) )
+      {
+      const uword n_threads = (std::min)( uword(mp_thread_limit::get()), n_tasks );
       
-      if( (XG_mem[a_best_j] - XI_val) <= eT(0) )
-        {
-        // a_best_j is to the left of the interpolated position
-        
-        b_best_j = ( (a_best_j+1) < NG) ? (a_best_j+1) : a_best_j; 
-        }
-      else
+      #pragma omp parallel for schedule(static) num_threads(int(n_threads))
+      for(uword t=0; t < n_threads; ++t)
         {
-        // a_best_j is to the right of the interpolated position
+        const uword start = (t    * n_tasks) / n_threads;
+        const uword end   = ((t+1) * n_tasks) / n_threads;
         
-        b_best_j = (a_best_j >= 1) ? (a_best_j-1) : a_best_j; 
-        }
-      
-      b_best_err = std::abs( XG_mem[b_best_j] - XI_val );
-      
-      if(a_best_j > b_best_j)
-        {
-        std::swap(a_best_j,   b_best_j  );
-        std::swap(a_best_err, b_best_err);
+        if(mode == 0)  { interp2_helper_mode0_range(ZG, D, ZI, pos, W, XI_mem, grid.N, method, extrap_val, start, end); }
+        if(mode == 1)  { interp2_helper_mode1_range(ZG, D, ZI, pos, W, XI_mem, grid.N, method, extrap_val, start, end); }
         }
       
-      const eT weight = (a_best_err > eT(0)) ? (a_best_err / (a_best_err + b_best_err)) : eT(0);
-      
-      if(mode == 0)  { ZI.row(i) = (eT(1) - weight)*ZG.row(a_best_j) + (weight)*ZG.row(b_best_j); }
-      if(mode == 1)  { ZI.col(i) = (eT(1) - weight)*ZG.col(a_best_j) + (weight)*ZG.col(b_best_j); }
+      return;
       }
     }
+  #endif
+  
+  if(mode == 0)  { interp2_helper_mode0_range(ZG, D, ZI, pos, W, XI_mem, grid.N, method, extrap_val, 0, n_tasks); }
+  if(mode == 1)  { interp2_helper_mode1_range(ZG, D, ZI, pos, W, XI_mem, grid.N, method, extrap_val, 0, n_tasks); }
   }
 
 
@@ -195,7 +215,15 @@ interp2
   
   const char sig = (method != nullptr) ? method[0] : char(0);
   
-  arma_debug_check( ((sig != 'n') && (sig != 'l')), "interp2(): unsupported interpolation type" ); 
+  uword method_id = 0;
+  
+       if(sig == 'n')  { method_id = 1; }  // nearest neighbour
+  else if(sig == 'l')  { method_id = 2; }  // linear
+  else if(sig == 'c')  { method_id = 3; }  // cubic
+  else if(sig == 'p')  { method_id = 3; }  // pchip (same as cubic)
+  else if(sig == 's')  { method_id = 4; }  // spline
+  
+  arma_debug_check( (method_id == 0), "interp2(): unsupported interpolation type" ); 
   
   const quasi_unwrap<T1> UXG(  X.get_ref() );
   const quasi_unwrap<T2> UYG(  Y.get_ref() );
@@ -215,45 +243,24 @@ interp2
   arma_debug_check( (UXG.M.n_elem != UZG.M.n_cols), "interp2(): number of elements in X must equal the number of columns in Z" );
   arma_debug_check( (UYG.M.n_elem != UZG.M.n_rows), "interp2(): number of elements in Y must equal the number of rows in Z"    );
   
-  arma_debug_check( (UXG.M.is_sorted("strictascend") == false), "interp2(): X must be monotonically increasing" );
-  arma_debug_check( (UYG.M.is_sorted("strictascend") == false), "interp2(): Y must be monotonically increasing" );
-  
-  arma_debug_check( (UXI.M.is_sorted("strictascend") == false), "interp2(): XI must be monotonically increasing" );
-  arma_debug_check( (UYI.M.is_sorted("strictascend") == false), "interp2(): YI must be monotonically increasing" );
+  arma_debug_check( ((UXG.M.is_sorted("strictascend") == false) || UXG.M.has_nan()), "interp2(): X must be monotonically increasing" );
+  arma_debug_check( ((UYG.M.is_sorted("strictascend") == false) || UYG.M.has_nan()), "interp2(): Y must be monotonically increasing" );
   
   Mat<eT> tmp;
   
+  interp2_helper(UYG.M, UZG.M, UYI.M, tmp, method_id, extrap_val, 0);
+  
   if( UXG.is_alias(ZI) || UXI.is_alias(ZI) )
     {
     Mat<eT> out;
     
-    if(sig == 'n')
-      {
-      interp2_helper_nearest(UYG.M, UZG.M, UYI.M, tmp, extrap_val, 0);
-      interp2_helper_nearest(UXG.M, tmp,   UXI.M, out, extrap_val, 1);
-      }
-    else
-    if(sig == 'l')
-      {
-      interp2_helper_linear(UYG.M, UZG.M, UYI.M, tmp, extrap_val, 0);
-      interp2_helper_linear(UXG.M, tmp,   UXI.M, out, extrap_val, 1);
-      }
+    interp2_helper(UXG.M, tmp, UXI.M, out, method_id, extrap_val, 1);
     
     ZI.steal_mem(out);
     }
   else
     {
-    if(sig == 'n')
-      {
-      interp2_helper_nearest(UYG.M, UZG.M, UYI.M, tmp, extrap_val, 0);
-      interp2_helper_nearest(UXG.M, tmp,   UXI.M,  ZI, extrap_val, 1);
-      }
-    else
-    if(sig == 'l')
-      {
-      interp2_helper_linear(UYG.M, UZG.M, UYI.M, tmp, extrap_val, 0);
-      interp2_helper_linear(UXG.M, tmp,   UXI.M,  ZI, extrap_val, 1);
-      }
+    interp2_helper(UXG.M, tmp, UXI.M, ZI, method_id, extrap_val, 1);
     }
   }
 
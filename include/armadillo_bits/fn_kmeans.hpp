@@ -54,4 +54,117 @@ kmeans
 
 
 
+//! mini-batch k-means; each iteration uses a batch of samples drawn at random from the given data
+template<typename T1>
+inline
+typename enable_if2<is_real<typename T1::elem_type>::value, bool>::result
+kmeans_minibatch
+  (
+         Mat<typename T1::elem_type>&    means,
+  const Base<typename T1::elem_type,T1>& data,
+  const uword                            k,
+  const gmm_seed_mode&                   seed_mode,
+  const uword                            n_iter,
+  const uword                            batch_size,
+  const bool                             print_mode
+  )
+  {
+  arma_extra_debug_sigprint();
+  
+  typedef typename T1::elem_type eT;
+  
+  const quasi_unwrap<T1> U(data.get_ref());
+  
+  gmm_priv::km_batch_mat<eT> get_batch(U.M, batch_size);
+  
+  gmm_priv::gmm_diag<eT> model;
+  
+  const bool status = model.kmeans_minibatch_wrapper(means, get_batch, k, seed_mode, n_iter, print_mode);
+  
+  if(status == true)
+    {
+    means = model.means;
+    }
+  else
+    {
+    means.soft_reset();
+    }
+  
+  return status;
+  }
+
+
+
+//! mini-batch k-means; each iteration uses a batch of samples drawn from randomly selected blocks of a file in arma_compact format
+template<typename eT>
+inline
+typename enable_if2<is_real<eT>::value, bool>::result
+kmeans_minibatch
+  (
+         Mat<eT>&            means,
+         compact_reader<eT>& reader,
+  const uword                k,
+  const gmm_seed_mode&       seed_mode,
+  const uword                n_iter,
+  const uword                batch_size,
+  const bool                 print_mode
+  )
+  {
+  arma_extra_debug_sigprint();
+  
+  gmm_priv::km_batch_reader<eT> get_batch(reader, batch_size);
+  
+  gmm_priv::gmm_diag<eT> model;
+  
+  const bool status = model.kmeans_minibatch_wrapper(means, get_batch, k, seed_mode, n_iter, print_mode);
+  
+  if(status == true)
+    {
+    means = model.means;
+    }
+  else
+    {
+    means.soft_reset();
+    }
+  
+  return status;
+  }
+
+
+
+//! mini-batch k-means; each iteration uses the batch of samples provided by get_batch(batch),
+//! which returns false when no more batches are available
+template<typename eT, typename functor>
+inline
+typename enable_if2<is_real<eT>::value, bool>::result
+kmeans_minibatch
+  (
+         Mat<eT>&      means,
+         functor       get_batch,
+  const uword          k,
+  const gmm_seed_mode& seed_mode,
+  const uword          n_iter,
+  const bool           print_mode
+  )
+  {
+  arma_extra_debug_sigprint();
+  
+  gmm_priv::gmm_diag<eT> model;
+  
+  const bool status = model.kmeans_minibatch_wrapper(means, get_batch, k, seed_mode, n_iter, print_mode);
+  
+  if(status == true)
+    {
+    means = model.means;
+    }
+  else
+    {
+    means.soft_reset();
+    }
+  
+  return status;
+  }
+
+
+
 //! @}
@@ -68,4 +68,21 @@ median(const T& x)
 
 
 
+template<typename T1>
+arma_warn_unused
+arma_inline
+typename enable_if2< is_cx<typename T1::elem_type>::no, const OpCube<T1, op_median> >::result
+median
+  (
+  const BaseCube<typename T1::elem_type,T1>& X,
+  const uword dim = 0
+  )
+  {
+  arma_extra_debug_sigprint();
+  
+  return OpCube<T1, op_median>(X.get_ref(), dim, 0);
+  }
+
+
+
 //! @}
@@ -31,7 +31,7 @@ unique(const T1& A)
   {
   arma_extra_debug_sigprint();
   
-  return Op<T1,op_unique_vec>(A);
+  return Op<T1,op_unique_vec>(A, uword(0), uword(0));
   }
 
 
@@ -48,7 +48,55 @@ unique(const T1& A)
   {
   arma_extra_debug_sigprint();
   
-  return Op<T1,op_unique>(A);
+  return Op<T1,op_unique>(A, uword(0), uword(0));
+  }
+
+
+
+//! order = "sorted": the unique elements are sorted in ascending order (default);
+//! order = "stable": the unique elements are in the order of their first occurrence
+template<typename T1>
+arma_warn_unused
+inline
+typename
+enable_if2
+  <
+  is_arma_type<T1>::value && resolves_to_vector<T1>::yes,
+  const Op<T1,op_unique_vec>
+  >::result
+unique(const T1& A, const char* order)
+  {
+  arma_extra_debug_sigprint();
+  
+  const char sig1 = (order != nullptr) ? order[0] : char(0);
+  const char sig2 = (sig1  != char(0)) ? order[1] : char(0);
+  
+  arma_debug_check( ((sig1 != 's') || ((sig2 != 'o') && (sig2 != 't'))), "unique(): unknown order specified" );
+  
+  return Op<T1,op_unique_vec>(A, ((sig2 == 't') ? uword(1) : uword(0)), uword(0));
+  }
+
+
+
+template<typename T1>
+arma_warn_unused
+inline
+typename
+enable_if2
+  <
+  is_arma_type<T1>::value && resolves_to_vector<T1>::no,
+  const Op<T1,op_unique>
+  >::result
+unique(const T1& A, const char* order)
+  {
+  arma_extra_debug_sigprint();
+  
+  const char sig1 = (order != nullptr) ? order[0] : char(0);
+  const char sig2 = (sig1  != char(0)) ? order[1] : char(0);
+  
+  arma_debug_check( ((sig1 != 's') || ((sig2 != 'o') && (sig2 != 't'))), "unique(): unknown order specified" );
+  
+  return Op<T1,op_unique>(A, ((sig2 == 't') ? uword(1) : uword(0)), uword(0));
   }
 
 
@@ -35,6 +35,15 @@ class glue_conv
   template<typename eT> inline static void apply(Mat<eT>& out, const Mat<eT>& A, const Mat<eT>& B, const bool A_is_col);
   
   template<typename T1, typename T2> inline static void apply(Mat<typename T1::elem_type>& out, const Glue<T1,T2,glue_conv>& X);
+  
+  template<typename eT> inline static void apply_direct(eT* out_mem, const uword out_n_elem, const Mat<eT>& x, const Mat<eT>& h);
+  
+  template<typename eT> inline static void apply_direct_range(eT* out_mem, const eT* xx_mem, const eT* hh_mem, const uword h_n_elem, const uword start, const uword end);
+  
+  template<typename eT> inline static bool apply_fft(eT* out_mem, const uword out_n_elem, const Mat<eT>& x, const Mat<eT>& h, const typename arma_real_or_cx_only<eT>::result* junk = nullptr);
+  template<typename eT> inline static bool apply_fft(eT* out_mem, const uword out_n_elem, const Mat<eT>& x, const Mat<eT>& h, const typename arma_integral_only<eT>::result* junk = nullptr);
+  
+  template<typename eT, typename cx_type, typename worker_type_fwd, typename worker_type_inv> inline static void apply_fft_range(eT* out_mem, const uword out_n_elem, const eT* xx_mem, const cx_type* H_mem, const uword h_n_elem, const uword L, const worker_type_fwd& fwd, const worker_type_inv& inv, const uword task_start, const uword task_end);
   };
 
 
@@ -47,6 +56,39 @@ class glue_conv2
   template<typename eT> inline static void apply(Mat<eT>& out, const Mat<eT>& A, const Mat<eT>& B);
   
   template<typename T1, typename T2> inline static void apply(Mat<typename T1::elem_type>& out, const Glue<T1,T2,glue_conv2>& expr);
+  
+  template<typename eT> inline static void apply_direct(Mat<eT>& out, const Mat<eT>& W, const Mat<eT>& G);
+  
+  template<typename eT> inline static void apply_direct_range(Mat<eT>& out, const Mat<eT>& X, const Mat<eT>& H, const uword col_start, const uword col_end);
+  
+  template<typename eT> inline static bool apply_fft(Mat<eT>& out, const Mat<eT>& W, const Mat<eT>& G, const typename arma_real_or_cx_only<eT>::result* junk = nullptr);
+  template<typename eT> inline static bool apply_fft(Mat<eT>& out, const Mat<eT>& W, const Mat<eT>& G, const typename arma_integral_only<eT>::result* junk = nullptr);
+  
+  template<typename eT, typename cx_type, typename worker_type_fwd, typename worker_type_inv> inline static void apply_fft_range(Mat<eT>& out, const Mat<eT>& XX, const Mat<cx_type>& H, const uword G_n_rows, const uword G_n_cols, const worker_type_fwd* fwd_r, const worker_type_inv* inv_r, const worker_type_fwd* fwd_c, const worker_type_inv* inv_c, const uword task_start, const uword task_end);
+  };
+
+
+
+//! helpers for FFT based convolution (overlap-save method):
+//! for real element types, two blocks of data are packed into the real and imaginary parts of one complex transform
+
+class glue_conv_fft
+  {
+  public:
+  
+  template<typename T> arma_inline static void pack(std::complex<T>& z, const T a, const T b) { z = std::complex<T>(a, b); }
+  
+  template<typename T> arma_inline static void pack(std::complex<T>& z, const std::complex<T>& a, const std::complex<T>&) { z = a; }
+  
+  template<typename T> arma_inline static void unpack(T& a, T& b, const std::complex<T>& z) { a = z.real(); b = z.imag(); }
+  
+  template<typename T> arma_inline static void unpack(std::complex<T>& a, std::complex<T>&, const std::complex<T>& z) { a = z; }
+  
+  inline static double transform_cost(const uword L);
+  
+  inline static uword calc_length(double& cost, const uword n_filt, const uword n_out, const uword n_per_task);
+  
+  inline static void calc_size(uword& L_rows, uword& L_cols, double& cost, const uword G_n_rows, const uword G_n_cols, const uword out_n_rows, const uword out_n_cols, const uword n_per_task);
   };
 
 
@@ -19,7 +19,6 @@
 
 
 
-// TODO: this implementation of conv() is rudimentary; replace with faster version
 template<typename eT>
 inline
 void
@@ -31,12 +30,32 @@ glue_conv::apply(Mat<eT>& out, const Mat<eT>& A, const Mat<eT>& B, const bool A_
   const Mat<eT>& x = (A.n_elem <= B.n_elem) ? B : A;
   
   const uword   h_n_elem    = h.n_elem;
-  const uword   h_n_elem_m1 = h_n_elem - 1;
   const uword   x_n_elem    = x.n_elem;
   const uword out_n_elem    = ((h_n_elem + x_n_elem) > 0) ? (h_n_elem + x_n_elem - 1) : uword(0);
   
   if( (h_n_elem == 0) || (x_n_elem == 0) )  { out.zeros(); return; }
   
+  (A_is_col) ? out.set_size(out_n_elem, 1) : out.set_size(1, out_n_elem);
+  
+  eT* out_mem = out.memptr();
+  
+  if(glue_conv::apply_fft(out_mem, out_n_elem, x, h))  { return; }
+  
+  glue_conv::apply_direct(out_mem, out_n_elem, x, h);
+  }
+
+
+
+template<typename eT>
+inline
+void
+glue_conv::apply_direct(eT* out_mem, const uword out_n_elem, const Mat<eT>& x, const Mat<eT>& h)
+  {
+  arma_extra_debug_sigprint();
+  
+  const uword h_n_elem    = h.n_elem;
+  const uword h_n_elem_m1 = h_n_elem - 1;
+  const uword x_n_elem    = x.n_elem;
   
   Col<eT> hh(h_n_elem);  // flipped version of h
   
@@ -56,12 +75,40 @@ glue_conv::apply(Mat<eT>& out, const Mat<eT>& A, const Mat<eT>& B, const bool A_
   
   arrayops::copy( &(xx_mem[h_n_elem_m1]), x_mem, x_n_elem );
   
+  #if defined(ARMA_USE_OPENMP)
+    {
+    if( (out_n_elem > 1) && mp_gate<eT>::eval(out_n_elem * h_n_elem) )
+      {
+      const uword n_threads = (std::min)( uword(mp_thread_limit::get()), out_n_elem );
+      
+      #pragma omp parallel for schedule(static) num_threads(int(n_threads))
+      for(uword t=0; t < n_threads; ++t)
+        {
+        const uword start = (t    * out_n_elem) / n_threads;
+        const uword end   = ((t+1) * out_n_elem) / n_threads;
+        
+        glue_conv::apply_direct_range(out_mem, xx_mem, hh_mem, h_n_elem, start, end);
+        }
+      
+      return;
+      }
+    }
+  #endif
   
-  (A_is_col) ? out.set_size(out_n_elem, 1) : out.set_size(1, out_n_elem);
-  
-  eT* out_mem = out.memptr();
+  glue_conv::apply_direct_range(out_mem, xx_mem, hh_mem, h_n_elem, 0, out_n_elem);
+  }
+
+
+
+//! direct convolution for the output elements [start, end)
+template<typename eT>
+inline
+void
+glue_conv::apply_direct_range(eT* out_mem, const eT* xx_mem, const eT* hh_mem, const uword h_n_elem, const uword start, const uword end)
+  {
+  arma_extra_debug_sigprint();
   
-  for(uword i=0; i < out_n_elem; ++i)
+  for(uword i=start; i < end; ++i)
     {
     // out_mem[i] = dot( hh, xx.subvec(i, (i + h_n_elem_m1)) );
     
@@ -71,6 +118,167 @@ glue_conv::apply(Mat<eT>& out, const Mat<eT>& A, const Mat<eT>& B, const bool A_
 
 
 
+//! FFT based convolution via the overlap-save method;
+//! returns false if the estimated cost is higher than for direct convolution, or if x or h have non-finite values
+template<typename eT>
+inline
+bool
+glue_conv::apply_fft(eT* out_mem, const uword out_n_elem, const Mat<eT>& x, const Mat<eT>& h, const typename arma_real_or_cx_only<eT>::result* junk)
+  {
+  arma_extra_debug_sigprint();
+  arma_ignore(junk);
+  
+  typedef typename get_pod_type<eT>::result T;
+  typedef std::complex<T>                   cx_type;
+  
+  const uword h_n_elem = h.n_elem;
+  const uword x_n_elem = x.n_elem;
+  
+  // each transform processes two blocks of real data or one block of complex data
+  const uword n_per_task = (is_cx<eT>::yes) ? uword(1) : uword(2);
+  
+  double fft_cost = 0.0;
+  
+  const uword L = glue_conv_fft::calc_length(fft_cost, h_n_elem, out_n_elem, n_per_task);
+  
+  // cost of direct convolution, in the same units; a complex multiply-add is about 8 times slower than a real one
+  const double direct_cost = double(out_n_elem) * double(h_n_elem) * ( (is_cx<eT>::yes) ? double(8) : double(1) );
+  
+  if( (L == 0) || (fft_cost >= direct_cost) )  { return false; }
+  
+  // the transforms would spread a NaN or Inf over whole blocks of the output, rather than only the affected elements
+  if( (x.is_finite() == false) || (h.is_finite() == false) )  { return false; }
+  
+  arma_extra_debug_print("glue_conv::apply_fft(): using FFT");
+  
+  const uword step    = L - h_n_elem + 1;   // number of output elements per block
+  const uword n_block = (out_n_elem + step - 1) / step;
+  const uword n_tasks = (n_block + n_per_task - 1) / n_per_task;
+  
+  // zero padded version of x, long enough for all blocks of all tasks
+  
+  Col<eT> xx( (n_tasks * n_per_task * step + h_n_elem - 1), fill::zeros );
+  
+  arrayops::copy( &(xx.memptr()[h_n_elem - 1]), x.memptr(), x_n_elem );
+  
+  const std::shared_ptr< const fft_engine<cx_type,false> > fwd = fft_engine_cache<cx_type,false>::get(L);
+  const std::shared_ptr< const fft_engine<cx_type,true > > inv = fft_engine_cache<cx_type,true >::get(L);
+  
+  // transform of the zero padded filter, with the 1/L scaling of the inverse transform folded in
+  
+  podarray<cx_type> hh(L);
+  podarray<cx_type> H(L);
+  
+  const eT* h_mem = h.memptr();
+  
+  for(uword i=0; i < h_n_elem; ++i)  { hh[i] = cx_type(h_mem[i]); }
+  for(uword i=h_n_elem; i < L; ++i)  { hh[i] = cx_type(0);        }
+  
+  fwd->run(H.memptr(), hh.memptr());
+  
+  arrayops::inplace_div(H.memptr(), cx_type(T(L)), L);
+  
+  #if defined(ARMA_USE_OPENMP)
+    {
+    if( (n_tasks > 1) && mp_gate<eT>::eval(n_tasks * L) )
+      {
+      const uword n_threads = (std::min)( uword(mp_thread_limit::get()), n_tasks );
+      
+      #pragma omp parallel for schedule(static) num_threads(int(n_threads))
+      for(uword t=0; t < n_threads; ++t)
+        {
+        const uword task_start = (t    * n_tasks) / n_threads;
+        const uword task_end   = ((t+1) * n_tasks) / n_threads;
+        
+        glue_conv::apply_fft_range(out_mem, out_n_elem, xx.memptr(), H.memptr(), h_n_elem, L, *fwd, *inv, task_start, task_end);
+        }
+      
+      return true;
+      }
+    }
+  #endif
+  
+  glue_conv::apply_fft_range(out_mem, out_n_elem, xx.memptr(), H.memptr(), h_n_elem, L, *fwd, *inv, 0, n_tasks);
+  
+  return true;
+  }
+
+
+
+template<typename eT>
+inline
+bool
+glue_conv::apply_fft(eT* out_mem, const uword out_n_elem, const Mat<eT>& x, const Mat<eT>& h, const typename arma_integral_only<eT>::result* junk)
+  {
+  arma_extra_debug_sigprint();
+  arma_ignore(out_mem);
+  arma_ignore(out_n_elem);
+  arma_ignore(x);
+  arma_ignore(h);
+  arma_ignore(junk);
+  
+  return false;
+  }
+
+
+
+//! process the blocks of tasks [task_start, task_end);
+//! block b produces output elements [b*step, (b+1)*step) from elements [b*step, b*step + L) of the zero padded input
+template<typename eT, typename cx_type, typename worker_type_fwd, typename worker_type_inv>
+inline
+void
+glue_conv::apply_fft_range(eT* out_mem, const uword out_n_elem, const eT* xx_mem, const cx_type* H_mem, const uword h_n_elem, const uword L, const worker_type_fwd& fwd, const worker_type_inv& inv, const uword task_start, const uword task_end)
+  {
+  arma_extra_debug_sigprint();
+  
+  const uword n_per_task = (is_cx<eT>::yes) ? uword(1) : uword(2);
+  
+  const uword offset = h_n_elem - 1;
+  const uword step   = L - offset;
+  
+  podarray<cx_type> buf_a(L);
+  podarray<cx_type> buf_b(L);
+  
+  cx_type* buf_a_mem = buf_a.memptr();
+  cx_type* buf_b_mem = buf_b.memptr();
+  
+  for(uword task=task_start; task < task_end; ++task)
+    {
+    const uword start_a = (task * n_per_task) * step;
+    const uword start_b = start_a + step;   // only used for real data
+    
+    const eT* src_a = &xx_mem[start_a];
+    const eT* src_b = &xx_mem[(n_per_task > 1) ? start_b : start_a];
+    
+    for(uword i=0; i < L; ++i)  { glue_conv_fft::pack(buf_a_mem[i], src_a[i], src_b[i]); }
+    
+    fwd.run(buf_b_mem, buf_a_mem);
+    
+    for(uword i=0; i < L; ++i)  { buf_b_mem[i] *= H_mem[i]; }
+    
+    inv.run(buf_a_mem, buf_b_mem);
+    
+    // the first h_n_elem-1 elements of each block are affected by the circular wrap-around
+    
+    const uword n_a = (start_a < out_n_elem) ? (std::min)(step, out_n_elem - start_a) : uword(0);
+    const uword n_b = (start_b < out_n_elem) ? (std::min)(step, out_n_elem - start_b) : uword(0);
+    
+    eT dummy;
+    
+    if(n_per_task > 1)
+      {
+      for(uword i=0; i < n_b; ++i)  { glue_conv_fft::unpack(out_mem[start_a + i], out_mem[start_b + i], buf_a_mem[offset + i]); }
+      for(uword i=n_b; i < n_a; ++i)  { glue_conv_fft::unpack(out_mem[start_a + i], dummy,               buf_a_mem[offset + i]); }
+      }
+    else
+      {
+      for(uword i=0; i < n_a; ++i)  { glue_conv_fft::unpack(out_mem[start_a + i], dummy, buf_a_mem[offset + i]); }
+      }
+    }
+  }
+
+
+
 // // alternative implementation of 1d convolution
 // template<typename eT>
 // inline
@@ -190,7 +398,20 @@ glue_conv::apply(Mat<typename T1::elem_type>& out, const Glue<T1,T2,glue_conv>&
   
   if(mode == 0)  // full convolution
     {
-    glue_conv::apply(out, A, B, A_is_col);
+    // out is resized before A and B are read, so an alias needs a temporary
+    
+    if(UA.is_alias(out) || UB.is_alias(out))
+      {
+      Mat<eT> tmp;
+      
+      glue_conv::apply(tmp, A, B, A_is_col);
+      
+      out.steal_mem(tmp);
+      }
+    else
+      {
+      glue_conv::apply(out, A, B, A_is_col);
+      }
     }
   else
   if(mode == 1)  // same size as A
@@ -218,7 +439,6 @@ glue_conv::apply(Mat<typename T1::elem_type>& out, const Glue<T1,T2,glue_conv>&
 
 
 
-// TODO: this implementation of conv2() is rudimentary; replace with faster version
 template<typename eT>
 inline
 void
@@ -234,6 +454,21 @@ glue_conv2::apply(Mat<eT>& out, const Mat<eT>& A, const Mat<eT>& B)
   
   if(G.is_empty() || W.is_empty())  { out.zeros(); return; }
   
+  out.set_size( out_n_rows, out_n_cols );
+  
+  if(glue_conv2::apply_fft(out, W, G))  { return; }
+  
+  glue_conv2::apply_direct(out, W, G);
+  }
+
+
+
+template<typename eT>
+inline
+void
+glue_conv2::apply_direct(Mat<eT>& out, const Mat<eT>& W, const Mat<eT>& G)
+  {
+  arma_extra_debug_sigprint();
   
   Mat<eT> H(G.n_rows, G.n_cols);  // flipped filter coefficients
   
@@ -259,10 +494,47 @@ glue_conv2::apply(Mat<eT>& out, const Mat<eT>& A, const Mat<eT>& B)
   
   X( H_n_rows_m1, H_n_cols_m1, arma::size(W) ) = W;  // zero padded version of 2D image
   
+  const uword out_n_cols = out.n_cols;
   
-  out.set_size( out_n_rows, out_n_cols );
+  #if defined(ARMA_USE_OPENMP)
+    {
+    if( (out_n_cols > 1) && mp_gate<eT>::eval(out.n_elem * H.n_elem) )
+      {
+      const uword n_threads = (std::min)( uword(mp_thread_limit::get()), out_n_cols );
+      
+      #pragma omp parallel for schedule(static) num_threads(int(n_threads))
+      for(uword t=0; t < n_threads; ++t)
+        {
+        const uword col_start = (t    * out_n_cols) / n_threads;
+        const uword col_end   = ((t+1) * out_n_cols) / n_threads;
+        
+        glue_conv2::apply_direct_range(out, X, H, col_start, col_end);
+        }
+      
+      return;
+      }
+    }
+  #endif
+  
+  glue_conv2::apply_direct_range(out, X, H, 0, out_n_cols);
+  }
+
+
+
+//! direct convolution for the output columns [col_start, col_end)
+template<typename eT>
+inline
+void
+glue_conv2::apply_direct_range(Mat<eT>& out, const Mat<eT>& X, const Mat<eT>& H, const uword col_start, const uword col_end)
+  {
+  arma_extra_debug_sigprint();
+  
+  const uword out_n_rows = out.n_rows;
+  
+  const uword H_n_rows = H.n_rows;
+  const uword H_n_cols = H.n_cols;
   
-  for(uword col=0; col < out_n_cols; ++col)
+  for(uword col=col_start; col < col_end; ++col)
     {
     eT* out_colptr = out.colptr(col);
     
@@ -286,6 +558,219 @@ glue_conv2::apply(Mat<eT>& out, const Mat<eT>& A, const Mat<eT>& B)
 
 
 
+//! FFT based convolution via the overlap-save method, using 2D tiles;
+//! returns false if the estimated cost is higher than for direct convolution, or if W or G have non-finite values
+template<typename eT>
+inline
+bool
+glue_conv2::apply_fft(Mat<eT>& out, const Mat<eT>& W, const Mat<eT>& G, const typename arma_real_or_cx_only<eT>::result* junk)
+  {
+  arma_extra_debug_sigprint();
+  arma_ignore(junk);
+  
+  typedef typename get_pod_type<eT>::result T;
+  typedef std::complex<T>                   cx_type;
+  
+  const uword n_per_task = (is_cx<eT>::yes) ? uword(1) : uword(2);
+  
+  uword  L_rows   = 0;
+  uword  L_cols   = 0;
+  double fft_cost = 0.0;
+  
+  glue_conv_fft::calc_size(L_rows, L_cols, fft_cost, G.n_rows, G.n_cols, out.n_rows, out.n_cols, n_per_task);
+  
+  // cost of direct convolution, in the same units; the short dot products of the direct method make each multiply-add
+  // about 2 times slower than for 1D convolution
+  const double direct_cost = double(out.n_elem) * double(G.n_elem) * ( (is_cx<eT>::yes) ? double(8) : double(2) );
+  
+  if( (L_rows == 0) || (fft_cost >= direct_cost) )  { return false; }
+  
+  // the transforms would spread a NaN or Inf over whole tiles of the output, rather than only the affected elements
+  if( (W.is_finite() == false) || (G.is_finite() == false) )  { return false; }
+  
+  arma_extra_debug_print("glue_conv2::apply_fft(): using FFT");
+  
+  const uword step_rows = L_rows - G.n_rows + 1;
+  const uword step_cols = L_cols - G.n_cols + 1;
+  
+  const uword n_tile_rows = (out.n_rows + step_rows - 1) / step_rows;
+  const uword n_tile_cols = (out.n_cols + step_cols - 1) / step_cols;
+  
+  const uword n_tiles = n_tile_rows * n_tile_cols;
+  const uword n_tasks = (n_tiles + n_per_task - 1) / n_per_task;
+  
+  // zero padded version of the image, covering all tiles
+  
+  Mat<eT> XX( (n_tile_rows * step_rows + G.n_rows - 1), (n_tile_cols * step_cols + G.n_cols - 1), fill::zeros );
+  
+  XX( G.n_rows - 1, G.n_cols - 1, arma::size(W) ) = W;
+  
+  // transforms of length 1 are skipped
+  
+  std::shared_ptr< const fft_engine<cx_type,false> > fwd_r;
+  std::shared_ptr< const fft_engine<cx_type,true > > inv_r;
+  std::shared_ptr< const fft_engine<cx_type,false> > fwd_c;
+  std::shared_ptr< const fft_engine<cx_type,true > > inv_c;
+  
+  if(L_rows > 1)  { fwd_r = fft_engine_cache<cx_type,false>::get(L_rows);  inv_r = fft_engine_cache<cx_type,true>::get(L_rows); }
+  if(L_cols > 1)  { fwd_c = fft_engine_cache<cx_type,false>::get(L_cols);  inv_c = fft_engine_cache<cx_type,true>::get(L_cols); }
+  
+  // transform of the zero padded filter, with the 1/(L_rows*L_cols) scaling of the inverse transform folded in
+  
+  Mat<cx_type> H(L_rows, L_cols, fill::zeros);
+  
+  for(uword col=0; col < G.n_cols; ++col)
+  for(uword row=0; row < G.n_rows; ++row)
+    {
+    H.at(row,col) = cx_type( G.at(row,col) );
+    }
+  
+  if(L_rows > 1)  { op_fft_dim::apply_range(H.memptr(), 1,      L_rows, *fwd_r, 0, L_cols                                                    ); }
+  if(L_cols > 1)  { op_fft_dim::apply_range(H.memptr(), L_rows, L_cols, *fwd_c, 0, (L_rows + op_fft_dim::tile_size - 1) / op_fft_dim::tile_size); }
+  
+  H /= cx_type( T(L_rows * L_cols) );
+  
+  #if defined(ARMA_USE_OPENMP)
+    {
+    if( (n_tasks > 1) && mp_gate<eT>::eval(n_tasks * H.n_elem) )
+      {
+      const uword n_threads = (std::min)( uword(mp_thread_limit::get()), n_tasks );
+      
+      #pragma omp parallel for schedule(static) num_threads(int(n_threads))
+      for(uword t=0; t < n_threads; ++t)
+        {
+        const uword task_start = (t    * n_tasks) / n_threads;
+        const uword task_end   = ((t+1) * n_tasks) / n_threads;
+        
+        glue_conv2::apply_fft_range(out, XX, H, G.n_rows, G.n_cols, fwd_r.get(), inv_r.get(), fwd_c.get(), inv_c.get(), task_start, task_end);
+        }
+      
+      return true;
+      }
+    }
+  #endif
+  
+  glue_conv2::apply_fft_range(out, XX, H, G.n_rows, G.n_cols, fwd_r.get(), inv_r.get(), fwd_c.get(), inv_c.get(), 0, n_tasks);
+  
+  return true;
+  }
+
+
+
+template<typename eT>
+inline
+bool
+glue_conv2::apply_fft(Mat<eT>& out, const Mat<eT>& W, const Mat<eT>& G, const typename arma_integral_only<eT>::result* junk)
+  {
+  arma_extra_debug_sigprint();
+  arma_ignore(out);
+  arma_ignore(W);
+  arma_ignore(G);
+  arma_ignore(junk);
+  
+  return false;
+  }
+
+
+
+//! process the tiles of tasks [task_start, task_end);
+//! each tile produces a step_rows x step_cols block of the output from a L_rows x L_cols block of the zero padded image
+template<typename eT, typename cx_type, typename worker_type_fwd, typename worker_type_inv>
+inline
+void
+glue_conv2::apply_fft_range(Mat<eT>& out, const Mat<eT>& XX, const Mat<cx_type>& H, const uword G_n_rows, const uword G_n_cols, const worker_type_fwd* fwd_r, const worker_type_inv* inv_r, const worker_type_fwd* fwd_c, const worker_type_inv* inv_c, const uword task_start, const uword task_end)
+  {
+  arma_extra_debug_sigprint();
+  
+  const uword n_per_task = (is_cx<eT>::yes) ? uword(1) : uword(2);
+  
+  const uword L_rows = H.n_rows;
+  const uword L_cols = H.n_cols;
+  
+  const uword offset_rows = G_n_rows - 1;
+  const uword offset_cols = G_n_cols - 1;
+  
+  const uword step_rows = L_rows - offset_rows;
+  const uword step_cols = L_cols - offset_cols;
+  
+  const uword n_tile_rows = (out.n_rows + step_rows - 1) / step_rows;
+  const uword n_tile_cols = (out.n_cols + step_cols - 1) / step_cols;
+  
+  const uword n_tiles = n_tile_rows * n_tile_cols;
+  
+  const uword n_row_tasks = (L_rows + op_fft_dim::tile_size - 1) / op_fft_dim::tile_size;
+  
+  Mat<cx_type> buf(L_rows, L_cols);
+  
+  const cx_type* H_mem   = H.memptr();
+        cx_type* buf_mem = buf.memptr();
+  
+  for(uword task=task_start; task < task_end; ++task)
+    {
+    const uword tile_a = task * n_per_task;
+    const uword tile_b = tile_a + 1;   // only used for real data
+    
+    const bool use_b = (n_per_task > 1) && (tile_b < n_tiles);
+    
+    const uword row_a = (tile_a % n_tile_rows) * step_rows;
+    const uword col_a = (tile_a / n_tile_rows) * step_cols;
+    
+    const uword row_b = (use_b) ? (tile_b % n_tile_rows) * step_rows : row_a;
+    const uword col_b = (use_b) ? (tile_b / n_tile_rows) * step_cols : col_a;
+    
+    for(uword col=0; col < L_cols; ++col)
+      {
+      const eT* src_a = &(XX.colptr(col_a + col)[row_a]);
+      const eT* src_b = &(XX.colptr(col_b + col)[row_b]);
+      
+      cx_type* dest = buf.colptr(col);
+      
+      for(uword row=0; row < L_rows; ++row)  { glue_conv_fft::pack(dest[row], src_a[row], src_b[row]); }
+      }
+    
+    if(L_rows > 1)  { op_fft_dim::apply_range(buf_mem, 1,      L_rows, *fwd_r, 0, L_cols     ); }
+    if(L_cols > 1)  { op_fft_dim::apply_range(buf_mem, L_rows, L_cols, *fwd_c, 0, n_row_tasks); }
+    
+    for(uword i=0; i < buf.n_elem; ++i)  { buf_mem[i] *= H_mem[i]; }
+    
+    if(L_cols > 1)  { op_fft_dim::apply_range(buf_mem, L_rows, L_cols, *inv_c, 0, n_row_tasks); }
+    if(L_rows > 1)  { op_fft_dim::apply_range(buf_mem, 1,      L_rows, *inv_r, 0, L_cols     ); }
+    
+    // the first G_n_rows-1 rows and G_n_cols-1 columns of each tile are affected by the circular wrap-around
+    
+    const uword n_rows_a = (std::min)(step_rows, out.n_rows - row_a);
+    const uword n_cols_a = (std::min)(step_cols, out.n_cols - col_a);
+    
+    const uword n_rows_b = (std::min)(step_rows, out.n_rows - row_b);
+    const uword n_cols_b = (std::min)(step_cols, out.n_cols - col_b);
+    
+    eT dummy;
+    
+    for(uword col=0; col < n_cols_a; ++col)
+      {
+      const cx_type* src = &(buf.colptr(offset_cols + col)[offset_rows]);
+      
+      eT* dest = &(out.colptr(col_a + col)[row_a]);
+      
+      for(uword row=0; row < n_rows_a; ++row)  { glue_conv_fft::unpack(dest[row], dummy, src[row]); }
+      }
+    
+    if(use_b)
+      {
+      for(uword col=0; col < n_cols_b; ++col)
+        {
+        const cx_type* src = &(buf.colptr(offset_cols + col)[offset_rows]);
+        
+        eT* dest = &(out.colptr(col_b + col)[row_b]);
+        
+        for(uword row=0; row < n_rows_b; ++row)  { glue_conv_fft::unpack(dummy, dest[row], src[row]); }
+        }
+      }
+    }
+  }
+
+
+
 template<typename T1, typename T2>
 inline
 void
@@ -305,7 +790,20 @@ glue_conv2::apply(Mat<typename T1::elem_type>& out, const Glue<T1,T2,glue_conv2>
   
   if(mode == 0)  // full convolution
     {
-    glue_conv2::apply(out, A, B);
+    // out is resized before A and B are read, so an alias needs a temporary
+    
+    if(UA.is_alias(out) || UB.is_alias(out))
+      {
+      Mat<eT> tmp;
+      
+      glue_conv2::apply(tmp, A, B);
+      
+      out.steal_mem(tmp);
+      }
+    else
+      {
+      glue_conv2::apply(out, A, B);
+      }
     }
   else
   if(mode == 1)  // same size as A
@@ -330,4 +828,113 @@ glue_conv2::apply(Mat<typename T1::elem_type>& out, const Glue<T1,T2,glue_conv2>
 
 
 
+///
+
+
+
+inline
+double
+glue_conv_fft::transform_cost(const uword L)
+  {
+  // approximate cost of one complex transform of length L,
+  // in units of one real multiply-add of direct convolution (empirically determined)
+  
+  uword L_log2 = 0;
+  
+  while( (uword(1) << L_log2) < L )  { ++L_log2; }
+  
+  return double(8) * double(L) * double(L_log2);
+  }
+
+
+
+//! transform length for 1D convolution with the lowest estimated cost;
+//! candidate lengths are powers of 2, from the smallest one that holds the filter
+//! up to the smallest one that holds the whole output in one block
+inline
+uword
+glue_conv_fft::calc_length(double& cost, const uword n_filt, const uword n_out, const uword n_per_task)
+  {
+  arma_extra_debug_sigprint();
+  
+  uword L = 2;
+  
+  while(L < n_filt)  { L *= 2; }
+  
+  uword best_L    = 0;
+  double best_cost = 0.0;
+  
+  for(bool done = false; done == false; L *= 2)
+    {
+    const uword step    = L - n_filt + 1;
+    const uword n_block = (n_out + step - 1) / step;
+    const uword n_tasks = (n_block + n_per_task - 1) / n_per_task;
+    
+    // forward and inverse transforms, plus the element-wise multiplication, packing and unpacking
+    const double L_cost = double(n_tasks) * ( double(2) * glue_conv_fft::transform_cost(L) + double(24) * double(L) );
+    
+    if( (best_L == 0) || (L_cost < best_cost) )  { best_L = L; best_cost = L_cost; }
+    
+    done = (n_block <= 1);
+    }
+  
+  cost = best_cost;
+  
+  return best_L;
+  }
+
+
+
+//! tile size for 2D convolution with the lowest estimated cost;
+//! the candidate sizes for each dimension are chosen as for 1D convolution,
+//! except that a dimension of size 1 is not transformed
+inline
+void
+glue_conv_fft::calc_size(uword& L_rows, uword& L_cols, double& cost, const uword G_n_rows, const uword G_n_cols, const uword out_n_rows, const uword out_n_cols, const uword n_per_task)
+  {
+  arma_extra_debug_sigprint();
+  
+  L_rows = 0;
+  L_cols = 0;
+  cost   = 0.0;
+  
+  const uword L_rows_start = ((G_n_rows == 1) && (out_n_rows == 1)) ? uword(1) : uword(2);
+  const uword L_cols_start = ((G_n_cols == 1) && (out_n_cols == 1)) ? uword(1) : uword(2);
+  
+  uword Lr = L_rows_start;
+  
+  while(Lr < G_n_rows)  { Lr *= 2; }
+  
+  for(bool done_rows = false; done_rows == false; Lr *= 2)
+    {
+    const uword step_rows   = Lr - G_n_rows + 1;
+    const uword n_tile_rows = (out_n_rows + step_rows - 1) / step_rows;
+    
+    done_rows = (n_tile_rows <= 1);
+    
+    uword Lc = L_cols_start;
+    
+    while(Lc < G_n_cols)  { Lc *= 2; }
+    
+    for(bool done_cols = false; done_cols == false; Lc *= 2)
+      {
+      const uword step_cols   = Lc - G_n_cols + 1;
+      const uword n_tile_cols = (out_n_cols + step_cols - 1) / step_cols;
+      
+      done_cols = (n_tile_cols <= 1);
+      
+      const uword n_tasks = (n_tile_rows * n_tile_cols + n_per_task - 1) / n_per_task;
+      
+      // forward and inverse transforms along both dimensions, plus the element-wise multiplication, packing and unpacking
+      const double tile_cost = double(2) * ( double(Lc) * glue_conv_fft::transform_cost(Lr) + double(Lr) * glue_conv_fft::transform_cost(Lc) ) + double(24) * double(Lr) * double(Lc);
+      
+      const double total_cost = double(n_tasks) * tile_cost;
+      
+      if( (L_rows == 0) || (total_cost < cost) )  { L_rows = Lr; L_cols = Lc; cost = total_cost; }
+      }
+    }
+  }
+
+
+
 //! @}
@@ -36,6 +36,9 @@ class glue_intersect
   
   template<typename T1, typename T2>
   inline static void apply(Mat<typename T1::elem_type>& out, uvec& iA, uvec& iB, const Base<typename T1::elem_type,T1>& A_expr, const Base<typename T1::elem_type,T2>& B_expr, const bool calc_indx);
+  
+  template<typename eT>
+  inline static bool apply_hash(Mat<eT>& out, uvec& iA, uvec& iB, const Mat<eT>& A, const Mat<eT>& B, const bool calc_indx);
   };
 
 
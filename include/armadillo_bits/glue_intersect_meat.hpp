@@ -54,6 +54,8 @@ glue_intersect::apply(Mat<typename T1::elem_type>& out, uvec& iA, uvec& iB, cons
     return;
     }
   
+  if( ((UA.M.n_elem + UB.M.n_elem) >= hash_aux::threshold) && glue_intersect::apply_hash(out, iA, iB, UA.M, UB.M, calc_indx) )  { return; }
+  
   uvec A_uniq_indx;
   uvec B_uniq_indx; 
   
@@ -143,4 +145,86 @@ glue_intersect::apply(Mat<typename T1::elem_type>& out, uvec& iA, uvec& iB, cons
 
 
 
+//! hash-based implementation for integer elements;
+//! the indices in iA and iB refer to the first occurrence of each common value.
+//! returns false if the inputs have too many distinct values, in which case the sort-based implementation is used.
+template<typename eT>
+inline
+bool
+glue_intersect::apply_hash(Mat<eT>& out, uvec& iA, uvec& iB, const Mat<eT>& A, const Mat<eT>& B, const bool calc_indx)
+  {
+  arma_extra_debug_sigprint();
+  
+  hash_aux_table<eT> A_table;
+  hash_aux_table<eT> B_table;
+  
+  if(hash_aux::build(A_table, A.memptr(), A.n_elem) == false)  { return false; }
+  if(hash_aux::build(B_table, B.memptr(), B.n_elem) == false)  { return false; }
+  
+  const uword A_n_distinct = A_table.size();
+  
+  Col<eT> C_vals(A_n_distinct);
+  uvec    C_iA(A_n_distinct);
+  uvec    C_iB(A_n_distinct);
+  
+  uword C_count = 0;
+  
+  for(uword j=0; j < A_n_distinct; ++j)
+    {
+    const eT val = A_table.vals[j];
+    
+    uword B_index = 0;
+    
+    if(B_table.find(val, B_index))
+      {
+      C_vals[C_count] = val;
+      C_iA[C_count]   = A_table.indices[j];
+      C_iB[C_count]   = B_index;
+      
+      ++C_count;
+      }
+    }
+  
+  if(C_count == 0)
+    {
+    out.reset();
+    iA.reset();
+    iB.reset();
+    return true;
+    }
+  
+  C_vals.resize(C_count);
+  
+  const uvec C_order = sort_index(C_vals);
+  
+  if(A.is_rowvec() && B.is_rowvec())
+    {
+    out.set_size(1, C_count);
+    }
+  else
+    {
+    out.set_size(C_count, 1);
+    }
+  
+  eT* out_mem = out.memptr();
+  
+  for(uword i=0; i < C_count; ++i)  { out_mem[i] = C_vals[ C_order[i] ]; }
+  
+  if(calc_indx)
+    {
+    iA.set_size(C_count);
+    iB.set_size(C_count);
+    
+    for(uword i=0; i < C_count; ++i)
+      {
+      iA[i] = C_iA[ C_order[i] ];
+      iB[i] = C_iB[ C_order[i] ];
+      }
+    }
+  
+  return true;
+  }
+
+
+
 //! @}
@@ -23,9 +23,22 @@ class glue_quantile
   {
   public:
   
+  static constexpr uword row_block_size = 16;  //!< number of rows copied together when finding the quantiles of each row
+  
+  template<typename eTb>
+  inline static uvec get_ranks(const Mat<eTb>& P, const uword N);
+  
+  template<typename eTa>
+  inline static void multi_select(eTa* Y_mem, const uword lo, const uword hi, const uword* ranks, const uword n_ranks);
+  
   template<typename eTa, typename eTb>
-  inline static void worker(eTb* out_mem, Col<eTa>& Y, const Mat<eTb>& P);
+  inline static void worker(eTb* out_mem, eTa* Y_mem, const uword Y_n_elem, const Mat<eTb>& P, const uvec& ranks);
   
+  template<typename eTa, typename eTb>
+  inline static void apply_cols(Mat<eTb>& out, const Mat<eTa>& X, const Mat<eTb>& P, const uvec& ranks, const uword col_start, const uword col_end, eTa* scratch);
+  
+  template<typename eTa, typename eTb>
+  inline static void apply_rows(Mat<eTb>& out, const Mat<eTa>& X, const Mat<eTb>& P, const uvec& ranks, const uword row_start, const uword row_end, eTa* scratch, eTb* out_scratch);
   
   template<typename eTa, typename eTb>
   inline static void apply_noalias(Mat<eTb>& out, const Mat<eTa>& X, const Mat<eTb>& P, const uword dim);
@@ -18,16 +18,84 @@
 //! @{
 
 
+//! find the order statistics (ie. positions in the sorted data) needed for the quantiles in P,
+//! given N data elements; the positions are sorted and unique
+template<typename eTb>
+inline
+uvec
+glue_quantile::get_ranks(const Mat<eTb>& P, const uword N)
+  {
+  arma_extra_debug_sigprint();
+  
+  const eTb*  P_mem    = P.memptr();
+  const uword P_n_elem = P.n_elem;
+  
+  const eTb alpha = 0.5;
+  const eTb N_val = eTb(N);
+  const eTb P_min = (eTb(1) - alpha) / N_val;
+  const eTb P_max = (N_val  - alpha) / N_val;
+  
+  std::vector<uword> ranks;
+  
+  ranks.reserve(2*P_n_elem);
+  
+  for(uword i=0; i < P_n_elem; ++i)
+    {
+    const eTb P_i = P_mem[i];
+    
+    if( (P_i < P_min) || (P_i > P_max) )  { continue; }
+    
+    const uword k = uword(std::floor(N_val * P_i + alpha));
+    
+    // k == N only occurs when P_i == P_max, in which case only element k-1 is used
+    
+    ranks.push_back(k-1);
+    
+    if(k < N)  { ranks.push_back(k); }
+    }
+  
+  std::sort(ranks.begin(), ranks.end());
+  
+  const uword n_ranks = uword( std::unique(ranks.begin(), ranks.end()) - ranks.begin() );
+  
+  uvec out(n_ranks);
+  
+  if(n_ranks > 0)  { arrayops::copy(out.memptr(), &(ranks[0]), n_ranks); }
+  
+  return out;
+  }
+
+
+
+//! partially sort Y_mem[lo] to Y_mem[hi-1] so that each of the given ranks holds its order statistic;
+//! the range is split at the middle rank, so that the cost grows logarithmically with the number of ranks
+template<typename eTa>
+inline
+void
+glue_quantile::multi_select(eTa* Y_mem, const uword lo, const uword hi, const uword* ranks, const uword n_ranks)
+  {
+  if(n_ranks == 0)  { return; }
+  
+  const uword mid = n_ranks / 2;
+  const uword k   = ranks[mid];
+  
+  std::nth_element( Y_mem + lo, Y_mem + k, Y_mem + hi );
+  
+  glue_quantile::multi_select(Y_mem, lo,  k,  ranks,           mid              );
+  glue_quantile::multi_select(Y_mem, k+1, hi, ranks + mid + 1, n_ranks - mid - 1);
+  }
+
+
+
 template<typename eTa, typename eTb>
 inline
 void
-glue_quantile::worker(eTb* out_mem, Col<eTa>& Y, const Mat<eTb>& P)
+glue_quantile::worker(eTb* out_mem, eTa* Y_mem, const uword Y_n_elem, const Mat<eTb>& P, const uvec& ranks)
   {
   arma_extra_debug_sigprint();
   
   // NOTE: assuming out_mem is an array with P.n_elem elements
-  
-  // TODO: ignore non-finite values ?
+  // NOTE: assuming ranks was obtained via get_ranks(P, Y_n_elem)
   
   // algorithm based on "Definition 5" in:
   // Rob J. Hyndman and Yanan Fan.
@@ -38,8 +106,19 @@ glue_quantile::worker(eTb* out_mem, Col<eTa>& Y, const Mat<eTb>& P)
   const eTb*  P_mem    = P.memptr();
   const uword P_n_elem = P.n_elem;
   
+  // NaN has no position in the sorted data, so all quantiles of data with NaN are NaN
+  
+  if(arrayops::has_nan(Y_mem, Y_n_elem))
+    {
+    arrayops::inplace_set(out_mem, Datum<eTb>::nan, P_n_elem);
+    
+    return;
+    }
+  
+  glue_quantile::multi_select(Y_mem, 0, Y_n_elem, ranks.memptr(), ranks.n_elem);
+  
   const eTb alpha = 0.5;
-  const eTb N     = eTb(Y.n_elem);
+  const eTb N     = eTb(Y_n_elem);
   const eTb P_min = (eTb(1) - alpha) / N;
   const eTb P_max = (N      - alpha) / N;
   
@@ -51,12 +130,12 @@ glue_quantile::worker(eTb* out_mem, Col<eTa>& Y, const Mat<eTb>& P)
     
     if(P_i < P_min)
       {
-      out_val = (P_i < eTb(0)) ? eTb(-std::numeric_limits<eTb>::infinity()) : eTb(Y.min());
+      out_val = (P_i < eTb(0)) ? eTb(-std::numeric_limits<eTb>::infinity()) : eTb(op_min::direct_min(Y_mem, Y_n_elem));
       }
     else
     if(P_i > P_max)
       {
-      out_val = (P_i > eTb(1)) ? eTb( std::numeric_limits<eTb>::infinity()) : eTb(Y.max());
+      out_val = (P_i > eTb(1)) ? eTb( std::numeric_limits<eTb>::infinity()) : eTb(op_max::direct_max(Y_mem, Y_n_elem));
       }
     else
       {
@@ -65,16 +144,7 @@ glue_quantile::worker(eTb* out_mem, Col<eTa>& Y, const Mat<eTb>& P)
       
       const eTb w = (P_i - P_k) * N;
       
-      eTa* Y_k_ptr = Y.begin() + uword(k);
-      std::nth_element( Y.begin(), Y_k_ptr, Y.end() );
-      const eTa Y_k_val = (*Y_k_ptr);
-      
-      eTa* Y_km1_ptr = Y.begin() + uword(k-1);
-      // std::nth_element( Y.begin(), Y_km1_ptr, Y.end() );
-      std::nth_element( Y.begin(), Y_km1_ptr, Y_k_ptr );
-      const eTa Y_km1_val = (*Y_km1_ptr);
-      
-      out_val = ((eTb(1) - w) * Y_km1_val) + (w * Y_k_val);
+      out_val = (k < Y_n_elem) ? ( ((eTb(1) - w) * Y_mem[k-1]) + (w * Y_mem[k]) ) : eTb(Y_mem[k-1]);
       }
     
     out_mem[i] = out_val;
@@ -83,6 +153,60 @@ glue_quantile::worker(eTb* out_mem, Col<eTa>& Y, const Mat<eTb>& P)
 
 
 
+template<typename eTa, typename eTb>
+inline
+void
+glue_quantile::apply_cols(Mat<eTb>& out, const Mat<eTa>& X, const Mat<eTb>& P, const uvec& ranks, const uword col_start, const uword col_end, eTa* scratch)
+  {
+  arma_extra_debug_sigprint();
+  
+  const uword X_n_rows = X.n_rows;
+  
+  for(uword col=col_start; col < col_end; ++col)
+    {
+    arrayops::copy(scratch, X.colptr(col), X_n_rows);
+    
+    glue_quantile::worker(out.colptr(col), scratch, X_n_rows, P, ranks);
+    }
+  }
+
+
+
+//! the rows are copied in blocks, so that the elements of each column are read contiguously;
+//! scratch must have space for row_block_size rows, and out_scratch must have P.n_elem elements
+template<typename eTa, typename eTb>
+inline
+void
+glue_quantile::apply_rows(Mat<eTb>& out, const Mat<eTa>& X, const Mat<eTb>& P, const uvec& ranks, const uword row_start, const uword row_end, eTa* scratch, eTb* out_scratch)
+  {
+  arma_extra_debug_sigprint();
+  
+  const uword X_n_cols = X.n_cols;
+  const uword P_n_elem = P.n_elem;
+  
+  for(uword blk_start=row_start; blk_start < row_end; blk_start += glue_quantile::row_block_size)
+    {
+    const uword blk_n_rows = (std::min)(uword(glue_quantile::row_block_size), row_end - blk_start);
+    
+    for(uword col=0; col < X_n_cols; ++col)
+      {
+      const eTa* X_colptr = X.colptr(col) + blk_start;
+      
+      for(uword r=0; r < blk_n_rows; ++r)  { scratch[r*X_n_cols + col] = X_colptr[r]; }
+      }
+    
+    for(uword r=0; r < blk_n_rows; ++r)
+      {
+      glue_quantile::worker(out_scratch, &(scratch[r*X_n_cols]), X_n_cols, P, ranks);
+      
+      for(uword i=0; i < P_n_elem; ++i)  { out.at(blk_start + r, i) = out_scratch[i]; }
+      }
+    }
+  }
+
+
+
+//! the columns (dim=0) or rows (dim=1) are split between threads, with each thread using its own scratch space
 template<typename eTa, typename eTb>
 inline
 void
@@ -92,6 +216,8 @@ glue_quantile::apply_noalias(Mat<eTb>& out, const Mat<eTa>& X, const Mat<eTb>& P
   
   arma_debug_check( ((P.is_vec() == false) && (P.is_empty() == false)), "quantile(): parameter 'P' must be a vector" );
   
+  arma_debug_check( P.has_nan(), "quantile(): parameter 'P' must not have NaN elements" );
+  
   if(X.is_empty())  { out.reset(); return; }
   
   const uword X_n_rows = X.n_rows;
@@ -105,23 +231,33 @@ glue_quantile::apply_noalias(Mat<eTb>& out, const Mat<eTa>& X, const Mat<eTb>& P
     
     if(out.is_empty())  { return; }
     
-    Col<eTa> Y(X_n_rows);
+    const uvec ranks = glue_quantile::get_ranks(P, X_n_rows);
     
-    if(X_n_cols == 1)
-      {
-      arrayops::copy(Y.memptr(), X.memptr(), X_n_rows);
-      
-      glue_quantile::worker(out.memptr(), Y, P);
-      }
-    else
+    #if defined(ARMA_USE_OPENMP)
       {
-      for(uword col=0; col < X_n_cols; ++col)
+      if( (X_n_cols > 1) && mp_gate<eTa>::eval(X.n_elem) )
         {
-        arrayops::copy(Y.memptr(), X.colptr(col), X_n_rows);
+        const uword n_threads = (std::min)( uword(mp_thread_limit::get()), X_n_cols );
         
-        glue_quantile::worker(out.colptr(col), Y, P);
+        Mat<eTa> scratch(X_n_rows, n_threads);
+        
+        #pragma omp parallel for schedule(static) num_threads(int(n_threads))
+        for(uword t=0; t < n_threads; ++t)
+          {
+          const uword col_start = (t    * X_n_cols) / n_threads;
+          const uword col_end   = ((t+1) * X_n_cols) / n_threads;
+          
+          glue_quantile::apply_cols(out, X, P, ranks, col_start, col_end, scratch.colptr(t));
+          }
+        
+        return;
         }
       }
+    #endif
+    
+    podarray<eTa> scratch(X_n_rows);
+    
+    glue_quantile::apply_cols(out, X, P, ranks, 0, X_n_cols, scratch.memptr());
     }
   else
   if(dim == 1)
@@ -130,31 +266,37 @@ glue_quantile::apply_noalias(Mat<eTb>& out, const Mat<eTa>& X, const Mat<eTb>& P
     
     if(out.is_empty())  { return; }
     
-    Col<eTa> Y(X_n_cols);
+    const uvec ranks = glue_quantile::get_ranks(P, X_n_cols);
     
-    if(X_n_rows == 1)
-      {
-      arrayops::copy(Y.memptr(), X.memptr(), X_n_cols);
-      
-      glue_quantile::worker(out.memptr(), Y, P);
-      }
-    else
+    const uword scratch_n_elem = (std::min)(X_n_rows, uword(glue_quantile::row_block_size)) * X_n_cols;
+    
+    #if defined(ARMA_USE_OPENMP)
       {
-      Col<eTb> tmp(P_n_elem);
-      
-      eTb* tmp_mem = tmp.memptr();
-      
-      for(uword row=0; row < X_n_rows; ++row)
+      if( (X_n_rows > 1) && mp_gate<eTa>::eval(X.n_elem) )
         {
-        eTa* Y_mem = Y.memptr();
+        const uword n_threads = (std::min)( uword(mp_thread_limit::get()), X_n_rows );
         
-        for(uword col=0; col < X_n_cols; ++col)  { Y_mem[col] = X.at(row,col); }
+        Mat<eTa> scratch(scratch_n_elem, n_threads);
+        Mat<eTb> out_scratch(P_n_elem,   n_threads);
         
-        glue_quantile::worker(tmp_mem, Y, P);
+        #pragma omp parallel for schedule(static) num_threads(int(n_threads))
+        for(uword t=0; t < n_threads; ++t)
+          {
+          const uword row_start = (t    * X_n_rows) / n_threads;
+          const uword row_end   = ((t+1) * X_n_rows) / n_threads;
+          
+          glue_quantile::apply_rows(out, X, P, ranks, row_start, row_end, scratch.colptr(t), out_scratch.colptr(t));
+          }
         
-        for(uword i=0; i < P_n_elem; ++i)  { out.at(row,i) = tmp_mem[i]; }
+        return;
         }
       }
+    #endif
+    
+    podarray<eTa> scratch(scratch_n_elem);
+    podarray<eTb> out_scratch(P_n_elem);
+    
+    glue_quantile::apply_rows(out, X, P, ranks, 0, X_n_rows, scratch.memptr(), out_scratch.memptr());
     }
   }
 
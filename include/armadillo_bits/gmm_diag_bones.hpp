@@ -95,6 +95,17 @@ class gmm_diag
     const bool            print_mode
     );
   
+  template<typename T1>
+  inline
+  bool
+  learn_batch
+    (
+    const Base<eT,T1>&    data,
+    const uword           batch_id,
+    const eT              var_floor,
+    const eT              decay = eT(0.6)
+    );
+  
   
   template<typename T1>
   inline
@@ -109,6 +120,19 @@ class gmm_diag
     const bool            print_mode
     );
   
+  template<typename functor>
+  inline
+  bool
+  kmeans_minibatch_wrapper
+    (
+           Mat<eT>&       user_means,
+           functor&       get_batch,
+    const uword           n_gaus,
+    const gmm_seed_mode&  seed_mode,
+    const uword           n_iter,
+    const bool            print_mode
+    );
+  
   
   //
   
@@ -118,6 +142,11 @@ class gmm_diag
   arma_aligned Row<eT> log_det_etc;
   arma_aligned Row<eT> log_hefts;
   arma_aligned Col<eT> mah_aux;
+  arma_aligned Mat<eT> blk_coeffs;  // [ (mean - blk_centre) % inv_dcov ; -0.5*inv_dcov ] for each gaussian, stored as rows
+  arma_aligned Col<eT> blk_consts;  // log_det_etc - 0.5*sum((mean - blk_centre)^2 % inv_dcov) for each gaussian
+  arma_aligned Col<eT> blk_centre;
+  
+  static constexpr uword block_size = 256;  // number of samples processed together by internal_block_scores()
   
   //
   
@@ -130,6 +159,14 @@ class gmm_diag
   
   inline umat internal_gen_boundaries(const uword N) const;
   
+  inline bool internal_use_blocks(const uword N) const;
+  
+  inline void internal_block_scores(Mat<eT>& out, const Mat<eT>& X, const uword start_index, const uword end_index, const Mat<eT>& coeffs, const Col<eT>& offsets, const bool quadratic, Mat<eT>& tmp) const;
+  
+  inline void internal_range_log_p(eT* out, const Mat<eT>& X, const uword start_index, const uword end_index) const;
+  
+  inline void internal_range_assign(uword* out, const Mat<eT>& X, const uword start_index, const uword end_index, const gmm_dist_mode& dist_mode) const;
+  
   inline eT internal_scalar_log_p(const eT* x                     ) const;
   inline eT internal_scalar_log_p(const eT* x, const uword gaus_id) const;
   
@@ -156,12 +193,20 @@ class gmm_diag
   
   template<uword dist_id> inline bool km_iterate(const Mat<eT>& X, const uword max_iter, const bool verbose, const char* signature);
   
+  template<uword dist_id> inline uword km_assign(const Mat<eT>& X, const Mat<eT>& old_means, const uword start_index, const uword end_index, const bool full_search, const Mat<eT>& mean_info, const Mat<uword>& nbr_ids, const Mat<eT>& nbr_dists, uword* assign_mem, eT* upper_mem, eT* lower_mem, Mat<eT>& acc_means, uword* acc_hefts_mem, uword* last_indx_mem) const;
+  
+  inline eT km_minibatch_update(const Mat<eT>& X, Col<uword>& counts);
+  
   //
   
   inline bool em_iterate(const Mat<eT>& X, const uword max_iter, const eT var_floor, const bool verbose);
   
+  inline bool em_step(const Mat<eT>& X, const eT step_size, const eT var_floor);
+  
   inline void em_update_params(const Mat<eT>& X, const umat& boundaries, field< Mat<eT> >& t_acc_means, field< Mat<eT> >& t_acc_dcovs, field< Col<eT> >& t_acc_norm_lhoods, field< Col<eT> >& t_gaus_log_lhoods, Col<eT>& t_progress_log_lhoods);
   
+  inline void em_accumulate(const Mat<eT>& X, const umat& boundaries, field< Mat<eT> >& t_acc_means, field< Mat<eT> >& t_acc_dcovs, field< Col<eT> >& t_acc_norm_lhoods, field< Col<eT> >& t_gaus_log_lhoods, Col<eT>& t_progress_log_lhoods) const;
+  
   inline void em_generate_acc(const Mat<eT>& X, const uword start_index, const uword end_index, Mat<eT>& acc_means, Mat<eT>& acc_dcovs, Col<eT>& acc_norm_lhoods, Col<eT>& gaus_log_lhoods, eT& progress_log_lhood) const;
   
   inline void em_fix_params(const eT var_floor);
@@ -679,7 +679,9 @@ gmm_diag<eT>::learn
     || (seed_mode == static_subset)
     || (seed_mode == static_spread)
     || (seed_mode == random_subset)
-    || (seed_mode == random_spread);
+    || (seed_mode == random_spread)
+    || (seed_mode == random_plusplus)
+    || (seed_mode == random_scalable);
   
   arma_debug_check( (dist_mode_ok == false), "gmm_diag::learn(): dist_mode must be eucl_dist or maha_dist" );
   arma_debug_check( (seed_mode_ok == false), "gmm_diag::learn(): unknown seed_mode"                        );
@@ -788,6 +790,52 @@ gmm_diag<eT>::learn
 
 
 
+//! stepwise (online) EM: update an existing model using one batch of samples;
+//! the sufficient statistics implied by the current parameters are interpolated towards the statistics of the batch,
+//! using a step size of (batch_id+2)^(-decay)
+template<typename eT>
+template<typename T1>
+inline
+bool
+gmm_diag<eT>::learn_batch
+  (
+  const Base<eT,T1>& data,
+  const uword        batch_id,
+  const eT           var_floor,
+  const eT           decay
+  )
+  {
+  arma_extra_debug_sigprint();
+  
+  arma_debug_check( (var_floor < eT(0)                    ), "gmm_diag::learn_batch(): variance floor is negative"   );
+  arma_debug_check( ((decay < eT(0)) || (decay > eT(1))), "gmm_diag::learn_batch(): decay must be in the [0,1] interval" );
+  
+  const unwrap<T1>   tmp_X(data.get_ref());
+  const Mat<eT>& X = tmp_X.M;
+  
+  if(X.is_empty()          )  { arma_debug_warn("gmm_diag::learn_batch(): given matrix is empty"             ); return false; }
+  if(X.is_finite() == false)  { arma_debug_warn("gmm_diag::learn_batch(): given matrix has non-finite values"); return false; }
+  
+  if(means.is_empty()        )  { arma_debug_warn("gmm_diag::learn_batch(): no existing model"       ); return false; }
+  if(X.n_rows != means.n_rows)  { arma_debug_warn("gmm_diag::learn_batch(): dimensionality mismatch"); return false; }
+  
+  const eT var_floor_actual = (eT(var_floor) > eT(0)) ? eT(var_floor) : std::numeric_limits<eT>::min();
+  
+  const eT step_size = std::pow( eT(batch_id) + eT(2), -decay );
+  
+  const gmm_diag<eT> orig = (*this);
+  
+  const bool status = em_step(X, step_size, var_floor_actual);
+  
+  if(status == false)  { arma_debug_warn("gmm_diag::learn_batch(): EM update failed"); init(orig); return false; }
+  
+  init_constants();
+  
+  return true;
+  }
+
+
+
 template<typename eT>
 template<typename T1>
 inline
@@ -809,7 +857,9 @@ gmm_diag<eT>::kmeans_wrapper
     || (seed_mode == static_subset)
     || (seed_mode == static_spread)
     || (seed_mode == random_subset)
-    || (seed_mode == random_spread);
+    || (seed_mode == random_spread)
+    || (seed_mode == random_plusplus)
+    || (seed_mode == random_scalable);
   
   arma_debug_check( (seed_mode_ok == false), "kmeans(): unknown seed_mode" );
   
@@ -865,6 +915,117 @@ gmm_diag<eT>::kmeans_wrapper
 
 
 
+//! mini-batch k-means, as per Sculley, "Web-scale k-means clustering", WWW, 2010;
+//! get_batch(X) is called to obtain each batch of samples, and returns false when no more batches are available;
+//! the initial means are generated from the first batch
+template<typename eT>
+template<typename functor>
+inline
+bool
+gmm_diag<eT>::kmeans_minibatch_wrapper
+  (
+        Mat<eT>&       user_means,
+        functor&       get_batch,
+  const uword          N_gaus,
+  const gmm_seed_mode& seed_mode,
+  const uword          n_iter,
+  const bool           print_mode
+  )
+  {
+  arma_extra_debug_sigprint();
+  
+  const bool seed_mode_ok = \
+       (seed_mode == keep_existing)
+    || (seed_mode == static_subset)
+    || (seed_mode == static_spread)
+    || (seed_mode == random_subset)
+    || (seed_mode == random_spread)
+    || (seed_mode == random_plusplus)
+    || (seed_mode == random_scalable);
+  
+  arma_debug_check( (seed_mode_ok == false), "kmeans_minibatch(): unknown seed_mode" );
+  
+  Mat<eT> X;
+  
+  if( (get_batch(X) == false) || X.is_empty() )  { arma_debug_warn("kmeans_minibatch(): no data"                          ); return false; }
+  if( X.is_finite() == false                  )  { arma_debug_warn("kmeans_minibatch(): given data has non-finite values"); return false; }
+  
+  if(N_gaus == 0)  { reset(); return true; }
+  
+  
+  // initial means
+  
+  if(seed_mode == keep_existing)
+    {
+    access::rw(means) = user_means;
+    
+    if(means.is_empty()        )  { arma_debug_warn("kmeans_minibatch(): no existing means"      ); return false; }
+    if(X.n_rows != means.n_rows)  { arma_debug_warn("kmeans_minibatch(): dimensionality mismatch"); return false; }
+    }
+  else
+    {
+    if(X.n_cols < N_gaus)  { arma_debug_warn("kmeans_minibatch(): number of vectors in first batch is less than number of means"); return false; }
+    
+    access::rw(means).zeros(X.n_rows, N_gaus);
+    
+    if(print_mode)  { get_cout_stream() << "kmeans_minibatch(): generating initial means\n"; }
+    
+    generate_initial_means<1>(X, seed_mode);
+    }
+  
+  
+  // mini-batch updates
+  
+  const arma_ostream_state stream_state(get_cout_stream());
+  
+  if(print_mode)
+    {
+    get_cout_stream().unsetf(ios::showbase);
+    get_cout_stream().unsetf(ios::uppercase);
+    get_cout_stream().unsetf(ios::showpos);
+    get_cout_stream().unsetf(ios::scientific);
+    
+    get_cout_stream().setf(ios::right);
+    get_cout_stream().setf(ios::fixed);
+    }
+  
+  // number of samples assigned to each mean so far; the learning rate of each mean is the reciprocal of its count
+  Col<uword> counts(means.n_cols, fill::zeros);
+  
+  for(uword iter=1; iter <= n_iter; ++iter)
+    {
+    if(iter > 1)
+      {
+      if(get_batch(X) == false)  { break; }
+      
+      if(X.n_rows != means.n_rows)  { arma_debug_warn("kmeans_minibatch(): dimensionality mismatch"         ); return false; }
+      if(X.is_finite() == false  )  { arma_debug_warn("kmeans_minibatch(): given data has non-finite values"); return false; }
+      }
+    
+    const eT delta = km_minibatch_update(X, counts);
+    
+    if(print_mode)
+      {
+      get_cout_stream() << "kmeans_minibatch(): iteration: ";
+      get_cout_stream().setf(ios::fixed);
+      get_cout_stream().width(std::streamsize(4));
+      get_cout_stream() << iter;
+      get_cout_stream() << "   delta: ";
+      get_cout_stream().unsetf(ios::fixed);
+      get_cout_stream() << delta << '\n';
+      get_cout_stream().flush();
+      }
+    }
+  
+  stream_state.restore(get_cout_stream());
+  
+  if(means.is_finite() == false)  { arma_debug_warn("kmeans_minibatch(): clustering failed"); return false; }
+  
+  return true;
+  }
+
+
+
 //
 //
 //
@@ -998,6 +1159,36 @@ gmm_diag<eT>::init_constants()
     }
   
   log_hefts = log(hefts);
+  
+  // coefficients for evaluating the log-likelihoods of blocks of samples via matrix multiplication;
+  // the samples and means are shifted by blk_centre to reduce cancellation errors in the expansion of (x - mean)^2
+  
+  blk_centre = (N_gaus > 0) ? Col<eT>(mean(means, 1)) : Col<eT>(N_dims, fill::zeros);
+  
+  blk_coeffs.set_size(N_gaus, 2*N_dims);
+  blk_consts.set_size(N_gaus);
+  
+  const eT* blk_centre_mem = blk_centre.memptr();
+  
+  for(uword g=0; g < N_gaus; ++g)
+    {
+    const eT*     mean =     means.colptr(g);
+    const eT* inv_dcov = inv_dcovs.colptr(g);
+    
+    eT acc = eT(0);
+    
+    for(uword d=0; d < N_dims; ++d)
+      {
+      const eT tmp_mean = mean[d] - blk_centre_mem[d];
+      
+      blk_coeffs.at(g, d         ) = tmp_mean * inv_dcov[d];
+      blk_coeffs.at(g, d + N_dims) = eT(-0.5) * inv_dcov[d];
+      
+      acc += tmp_mean * tmp_mean * inv_dcov[d];
+      }
+    
+    blk_consts[g] = log_det_etc[g] - eT(0.5)*acc;
+    }
   }
 
 
@@ -1049,6 +1240,155 @@ gmm_diag<eT>::internal_gen_boundaries(const uword N) const
 
 
 
+//! the blocked evaluation is used when there are enough samples and gaussians to amortise setting up each block
+template<typename eT>
+inline
+bool
+gmm_diag<eT>::internal_use_blocks(const uword N) const
+  {
+  const uword N_gaus = means.n_cols;
+  
+  return ( (N >= 16) && (N_gaus >= 8) && ((N * N_gaus) >= 8192) );
+  }
+
+
+
+//! scores for samples start_index...end_index, with column i of out corresponding to sample start_index+i and row g to gaussian g;
+//! out = coeffs * [ x - blk_centre ; (x - blk_centre)^2 ] + offsets, with the squared terms only used if quadratic is true
+template<typename eT>
+inline
+void
+gmm_diag<eT>::internal_block_scores(Mat<eT>& out, const Mat<eT>& X, const uword start_index, const uword end_index, const Mat<eT>& coeffs, const Col<eT>& offsets, const bool quadratic, Mat<eT>& tmp) const
+  {
+  arma_extra_debug_sigprint();
+  
+  const uword N_dims = means.n_rows;
+  const uword N_blk  = (end_index - start_index) + 1;
+  
+  const eT* blk_centre_mem = blk_centre.memptr();
+  
+  tmp.set_size( (quadratic ? 2*N_dims : N_dims), N_blk );
+  
+  for(uword i=0; i < N_blk; ++i)
+    {
+    const eT* x       = X.colptr(start_index + i);
+          eT* tmp_mem = tmp.colptr(i);
+    
+    for(uword d=0; d < N_dims; ++d)  { tmp_mem[d] = x[d] - blk_centre_mem[d]; }
+    
+    if(quadratic)
+      {
+      for(uword d=0; d < N_dims; ++d)  { tmp_mem[d + N_dims] = tmp_mem[d] * tmp_mem[d]; }
+      }
+    }
+  
+  out = coeffs * tmp;
+  
+  out.each_col() += offsets;
+  }
+
+
+
+//! out[i] is the log-likelihood of sample start_index+i;
+//! the weighted log-likelihoods for each block of samples are obtained via one matrix multiply, followed by log-sum-exp over each column
+template<typename eT>
+inline
+void
+gmm_diag<eT>::internal_range_log_p(eT* out, const Mat<eT>& X, const uword start_index, const uword end_index) const
+  {
+  arma_extra_debug_sigprint();
+  
+  const Col<eT> offsets = blk_consts + log_hefts.t();
+  
+  Mat<eT> scores;
+  Mat<eT> tmp;
+  
+  for(uword blk_start = start_index; blk_start <= end_index; blk_start += block_size)
+    {
+    const uword blk_end = (std::min)(blk_start + block_size - 1, end_index);
+    
+    internal_block_scores(scores, X, blk_start, blk_end, blk_coeffs, offsets, true, tmp);
+    
+    const Row<eT> max_scores = max(scores, 0);
+    
+    scores.each_row() -= max_scores;
+    
+    const Row<eT> sum_exp = sum(exp(scores), 0);
+    
+    const uword N_blk = scores.n_cols;
+    
+    eT* out_mem = &(out[blk_start - start_index]);
+    
+    for(uword i=0; i < N_blk; ++i)
+      {
+      const eT max_score = max_scores[i];
+      
+      out_mem[i] = (max_score == -Datum<eT>::inf) ? max_score : (max_score + std::log(sum_exp[i]));
+      }
+    }
+  }
+
+
+
+//! out[i] is the gaussian closest to sample start_index+i, as per the given distance mode
+template<typename eT>
+inline
+void
+gmm_diag<eT>::internal_range_assign(uword* out, const Mat<eT>& X, const uword start_index, const uword end_index, const gmm_dist_mode& dist_mode) const
+  {
+  arma_extra_debug_sigprint();
+  
+  const uword N_gaus = means.n_cols;
+  
+  // for eucl_dist, maximising (mean - blk_centre)' (x - blk_centre) - 0.5*||mean - blk_centre||^2 minimises ||x - mean||^2
+  
+  const bool use_prob = (dist_mode == prob_dist);
+  
+  Mat<eT> coeffs;
+  Col<eT> offsets;
+  
+  if(use_prob)
+    {
+    offsets = blk_consts + log_hefts.t();
+    }
+  else
+    {
+    coeffs  = (means.each_col() - blk_centre).t();
+    offsets = eT(-0.5) * sum(square(coeffs), 1);
+    }
+  
+  Mat<eT> scores;
+  Mat<eT> tmp;
+  
+  for(uword blk_start = start_index; blk_start <= end_index; blk_start += block_size)
+    {
+    const uword blk_end = (std::min)(blk_start + block_size - 1, end_index);
+    
+    internal_block_scores(scores, X, blk_start, blk_end, (use_prob ? blk_coeffs : coeffs), offsets, use_prob, tmp);
+    
+    const uword N_blk = scores.n_cols;
+    
+    uword* out_mem = &(out[blk_start - start_index]);
+    
+    for(uword i=0; i < N_blk; ++i)
+      {
+      const eT* scores_mem = scores.colptr(i);
+      
+      eT    best_score = -Datum<eT>::inf;
+      uword best_g     = 0;
+      
+      for(uword g=0; g < N_gaus; ++g)
+        {
+        if(scores_mem[g] >= best_score)  { best_score = scores_mem[g]; best_g = g; }
+        }
+      
+      out_mem[i] = best_g;
+      }
+    }
+  }
+
+
+
 template<typename eT>
 arma_hot
 inline
@@ -1137,6 +1477,30 @@ gmm_diag<eT>::internal_vec_log_p(const Mat<eT>& X) const
   
   Row<eT> out(N);
   
+  if( (N > 0) && internal_use_blocks(N) )
+    {
+    #if defined(ARMA_USE_OPENMP)
+      {
+      const umat boundaries = internal_gen_boundaries(N);
+      
+      const uword n_threads = boundaries.n_cols;
+      
+      #pragma omp parallel for schedule(static)
+      for(uword t=0; t < n_threads; ++t)
+        {
+        const uword start_index = boundaries.at(0,t);
+        const uword   end_index = boundaries.at(1,t);
+        
+        internal_range_log_p(out.memptr() + start_index, X, start_index, end_index);
+        }
+      }
+    #else
+      {
+      internal_range_log_p(out.memptr(), X, 0, N-1);
+      }
+    #endif
+    }
+  else
   if(N > 0)
     {
     #if defined(ARMA_USE_OPENMP)
@@ -1242,6 +1606,8 @@ gmm_diag<eT>::internal_sum_log_p(const Mat<eT>& X) const
   
   if(N == 0)  { return (-Datum<eT>::inf); }
   
+  if(internal_use_blocks(N))  { return eT(accu(internal_vec_log_p(X))); }
+  
   
   #if defined(ARMA_USE_OPENMP)
     {
@@ -1355,6 +1721,8 @@ gmm_diag<eT>::internal_avg_log_p(const Mat<eT>& X) const
   
   if(N == 0)  { return (-Datum<eT>::inf); }
   
+  if(internal_use_blocks(N))  { return eT(mean(internal_vec_log_p(X))); }
+  
   
   #if defined(ARMA_USE_OPENMP)
     {
@@ -1551,24 +1919,48 @@ gmm_diag<eT>::internal_vec_assign(urowvec& out, const Mat<eT>& X, const gmm_dist
   
   uword* out_mem = out.memptr();
   
-  if(dist_mode == eucl_dist)
+  if( ((dist_mode == eucl_dist) || (dist_mode == prob_dist)) && internal_use_blocks(X_n_cols) )
     {
     #if defined(ARMA_USE_OPENMP)
       {
+      const umat boundaries = internal_gen_boundaries(X_n_cols);
+      
+      const uword n_threads = boundaries.n_cols;
+      
       #pragma omp parallel for schedule(static)
-      for(uword i=0; i<X_n_cols; ++i)
+      for(uword t=0; t < n_threads; ++t)
         {
-        const eT* X_colptr = X.colptr(i);
-        
-        eT    best_dist = Datum<eT>::inf;
-        uword best_g    = 0;
-        
-        for(uword g=0; g<N_gaus; ++g)
-          {
-          const eT tmp_dist = distance<eT,1>::eval(N_dims, X_colptr, means.colptr(g), X_colptr);
-          
-          if(tmp_dist <= best_dist)  { best_dist = tmp_dist;  best_g = g; }
-          }
+        const uword start_index = boundaries.at(0,t);
+        const uword   end_index = boundaries.at(1,t);
+        
+        internal_range_assign(out_mem + start_index, X, start_index, end_index, dist_mode);
+        }
+      }
+    #else
+      {
+      internal_range_assign(out_mem, X, 0, X_n_cols-1, dist_mode);
+      }
+    #endif
+    }
+  else
+  if(dist_mode == eucl_dist)
+    {
+    #if defined(ARMA_USE_OPENMP)
+      {
+      #pragma omp parallel for schedule(static)
+      for(uword i=0; i<X_n_cols; ++i)
+        {
+        const eT* X_colptr = X.colptr(i);
+        
+        eT    best_dist = Datum<eT>::inf;
+        uword best_g    = 0;
+        
+        for(uword g=0; g<N_gaus; ++g)
+          {
+          const eT tmp_dist = distance<eT,1>::eval(N_dims, X_colptr, means.colptr(g), X_colptr);
+          
+          if(tmp_dist <= best_dist)  { best_dist = tmp_dist;  best_g = g; }
+          }
         
         out_mem[i] = best_g;
         }
@@ -1667,6 +2059,20 @@ gmm_diag<eT>::internal_raw_hist(urowvec& hist, const Mat<eT>& X, const gmm_dist_
   
   if(N_gaus == 0)  { return; }
   
+  if( ((dist_mode == eucl_dist) || (dist_mode == prob_dist)) && internal_use_blocks(X_n_cols) )
+    {
+    urowvec labels;
+    
+    internal_vec_assign(labels, X, dist_mode);
+    
+    const uword* labels_mem = labels.memptr();
+          uword* hist_mem   = hist.memptr();
+    
+    for(uword i=0; i < X_n_cols; ++i)  { hist_mem[ labels_mem[i] ]++; }
+    
+    return;
+    }
+  
   #if defined(ARMA_USE_OPENMP)
     {
     const umat boundaries = internal_gen_boundaries(X_n_cols);
@@ -1884,6 +2290,16 @@ gmm_diag<eT>::generate_initial_means(const Mat<eT>& X, const gmm_seed_mode& seed
       access::rw(means).col(g) = X.unsafe_col(best_i);
       }
     }
+  else
+  if(seed_mode == random_plusplus)
+    {
+    km_seed<eT,dist_id>::plusplus(access::rw(means), X, mah_aux.memptr());
+    }
+  else
+  if(seed_mode == random_scalable)
+    {
+    km_seed<eT,dist_id>::scalable(access::rw(means), X, mah_aux.memptr());
+    }
   
   // get_cout_stream() << "generate_initial_means():" << '\n';
   // means.print();
@@ -2043,7 +2459,8 @@ gmm_diag<eT>::generate_initial_params(const Mat<eT>& X, const eT var_floor)
 
 
 
-//! multi-threaded implementation of k-means, inspired by MapReduce
+//! multi-threaded implementation of k-means, inspired by MapReduce;
+//! distance calculations are avoided where possible via the bounds in Hamerly, "Making k-means even faster", SDM, 2010
 template<typename eT>
 template<uword dist_id>
 inline
@@ -2079,6 +2496,21 @@ gmm_diag<eT>::km_iterate(const Mat<eT>& X, const uword max_iter, const bool verb
   Mat<eT> new_means = means;
   Mat<eT> old_means = means;
   
+  // per sample: assigned mean, upper bound on the distance to the assigned mean, lower bound on the distance to all other means;
+  // per mean (rows of mean_info): distance moved in the last iteration, largest distance moved by any other mean, half the distance to the closest other mean;
+  // per mean (columns of nbr_ids and nbr_dists): the closest other means and their distances, in ascending order of distance
+  
+  Col<uword> assign_ids(X_n_cols, fill::zeros);
+  Col<eT>    upper_bnds(X_n_cols, fill::zeros);
+  Col<eT>    lower_bnds(X_n_cols, fill::zeros);
+  
+  Mat<eT> mean_info(3, N_gaus, fill::zeros);
+  
+  const uword N_nbrs = (std::min)( uword(N_gaus-1), uword(256) );
+  
+  Mat<uword> nbr_ids  (N_nbrs, N_gaus);
+  Mat<eT>    nbr_dists(N_nbrs, N_gaus);
+  
   running_mean_scalar<eT> rs_delta;
   
   #if defined(ARMA_USE_OPENMP)
@@ -2088,6 +2520,8 @@ gmm_diag<eT>::km_iterate(const Mat<eT>& X, const uword max_iter, const bool verb
     field< Mat<eT>    > t_acc_means(n_threads);
     field< Row<uword> > t_acc_hefts(n_threads);
     field< Row<uword> > t_last_indx(n_threads);
+    
+    Col<uword> t_n_calcs(n_threads);
   #else
     const uword n_threads = 1;
   #endif
@@ -2096,6 +2530,43 @@ gmm_diag<eT>::km_iterate(const Mat<eT>& X, const uword max_iter, const bool verb
   
   for(uword iter=1; iter <= max_iter; ++iter)
     {
+    const bool full_search = (iter == 1);
+    
+    if(full_search == false)
+      {
+      #if defined(ARMA_USE_OPENMP)
+        #pragma omp parallel for schedule(static)
+      #endif
+      for(uword g=0; g < N_gaus; ++g)
+        {
+        std::vector< arma_sort_index_packet<eT> > packets(N_gaus-1);
+        
+        uword count = 0;
+        
+        for(uword h=0; h < N_gaus; ++h)
+          {
+          if(h == g)  { continue; }
+          
+          packets[count].val   = std::sqrt( distance<eT,dist_id>::eval(N_dims, old_means.colptr(g), old_means.colptr(h), mah_aux_mem) );
+          packets[count].index = h;
+          
+          ++count;
+          }
+        
+        std::partial_sort( packets.begin(), packets.begin() + N_nbrs, packets.end(), arma_sort_index_helper_ascend<eT>() );
+        
+        for(uword j=0; j < N_nbrs; ++j)
+          {
+          nbr_ids.at(j,g)   = packets[j].index;
+          nbr_dists.at(j,g) = packets[j].val;
+          }
+        
+        mean_info.at(2,g) = (N_nbrs > 0) ? eT(0.5) * nbr_dists.at(0,g) : Datum<eT>::inf;
+        }
+      }
+    
+    uword n_calcs = 0;
+    
     #if defined(ARMA_USE_OPENMP)
       {
       for(uword t=0; t < n_threads; ++t)
@@ -2108,34 +2579,10 @@ gmm_diag<eT>::km_iterate(const Mat<eT>& X, const uword max_iter, const bool verb
       #pragma omp parallel for schedule(static)
       for(uword t=0; t < n_threads; ++t)
         {
-        Mat<eT>& t_acc_means_t   = t_acc_means(t);
-        uword*   t_acc_hefts_mem = t_acc_hefts(t).memptr();
-        uword*   t_last_indx_mem = t_last_indx(t).memptr();
-        
         const uword start_index = boundaries.at(0,t);
         const uword   end_index = boundaries.at(1,t);
         
-        for(uword i=start_index; i <= end_index; ++i)
-          {
-          const eT* X_colptr = X.colptr(i);
-          
-          eT     min_dist = Datum<eT>::inf;
-          uword  best_g   = 0;
-          
-          for(uword g=0; g<N_gaus; ++g)
-            {
-            const eT dist = distance<eT,dist_id>::eval(N_dims, X_colptr, old_means.colptr(g), mah_aux_mem);
-            
-            if(dist < min_dist)  { min_dist = dist;  best_g = g; }
-            }
-          
-          eT* t_acc_mean = t_acc_means_t.colptr(best_g);
-          
-          for(uword d=0; d<N_dims; ++d)  { t_acc_mean[d] += X_colptr[d]; }
-          
-          t_acc_hefts_mem[best_g]++;
-          t_last_indx_mem[best_g] = i;
-          }
+        t_n_calcs[t] = km_assign<dist_id>(X, old_means, start_index, end_index, full_search, mean_info, nbr_ids, nbr_dists, assign_ids.memptr(), upper_bnds.memptr(), lower_bnds.memptr(), t_acc_means(t), t_acc_hefts(t).memptr(), t_last_indx(t).memptr());
         }
       
       // reduction
@@ -2154,33 +2601,15 @@ gmm_diag<eT>::km_iterate(const Mat<eT>& X, const uword max_iter, const bool verb
         {
         if( t_acc_hefts(t)(g) >= 1 )  { last_indx(g) = t_last_indx(t)(g); }
         }
+      
+      n_calcs = accu(t_n_calcs);
       }
     #else
       {
-      uword* acc_hefts_mem = acc_hefts.memptr();
-      uword* last_indx_mem = last_indx.memptr();
+      acc_means.zeros();
+      acc_hefts.zeros();
       
-      for(uword i=0; i < X_n_cols; ++i)
-        {
-        const eT* X_colptr = X.colptr(i);
-        
-        eT     min_dist = Datum<eT>::inf;
-        uword  best_g   = 0;
-        
-        for(uword g=0; g<N_gaus; ++g)
-          {
-          const eT dist = distance<eT,dist_id>::eval(N_dims, X_colptr, old_means.colptr(g), mah_aux_mem);
-          
-          if(dist < min_dist)  { min_dist = dist;  best_g = g; }
-          }
-        
-        eT* acc_mean = acc_means.colptr(best_g);
-        
-        for(uword d=0; d<N_dims; ++d)  { acc_mean[d] += X_colptr[d]; }
-        
-        acc_hefts_mem[best_g]++;
-        last_indx_mem[best_g] = i;
-        }
+      n_calcs = km_assign<dist_id>(X, old_means, 0, X_n_cols-1, full_search, mean_info, nbr_ids, nbr_dists, assign_ids.memptr(), upper_bnds.memptr(), lower_bnds.memptr(), acc_means, acc_hefts.memptr(), last_indx.memptr());
       }
     #endif
     
@@ -2247,11 +2676,26 @@ gmm_diag<eT>::km_iterate(const Mat<eT>& X, const uword max_iter, const bool verb
 
     rs_delta.reset();
     
+    eT    max_drift   = eT(0);
+    eT    max_drift_2 = eT(0);
+    uword max_drift_g = 0;
+    
     for(uword g=0; g < N_gaus; ++g)
       {
-      rs_delta( distance<eT,dist_id>::eval(N_dims, old_means.colptr(g), new_means.colptr(g), mah_aux_mem) );
+      const eT delta = distance<eT,dist_id>::eval(N_dims, old_means.colptr(g), new_means.colptr(g), mah_aux_mem);
+      
+      rs_delta(delta);
+      
+      const eT drift = std::sqrt(delta);
+      
+      mean_info.at(0,g) = drift;
+      
+           if(drift > max_drift  )  { max_drift_2 = max_drift; max_drift = drift; max_drift_g = g; }
+      else if(drift > max_drift_2)  { max_drift_2 = drift; }
       }
     
+    for(uword g=0; g < N_gaus; ++g)  { mean_info.at(1,g) = (g == max_drift_g) ? max_drift_2 : max_drift; }
+    
     if(verbose)
       {
       get_cout_stream() << signature << ": iteration: ";
@@ -2262,7 +2706,8 @@ gmm_diag<eT>::km_iterate(const Mat<eT>& X, const uword max_iter, const bool verb
       get_cout_stream() << "   delta: ";
       get_cout_stream().unsetf(ios::fixed);
       //get_cout_stream().setf(ios::scientific);
-      get_cout_stream() << rs_delta.mean() << '\n';
+      get_cout_stream() << rs_delta.mean();
+      get_cout_stream() << "   distance calculations: " << n_calcs << " of " << (X_n_cols * N_gaus) << '\n';
       get_cout_stream().flush();
       }
     
@@ -2280,6 +2725,290 @@ gmm_diag<eT>::km_iterate(const Mat<eT>& X, const uword max_iter, const bool verb
 
 
 
+//! assign samples start_index...end_index to their nearest means and accumulate the samples for each mean;
+//! the bounds from the previous iteration are used to skip samples which cannot have changed their assignment;
+//! otherwise the closest means of the currently assigned mean are examined first, in ascending order of distance,
+//! stopping once the remaining means cannot be closer than the two closest means found so far;
+//! returns the number of distance calculations
+template<typename eT>
+template<uword dist_id>
+inline
+uword
+gmm_diag<eT>::km_assign
+  (
+  const Mat<eT>&    X,
+  const Mat<eT>&    old_means,
+  const uword       start_index,
+  const uword         end_index,
+  const bool        full_search,
+  const Mat<eT>&    mean_info,
+  const Mat<uword>& nbr_ids,
+  const Mat<eT>&    nbr_dists,
+        uword*      assign_mem,
+        eT*         upper_mem,
+        eT*         lower_mem,
+        Mat<eT>&    acc_means,
+        uword*      acc_hefts_mem,
+        uword*      last_indx_mem
+  )
+  const
+  {
+  arma_extra_debug_sigprint();
+  
+  const uword N_dims = means.n_rows;
+  const uword N_gaus = means.n_cols;
+  const uword N_nbrs = nbr_ids.n_rows;
+  
+  const eT* mah_aux_mem = mah_aux.memptr();
+  
+  uword n_calcs = 0;
+  
+  for(uword i=start_index; i <= end_index; ++i)
+    {
+    const eT* X_colptr = X.colptr(i);
+    
+    uword best_g   = assign_mem[i];
+    eT    min_dist = Datum<eT>::inf;
+    
+    bool search     = full_search;
+    bool exhaustive = full_search;
+    
+    if(full_search == false)
+      {
+      eT upper_bnd = upper_mem[i] + mean_info.at(0,best_g);
+      eT lower_bnd = lower_mem[i] - mean_info.at(1,best_g);
+      
+      const eT threshold = (std::max)(mean_info.at(2,best_g), lower_bnd);
+      
+      if(upper_bnd > threshold)
+        {
+        min_dist  = distance<eT,dist_id>::eval(N_dims, X_colptr, old_means.colptr(best_g), mah_aux_mem);
+        upper_bnd = std::sqrt(min_dist);
+        
+        ++n_calcs;
+        
+        search = (upper_bnd > threshold);
+        }
+      
+      upper_mem[i] = upper_bnd;
+      lower_mem[i] = lower_bnd;
+      }
+    
+    if(search)
+      {
+      eT min_dist_2 = Datum<eT>::inf;
+      
+      if(exhaustive == false)
+        {
+        // upper_mem[i] is now the exact distance to the assigned mean;
+        // via the triangle inequality, dist(x, mean_g) >= dist(mean_assigned, mean_g) - dist(x, mean_assigned)
+        
+        const eT upper_bnd = upper_mem[i];
+        
+        const uword* nbr_ids_mem   = nbr_ids.colptr(best_g);
+        const eT*    nbr_dists_mem = nbr_dists.colptr(best_g);
+        
+        bool done = false;
+        
+        for(uword j=0; j < N_nbrs; ++j)
+          {
+          const eT bnd = nbr_dists_mem[j] - upper_bnd;
+          
+          if( (bnd > eT(0)) && ((bnd*bnd) > min_dist_2) )  { done = true; break; }
+          
+          const uword g = nbr_ids_mem[j];
+          
+          const eT dist = distance<eT,dist_id>::eval(N_dims, X_colptr, old_means.colptr(g), mah_aux_mem);
+          
+          ++n_calcs;
+          
+          // ties are resolved in favour of the mean with the lowest index
+          if( (dist < min_dist) || ((dist == min_dist) && (g < best_g)) )
+            {
+            min_dist_2 = min_dist; min_dist = dist; best_g = g;
+            }
+          else
+          if(dist < min_dist_2)
+            {
+            min_dist_2 = dist;
+            }
+          }
+        
+        // the means which are not in the list of neighbours are at least as far away as the last neighbour
+        if( (done == false) && (N_nbrs < (N_gaus-1)) )
+          {
+          const eT bnd = nbr_dists_mem[N_nbrs-1] - upper_bnd;
+          
+          exhaustive = ( (bnd <= eT(0)) || ((bnd*bnd) <= min_dist_2) );
+          }
+        }
+      
+      if(exhaustive)
+        {
+        min_dist   = Datum<eT>::inf;
+        min_dist_2 = Datum<eT>::inf;
+        
+        best_g = 0;
+        
+        for(uword g=0; g<N_gaus; ++g)
+          {
+          const eT dist = distance<eT,dist_id>::eval(N_dims, X_colptr, old_means.colptr(g), mah_aux_mem);
+          
+               if(dist < min_dist  )  { min_dist_2 = min_dist; min_dist = dist; best_g = g; }
+          else if(dist < min_dist_2)  { min_dist_2 = dist; }
+          }
+        
+        n_calcs += N_gaus;
+        }
+      
+      assign_mem[i] = best_g;
+      upper_mem[i]  = std::sqrt(min_dist);
+      lower_mem[i]  = std::sqrt(min_dist_2);
+      }
+    
+    eT* acc_mean = acc_means.colptr(best_g);
+    
+    for(uword d=0; d<N_dims; ++d)  { acc_mean[d] += X_colptr[d]; }
+    
+    acc_hefts_mem[best_g]++;
+    last_indx_mem[best_g] = i;
+    }
+  
+  return n_calcs;
+  }
+
+
+
+//! assign each sample in X to its nearest mean, and move each mean towards the average of its assigned samples,
+//! with a learning rate equal to the reciprocal of the number of samples assigned to the mean so far;
+//! the squared Euclidean distances are obtained via ||x||^2 - 2 m'x + ||m||^2, where m'x is computed for all samples and means by a single matrix multiply;
+//! returns the average squared distance moved by the means
+template<typename eT>
+inline
+eT
+gmm_diag<eT>::km_minibatch_update(const Mat<eT>& X, Col<uword>& counts)
+  {
+  arma_extra_debug_sigprint();
+  
+  const uword N_dims   = means.n_rows;
+  const uword N_gaus   = means.n_cols;
+  const uword X_n_cols = X.n_cols;
+  
+  if(X_n_cols == 0)  { return eT(0); }
+  
+  // ||x||^2 is the same for all means, so only 0.5*||m||^2 - m'x needs to be compared
+  
+  const Row<eT>  half_norms = eT(0.5) * sum(square(means), 0);
+  const Mat<eT>  cross      = means.t() * X;
+  
+  Col<uword> assign_ids(X_n_cols);
+  
+  const eT*    half_norms_mem = half_norms.memptr();
+        uword* assign_mem     = assign_ids.memptr();
+  
+  #if defined(ARMA_USE_OPENMP)
+    {
+    const umat boundaries = internal_gen_boundaries(X_n_cols);
+    const uword n_threads = boundaries.n_cols;
+    
+    #pragma omp parallel for schedule(static)
+    for(uword t=0; t < n_threads; ++t)
+      {
+      const uword start_index = boundaries.at(0,t);
+      const uword   end_index = boundaries.at(1,t);
+      
+      for(uword i=start_index; i <= end_index; ++i)
+        {
+        const eT* cross_colptr = cross.colptr(i);
+        
+        eT    min_dist = Datum<eT>::inf;
+        uword best_g   = 0;
+        
+        for(uword g=0; g < N_gaus; ++g)
+          {
+          const eT dist = half_norms_mem[g] - cross_colptr[g];
+          
+          if(dist < min_dist)  { min_dist = dist; best_g = g; }
+          }
+        
+        assign_mem[i] = best_g;
+        }
+      }
+    }
+  #else
+    {
+    for(uword i=0; i < X_n_cols; ++i)
+      {
+      const eT* cross_colptr = cross.colptr(i);
+      
+      eT    min_dist = Datum<eT>::inf;
+      uword best_g   = 0;
+      
+      for(uword g=0; g < N_gaus; ++g)
+        {
+        const eT dist = half_norms_mem[g] - cross_colptr[g];
+        
+        if(dist < min_dist)  { min_dist = dist; best_g = g; }
+        }
+      
+      assign_mem[i] = best_g;
+      }
+    }
+  #endif
+  
+  Mat<eT>    acc_means(N_dims, N_gaus, fill::zeros);
+  Col<uword> acc_hefts(N_gaus,         fill::zeros);
+  
+  for(uword i=0; i < X_n_cols; ++i)
+    {
+    const uword g = assign_mem[i];
+    
+    const eT* X_colptr = X.colptr(i);
+          eT* acc_mean = acc_means.colptr(g);
+    
+    for(uword d=0; d < N_dims; ++d)  { acc_mean[d] += X_colptr[d]; }
+    
+    acc_hefts[g]++;
+    }
+  
+  // applying the per-sample update m += (x - m) / count to all samples assigned to a mean
+  // is equivalent to m += (sum(x) - n*m) / count, where count includes the n new samples
+  
+  running_mean_scalar<eT> rs_delta;
+  
+  uword* counts_mem = counts.memptr();
+  
+  for(uword g=0; g < N_gaus; ++g)
+    {
+    const uword n = acc_hefts[g];
+    
+    if(n == 0)  { rs_delta(eT(0)); continue; }
+    
+    counts_mem[g] += n;
+    
+    const eT* acc_mean = acc_means.colptr(g);
+          eT* mean     = access::rw(means).colptr(g);
+    
+    const eT rate = eT(1) / eT(counts_mem[g]);
+    
+    eT delta = eT(0);
+    
+    for(uword d=0; d < N_dims; ++d)
+      {
+      const eT step = rate * (acc_mean[d] - eT(n) * mean[d]);
+      
+      mean[d] += step;
+      delta   += step*step;
+      }
+    
+    rs_delta(delta);
+    }
+  
+  return rs_delta.mean();
+  }
+
+
+
 //! multi-threaded implementation of Expectation-Maximisation, inspired by MapReduce
 template<typename eT>
 inline
@@ -2376,6 +3105,107 @@ gmm_diag<eT>::em_iterate(const Mat<eT>& X, const uword max_iter, const eT var_fl
 
 
 
+template<typename eT>
+inline
+bool
+gmm_diag<eT>::em_step(const Mat<eT>& X, const eT step_size, const eT var_floor)
+  {
+  arma_extra_debug_sigprint();
+  
+  const uword N_dims = means.n_rows;
+  const uword N_gaus = means.n_cols;
+  
+  const umat boundaries = internal_gen_boundaries(X.n_cols);
+  
+  const uword n_threads = boundaries.n_cols;
+  
+  field< Mat<eT> > t_acc_means(n_threads); 
+  field< Mat<eT> > t_acc_dcovs(n_threads);
+  
+  field< Col<eT> > t_acc_norm_lhoods(n_threads);
+  field< Col<eT> > t_gaus_log_lhoods(n_threads);
+  
+  Col<eT>          t_progress_log_lhood(n_threads);
+  
+  for(uword t=0; t<n_threads; t++)
+    {
+    t_acc_means[t].set_size(N_dims, N_gaus);
+    t_acc_dcovs[t].set_size(N_dims, N_gaus);
+    
+    t_acc_norm_lhoods[t].set_size(N_gaus);
+    t_gaus_log_lhoods[t].set_size(N_gaus);
+    }
+  
+  init_constants();
+  
+  em_accumulate(X, boundaries, t_acc_means, t_acc_dcovs, t_acc_norm_lhoods, t_gaus_log_lhoods, t_progress_log_lhood);
+  
+  if(arma_isfinite(accu(t_progress_log_lhood)) == false)  { return false; }
+  
+  Mat<eT>& final_acc_means = t_acc_means[0];
+  Mat<eT>& final_acc_dcovs = t_acc_dcovs[0];
+  
+  const Col<eT>& final_acc_norm_lhoods = t_acc_norm_lhoods[0];
+  
+  const eT batch_norm = eT(1) / eT(X.n_cols);
+  const eT old_weight = eT(1) - step_size;
+  
+  eT* hefts_mem = access::rw(hefts).memptr();
+  
+  // the sufficient statistics of the current model are heft, heft*mean and heft*(dcov + mean^2);
+  // conditionally update each component, as per em_update_params()
+  for(uword g=0; g < N_gaus; ++g)
+    {
+    const eT old_heft = hefts_mem[g];
+    const eT new_heft = (std::max)( old_weight * old_heft + step_size * batch_norm * final_acc_norm_lhoods[g], std::numeric_limits<eT>::min() );
+    
+    if(arma_isfinite(new_heft) == false)  { continue; }
+    
+    const eT* mean_mem = means.colptr(g);
+    const eT* dcov_mem = dcovs.colptr(g);
+    
+    eT* acc_mean_mem = final_acc_means.colptr(g);
+    eT* acc_dcov_mem = final_acc_dcovs.colptr(g);
+    
+    bool ok = true;
+    
+    for(uword d=0; d < N_dims; ++d)
+      {
+      const eT old_mean = mean_mem[d];
+      
+      const eT stat1 = old_weight * old_heft * old_mean                          + step_size * batch_norm * acc_mean_mem[d];
+      const eT stat2 = old_weight * old_heft * (dcov_mem[d] + old_mean*old_mean) + step_size * batch_norm * acc_dcov_mem[d];
+      
+      const eT tmp1 = stat1 / new_heft;
+      const eT tmp2 = stat2 / new_heft - tmp1*tmp1;
+      
+      acc_mean_mem[d] = tmp1;
+      acc_dcov_mem[d] = tmp2;
+      
+      if(arma_isfinite(tmp2) == false)  { ok = false; }
+      }
+    
+    if(ok)
+      {
+      hefts_mem[g] = new_heft;
+      
+      arrayops::copy(access::rw(means).colptr(g), acc_mean_mem, N_dims);
+      arrayops::copy(access::rw(dcovs).colptr(g), acc_dcov_mem, N_dims);
+      }
+    }
+  
+  em_fix_params(var_floor);
+  
+  if(any(vectorise(dcovs) <= eT(0)))  { return false; }
+  if(means.is_finite() == false    )  { return false; }
+  if(dcovs.is_finite() == false    )  { return false; }
+  if(hefts.is_finite() == false    )  { return false; }
+  
+  return true;
+  }
+
+
+
 
 template<typename eT>
 inline
@@ -2393,30 +3223,7 @@ gmm_diag<eT>::em_update_params
   {
   arma_extra_debug_sigprint();
   
-  const uword n_threads = boundaries.n_cols;
-  
-  
-  // em_generate_acc() is the "map" operation, which produces partial accumulators for means, diagonal covariances and hefts
-    
-  #if defined(ARMA_USE_OPENMP)
-    {
-    #pragma omp parallel for schedule(static)
-    for(uword t=0; t<n_threads; t++)
-      {
-      Mat<eT>& acc_means          = t_acc_means[t];
-      Mat<eT>& acc_dcovs          = t_acc_dcovs[t];
-      Col<eT>& acc_norm_lhoods    = t_acc_norm_lhoods[t];
-      Col<eT>& gaus_log_lhoods    = t_gaus_log_lhoods[t];
-      eT&      progress_log_lhood = t_progress_log_lhood[t];
-      
-      em_generate_acc(X, boundaries.at(0,t), boundaries.at(1,t), acc_means, acc_dcovs, acc_norm_lhoods, gaus_log_lhoods, progress_log_lhood);
-      }
-    }
-  #else
-    {
-    em_generate_acc(X, boundaries.at(0,0), boundaries.at(1,0), t_acc_means[0], t_acc_dcovs[0], t_acc_norm_lhoods[0], t_gaus_log_lhoods[0], t_progress_log_lhood[0]);
-    }
-  #endif
+  em_accumulate(X, boundaries, t_acc_means, t_acc_dcovs, t_acc_norm_lhoods, t_gaus_log_lhoods, t_progress_log_lhood);
   
   const uword N_dims = means.n_rows;
   const uword N_gaus = means.n_cols;
@@ -2427,17 +3234,6 @@ gmm_diag<eT>::em_update_params
   Col<eT>& final_acc_norm_lhoods = t_acc_norm_lhoods[0];
   
   
-  // the "reduce" operation, which combines the partial accumulators produced by the separate threads
-  
-  for(uword t=1; t<n_threads; t++)
-    {
-    final_acc_means += t_acc_means[t];
-    final_acc_dcovs += t_acc_dcovs[t];
-    
-    final_acc_norm_lhoods += t_acc_norm_lhoods[t];
-    }
-  
-  
   eT* hefts_mem = access::rw(hefts).memptr();
   
   
@@ -2506,6 +3302,63 @@ gmm_diag<eT>::em_update_params
 
 
 
+//! the combined accumulators are stored in t_acc_means[0], t_acc_dcovs[0] and t_acc_norm_lhoods[0]
+template<typename eT>
+inline
+void
+gmm_diag<eT>::em_accumulate
+  (
+  const Mat<eT>&          X,
+  const umat&             boundaries,
+        field< Mat<eT> >& t_acc_means,
+        field< Mat<eT> >& t_acc_dcovs,
+        field< Col<eT> >& t_acc_norm_lhoods,
+        field< Col<eT> >& t_gaus_log_lhoods,
+        Col<eT>&          t_progress_log_lhood
+  )
+  const
+  {
+  arma_extra_debug_sigprint();
+  
+  const uword n_threads = boundaries.n_cols;
+  
+  
+  // em_generate_acc() is the "map" operation, which produces partial accumulators for means, diagonal covariances and hefts
+    
+  #if defined(ARMA_USE_OPENMP)
+    {
+    #pragma omp parallel for schedule(static)
+    for(uword t=0; t<n_threads; t++)
+      {
+      Mat<eT>& acc_means          = t_acc_means[t];
+      Mat<eT>& acc_dcovs          = t_acc_dcovs[t];
+      Col<eT>& acc_norm_lhoods    = t_acc_norm_lhoods[t];
+      Col<eT>& gaus_log_lhoods    = t_gaus_log_lhoods[t];
+      eT&      progress_log_lhood = t_progress_log_lhood[t];
+      
+      em_generate_acc(X, boundaries.at(0,t), boundaries.at(1,t), acc_means, acc_dcovs, acc_norm_lhoods, gaus_log_lhoods, progress_log_lhood);
+      }
+    }
+  #else
+    {
+    em_generate_acc(X, boundaries.at(0,0), boundaries.at(1,0), t_acc_means[0], t_acc_dcovs[0], t_acc_norm_lhoods[0], t_gaus_log_lhoods[0], t_progress_log_lhood[0]);
+    }
+  #endif
+  
+  
+  // the "reduce" operation, which combines the partial accumulators produced by the separate threads
+  
+  for(uword t=1; t<n_threads; t++)
+    {
+    t_acc_means[0] += t_acc_means[t];
+    t_acc_dcovs[0] += t_acc_dcovs[t];
+    
+    t_acc_norm_lhoods[0] += t_acc_norm_lhoods[t];
+    }
+  }
+
+
+
 template<typename eT>
 inline
 void
@@ -95,6 +95,17 @@ class gmm_full
     const bool            print_mode
     );
   
+  template<typename T1>
+  inline
+  bool
+  learn_batch
+    (
+    const Base<eT,T1>&    data,
+    const uword           batch_id,
+    const eT              var_floor,
+    const eT              decay = eT(0.6)
+    );
+  
   
   //
   
@@ -106,6 +117,9 @@ class gmm_full
   arma_aligned Row<eT>  log_hefts;
   arma_aligned Col<eT>  mah_aux;
   arma_aligned Cube<eT> chol_fcovs;
+  arma_aligned Cube<eT> inv_chol_fcovs;
+  
+  static constexpr uword block_size = 256;  // number of samples processed together by internal_block_log_p()
   
   //
   
@@ -121,6 +135,14 @@ class gmm_full
   inline eT internal_scalar_log_p(const eT* x                     ) const;
   inline eT internal_scalar_log_p(const eT* x, const uword gaus_id) const;
   
+  inline void internal_block_log_p(eT* out, const Mat<eT>& X, const uword start_index, const uword end_index, const uword gaus_id, Mat<eT>& tmp_diff, Mat<eT>& tmp_prod) const;
+  inline void internal_block_log_p(Mat<eT>& out, const Mat<eT>& X, const uword start_index, const uword end_index, Mat<eT>& tmp_diff, Mat<eT>& tmp_prod) const;
+  
+  inline void internal_range_log_p(eT* out, const Mat<eT>& X, const uword start_index, const uword end_index) const;
+  inline void internal_range_log_p(eT* out, const Mat<eT>& X, const uword start_index, const uword end_index, const uword gaus_id) const;
+  
+  inline void internal_range_assign(uword* out, const Mat<eT>& X, const uword start_index, const uword end_index) const;
+  
   inline Row<eT> internal_vec_log_p(const Mat<eT>& X                     ) const;
   inline Row<eT> internal_vec_log_p(const Mat<eT>& X, const uword gaus_id) const;
   
@@ -148,8 +170,12 @@ class gmm_full
   
   inline bool em_iterate(const Mat<eT>& X, const uword max_iter, const eT var_floor, const bool verbose);
   
+  inline bool em_step(const Mat<eT>& X, const eT step_size, const eT var_floor);
+  
   inline void em_update_params(const Mat<eT>& X, const umat& boundaries, field< Mat<eT> >& t_acc_means, field< Cube<eT> >& t_acc_fcovs, field< Col<eT> >& t_acc_norm_lhoods, field< Col<eT> >& t_gaus_log_lhoods, Col<eT>& t_progress_log_lhoods, const eT var_floor);
   
+  inline void em_accumulate(const Mat<eT>& X, const umat& boundaries, field< Mat<eT> >& t_acc_means, field< Cube<eT> >& t_acc_fcovs, field< Col<eT> >& t_acc_norm_lhoods, field< Col<eT> >& t_gaus_log_lhoods, Col<eT>& t_progress_log_lhoods) const;
+  
   inline void em_generate_acc(const Mat<eT>& X, const uword start_index, const uword end_index, Mat<eT>& acc_means, Cube<eT>& acc_fcovs, Col<eT>& acc_norm_lhoods, Col<eT>& gaus_log_lhoods, eT& progress_log_lhood) const;
   
   inline void em_fix_params(const eT var_floor);
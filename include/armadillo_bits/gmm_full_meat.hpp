@@ -718,7 +718,9 @@ gmm_full<eT>::learn
     || (seed_mode == static_subset)
     || (seed_mode == static_spread)
     || (seed_mode == random_subset)
-    || (seed_mode == random_spread);
+    || (seed_mode == random_spread)
+    || (seed_mode == random_plusplus)
+    || (seed_mode == random_scalable);
   
   arma_debug_check( (dist_mode_ok == false), "gmm_full::learn(): dist_mode must be eucl_dist or maha_dist" );
   arma_debug_check( (seed_mode_ok == false), "gmm_full::learn(): unknown seed_mode"                        );
@@ -827,6 +829,52 @@ gmm_full<eT>::learn
 
 
 
+//! stepwise (online) EM: update an existing model using one batch of samples;
+//! the sufficient statistics implied by the current parameters are interpolated towards the statistics of the batch,
+//! using a step size of (batch_id+2)^(-decay)
+template<typename eT>
+template<typename T1>
+inline
+bool
+gmm_full<eT>::learn_batch
+  (
+  const Base<eT,T1>& data,
+  const uword        batch_id,
+  const eT           var_floor,
+  const eT           decay
+  )
+  {
+  arma_extra_debug_sigprint();
+  
+  arma_debug_check( (var_floor < eT(0)                    ), "gmm_full::learn_batch(): variance floor is negative"   );
+  arma_debug_check( ((decay < eT(0)) || (decay > eT(1))), "gmm_full::learn_batch(): decay must be in the [0,1] interval" );
+  
+  const unwrap<T1>   tmp_X(data.get_ref());
+  const Mat<eT>& X = tmp_X.M;
+  
+  if(X.is_empty()          )  { arma_debug_warn("gmm_full::learn_batch(): given matrix is empty"             ); return false; }
+  if(X.is_finite() == false)  { arma_debug_warn("gmm_full::learn_batch(): given matrix has non-finite values"); return false; }
+  
+  if(means.is_empty()        )  { arma_debug_warn("gmm_full::learn_batch(): no existing model"       ); return false; }
+  if(X.n_rows != means.n_rows)  { arma_debug_warn("gmm_full::learn_batch(): dimensionality mismatch"); return false; }
+  
+  const eT var_floor_actual = (eT(var_floor) > eT(0)) ? eT(var_floor) : std::numeric_limits<eT>::min();
+  
+  const eT step_size = std::pow( eT(batch_id) + eT(2), -decay );
+  
+  const gmm_full<eT> orig = (*this);
+  
+  const bool status = em_step(X, step_size, var_floor_actual);
+  
+  if(status == false)  { arma_debug_warn("gmm_full::learn_batch(): EM update failed"); init(orig); return false; }
+  
+  init_constants();
+  
+  return true;
+  }
+
+
+
 //
 //
 //
@@ -925,34 +973,59 @@ gmm_full<eT>::init_constants(const bool calc_chol)
   //
   
   inv_fcovs.copy_size(fcovs);
+  inv_chol_fcovs.copy_size(fcovs);
   log_det_etc.set_size(N_gaus);
   
-  Mat<eT> tmp_inv;
+  if(calc_chol)  { chol_fcovs.copy_size(fcovs); }
+  
+  Mat<eT> tmp_chol;
+  Mat<eT> tmp_inv_chol;
   
   for(uword g=0; g < N_gaus; ++g)
     {
-    const Mat<eT>&     fcov =      fcovs.slice(g);
-          Mat<eT>& inv_fcov =  inv_fcovs.slice(g);
+    const Mat<eT>&          fcov =          fcovs.slice(g);
+          Mat<eT>&      inv_fcov =      inv_fcovs.slice(g);
+          Mat<eT>& inv_chol_fcov = inv_chol_fcovs.slice(g);
     
-  //const bool inv_ok = auxlib::inv(tmp_inv, fcov);
-    const bool inv_ok = auxlib::inv_sympd(tmp_inv, fcov);
+    // fcov = L * L.t(), so inv(fcov) = inv(L).t() * inv(L) and log(det(fcov)) = 2 * sum(log(diag(L)));
+    // the Mahalanobis distance is then the squared norm of inv(L) * (x - mean)
     
-    eT log_det_val  = eT(0);
-    eT log_det_sign = eT(0);
+    const uword chol_layout = 1;  // indicates "lower"
     
-    log_det(log_det_val, log_det_sign, fcov);
+    bool chol_ok = op_chol::apply_direct(tmp_chol, fcov, chol_layout);
     
-    const bool log_det_ok = ( (arma_isfinite(log_det_val)) && (log_det_sign > eT(0)) );
+    if(chol_ok)  { chol_ok = auxlib::inv_tr(tmp_inv_chol, tmp_chol, chol_layout); }
+    
+    eT log_det_val = eT(0);
     
-    if(inv_ok && log_det_ok)
+    if(chol_ok)
       {
-      inv_fcov = tmp_inv;
+      for(uword d=0; d < N_dims; ++d)
+        {
+        log_det_val += std::log(tmp_chol.at(d,d));
+        }
+      
+      log_det_val *= eT(2);
+      
+      chol_ok = ( (arma_isfinite(log_det_val)) && (tmp_inv_chol.is_finite()) );
+      }
+    
+    if(chol_ok)
+      {
+      inv_chol_fcov = tmp_inv_chol;
+      
+      inv_fcov = tmp_inv_chol.t() * tmp_inv_chol;
+      
+      if(calc_chol)  { chol_fcovs.slice(g) = tmp_chol; }
       }
     else
       {
       // last resort: treat the covariance matrix as diagonal
       
       inv_fcov.zeros();
+      inv_chol_fcov.zeros();
+      
+      if(calc_chol)  { chol_fcovs.slice(g).zeros(); }
       
       log_det_val = eT(0);
       
@@ -960,7 +1033,10 @@ gmm_full<eT>::init_constants(const bool calc_chol)
         {
         const eT sanitised_val = (std::max)( eT(fcov.at(d,d)), eT(std::numeric_limits<eT>::min()) );
         
-        inv_fcov.at(d,d) = eT(1) / sanitised_val;
+        inv_fcov.at(d,d)      = eT(1) / sanitised_val;
+        inv_chol_fcov.at(d,d) = eT(1) / std::sqrt(sanitised_val);
+        
+        if(calc_chol)  { chol_fcovs.slice(g).at(d,d) = std::sqrt(sanitised_val); }
         
         log_det_val += std::log(sanitised_val);
         }
@@ -979,42 +1055,6 @@ gmm_full<eT>::init_constants(const bool calc_chol)
     }
   
   log_hefts = log(hefts);
-  
-  
-  if(calc_chol)
-    {
-    chol_fcovs.copy_size(fcovs);
-    
-    Mat<eT> tmp_chol;
-    
-    for(uword g=0; g < N_gaus; ++g)
-      {
-      const Mat<eT>& fcov      =      fcovs.slice(g);
-            Mat<eT>& chol_fcov = chol_fcovs.slice(g);
-      
-      const uword chol_layout = 1;  // indicates "lower"
-      
-      const bool chol_ok = op_chol::apply_direct(tmp_chol, fcov, chol_layout);
-      
-      if(chol_ok)
-        {
-        chol_fcov = tmp_chol;
-        }
-      else
-        {
-        // last resort: treat the covariance matrix as diagonal
-        
-        chol_fcov.zeros();
-        
-        for(uword d=0; d < N_dims; ++d)
-          {
-          const eT sanitised_val = (std::max)( eT(fcov.at(d,d)), eT(std::numeric_limits<eT>::min()) );
-          
-          chol_fcov.at(d,d) = std::sqrt(sanitised_val);
-          }
-        }
-      }
-    }
   }
 
 
@@ -1131,6 +1171,192 @@ gmm_full<eT>::internal_scalar_log_p(const eT* x, const uword g) const
 
 
 
+//! log-likelihoods of samples start_index...end_index for one gaussian;
+//! the Mahalanobis distances for the whole block are obtained via one matrix multiply with the inverse Cholesky factor
+template<typename eT>
+inline
+void
+gmm_full<eT>::internal_block_log_p(eT* out, const Mat<eT>& X, const uword start_index, const uword end_index, const uword g, Mat<eT>& tmp_diff, Mat<eT>& tmp_prod) const
+  {
+  arma_extra_debug_sigprint();
+  
+  const uword N_dims = means.n_rows;
+  const uword N_blk  = (end_index - start_index) + 1;
+  
+  const eT* mean_mem = means.colptr(g);
+  
+  tmp_diff.set_size(N_dims, N_blk);
+  
+  for(uword i=0; i < N_blk; ++i)
+    {
+    const eT* x        = X.colptr(start_index + i);
+          eT* diff_mem = tmp_diff.colptr(i);
+    
+    for(uword d=0; d < N_dims; ++d)
+      {
+      diff_mem[d] = x[d] - mean_mem[d];
+      }
+    }
+  
+  tmp_prod = inv_chol_fcovs.slice(g) * tmp_diff;
+  
+  const eT log_det_val = log_det_etc.mem[g];
+  
+  for(uword i=0; i < N_blk; ++i)
+    {
+    const eT* prod_mem = tmp_prod.colptr(i);
+    
+    eT acc = eT(0);
+    
+    for(uword d=0; d < N_dims; ++d)
+      {
+      const eT val = prod_mem[d];
+      
+      acc += val*val;
+      }
+    
+    out[i] = eT(-0.5)*acc + log_det_val;
+    }
+  }
+
+
+
+//! log-likelihoods of samples start_index...end_index for all gaussians (excluding hefts);
+//! row i of out corresponds to sample start_index+i, and column g corresponds to gaussian g
+template<typename eT>
+inline
+void
+gmm_full<eT>::internal_block_log_p(Mat<eT>& out, const Mat<eT>& X, const uword start_index, const uword end_index, Mat<eT>& tmp_diff, Mat<eT>& tmp_prod) const
+  {
+  arma_extra_debug_sigprint();
+  
+  const uword N_gaus = means.n_cols;
+  const uword N_blk  = (end_index - start_index) + 1;
+  
+  out.set_size(N_blk, N_gaus);
+  
+  for(uword g=0; g < N_gaus; ++g)
+    {
+    internal_block_log_p(out.colptr(g), X, start_index, end_index, g, tmp_diff, tmp_prod);
+    }
+  }
+
+
+
+//! out[i] is the log-likelihood of sample start_index+i
+template<typename eT>
+inline
+void
+gmm_full<eT>::internal_range_log_p(eT* out, const Mat<eT>& X, const uword start_index, const uword end_index) const
+  {
+  arma_extra_debug_sigprint();
+  
+  const uword N_gaus = means.n_cols;
+  
+  if(N_gaus == 0)
+    {
+    arrayops::inplace_set(out, -Datum<eT>::inf, (end_index - start_index) + 1);
+    
+    return;
+    }
+  
+  const eT* log_hefts_mem = log_hefts.memptr();
+  
+  Mat<eT> blk_log_p;
+  Mat<eT> tmp_diff;
+  Mat<eT> tmp_prod;
+  
+  for(uword blk_start = start_index; blk_start <= end_index; blk_start += block_size)
+    {
+    const uword blk_end = (std::min)(blk_start + block_size - 1, end_index);
+    
+    internal_block_log_p(blk_log_p, X, blk_start, blk_end, tmp_diff, tmp_prod);
+    
+    const uword N_blk = blk_log_p.n_rows;
+    
+    eT* out_mem = &(out[blk_start - start_index]);
+    
+    for(uword i=0; i < N_blk; ++i)
+      {
+      eT log_sum = blk_log_p.at(i,0) + log_hefts_mem[0];
+      
+      for(uword g=1; g < N_gaus; ++g)
+        {
+        log_sum = log_add_exp(log_sum, blk_log_p.at(i,g) + log_hefts_mem[g]);
+        }
+      
+      out_mem[i] = log_sum;
+      }
+    }
+  }
+
+
+
+template<typename eT>
+inline
+void
+gmm_full<eT>::internal_range_log_p(eT* out, const Mat<eT>& X, const uword start_index, const uword end_index, const uword gaus_id) const
+  {
+  arma_extra_debug_sigprint();
+  
+  Mat<eT> tmp_diff;
+  Mat<eT> tmp_prod;
+  
+  for(uword blk_start = start_index; blk_start <= end_index; blk_start += block_size)
+    {
+    const uword blk_end = (std::min)(blk_start + block_size - 1, end_index);
+    
+    internal_block_log_p(&(out[blk_start - start_index]), X, blk_start, blk_end, gaus_id, tmp_diff, tmp_prod);
+    }
+  }
+
+
+
+//! out[i] is the gaussian with the highest weighted likelihood for sample start_index+i
+template<typename eT>
+inline
+void
+gmm_full<eT>::internal_range_assign(uword* out, const Mat<eT>& X, const uword start_index, const uword end_index) const
+  {
+  arma_extra_debug_sigprint();
+  
+  const uword N_gaus = means.n_cols;
+  
+  const eT* log_hefts_mem = log_hefts.memptr();
+  
+  Mat<eT> blk_log_p;
+  Mat<eT> tmp_diff;
+  Mat<eT> tmp_prod;
+  
+  for(uword blk_start = start_index; blk_start <= end_index; blk_start += block_size)
+    {
+    const uword blk_end = (std::min)(blk_start + block_size - 1, end_index);
+    
+    internal_block_log_p(blk_log_p, X, blk_start, blk_end, tmp_diff, tmp_prod);
+    
+    const uword N_blk = blk_log_p.n_rows;
+    
+    uword* out_mem = &(out[blk_start - start_index]);
+    
+    for(uword i=0; i < N_blk; ++i)
+      {
+      eT    best_p = -Datum<eT>::inf;
+      uword best_g = 0;
+      
+      for(uword g=0; g < N_gaus; ++g)
+        {
+        const eT tmp_p = blk_log_p.at(i,g) + log_hefts_mem[g];
+        
+        if(tmp_p >= best_p)  { best_p = tmp_p; best_g = g; }
+        }
+      
+      out_mem[i] = best_g;
+      }
+    }
+  }
+
+
+
 template<typename eT>
 inline
 Row<eT>
@@ -1159,22 +1385,12 @@ gmm_full<eT>::internal_vec_log_p(const Mat<eT>& X) const
         const uword start_index = boundaries.at(0,t);
         const uword   end_index = boundaries.at(1,t);
         
-        eT* out_mem = out.memptr();
-        
-        for(uword i=start_index; i <= end_index; ++i)
-          {
-          out_mem[i] = internal_scalar_log_p( X.colptr(i) );
-          }
+        internal_range_log_p(out.memptr() + start_index, X, start_index, end_index);
         }
       }
     #else
       {
-      eT* out_mem = out.memptr();
-      
-      for(uword i=0; i < N_samples; ++i)
-        {
-        out_mem[i] = internal_scalar_log_p( X.colptr(i) );
-        }
+      internal_range_log_p(out.memptr(), X, 0, N_samples-1);
       }
     #endif
     }
@@ -1213,22 +1429,12 @@ gmm_full<eT>::internal_vec_log_p(const Mat<eT>& X, const uword gaus_id) const
         const uword start_index = boundaries.at(0,t);
         const uword   end_index = boundaries.at(1,t);
         
-        eT* out_mem = out.memptr();
-        
-        for(uword i=start_index; i <= end_index; ++i)
-          {
-          out_mem[i] = internal_scalar_log_p( X.colptr(i), gaus_id );
-          }
+        internal_range_log_p(out.memptr() + start_index, X, start_index, end_index, gaus_id);
         }
       }
     #else
       {
-      eT* out_mem = out.memptr();
-      
-      for(uword i=0; i < N_samples; ++i)
-        {
-        out_mem[i] = internal_scalar_log_p( X.colptr(i), gaus_id );
-        }
+      internal_range_log_p(out.memptr(), X, 0, N_samples-1, gaus_id);
       }
     #endif
     }
@@ -1246,50 +1452,12 @@ gmm_full<eT>::internal_sum_log_p(const Mat<eT>& X) const
   arma_extra_debug_sigprint();
   
   arma_debug_check( (X.n_rows != means.n_rows), "gmm_full::sum_log_p(): incompatible dimensions" );
-    
-  const uword N = X.n_cols;
   
-  if(N == 0)  { return (-Datum<eT>::inf); }
+  if(X.n_cols == 0)  { return (-Datum<eT>::inf); }
   
+  const Row<eT> vals = internal_vec_log_p(X);
   
-  #if defined(ARMA_USE_OPENMP)
-    {
-    const umat boundaries = internal_gen_boundaries(N);
-    
-    const uword n_threads = boundaries.n_cols;
-    
-    Col<eT> t_accs(n_threads, fill::zeros);
-    
-    #pragma omp parallel for schedule(static)
-    for(uword t=0; t < n_threads; ++t)
-      {
-      const uword start_index = boundaries.at(0,t);
-      const uword   end_index = boundaries.at(1,t);
-      
-      eT t_acc = eT(0);
-      
-      for(uword i=start_index; i <= end_index; ++i)
-        {
-        t_acc += internal_scalar_log_p( X.colptr(i) );
-        }
-      
-      t_accs[t] = t_acc;
-      }
-    
-    return eT(accu(t_accs));
-    }
-  #else
-    {
-    eT acc = eT(0);
-    
-    for(uword i=0; i<N; ++i)
-      {
-      acc += internal_scalar_log_p( X.colptr(i) );
-      }
-    
-    return acc;
-    }
-  #endif
+  return eT(accu(vals));
   }
 
 
@@ -1303,50 +1471,12 @@ gmm_full<eT>::internal_sum_log_p(const Mat<eT>& X, const uword gaus_id) const
   
   arma_debug_check( (X.n_rows != means.n_rows), "gmm_full::sum_log_p(): incompatible dimensions"            );
   arma_debug_check( (gaus_id  >= means.n_cols), "gmm_full::sum_log_p(): specified gaussian is out of range" );
-    
-  const uword N = X.n_cols;
   
-  if(N == 0)  { return (-Datum<eT>::inf); }
+  if(X.n_cols == 0)  { return (-Datum<eT>::inf); }
   
+  const Row<eT> vals = internal_vec_log_p(X, gaus_id);
   
-  #if defined(ARMA_USE_OPENMP)
-    {
-    const umat boundaries = internal_gen_boundaries(N);
-    
-    const uword n_threads = boundaries.n_cols;
-    
-    Col<eT> t_accs(n_threads, fill::zeros);
-    
-    #pragma omp parallel for schedule(static)
-    for(uword t=0; t < n_threads; ++t)
-      {
-      const uword start_index = boundaries.at(0,t);
-      const uword   end_index = boundaries.at(1,t);
-      
-      eT t_acc = eT(0);
-      
-      for(uword i=start_index; i <= end_index; ++i)
-        {
-        t_acc += internal_scalar_log_p( X.colptr(i), gaus_id );
-        }
-      
-      t_accs[t] = t_acc;
-      }
-    
-    return eT(accu(t_accs));
-    }
-  #else
-    {
-    eT acc = eT(0);
-    
-    for(uword i=0; i<N; ++i)
-      {
-      acc += internal_scalar_log_p( X.colptr(i), gaus_id );
-      }
-    
-    return acc;
-    }
-  #endif
+  return eT(accu(vals));
   }
 
 
@@ -1358,63 +1488,13 @@ gmm_full<eT>::internal_avg_log_p(const Mat<eT>& X) const
   {
   arma_extra_debug_sigprint();
   
-  const uword N_dims    = means.n_rows;
-  const uword N_samples = X.n_cols;
-  
-  arma_debug_check( (X.n_rows != N_dims), "gmm_full::avg_log_p(): incompatible dimensions" );
+  arma_debug_check( (X.n_rows != means.n_rows), "gmm_full::avg_log_p(): incompatible dimensions" );
   
-  if(N_samples == 0)  { return (-Datum<eT>::inf); }
+  if(X.n_cols == 0)  { return (-Datum<eT>::inf); }
   
+  const Row<eT> vals = internal_vec_log_p(X);
   
-  #if defined(ARMA_USE_OPENMP)
-    {
-    const umat boundaries = internal_gen_boundaries(N_samples);
-    
-    const uword n_threads = boundaries.n_cols;
-    
-    field< running_mean_scalar<eT> > t_running_means(n_threads);
-    
-    
-    #pragma omp parallel for schedule(static)
-    for(uword t=0; t < n_threads; ++t)
-      {
-      const uword start_index = boundaries.at(0,t);
-      const uword   end_index = boundaries.at(1,t);
-      
-      running_mean_scalar<eT>& current_running_mean = t_running_means[t];
-      
-      for(uword i=start_index; i <= end_index; ++i)
-        {
-        current_running_mean( internal_scalar_log_p( X.colptr(i) ) );
-        }
-      }
-    
-    
-    eT avg = eT(0);
-    
-    for(uword t=0; t < n_threads; ++t)
-      {
-      running_mean_scalar<eT>& current_running_mean = t_running_means[t];
-      
-      const eT w = eT(current_running_mean.count()) / eT(N_samples);
-      
-      avg += w * current_running_mean.mean();
-      }
-    
-    return avg;
-    }
-  #else
-    {
-    running_mean_scalar<eT> running_mean;
-    
-    for(uword i=0; i < N_samples; ++i)
-      {
-      running_mean( internal_scalar_log_p( X.colptr(i) ) );
-      }
-    
-    return running_mean.mean();
-    }
-  #endif
+  return eT(mean(vals));
   }
 
 
@@ -1426,64 +1506,14 @@ gmm_full<eT>::internal_avg_log_p(const Mat<eT>& X, const uword gaus_id) const
   {
   arma_extra_debug_sigprint();
   
-  const uword N_dims    = means.n_rows;
-  const uword N_samples = X.n_cols;
-  
-  arma_debug_check( (X.n_rows != N_dims),       "gmm_full::avg_log_p(): incompatible dimensions"            );
+  arma_debug_check( (X.n_rows != means.n_rows), "gmm_full::avg_log_p(): incompatible dimensions"            );
   arma_debug_check( (gaus_id  >= means.n_cols), "gmm_full::avg_log_p(): specified gaussian is out of range" );
   
-  if(N_samples == 0)  { return (-Datum<eT>::inf); }
+  if(X.n_cols == 0)  { return (-Datum<eT>::inf); }
   
+  const Row<eT> vals = internal_vec_log_p(X, gaus_id);
   
-  #if defined(ARMA_USE_OPENMP)
-    {
-    const umat boundaries = internal_gen_boundaries(N_samples);
-    
-    const uword n_threads = boundaries.n_cols;
-    
-    field< running_mean_scalar<eT> > t_running_means(n_threads);
-    
-    
-    #pragma omp parallel for schedule(static)
-    for(uword t=0; t < n_threads; ++t)
-      {
-      const uword start_index = boundaries.at(0,t);
-      const uword   end_index = boundaries.at(1,t);
-      
-      running_mean_scalar<eT>& current_running_mean = t_running_means[t];
-      
-      for(uword i=start_index; i <= end_index; ++i)
-        {
-        current_running_mean( internal_scalar_log_p( X.colptr(i), gaus_id) );
-        }
-      }
-    
-    
-    eT avg = eT(0);
-    
-    for(uword t=0; t < n_threads; ++t)
-      {
-      running_mean_scalar<eT>& current_running_mean = t_running_means[t];
-      
-      const eT w = eT(current_running_mean.count()) / eT(N_samples);
-      
-      avg += w * current_running_mean.mean();
-      }
-    
-    return avg;
-    }
-  #else
-    {
-    running_mean_scalar<eT> running_mean;
-    
-    for(uword i=0; i<N_samples; ++i)
-      {
-      running_mean( internal_scalar_log_p( X.colptr(i), gaus_id ) );
-      }
-    
-    return running_mean.mean();
-    }
-  #endif
+  return eT(mean(vals));
   }
 
 
@@ -1614,61 +1644,27 @@ gmm_full<eT>::internal_vec_assign(urowvec& out, const Mat<eT>& X, const gmm_dist
     #endif
     }
   else
-  if(dist_mode == prob_dist)
-    {
-    #if defined(ARMA_USE_OPENMP)
-      {
-      const umat boundaries = internal_gen_boundaries(X_n_cols);
-      
-      const uword n_threads = boundaries.n_cols;
-      
-      const eT* log_hefts_mem = log_hefts.memptr();
-      
-      #pragma omp parallel for schedule(static)
-      for(uword t=0; t < n_threads; ++t)
-        {
-        const uword start_index = boundaries.at(0,t);
-        const uword   end_index = boundaries.at(1,t);
-        
-        for(uword i=start_index; i <= end_index; ++i)
-          {
-          const eT* X_colptr = X.colptr(i);
-           
-          eT    best_p = -Datum<eT>::inf;
-          uword best_g = 0;
-          
-          for(uword g=0; g<N_gaus; ++g)
-            {
-            const eT tmp_p = internal_scalar_log_p(X_colptr, g) + log_hefts_mem[g];
-            
-            if(tmp_p >= best_p)  { best_p = tmp_p; best_g = g; }
-            }
-          
-          out_mem[i] = best_g;
-          }
-        }
-      }
-    #else
+  if(dist_mode == prob_dist)
+    {
+    #if defined(ARMA_USE_OPENMP)
       {
-      const eT* log_hefts_mem = log_hefts.memptr();
+      const umat boundaries = internal_gen_boundaries(X_n_cols);
       
-      for(uword i=0; i<X_n_cols; ++i)
+      const uword n_threads = (X_n_cols > 0) ? boundaries.n_cols : uword(0);
+      
+      #pragma omp parallel for schedule(static)
+      for(uword t=0; t < n_threads; ++t)
         {
-        const eT* X_colptr = X.colptr(i);
-         
-        eT    best_p = -Datum<eT>::inf;
-        uword best_g = 0;
-        
-        for(uword g=0; g<N_gaus; ++g)
-          {
-          const eT tmp_p = internal_scalar_log_p(X_colptr, g) + log_hefts_mem[g];
-          
-          if(tmp_p >= best_p)  { best_p = tmp_p; best_g = g; }
-          }
+        const uword start_index = boundaries.at(0,t);
+        const uword   end_index = boundaries.at(1,t);
         
-        out_mem[i] = best_g;
+        internal_range_assign(out_mem + start_index, X, start_index, end_index);
         }
       }
+    #else
+      {
+      if(X_n_cols > 0)  { internal_range_assign(out_mem, X, 0, X_n_cols-1); }
+      }
     #endif
     }
   else
@@ -1738,8 +1734,6 @@ gmm_full<eT>::internal_raw_hist(urowvec& hist, const Mat<eT>& X, const gmm_dist_
     else
     if(dist_mode == prob_dist)
       {
-      const eT* log_hefts_mem = log_hefts.memptr();
-      
       #pragma omp parallel for schedule(static)
       for(uword t=0; t < n_threads; ++t)
         {
@@ -1748,22 +1742,15 @@ gmm_full<eT>::internal_raw_hist(urowvec& hist, const Mat<eT>& X, const gmm_dist_
         const uword start_index = boundaries.at(0,t);
         const uword   end_index = boundaries.at(1,t);
         
-        for(uword i=start_index; i <= end_index; ++i)
-          {
-          const eT* X_colptr = X.colptr(i);
-            
-          eT    best_p = -Datum<eT>::inf;
-          uword best_g = 0;
-          
-          for(uword g=0; g < N_gaus; ++g)
-            {
-            const eT tmp_p = internal_scalar_log_p(X_colptr, g) + log_hefts_mem[g];
-            
-            if(tmp_p >= best_p)  { best_p = tmp_p; best_g = g; }
-            }
-          
-          thread_hist_mem[best_g]++;
-          }
+        if(X_n_cols == 0)  { continue; }
+        
+        uvec thread_assign((end_index - start_index) + 1);
+        
+        internal_range_assign(thread_assign.memptr(), X, start_index, end_index);
+        
+        const uword* thread_assign_mem = thread_assign.memptr();
+        
+        for(uword i=0; i < thread_assign.n_elem; ++i)  { thread_hist_mem[ thread_assign_mem[i] ]++; }
         }
       }
     
@@ -1799,23 +1786,15 @@ gmm_full<eT>::internal_raw_hist(urowvec& hist, const Mat<eT>& X, const gmm_dist_
     else
     if(dist_mode == prob_dist)
       {
-      const eT* log_hefts_mem = log_hefts.memptr();
-      
-      for(uword i=0; i<X_n_cols; ++i)
+      if(X_n_cols > 0)
         {
-        const eT* X_colptr = X.colptr(i);
-          
-        eT    best_p = -Datum<eT>::inf;
-        uword best_g = 0;
+        uvec assign_vals(X_n_cols);
         
-        for(uword g=0; g < N_gaus; ++g)
-          {
-          const eT tmp_p = internal_scalar_log_p(X_colptr, g) + log_hefts_mem[g];
-          
-          if(tmp_p >= best_p)  { best_p = tmp_p; best_g = g; }
-          }
+        internal_range_assign(assign_vals.memptr(), X, 0, X_n_cols-1);
         
-        hist_mem[best_g]++;
+        const uword* assign_mem = assign_vals.memptr();
+        
+        for(uword i=0; i<X_n_cols; ++i)  { hist_mem[ assign_mem[i] ]++; }
         }
       }
     }
@@ -1911,6 +1890,16 @@ gmm_full<eT>::generate_initial_means(const Mat<eT>& X, const gmm_seed_mode& seed
       access::rw(means).col(g) = X.unsafe_col(best_i);
       }
     }
+  else
+  if(seed_mode == random_plusplus)
+    {
+    km_seed<eT,dist_id>::plusplus(access::rw(means), X, mah_aux.memptr());
+    }
+  else
+  if(seed_mode == random_scalable)
+    {
+    km_seed<eT,dist_id>::scalable(access::rw(means), X, mah_aux.memptr());
+    }
   
   // get_cout_stream() << "generate_initial_means():" << '\n';
   // means.print();
@@ -2411,6 +2400,127 @@ gmm_full<eT>::em_iterate(const Mat<eT>& X, const uword max_iter, const eT var_fl
 
 
 
+template<typename eT>
+inline
+bool
+gmm_full<eT>::em_step(const Mat<eT>& X, const eT step_size, const eT var_floor)
+  {
+  arma_extra_debug_sigprint();
+  
+  const uword N_dims = means.n_rows;
+  const uword N_gaus = means.n_cols;
+  
+  const umat boundaries = internal_gen_boundaries(X.n_cols);
+  
+  const uword n_threads = boundaries.n_cols;
+  
+  field<  Mat<eT> > t_acc_means(n_threads); 
+  field< Cube<eT> > t_acc_fcovs(n_threads);
+  
+  field< Col<eT> > t_acc_norm_lhoods(n_threads);
+  field< Col<eT> > t_gaus_log_lhoods(n_threads);
+  
+  Col<eT>          t_progress_log_lhood(n_threads);
+  
+  for(uword t=0; t<n_threads; t++)
+    {
+    t_acc_means[t].set_size(N_dims, N_gaus);
+    t_acc_fcovs[t].set_size(N_dims, N_dims, N_gaus);
+    
+    t_acc_norm_lhoods[t].set_size(N_gaus);
+    t_gaus_log_lhoods[t].set_size(N_gaus);
+    }
+  
+  const bool calc_chol = false;
+  
+  init_constants(calc_chol);
+  
+  em_accumulate(X, boundaries, t_acc_means, t_acc_fcovs, t_acc_norm_lhoods, t_gaus_log_lhoods, t_progress_log_lhood);
+  
+  if(arma_isfinite(accu(t_progress_log_lhood)) == false)  { return false; }
+  
+   Mat<eT>& final_acc_means = t_acc_means[0];
+  Cube<eT>& final_acc_fcovs = t_acc_fcovs[0];
+  
+  const Col<eT>& final_acc_norm_lhoods = t_acc_norm_lhoods[0];
+  
+  const eT batch_norm = eT(1) / eT(X.n_cols);
+  const eT old_weight = eT(1) - step_size;
+  
+  eT* hefts_mem = access::rw(hefts).memptr();
+  
+  Mat<eT> mean_outer(N_dims, N_dims);
+  
+  // the sufficient statistics of the current model are heft, heft*mean and heft*(fcov + mean*mean.t());
+  // conditionally update each component, as per em_update_params()
+  for(uword g=0; g < N_gaus; ++g)
+    {
+    const eT old_heft = hefts_mem[g];
+    const eT new_heft = (std::max)( old_weight * old_heft + step_size * batch_norm * final_acc_norm_lhoods[g], std::numeric_limits<eT>::min() );
+    
+    if(arma_isfinite(new_heft) == false)  { continue; }
+    
+    const Col<eT> old_mean(const_cast<eT*>(means.colptr(g)), N_dims, false, true);
+    
+    Col<eT>  new_mean(final_acc_means.colptr(g), N_dims, false, true);
+    Mat<eT>& new_fcov = final_acc_fcovs.slice(g);
+    
+    mean_outer = old_mean * old_mean.t();
+    mean_outer += fcovs.slice(g);
+    
+    new_mean = (old_weight * old_heft / new_heft) * old_mean   + (step_size * batch_norm / new_heft) * new_mean;
+    new_fcov = (old_weight * old_heft / new_heft) * mean_outer + (step_size * batch_norm / new_heft) * new_fcov;
+    
+    mean_outer = new_mean * new_mean.t();
+    
+    new_fcov -= mean_outer;
+    
+    for(uword d=0; d < N_dims; ++d)
+      {
+      eT& val = new_fcov.at(d,d);
+      
+      if(val < var_floor)  { val = var_floor; }
+      }
+    
+    if(new_fcov.is_finite() == false)  { continue; }
+    
+    eT log_det_val  = eT(0);
+    eT log_det_sign = eT(0);
+    
+    log_det(log_det_val, log_det_sign, new_fcov);
+    
+    const bool log_det_ok = ( (arma_isfinite(log_det_val)) && (log_det_sign > eT(0)) );
+    
+    const bool inv_ok = (log_det_ok) ? bool(auxlib::inv_sympd(mean_outer, new_fcov)) : bool(false);  // mean_outer is used as a junk matrix
+    
+    if(log_det_ok && inv_ok)
+      {
+      hefts_mem[g] = new_heft;
+      
+      arrayops::copy(access::rw(means).colptr(g), new_mean.memptr(), N_dims);
+      
+      access::rw(fcovs).slice(g) = new_fcov;
+      }
+    }
+  
+  em_fix_params(var_floor);
+  
+  for(uword g=0; g < N_gaus; ++g)
+    {
+    const Mat<eT>& fcov = fcovs.slice(g);
+    
+    if(any(vectorise(fcov.diag()) <= eT(0)))  { return false; }
+    }
+  
+  if(means.is_finite() == false)  { return false; }
+  if(fcovs.is_finite() == false)  { return false; }
+  if(hefts.is_finite() == false)  { return false; }
+  
+  return true;
+  }
+
+
+
 
 template<typename eT>
 inline
@@ -2429,30 +2539,7 @@ gmm_full<eT>::em_update_params
   {
   arma_extra_debug_sigprint();
   
-  const uword n_threads = boundaries.n_cols;
-  
-  
-  // em_generate_acc() is the "map" operation, which produces partial accumulators for means, diagonal covariances and hefts
-    
-  #if defined(ARMA_USE_OPENMP)
-    {
-    #pragma omp parallel for schedule(static)
-    for(uword t=0; t<n_threads; t++)
-      {
-       Mat<eT>& acc_means          = t_acc_means[t];
-      Cube<eT>& acc_fcovs          = t_acc_fcovs[t];
-       Col<eT>& acc_norm_lhoods    = t_acc_norm_lhoods[t];
-       Col<eT>& gaus_log_lhoods    = t_gaus_log_lhoods[t];
-       eT&      progress_log_lhood = t_progress_log_lhood[t];
-      
-      em_generate_acc(X, boundaries.at(0,t), boundaries.at(1,t), acc_means, acc_fcovs, acc_norm_lhoods, gaus_log_lhoods, progress_log_lhood);
-      }
-    }
-  #else
-    {
-    em_generate_acc(X, boundaries.at(0,0), boundaries.at(1,0), t_acc_means[0], t_acc_fcovs[0], t_acc_norm_lhoods[0], t_gaus_log_lhoods[0], t_progress_log_lhood[0]);
-    }
-  #endif
+  em_accumulate(X, boundaries, t_acc_means, t_acc_fcovs, t_acc_norm_lhoods, t_gaus_log_lhoods, t_progress_log_lhood);
   
   const uword N_dims = means.n_rows;
   const uword N_gaus = means.n_cols;
@@ -2463,17 +2550,6 @@ gmm_full<eT>::em_update_params
   Col<eT>& final_acc_norm_lhoods = t_acc_norm_lhoods[0];
   
   
-  // the "reduce" operation, which combines the partial accumulators produced by the separate threads
-  
-  for(uword t=1; t<n_threads; t++)
-    {
-    final_acc_means += t_acc_means[t];
-    final_acc_fcovs += t_acc_fcovs[t];
-    
-    final_acc_norm_lhoods += t_acc_norm_lhoods[t];
-    }
-  
-  
   eT* hefts_mem = access::rw(hefts).memptr();
   
   Mat<eT> mean_outer(N_dims, N_dims);
@@ -2566,6 +2642,63 @@ gmm_full<eT>::em_update_params
 
 
 
+//! the combined accumulators are stored in t_acc_means[0], t_acc_fcovs[0] and t_acc_norm_lhoods[0]
+template<typename eT>
+inline
+void
+gmm_full<eT>::em_accumulate
+  (
+  const Mat<eT>&           X,
+  const umat&              boundaries,
+        field<  Mat<eT> >& t_acc_means,
+        field< Cube<eT> >& t_acc_fcovs,
+        field<  Col<eT> >& t_acc_norm_lhoods,
+        field<  Col<eT> >& t_gaus_log_lhoods,
+        Col<eT>&           t_progress_log_lhood
+  )
+  const
+  {
+  arma_extra_debug_sigprint();
+  
+  const uword n_threads = boundaries.n_cols;
+  
+  
+  // em_generate_acc() is the "map" operation, which produces partial accumulators for means, full covariances and hefts
+    
+  #if defined(ARMA_USE_OPENMP)
+    {
+    #pragma omp parallel for schedule(static)
+    for(uword t=0; t<n_threads; t++)
+      {
+       Mat<eT>& acc_means          = t_acc_means[t];
+      Cube<eT>& acc_fcovs          = t_acc_fcovs[t];
+       Col<eT>& acc_norm_lhoods    = t_acc_norm_lhoods[t];
+       Col<eT>& gaus_log_lhoods    = t_gaus_log_lhoods[t];
+       eT&      progress_log_lhood = t_progress_log_lhood[t];
+      
+      em_generate_acc(X, boundaries.at(0,t), boundaries.at(1,t), acc_means, acc_fcovs, acc_norm_lhoods, gaus_log_lhoods, progress_log_lhood);
+      }
+    }
+  #else
+    {
+    em_generate_acc(X, boundaries.at(0,0), boundaries.at(1,0), t_acc_means[0], t_acc_fcovs[0], t_acc_norm_lhoods[0], t_gaus_log_lhoods[0], t_progress_log_lhood[0]);
+    }
+  #endif
+  
+  
+  // the "reduce" operation, which combines the partial accumulators produced by the separate threads
+  
+  for(uword t=1; t<n_threads; t++)
+    {
+    t_acc_means[0] += t_acc_means[t];
+    t_acc_fcovs[0] += t_acc_fcovs[t];
+    
+    t_acc_norm_lhoods[0] += t_acc_norm_lhoods[t];
+    }
+  }
+
+
+
 template<typename eT>
 inline
 void
@@ -2598,61 +2731,66 @@ gmm_full<eT>::em_generate_acc
   const eT* log_hefts_mem       = log_hefts.memptr();
         eT* gaus_log_lhoods_mem = gaus_log_lhoods.memptr();
   
+  Mat<eT> blk_lhoods;
+  Mat<eT> tmp_diff;
+  Mat<eT> tmp_prod;
   
-  for(uword i=start_index; i <= end_index; i++)
+  for(uword blk_start = start_index; blk_start <= end_index; blk_start += block_size)
     {
-    const eT* x = X.colptr(i);
-    
-    for(uword g=0; g < N_gaus; ++g)
-      {
-      gaus_log_lhoods_mem[g] = internal_scalar_log_p(x, g) + log_hefts_mem[g];
-      }
+    const uword blk_end = (std::min)(blk_start + block_size - 1, end_index);
     
-    eT log_lhood_sum = gaus_log_lhoods_mem[0];
+    internal_block_log_p(blk_lhoods, X, blk_start, blk_end, tmp_diff, tmp_prod);
     
-    for(uword g=1; g < N_gaus; ++g)
-      {
-      log_lhood_sum = log_add_exp(log_lhood_sum, gaus_log_lhoods_mem[g]);
-      }
+    const uword N_blk = blk_lhoods.n_rows;
     
-    progress_log_lhood += log_lhood_sum;
+    // convert the log-likelihoods into normalised likelihoods
     
-    for(uword g=0; g < N_gaus; ++g)
+    for(uword i=0; i < N_blk; ++i)
       {
-      const eT norm_lhood = std::exp(gaus_log_lhoods_mem[g] - log_lhood_sum);
+      for(uword g=0; g < N_gaus; ++g)
+        {
+        gaus_log_lhoods_mem[g] = blk_lhoods.at(i,g) + log_hefts_mem[g];
+        }
+      
+      eT log_lhood_sum = gaus_log_lhoods_mem[0];
       
-      acc_norm_lhoods[g] += norm_lhood;
+      for(uword g=1; g < N_gaus; ++g)
+        {
+        log_lhood_sum = log_add_exp(log_lhood_sum, gaus_log_lhoods_mem[g]);
+        }
       
-      eT* acc_mean_mem = acc_means.colptr(g);
+      progress_log_lhood += log_lhood_sum;
       
-      for(uword d=0; d < N_dims; ++d)
+      for(uword g=0; g < N_gaus; ++g)
         {
-        acc_mean_mem[d] += x[d] * norm_lhood;
+        blk_lhoods.at(i,g) = std::exp(gaus_log_lhoods_mem[g] - log_lhood_sum);
         }
+      }
+    
+    const Mat<eT> X_blk(const_cast<eT*>(X.colptr(blk_start)), N_dims, N_blk, false, true);
+    
+    acc_means += X_blk * blk_lhoods;
+    
+    for(uword g=0; g < N_gaus; ++g)
+      {
+      const eT* norm_lhoods_mem = blk_lhoods.colptr(g);
       
-      Mat<eT>& acc_fcov = access::rw(acc_fcovs).slice(g);
+      // weighted outer products: acc_fcov += sum_i norm_lhood_i * (x_i * x_i.t())
       
-      // specialised version of acc_fcov += norm_lhood * (xx * xx.t());
+      tmp_diff.set_size(N_dims, N_blk);
       
-      for(uword d=0; d < N_dims; ++d)
+      for(uword i=0; i < N_blk; ++i)
         {
-        const uword dp1 = d+1;
-        
-        const eT xd = x[d];
-        
-        eT* acc_fcov_col_d = acc_fcov.colptr(d) + d;
-        eT* acc_fcov_row_d = &(acc_fcov.at(d,dp1));
+        const eT  norm_lhood = norm_lhoods_mem[i];
+        const eT* x          = X_blk.colptr(i);
+              eT* tmp_mem    = tmp_diff.colptr(i);
         
-        (*acc_fcov_col_d) += norm_lhood * (xd * xd);  acc_fcov_col_d++;
+        acc_norm_lhoods[g] += norm_lhood;
         
-        for(uword e=dp1; e < N_dims; ++e)
-          {
-          const eT val = norm_lhood * (xd * x[e]);
-          
-          (*acc_fcov_col_d) += val;  acc_fcov_col_d++;
-          (*acc_fcov_row_d) += val;  acc_fcov_row_d += N_dims;
-          }
+        for(uword d=0; d < N_dims; ++d)  { tmp_mem[d] = norm_lhood * x[d]; }
         }
+      
+      acc_fcovs.slice(g) += tmp_diff * X_blk.t();
       }
     }
   
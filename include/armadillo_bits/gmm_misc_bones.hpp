@@ -43,12 +43,16 @@ struct gmm_seed_static_subset : public gmm_seed_mode { inline gmm_seed_static_su
 struct gmm_seed_static_spread : public gmm_seed_mode { inline gmm_seed_static_spread() : gmm_seed_mode(3) {} };
 struct gmm_seed_random_subset : public gmm_seed_mode { inline gmm_seed_random_subset() : gmm_seed_mode(4) {} };
 struct gmm_seed_random_spread : public gmm_seed_mode { inline gmm_seed_random_spread() : gmm_seed_mode(5) {} };
+struct gmm_seed_random_plusplus : public gmm_seed_mode { inline gmm_seed_random_plusplus() : gmm_seed_mode(6) {} };
+struct gmm_seed_random_scalable : public gmm_seed_mode { inline gmm_seed_random_scalable() : gmm_seed_mode(7) {} };
 
 static const gmm_seed_keep_existing keep_existing;
 static const gmm_seed_static_subset static_subset;
 static const gmm_seed_static_spread static_spread;
 static const gmm_seed_random_subset random_subset;
 static const gmm_seed_random_spread random_spread;
+static const gmm_seed_random_plusplus random_plusplus;
+static const gmm_seed_random_scalable random_scalable;
 
 
 namespace gmm_priv
@@ -111,6 +115,73 @@ struct distance<eT, uword(2)>
   };
 
 
+
+
+// uniformly distributed index in [0, N-1];
+// unlike randi(), not limited to the range of int
+
+inline uword km_rand_index(const uword N);
+
+
+
+// seeding of initial means via k-means++ and k-means|| (scalable k-means++)
+
+template<typename eT, uword dist_id>
+struct km_seed
+  {
+  inline static void plusplus(Mat<eT>& means, const Mat<eT>& X, const eT* mah_aux_mem);
+  inline static void scalable(Mat<eT>& means, const Mat<eT>& X, const eT* mah_aux_mem);
+  
+  inline static void update_min_dists(Col<eT>& min_dists, Col<uword>& nearest, const Mat<eT>& X, const eT* mean_mem, const uword mean_id, const eT* mah_aux_mem);
+  
+  inline static uword draw_index(const Col<eT>& weights);
+  
+  inline static void weighted_plusplus(Mat<eT>& means, const Mat<eT>& Y, const Col<eT>& Y_weights, const eT* mah_aux_mem);
+  };
+
+
+
+// sources of batches for mini-batch k-means;
+// each call of operator() fills the given matrix with a new batch of samples,
+// returning false when no more samples are available
+
+template<typename eT>
+class km_batch_mat
+  {
+  public:
+  
+  inline km_batch_mat(const Mat<eT>& in_X, const uword in_batch_size);
+  
+  inline bool operator() (Mat<eT>& batch);
+  
+  
+  private:
+  
+  const Mat<eT>& X;
+  const uword    batch_size;
+  };
+
+
+
+template<typename eT>
+class km_batch_reader
+  {
+  public:
+  
+  inline km_batch_reader(compact_reader<eT>& in_reader, const uword in_batch_size);
+  
+  inline bool operator() (Mat<eT>& batch);
+  
+  
+  private:
+  
+  compact_reader<eT>& reader;
+  const uword         batch_size;
+  
+  Mat<eT> block;
+  };
+
+
 }
 
 
@@ -188,6 +188,346 @@ distance<eT, uword(2)>::eval(const uword N, const eT* A, const eT* B, const eT*
   return (acc1 + acc2);
   }
 
+
+
+//
+//
+//
+
+
+
+inline
+uword
+km_rand_index(const uword N)
+  {
+  const uword index = uword( double(arma_rng::randu<double>()) * double(N) );
+  
+  return (index < N) ? index : (N-1);
+  }
+
+
+
+//! k-means++: each new mean is a sample drawn with probability proportional to its squared distance from the nearest existing mean
+template<typename eT, uword dist_id>
+inline
+void
+km_seed<eT,dist_id>::plusplus(Mat<eT>& means, const Mat<eT>& X, const eT* mah_aux_mem)
+  {
+  arma_extra_debug_sigprint();
+  
+  const uword N_gaus   = means.n_cols;
+  const uword X_n_cols = X.n_cols;
+  
+  if( (N_gaus == 0) || (X_n_cols == 0) )  { return; }
+  
+  Col<eT>    min_dists(X_n_cols);
+  Col<uword> nearest(X_n_cols);
+  
+  min_dists.fill(Datum<eT>::inf);
+  
+  uword index = km_rand_index(X_n_cols);
+  
+  means.col(0) = X.unsafe_col(index);
+  
+  for(uword g=1; g < N_gaus; ++g)
+    {
+    update_min_dists(min_dists, nearest, X, means.colptr(g-1), g-1, mah_aux_mem);
+    
+    index = draw_index(min_dists);
+    
+    means.col(g) = X.unsafe_col(index);
+    }
+  }
+
+
+
+//! k-means|| as per Bahmani et al, "Scalable K-Means++", PVLDB, 2012;
+//! several rounds of independent oversampling produce a candidate set,
+//! which is then reduced to the required number of means via weighted k-means++
+template<typename eT, uword dist_id>
+inline
+void
+km_seed<eT,dist_id>::scalable(Mat<eT>& means, const Mat<eT>& X, const eT* mah_aux_mem)
+  {
+  arma_extra_debug_sigprint();
+  
+  const uword N_gaus   = means.n_cols;
+  const uword X_n_cols = X.n_cols;
+  
+  if( (N_gaus == 0) || (X_n_cols == 0) )  { return; }
+  
+  const uword N_rounds     = 5;
+  const eT    oversampling = eT(2) * eT(N_gaus);
+  
+  Col<eT>    min_dists(X_n_cols);
+  Col<uword> nearest(X_n_cols);
+  
+  min_dists.fill(Datum<eT>::inf);
+  nearest.zeros();
+  
+  std::vector<uword> candidates;
+  
+  candidates.push_back( km_rand_index(X_n_cols) );
+  
+  uword N_processed = 0;
+  
+  for(uword round=0; round <= N_rounds; ++round)
+    {
+    const uword N_candidates = uword(candidates.size());
+    
+    for(uword c=N_processed; c < N_candidates; ++c)
+      {
+      update_min_dists(min_dists, nearest, X, X.colptr(candidates[c]), c, mah_aux_mem);
+      }
+    
+    N_processed = N_candidates;
+    
+    // the last round only updates the distances and nearest candidates
+    if(round == N_rounds)  { break; }
+    
+    const eT total = eT(accu(min_dists));
+    
+    if( (total <= eT(0)) || (arma_isfinite(total) == false) )  { break; }
+    
+    const Col<eT> draws = randu< Col<eT> >(X_n_cols);
+    
+    const eT* draws_mem     = draws.memptr();
+    const eT* min_dists_mem = min_dists.memptr();
+    
+    for(uword i=0; i < X_n_cols; ++i)
+      {
+      if( (draws_mem[i] * total) < (oversampling * min_dists_mem[i]) )  { candidates.push_back(i); }
+      }
+    }
+  
+  const uword N_candidates = uword(candidates.size());
+  
+  if(N_candidates <= N_gaus)  { plusplus(means, X, mah_aux_mem); return; }
+  
+  // weight each candidate by the number of samples for which it is the nearest candidate
+  
+  Col<eT> Y_weights(N_candidates, fill::zeros);
+  
+  const uword* nearest_mem = nearest.memptr();
+  
+  for(uword i=0; i < X_n_cols; ++i)  { Y_weights[ nearest_mem[i] ] += eT(1); }
+  
+  const Mat<eT> Y = X.cols( conv_to<uvec>::from(candidates) );
+  
+  weighted_plusplus(means, Y, Y_weights, mah_aux_mem);
+  }
+
+
+
+//! min_dists[i] = min(min_dists[i], dist(X.col(i), mean)); nearest[i] records the id of the mean providing the minimum
+template<typename eT, uword dist_id>
+inline
+void
+km_seed<eT,dist_id>::update_min_dists(Col<eT>& min_dists, Col<uword>& nearest, const Mat<eT>& X, const eT* mean_mem, const uword mean_id, const eT* mah_aux_mem)
+  {
+  arma_extra_debug_sigprint();
+  
+  const uword N_dims   = X.n_rows;
+  const uword X_n_cols = X.n_cols;
+  
+  eT*    min_dists_mem = min_dists.memptr();
+  uword* nearest_mem   = nearest.memptr();
+  
+  #if defined(ARMA_USE_OPENMP)
+    {
+    const bool use_mp = (X_n_cols > 1) && mp_gate<eT>::eval(X.n_elem);
+    
+    if(use_mp)
+      {
+      const int n_threads = mp_thread_limit::get();
+      
+      #pragma omp parallel for schedule(static) num_threads(n_threads)
+      for(uword i=0; i < X_n_cols; ++i)
+        {
+        const eT dist = distance<eT,dist_id>::eval(N_dims, X.colptr(i), mean_mem, mah_aux_mem);
+        
+        if(dist < min_dists_mem[i])  { min_dists_mem[i] = dist; nearest_mem[i] = mean_id; }
+        }
+      
+      return;
+      }
+    }
+  #endif
+  
+  for(uword i=0; i < X_n_cols; ++i)
+    {
+    const eT dist = distance<eT,dist_id>::eval(N_dims, X.colptr(i), mean_mem, mah_aux_mem);
+    
+    if(dist < min_dists_mem[i])  { min_dists_mem[i] = dist; nearest_mem[i] = mean_id; }
+    }
+  }
+
+
+
+//! draw an index with probability proportional to its weight; if all weights are zero, draw uniformly
+template<typename eT, uword dist_id>
+inline
+uword
+km_seed<eT,dist_id>::draw_index(const Col<eT>& weights)
+  {
+  arma_extra_debug_sigprint();
+  
+  const uword N = weights.n_elem;
+  
+  const eT* weights_mem = weights.memptr();
+  
+  const eT total = eT(accu(weights));
+  
+  if( (total <= eT(0)) || (arma_isfinite(total) == false) )
+    {
+    return km_rand_index(N);
+    }
+  
+  const eT threshold = as_scalar(randu< Col<eT> >(1)) * total;
+  
+  eT    acc        = eT(0);
+  uword last_valid = 0;
+  
+  for(uword i=0; i < N; ++i)
+    {
+    const eT val = weights_mem[i];
+    
+    if(val > eT(0))
+      {
+      acc += val;
+      
+      last_valid = i;
+      
+      if(acc > threshold)  { return i; }
+      }
+    }
+  
+  // only reachable due to rounding errors
+  return last_valid;
+  }
+
+
+
+template<typename eT, uword dist_id>
+inline
+void
+km_seed<eT,dist_id>::weighted_plusplus(Mat<eT>& means, const Mat<eT>& Y, const Col<eT>& Y_weights, const eT* mah_aux_mem)
+  {
+  arma_extra_debug_sigprint();
+  
+  const uword N_gaus   = means.n_cols;
+  const uword Y_n_cols = Y.n_cols;
+  
+  Col<eT>    min_dists(Y_n_cols);
+  Col<uword> nearest(Y_n_cols);
+  Col<eT>    probs(Y_n_cols);
+  
+  min_dists.fill(Datum<eT>::inf);
+  
+  uword index = draw_index(Y_weights);
+  
+  means.col(0) = Y.unsafe_col(index);
+  
+  for(uword g=1; g < N_gaus; ++g)
+    {
+    update_min_dists(min_dists, nearest, Y, means.colptr(g-1), g-1, mah_aux_mem);
+    
+    probs = Y_weights % min_dists;
+    
+    index = draw_index(probs);
+    
+    means.col(g) = Y.unsafe_col(index);
+    }
+  }
+
+
+
+//
+//
+//
+
+
+
+template<typename eT>
+inline
+km_batch_mat<eT>::km_batch_mat(const Mat<eT>& in_X, const uword in_batch_size)
+  : X         (in_X         )
+  , batch_size(in_batch_size)
+  {
+  arma_extra_debug_sigprint();
+  }
+
+
+
+//! batch of samples drawn uniformly at random (with replacement) from a resident matrix
+template<typename eT>
+inline
+bool
+km_batch_mat<eT>::operator() (Mat<eT>& batch)
+  {
+  arma_extra_debug_sigprint();
+  
+  if( X.is_empty() || (batch_size == 0) )  { return false; }
+  
+  const uword X_n_cols = X.n_cols;
+  
+  uvec indices(batch_size);
+  
+  for(uword i=0; i < batch_size; ++i)  { indices[i] = km_rand_index(X_n_cols); }
+  
+  batch = X.cols(indices);
+  
+  return true;
+  }
+
+
+
+template<typename eT>
+inline
+km_batch_reader<eT>::km_batch_reader(compact_reader<eT>& in_reader, const uword in_batch_size)
+  : reader    (in_reader    )
+  , batch_size(in_batch_size)
+  {
+  arma_extra_debug_sigprint();
+  }
+
+
+
+//! batch of samples drawn from randomly selected blocks of a file in arma_compact format;
+//! only the selected blocks are read and decompressed
+template<typename eT>
+inline
+bool
+km_batch_reader<eT>::operator() (Mat<eT>& batch)
+  {
+  arma_extra_debug_sigprint();
+  
+  if( (reader.is_open() == false) || (reader.n_cols() == 0) || (batch_size == 0) )  { return false; }
+  
+  batch.set_size(reader.n_rows(), batch_size);
+  
+  uword count = 0;
+  
+  while(count < batch_size)
+    {
+    const uword block_id = km_rand_index(reader.n_blocks());
+    
+    if(reader.read_block(block, block_id) == false)  { batch.soft_reset(); return false; }
+    
+    const uword N = (std::min)(block.n_cols, batch_size - count);
+    
+    uvec indices(N);
+    
+    for(uword i=0; i < N; ++i)  { indices[i] = km_rand_index(block.n_cols); }
+    
+    batch.cols(count, count+N-1) = block.cols(indices);
+    
+    count += N;
+    }
+  
+  return true;
+  }
+
 }
 
 
@@ -0,0 +1,89 @@
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+//! \addtogroup hash_aux
+//! @{
+
+
+
+//! element types for which hash-based deduplication is used
+template<typename eT>
+struct hash_aux_eligible
+  {
+  static constexpr bool value = std::numeric_limits<eT>::is_integer && (sizeof(eT) <= 8);
+  };
+
+
+
+//! Hash table with open addressing (linear probing) for integer values;
+//! for each distinct value, the index of its first insertion is kept.
+//! The distinct values and their indices are stored in insertion order.
+template<typename eT>
+class hash_aux_table
+  {
+  public:
+  
+  inline hash_aux_table();
+  
+  inline bool insert(const eT val, const uword index);
+  inline bool find(const eT val, uword& index) const;
+  
+  inline uword size() const;
+  
+  std::vector<eT>    vals;     //!< distinct values, in insertion order
+  std::vector<uword> indices;  //!< index associated with each distinct value
+  
+  
+  private:
+  
+  std::vector<uword> slots;  //!< 0 = empty; otherwise 1 + position in vals
+  
+  uword shift;
+  
+  arma_inline uword slot_of(const eT val) const;
+  
+  inline void grow();
+  };
+
+
+
+//! Helper functions for deduplicating integer data via hash tables;
+//! used by unique(), find_unique() and intersect()
+class hash_aux
+  {
+  public:
+  
+  static constexpr uword threshold = 4096;  //!< minimum number of elements for the hash-based approach
+  
+  template<typename eT>
+  inline static bool build(hash_aux_table<eT>& table, const eT* X, const uword N, const typename enable_if< hash_aux_eligible<eT>::value        >::result* junk = nullptr);
+  
+  template<typename eT>
+  inline static bool build(hash_aux_table<eT>& table, const eT* X, const uword N, const typename enable_if< hash_aux_eligible<eT>::value == false >::result* junk = nullptr);
+  
+  template<typename eT>
+  inline static bool first_occurrences(Mat<uword>& out, const eT* X, const uword N);
+  
+  
+  private:
+  
+  template<typename eT>
+  inline static bool build_range(hash_aux_table<eT>& table, const eT* X, const uword start, const uword end, const uword max_distinct);
+  };
+
+
+
+//! @}
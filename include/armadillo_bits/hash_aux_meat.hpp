@@ -0,0 +1,251 @@
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+//! \addtogroup hash_aux
+//! @{
+
+
+
+template<typename eT>
+inline
+hash_aux_table<eT>::hash_aux_table()
+  : slots(256, uword(0))
+  , shift(64 - 8)
+  {
+  arma_extra_debug_sigprint();
+  }
+
+
+
+//! insert val with the given index, unless val is already present;
+//! returns true if val was inserted
+template<typename eT>
+inline
+bool
+hash_aux_table<eT>::insert(const eT val, const uword index)
+  {
+  const uword mask = uword(slots.size() - 1);
+  
+  uword slot = slot_of(val);
+  
+  while(slots[slot] != 0)
+    {
+    if(vals[ slots[slot]-1 ] == val)  { return false; }
+    
+    slot = (slot + 1) & mask;
+    }
+  
+  vals.push_back(val);
+  indices.push_back(index);
+  
+  slots[slot] = uword(vals.size());
+  
+  // keep the load factor at or below 0.5
+  
+  if( (2*vals.size()) > slots.size() )  { grow(); }
+  
+  return true;
+  }
+
+
+
+template<typename eT>
+inline
+bool
+hash_aux_table<eT>::find(const eT val, uword& index) const
+  {
+  const uword mask = uword(slots.size() - 1);
+  
+  uword slot = slot_of(val);
+  
+  while(slots[slot] != 0)
+    {
+    const uword pos = slots[slot]-1;
+    
+    if(vals[pos] == val)  { index = indices[pos]; return true; }
+    
+    slot = (slot + 1) & mask;
+    }
+  
+  return false;
+  }
+
+
+
+template<typename eT>
+inline
+uword
+hash_aux_table<eT>::size() const
+  {
+  return uword(vals.size());
+  }
+
+
+
+//! multiplicative (Fibonacci) hashing; the top bits of the product select the slot
+template<typename eT>
+arma_inline
+uword
+hash_aux_table<eT>::slot_of(const eT val) const
+  {
+  return uword( (u64(val) * u64(0x9E3779B97F4A7C15ULL)) >> shift );
+  }
+
+
+
+template<typename eT>
+inline
+void
+hash_aux_table<eT>::grow()
+  {
+  arma_extra_debug_sigprint();
+  
+  slots.assign(2*slots.size(), uword(0));
+  
+  shift--;
+  
+  const uword mask = uword(slots.size() - 1);
+  
+  const uword n_vals = uword(vals.size());
+  
+  for(uword pos=0; pos < n_vals; ++pos)
+    {
+    uword slot = slot_of(vals[pos]);
+    
+    while(slots[slot] != 0)  { slot = (slot + 1) & mask; }
+    
+    slots[slot] = pos+1;
+    }
+  }
+
+
+
+//
+
+
+
+//! insert the elements of X into the table, keeping the index of the first occurrence of each distinct value;
+//! returns false if there are so many distinct values that sorting is expected to be faster.
+//! When OpenMP is enabled, separate ranges of X are inserted into separate tables, which are then merged in order.
+template<typename eT>
+inline
+bool
+hash_aux::build(hash_aux_table<eT>& table, const eT* X, const uword N, const typename enable_if< hash_aux_eligible<eT>::value >::result* junk)
+  {
+  arma_extra_debug_sigprint();
+  arma_ignore(junk);
+  
+  const uword max_distinct = (std::max)(uword(1024), N/16);
+  
+  #if defined(ARMA_USE_OPENMP)
+    {
+    const uword n_threads = uword(mp_thread_limit::get());
+    
+    if( (n_threads > 1) && (N >= sort_aux::parallel_threshold) && mp_gate<eT>::eval(N) )
+      {
+      std::vector< hash_aux_table<eT> > local_tables(n_threads);
+      
+      podarray<uword> status(n_threads);
+      
+      #pragma omp parallel for schedule(static) num_threads(int(n_threads))
+      for(uword t=0; t < n_threads; ++t)
+        {
+        const uword start = (t    * N) / n_threads;
+        const uword end   = ((t+1) * N) / n_threads;
+        
+        status[t] = hash_aux::build_range(local_tables[t], X, start, end, max_distinct) ? uword(1) : uword(0);
+        }
+      
+      for(uword t=0; t < n_threads; ++t)
+        {
+        if(status[t] == 0)  { return false; }
+        
+        const hash_aux_table<eT>& local_table = local_tables[t];
+        
+        const uword local_size = local_table.size();
+        
+        for(uword j=0; j < local_size; ++j)  { table.insert(local_table.vals[j], local_table.indices[j]); }
+        
+        if(table.size() > max_distinct)  { return false; }
+        }
+      
+      return true;
+      }
+    }
+  #endif
+  
+  return hash_aux::build_range(table, X, 0, N, max_distinct);
+  }
+
+
+
+template<typename eT>
+inline
+bool
+hash_aux::build(hash_aux_table<eT>& table, const eT* X, const uword N, const typename enable_if< hash_aux_eligible<eT>::value == false >::result* junk)
+  {
+  arma_extra_debug_sigprint();
+  arma_ignore(table);
+  arma_ignore(X);
+  arma_ignore(N);
+  arma_ignore(junk);
+  
+  return false;
+  }
+
+
+
+template<typename eT>
+inline
+bool
+hash_aux::build_range(hash_aux_table<eT>& table, const eT* X, const uword start, const uword end, const uword max_distinct)
+  {
+  for(uword i=start; i < end; ++i)
+    {
+    if( table.insert(X[i], i) && (table.size() > max_distinct) )  { return false; }
+    }
+  
+  return true;
+  }
+
+
+
+//! find the index of the first occurrence of each distinct value in X, in ascending order of index
+template<typename eT>
+inline
+bool
+hash_aux::first_occurrences(Mat<uword>& out, const eT* X, const uword N)
+  {
+  arma_extra_debug_sigprint();
+  
+  hash_aux_table<eT> table;
+  
+  if(hash_aux::build(table, X, N) == false)  { return false; }
+  
+  const uword n_distinct = table.size();
+  
+  out.set_size(n_distinct, 1);
+  
+  if(n_distinct > 0)  { arrayops::copy(out.memptr(), &(table.indices[0]), n_distinct); }
+  
+  op_sort::direct_sort(out.memptr(), n_distinct, uword(0));
+  
+  return true;
+  }
+
+
+
+//! @}
@@ -484,6 +484,7 @@ search_hdf5_file
 //! Load an HDF5 matrix into an array of type specified by datatype,
 //! then convert that into the desired array 'dest'.
 //! This should only be called when eT is not the datatype.
+//! The optional mem_space and file_space arguments restrict loading to a subset of the dataset.
 template<typename eT>
 inline
 hid_t
@@ -492,7 +493,9 @@ load_and_convert_hdf5
   eT   *dest,
   hid_t dataset,
   hid_t datatype,
-  uword n_elem
+  uword n_elem,
+  hid_t mem_space  = H5S_ALL,
+  hid_t file_space = H5S_ALL
   )
   {
   
@@ -512,7 +515,7 @@ load_and_convert_hdf5
   if(is_equal)
     {
     Col<u8> v(n_elem);
-    hid_t status = arma_H5Dread(dataset, datatype, H5S_ALL, H5S_ALL, H5P_DEFAULT, void_ptr(v.memptr()));
+    hid_t status = arma_H5Dread(dataset, datatype, mem_space, file_space, H5P_DEFAULT, void_ptr(v.memptr()));
     arrayops::convert(dest, v.memptr(), n_elem);
 
     return status;
@@ -527,7 +530,7 @@ load_and_convert_hdf5
   if(is_equal)
     {
     Col<s8> v(n_elem);
-    hid_t status = arma_H5Dread(dataset, datatype, H5S_ALL, H5S_ALL, H5P_DEFAULT, void_ptr(v.memptr()));
+    hid_t status = arma_H5Dread(dataset, datatype, mem_space, file_space, H5P_DEFAULT, void_ptr(v.memptr()));
     arrayops::convert(dest, v.memptr(), n_elem);
 
     return status;
@@ -542,7 +545,7 @@ load_and_convert_hdf5
   if(is_equal)
     {
     Col<u16> v(n_elem);
-    hid_t status = arma_H5Dread(dataset, datatype, H5S_ALL, H5S_ALL, H5P_DEFAULT, void_ptr(v.memptr()));
+    hid_t status = arma_H5Dread(dataset, datatype, mem_space, file_space, H5P_DEFAULT, void_ptr(v.memptr()));
     arrayops::convert(dest, v.memptr(), n_elem);
 
     return status;
@@ -557,7 +560,7 @@ load_and_convert_hdf5
   if(is_equal)
     {
     Col<s16> v(n_elem);
-    hid_t status = arma_H5Dread(dataset, datatype, H5S_ALL, H5S_ALL, H5P_DEFAULT, void_ptr(v.memptr()));
+    hid_t status = arma_H5Dread(dataset, datatype, mem_space, file_space, H5P_DEFAULT, void_ptr(v.memptr()));
     arrayops::convert(dest, v.memptr(), n_elem);
 
     return status;
@@ -572,7 +575,7 @@ load_and_convert_hdf5
   if(is_equal)
     {
     Col<u32> v(n_elem);
-    hid_t status = arma_H5Dread(dataset, datatype, H5S_ALL, H5S_ALL, H5P_DEFAULT, void_ptr(v.memptr()));
+    hid_t status = arma_H5Dread(dataset, datatype, mem_space, file_space, H5P_DEFAULT, void_ptr(v.memptr()));
     arrayops::convert(dest, v.memptr(), n_elem);
 
     return status;
@@ -587,7 +590,7 @@ load_and_convert_hdf5
   if(is_equal)
     {
     Col<s32> v(n_elem);
-    hid_t status = arma_H5Dread(dataset, datatype, H5S_ALL, H5S_ALL, H5P_DEFAULT, void_ptr(v.memptr()));
+    hid_t status = arma_H5Dread(dataset, datatype, mem_space, file_space, H5P_DEFAULT, void_ptr(v.memptr()));
     arrayops::convert(dest, v.memptr(), n_elem);
 
     return status;
@@ -602,7 +605,7 @@ load_and_convert_hdf5
   if(is_equal)
     {
     Col<u64> v(n_elem);
-    hid_t status = arma_H5Dread(dataset, datatype, H5S_ALL, H5S_ALL, H5P_DEFAULT, void_ptr(v.memptr()));
+    hid_t status = arma_H5Dread(dataset, datatype, mem_space, file_space, H5P_DEFAULT, void_ptr(v.memptr()));
     arrayops::convert(dest, v.memptr(), n_elem);
 
     return status;
@@ -617,7 +620,7 @@ load_and_convert_hdf5
   if(is_equal)
     {
     Col<s64> v(n_elem);
-    hid_t status = arma_H5Dread(dataset, datatype, H5S_ALL, H5S_ALL, H5P_DEFAULT, void_ptr(v.memptr()));
+    hid_t status = arma_H5Dread(dataset, datatype, mem_space, file_space, H5P_DEFAULT, void_ptr(v.memptr()));
     arrayops::convert(dest, v.memptr(), n_elem);
 
     return status;
@@ -632,7 +635,7 @@ load_and_convert_hdf5
   if(is_equal)
     {
     Col<ulng_t> v(n_elem);
-    hid_t status = arma_H5Dread(dataset, datatype, H5S_ALL, H5S_ALL, H5P_DEFAULT, void_ptr(v.memptr()));
+    hid_t status = arma_H5Dread(dataset, datatype, mem_space, file_space, H5P_DEFAULT, void_ptr(v.memptr()));
     arrayops::convert(dest, v.memptr(), n_elem);
 
     return status;
@@ -647,7 +650,7 @@ load_and_convert_hdf5
   if(is_equal)
     {
     Col<slng_t> v(n_elem);
-    hid_t status = arma_H5Dread(dataset, datatype, H5S_ALL, H5S_ALL, H5P_DEFAULT, void_ptr(v.memptr()));
+    hid_t status = arma_H5Dread(dataset, datatype, mem_space, file_space, H5P_DEFAULT, void_ptr(v.memptr()));
     arrayops::convert(dest, v.memptr(), n_elem);
 
     return status;
@@ -662,7 +665,7 @@ load_and_convert_hdf5
   if(is_equal)
     {
     Col<float> v(n_elem);
-    hid_t status = arma_H5Dread(dataset, datatype, H5S_ALL, H5S_ALL, H5P_DEFAULT, void_ptr(v.memptr()));
+    hid_t status = arma_H5Dread(dataset, datatype, mem_space, file_space, H5P_DEFAULT, void_ptr(v.memptr()));
     arrayops::convert(dest, v.memptr(), n_elem);
 
     return status;
@@ -677,7 +680,7 @@ load_and_convert_hdf5
   if(is_equal)
     {
     Col<double> v(n_elem);
-    hid_t status = arma_H5Dread(dataset, datatype, H5S_ALL, H5S_ALL, H5P_DEFAULT, void_ptr(v.memptr()));
+    hid_t status = arma_H5Dread(dataset, datatype, mem_space, file_space, H5P_DEFAULT, void_ptr(v.memptr()));
     arrayops::convert(dest, v.memptr(), n_elem);
 
     return status;
@@ -697,7 +700,7 @@ load_and_convert_hdf5
       }
     
     Col< std::complex<float> > v(n_elem);
-    hid_t status = arma_H5Dread(dataset, datatype, H5S_ALL, H5S_ALL, H5P_DEFAULT, void_ptr(v.memptr()));
+    hid_t status = arma_H5Dread(dataset, datatype, mem_space, file_space, H5P_DEFAULT, void_ptr(v.memptr()));
     arrayops::convert_cx(dest, v.memptr(), n_elem);
     
     return status;
@@ -717,7 +720,7 @@ load_and_convert_hdf5
       }
     
     Col< std::complex<double> > v(n_elem);
-    hid_t status = arma_H5Dread(dataset, datatype, H5S_ALL, H5S_ALL, H5P_DEFAULT, void_ptr(v.memptr()));
+    hid_t status = arma_H5Dread(dataset, datatype, mem_space, file_space, H5P_DEFAULT, void_ptr(v.memptr()));
     arrayops::convert_cx(dest, v.memptr(), n_elem);
     
     return status;
@@ -729,6 +732,295 @@ load_and_convert_hdf5
 
 
 
+//! Select a subset of a dataset, specified via spans in terms of rows, columns and slices.
+//! dims[] uses HDF5 ordering (ie. slowest changing dimension first), and must have arma_n_dims elements,
+//! with the dimensions not present in the file (as indicated by file_n_dims) set to 1.
+//! On success, dims[] is overwritten with the size of the subset and a matching memory dataspace is returned;
+//! on failure, -1 is returned.
+inline
+hid_t
+select_subset(hid_t filespace, const int file_n_dims, hsize_t* dims, const int arma_n_dims, const span& rows, const span& cols, const span& slices)
+  {
+  const span* spans[3] = { &rows, &cols, &slices };
+  
+  hsize_t start[3] = { 0, 0, 0 };
+  hsize_t count[3] = { 0, 0, 0 };
+  
+  for(int k=0; k < arma_n_dims; ++k)
+    {
+    const int   j = arma_n_dims - 1 - k;
+    const span& s = *(spans[k]);
+    
+    if(s.whole)
+      {
+      start[j] = 0;
+      count[j] = dims[j];
+      }
+    else
+      {
+      if( (s.a > s.b) || (hsize_t(s.b) >= dims[j]) )  { return -1; }
+      
+      start[j] = s.a;
+      count[j] = s.b - s.a + 1;
+      }
+    }
+  
+  if(file_n_dims > 0)
+    {
+    const herr_t status = arma_H5Sselect_hyperslab(filespace, H5S_SELECT_SET, start, NULL, count, NULL);
+    
+    if(status < 0)  { return -1; }
+    }
+  
+  for(int j=0; j < arma_n_dims; ++j)  { dims[j] = count[j]; }
+  
+  return arma_H5Screate_simple(file_n_dims, count, NULL);
+  }
+
+
+
+//! Create a new dataset and write the given data, or append the data to an existing extendible dataset.
+//! dims[] uses HDF5 ordering (ie. slowest changing dimension first);
+//! an extendible dataset can only grow along the first dimension (ie. columns for matrices and slices for cubes).
+template<typename eT>
+inline
+bool
+write_dataset(hid_t location, const std::string& dataset_name, const int n_dims, const hsize_t* dims, const eT* mem, const hdf5_opts::opts& opts, std::string& err_msg)
+  {
+  const bool extend     = bool(opts.flags & hdf5_opts::flag_extend );
+  const bool do_deflate = bool(opts.flags & hdf5_opts::flag_deflate);
+  const bool do_chunk   = bool(opts.flags & hdf5_opts::flag_chunk  ) || do_deflate || extend;
+  
+  hid_t datatype = get_hdf5_type<eT>();
+  
+  // If this returned something invalid, well, it's time to crash.
+  arma_check(datatype == -1, "save(): unknown datatype for HDF5");
+  
+  bool write_okay = false;
+  
+  if( extend && (arma_H5Lexists(location, dataset_name.c_str(), H5P_DEFAULT) > 0) )
+    {
+    hid_t dataset = arma_H5Dopen(location, dataset_name.c_str(), H5P_DEFAULT);
+    
+    if(dataset < 0)  { arma_H5Tclose(datatype); err_msg = "couldn't open dataset in "; return false; }
+    
+    hid_t filespace = arma_H5Dget_space(dataset);
+    
+    hsize_t old_dims[3];
+    hsize_t max_dims[3];
+    
+    bool compatible = (arma_H5Sget_simple_extent_ndims(filespace) == n_dims);
+    
+    if(compatible)  { compatible = (arma_H5Sget_simple_extent_dims(filespace, old_dims, max_dims) >= 0); }
+    
+    if(compatible)  { compatible = (max_dims[0] == H5S_UNLIMITED); }
+    
+    for(int j=1; (j < n_dims) && compatible; ++j)  { compatible = (old_dims[j] == dims[j]); }
+    
+    arma_H5Sclose(filespace);
+    
+    if(compatible == false)
+      {
+      err_msg = "existing dataset is not extendible or has incompatible size in ";
+      }
+    else
+      {
+      hsize_t new_dims[3];
+      hsize_t start[3];
+      
+      for(int j=0; j < n_dims; ++j)  { new_dims[j] = dims[j]; start[j] = 0; }
+      
+      new_dims[0] = old_dims[0] + dims[0];
+      start[0]    = old_dims[0];
+      
+      write_okay = (arma_H5Dset_extent(dataset, new_dims) >= 0);
+      
+      if(write_okay && (dims[0] > 0))
+        {
+        filespace = arma_H5Dget_space(dataset);
+        
+        hid_t memspace = arma_H5Screate_simple(n_dims, dims, NULL);
+        
+        write_okay = (arma_H5Sselect_hyperslab(filespace, H5S_SELECT_SET, start, NULL, dims, NULL) >= 0);
+        
+        if(write_okay)  { write_okay = (arma_H5Dwrite(dataset, datatype, memspace, filespace, H5P_DEFAULT, mem) >= 0); }
+        
+        arma_H5Sclose(memspace);
+        arma_H5Sclose(filespace);
+        }
+      }
+    
+    arma_H5Dclose(dataset);
+    arma_H5Tclose(datatype);
+    
+    return write_okay;
+    }
+  
+  hsize_t max_dims[3];
+  
+  for(int j=0; j < n_dims; ++j)  { max_dims[j] = dims[j]; }
+  
+  if(extend)  { max_dims[0] = H5S_UNLIMITED; }
+  
+  hid_t dataspace = arma_H5Screate_simple(n_dims, dims, max_dims);
+  
+  hid_t dcpl = H5P_DEFAULT;
+  
+  bool has_zero_dim = false;
+  
+  for(int j=0; j < n_dims; ++j)  { has_zero_dim = has_zero_dim || (dims[j] == 0); }
+  
+  if(do_chunk && ((has_zero_dim == false) || extend))
+    {
+    // chunk shape is specified by the user in terms of rows, columns and slices
+    const uword user_chunk[3] = { opts.chunk_n_rows, opts.chunk_n_cols, opts.chunk_n_slices };
+    
+    const bool auto_chunk = (opts.chunk_n_rows == 0) || (opts.chunk_n_cols == 0) || (opts.chunk_n_slices == 0);
+    
+    // HDF5 requires each chunk to be smaller than 4 GB
+    const hsize_t max_chunk_n_elem = ((hsize_t(1) << 32) - 1) / sizeof(eT);
+    
+    hsize_t chunk_dims[3];
+    
+    if(auto_chunk)
+      {
+      // keep all dimensions except the first intact, and use roughly 1 MB per chunk;
+      // if the other dimensions are very large, they are reduced so that the chunk stays below the 4 GB limit
+      
+      for(int j=1; j < n_dims; ++j)  { chunk_dims[j] = (std::max)(dims[j], hsize_t(1)); }
+      
+      hsize_t inner_n_elem = 1;
+      
+      for(int j=1; j < n_dims; ++j)
+        {
+        hsize_t rest_n_elem = 1;
+        
+        for(int k=j+1; k < n_dims; ++k)  { rest_n_elem *= chunk_dims[k]; }
+        
+        chunk_dims[j] = (std::min)( chunk_dims[j], (std::max)(hsize_t(1), max_chunk_n_elem / rest_n_elem) );
+        
+        inner_n_elem *= chunk_dims[j];
+        }
+      
+      chunk_dims[0] = (std::max)( hsize_t(1), hsize_t(1048576) / (inner_n_elem * sizeof(eT)) );
+      }
+    else
+      {
+      for(int j=0; j < n_dims; ++j)  { chunk_dims[j] = user_chunk[n_dims - 1 - j]; }
+      }
+    
+    // chunks can't be larger than fixed-size dimensions
+    for(int j=0; j < n_dims; ++j)
+      {
+      if(max_dims[j] != H5S_UNLIMITED)  { chunk_dims[j] = (std::min)(chunk_dims[j], (std::max)(max_dims[j], hsize_t(1))); }
+      }
+    
+    hsize_t chunk_n_elem = 1;
+    
+    bool dcpl_okay = true;
+    
+    for(int j=0; (j < n_dims) && dcpl_okay; ++j)
+      {
+      dcpl_okay = (chunk_dims[j] <= (max_chunk_n_elem / chunk_n_elem));
+      
+      chunk_n_elem *= chunk_dims[j];
+      }
+    
+    if(dcpl_okay == false)  { err_msg = "chunk size must be smaller than 4 GB for "; }
+    
+    if(dcpl_okay)
+      {
+      dcpl = arma_H5Pcreate(arma_H5P_DATASET_CREATE);
+      
+      dcpl_okay = (dcpl >= 0);
+      
+      if(dcpl_okay == false)  { err_msg = "couldn't create dataset properties for "; }
+      }
+    
+    if(dcpl_okay)
+      {
+      dcpl_okay = (arma_H5Pset_chunk(dcpl, n_dims, chunk_dims) >= 0);
+      
+      if(dcpl_okay == false)  { err_msg = "chunk size rejected by HDF5 for "; }
+      }
+    
+    if(dcpl_okay && do_deflate)
+      {
+      dcpl_okay = (arma_H5Pset_deflate(dcpl, opts.deflate_level) >= 0);
+      
+      if(dcpl_okay == false)  { err_msg = "couldn't enable deflate compression for "; }
+      }
+    
+    if(dcpl_okay == false)
+      {
+      if( (dcpl != H5P_DEFAULT) && (dcpl >= 0) )  { arma_H5Pclose(dcpl); }
+      
+      arma_H5Sclose(dataspace);
+      arma_H5Tclose(datatype);
+      
+      return false;
+      }
+    }
+  
+  hid_t dataset = arma_H5Dcreate(location, dataset_name.c_str(), datatype, dataspace, H5P_DEFAULT, dcpl, H5P_DEFAULT);
+  
+  if(dataset < 0)
+    {
+    write_okay = false;
+    
+    err_msg = "couldn't create dataset in ";
+    }
+  else
+    {
+    write_okay = (arma_H5Dwrite(dataset, datatype, H5S_ALL, H5S_ALL, H5P_DEFAULT, mem) >= 0);
+    
+    arma_H5Dclose(dataset);
+    }
+  
+  if(dcpl != H5P_DEFAULT)  { arma_H5Pclose(dcpl); }
+  
+  arma_H5Sclose(dataspace);
+  arma_H5Tclose(datatype);
+  
+  return write_okay;
+  }
+
+
+
+//! the HDF5 library is typically not built to be thread-safe,
+//! so all loading and saving via HDF5 (including background saves) is done one operation at a time
+struct hdf5_lock
+  {
+  #if defined(ARMA_DONT_USE_STD_MUTEX)
+    
+    inline
+    hdf5_lock() {}
+    
+  #else
+    
+    const std::lock_guard<std::mutex> lock;
+    
+    inline
+    hdf5_lock()
+      : lock( get_mutex() )
+      {
+      }
+    
+    inline
+    static
+    std::mutex&
+    get_mutex()
+      {
+      static std::mutex hdf5_mutex;
+      
+      return hdf5_mutex;
+      }
+    
+  #endif
+  };
+
+
+
 struct hdf5_suspend_printing_errors
   {
   #if defined(ARMA_PRINT_HDF5_ERRORS)
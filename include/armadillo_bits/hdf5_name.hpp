@@ -26,24 +26,43 @@ namespace hdf5_opts
     {
     const flag_type flags;
     
+    const uword chunk_n_rows;    // chunk shape for saving; zero indicates automatic selection
+    const uword chunk_n_cols;
+    const uword chunk_n_slices;
+    
+    const unsigned int deflate_level;
+    
+    const span sel_rows;         // subset of the dataset for loading
+    const span sel_cols;
+    const span sel_slices;
+    
     inline explicit opts(const flag_type in_flags);
     
+    inline opts(const flag_type in_flags, const uword in_chunk_n_rows, const uword in_chunk_n_cols, const uword in_chunk_n_slices, const unsigned int in_deflate_level, const span& in_sel_rows, const span& in_sel_cols, const span& in_sel_slices);
+    
     inline const opts operator+(const opts& rhs) const;
     };
   
   inline
   opts::opts(const flag_type in_flags)
-    : flags(in_flags)
+    : flags         (in_flags)
+    , chunk_n_rows  (0)
+    , chunk_n_cols  (0)
+    , chunk_n_slices(0)
+    , deflate_level (0)
     {}
   
   inline
-  const opts
-  opts::operator+(const opts& rhs) const
-    {
-    const opts result( flags | rhs.flags );
-    
-    return result;
-    }
+  opts::opts(const flag_type in_flags, const uword in_chunk_n_rows, const uword in_chunk_n_cols, const uword in_chunk_n_slices, const unsigned int in_deflate_level, const span& in_sel_rows, const span& in_sel_cols, const span& in_sel_slices)
+    : flags         (in_flags         )
+    , chunk_n_rows  (in_chunk_n_rows  )
+    , chunk_n_cols  (in_chunk_n_cols  )
+    , chunk_n_slices(in_chunk_n_slices)
+    , deflate_level (in_deflate_level )
+    , sel_rows      (in_sel_rows      )
+    , sel_cols      (in_sel_cols      )
+    , sel_slices    (in_sel_slices    )
+    {}
   
   // The values below (eg. 1u << 0) are for internal Armadillo use only.
   // The values can change without notice.
@@ -52,16 +71,77 @@ namespace hdf5_opts
   static const flag_type flag_trans   = flag_type(1u << 0);
   static const flag_type flag_append  = flag_type(1u << 1);
   static const flag_type flag_replace = flag_type(1u << 2);
+  static const flag_type flag_chunk   = flag_type(1u << 3);
+  static const flag_type flag_deflate = flag_type(1u << 4);
+  static const flag_type flag_extend  = flag_type(1u << 5);
+  static const flag_type flag_subset  = flag_type(1u << 6);
+  
+  inline
+  const opts
+  opts::operator+(const opts& rhs) const
+    {
+    const bool rhs_chunk   = bool(rhs.flags & flag_chunk  );
+    const bool rhs_deflate = bool(rhs.flags & flag_deflate);
+    const bool rhs_subset  = bool(rhs.flags & flag_subset );
+    
+    const opts result
+      (
+      flags | rhs.flags,
+      rhs_chunk   ? rhs.chunk_n_rows   : chunk_n_rows,
+      rhs_chunk   ? rhs.chunk_n_cols   : chunk_n_cols,
+      rhs_chunk   ? rhs.chunk_n_slices : chunk_n_slices,
+      rhs_deflate ? rhs.deflate_level  : deflate_level,
+      rhs_subset  ? rhs.sel_rows       : sel_rows,
+      rhs_subset  ? rhs.sel_cols       : sel_cols,
+      rhs_subset  ? rhs.sel_slices     : sel_slices
+      );
+    
+    return result;
+    }
   
   struct opts_none    : public opts { inline opts_none()    : opts(flag_none   ) {} };
   struct opts_trans   : public opts { inline opts_trans()   : opts(flag_trans  ) {} };
   struct opts_append  : public opts { inline opts_append()  : opts(flag_append ) {} };
   struct opts_replace : public opts { inline opts_replace() : opts(flag_replace) {} };
+  struct opts_extend  : public opts { inline opts_extend()  : opts(flag_extend ) {} };
   
   static const opts_none    none;
   static const opts_trans   trans;
   static const opts_append  append;
   static const opts_replace replace;
+  static const opts_extend  extend;
+  
+  //! save using a chunked layout with the given chunk shape (in terms of rows, columns and slices)
+  inline
+  const opts
+  chunk(const uword n_rows, const uword n_cols, const uword n_slices = 1)
+    {
+    return opts(flag_chunk, n_rows, n_cols, n_slices, 0, span(), span(), span());
+    }
+  
+  //! save using a chunked layout, compressed with the deflate (zlib) filter; level is in the [0,9] interval
+  inline
+  const opts
+  deflate(const unsigned int level = 6)
+    {
+    return opts(flag_deflate, 0, 0, 0, (std::min)(level, 9u), span(), span(), span());
+    }
+  
+  //! load only the specified rows and columns
+  inline
+  const opts
+  subset(const span& rows, const span& cols)
+    {
+    return opts(flag_subset, 0, 0, 0, 0, rows, cols, span());
+    }
+  
+  //! load only the specified rows, columns and slices
+  inline
+  const opts
+  subset(const span& rows, const span& cols, const span& slices)
+    {
+    return opts(flag_subset, 0, 0, 0, 0, rows, cols, slices);
+    }
   }
 
 
@@ -0,0 +1,60 @@
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+//! \addtogroup iir_filter
+//! @{
+
+
+
+//! IIR filter implemented as a cascade of second-order sections (biquads), with internal state,
+//! for processing a stream of samples in blocks.
+//! each row of the coefficient matrix is one section: [ b0 b1 b2 a0 a1 a2 ];
+//! each column of the input is a separate channel; the state of each channel is kept between calls to process().
+template<typename eT>
+class iir_filter
+  {
+  public:
+  
+  inline ~iir_filter();
+  inline  iir_filter();
+  
+  template<typename T1> inline explicit iir_filter(const Base<eT,T1>& in_sos);
+  
+  template<typename T1> inline void set_coeffs(const Base<eT,T1>& in_sos);
+  
+  template<typename T1> inline void process(Mat<eT>& out, const Base<eT,T1>& in);
+  
+  inline void reset();
+  
+  inline const Mat<eT>& coeffs()     const;
+  inline uword          n_channels() const;
+  
+  
+  private:
+  
+  arma_aligned Mat<eT> sos;     //!< coefficients of the sections, normalised so that a0 = 1
+  arma_aligned Mat<eT> state;   //!< two delay elements per section for each channel (direct form II transposed)
+  
+  static constexpr uword group_size = 8;
+  
+  inline void process_cols(Mat<eT>& out, const Mat<eT>& in, const uword col_start, const uword col_end);
+  
+  template<uword N> inline void process_group(Mat<eT>& out, const Mat<eT>& in, const uword col);
+  };
+
+
+
+//! @}
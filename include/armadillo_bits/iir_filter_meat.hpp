@@ -0,0 +1,274 @@
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+//! \addtogroup iir_filter
+//! @{
+
+
+
+template<typename eT>
+inline
+iir_filter<eT>::~iir_filter()
+  {
+  arma_extra_debug_sigprint_this(this);
+  
+  arma_type_check(( (is_real<eT>::value == false) && (is_cx<eT>::no) ));
+  }
+
+
+
+template<typename eT>
+inline
+iir_filter<eT>::iir_filter()
+  {
+  arma_extra_debug_sigprint_this(this);
+  }
+
+
+
+template<typename eT>
+template<typename T1>
+inline
+iir_filter<eT>::iir_filter(const Base<eT,T1>& in_sos)
+  {
+  arma_extra_debug_sigprint_this(this);
+  
+  set_coeffs(in_sos);
+  }
+
+
+
+//! set the coefficients of the sections and clear the state
+template<typename eT>
+template<typename T1>
+inline
+void
+iir_filter<eT>::set_coeffs(const Base<eT,T1>& in_sos)
+  {
+  arma_extra_debug_sigprint();
+  
+  const quasi_unwrap<T1> U(in_sos.get_ref());
+  
+  const Mat<eT>& S = U.M;
+  
+  arma_debug_check( ((S.n_cols != 6) && (S.is_empty() == false)), "iir_filter::set_coeffs(): given matrix must have 6 columns" );
+  
+  Mat<eT> tmp(S);
+  
+  for(uword s=0; s < tmp.n_rows; ++s)
+    {
+    const eT a0 = tmp.at(s,3);
+    
+    arma_debug_check( (a0 == eT(0)), "iir_filter::set_coeffs(): coefficient a0 must be non-zero" );
+    
+    for(uword j=0; j < 6; ++j)  { tmp.at(s,j) /= a0; }
+    }
+  
+  sos.steal_mem(tmp);
+  
+  reset();
+  }
+
+
+
+//! filter the given block of samples, continuing from the state left by the previous block;
+//! each column is a separate channel; out may be the same matrix as in
+template<typename eT>
+template<typename T1>
+inline
+void
+iir_filter<eT>::process(Mat<eT>& out, const Base<eT,T1>& in)
+  {
+  arma_extra_debug_sigprint();
+  
+  const quasi_unwrap<T1> U(in.get_ref());
+  
+  const Mat<eT>& X = U.M;
+  
+  // each sample is read before the corresponding output is written, so out can be the same matrix as the input;
+  // a temporary is only needed for a partial overlap
+  
+  const bool in_place = (X.memptr() == out.memptr()) && (X.n_rows == out.n_rows) && (X.n_cols == out.n_cols);
+  
+  if(U.is_alias(out) && (in_place == false))
+    {
+    Mat<eT> tmp;
+    
+    process(tmp, X);
+    
+    out.steal_mem(tmp);
+    
+    return;
+    }
+  
+  arma_debug_check( (sos.n_rows == 0), "iir_filter::process(): filter coefficients not set" );
+  
+  if(state.n_cols != X.n_cols)
+    {
+    arma_debug_check( (state.n_cols > 0), "iir_filter::process(): number of channels differs from previous call" );
+    
+    state.zeros(2 * sos.n_rows, X.n_cols);
+    }
+  
+  if(in_place == false)  { out.set_size(X.n_rows, X.n_cols); }
+  
+  if(X.is_empty())  { return; }
+  
+  const uword n_cols = X.n_cols;
+  
+  #if defined(ARMA_USE_OPENMP)
+    {
+    if( (n_cols > 1) && mp_gate<eT>::eval(X.n_elem * sos.n_rows) )
+      {
+      const uword n_threads = (std::min)( uword(mp_thread_limit::get()), n_cols );
+      
+      #pragma omp parallel for schedule(static) num_threads(int(n_threads))
+      for(uword t=0; t < n_threads; ++t)
+        {
+        const uword col_start = (t    * n_cols) / n_threads;
+        const uword col_end   = ((t+1) * n_cols) / n_threads;
+        
+        process_cols(out, X, col_start, col_end);
+        }
+      
+      return;
+      }
+    }
+  #endif
+  
+  process_cols(out, X, 0, n_cols);
+  }
+
+
+
+//! clear the state, as if all previous input samples were zero
+template<typename eT>
+inline
+void
+iir_filter<eT>::reset()
+  {
+  arma_extra_debug_sigprint();
+  
+  state.reset();
+  }
+
+
+
+template<typename eT>
+inline
+const Mat<eT>&
+iir_filter<eT>::coeffs() const
+  {
+  return sos;
+  }
+
+
+
+template<typename eT>
+inline
+uword
+iir_filter<eT>::n_channels() const
+  {
+  return state.n_cols;
+  }
+
+
+
+template<typename eT>
+inline
+void
+iir_filter<eT>::process_cols(Mat<eT>& out, const Mat<eT>& in, const uword col_start, const uword col_end)
+  {
+  arma_extra_debug_sigprint();
+  
+  // the recursion of each section is inherently sequential,
+  // hence several channels are processed together to provide independent operations
+  
+  uword col = col_start;
+  
+  for(; (col + group_size) <= col_end; col += group_size)  { process_group<group_size>(out, in, col); }
+  
+  for(; col < col_end; ++col)  { process_group<1>(out, in, col); }
+  }
+
+
+
+//! apply all sections to channels [col, col+N)
+template<typename eT>
+template<uword N>
+inline
+void
+iir_filter<eT>::process_group(Mat<eT>& out, const Mat<eT>& in, const uword col)
+  {
+  const uword n_sections = sos.n_rows;
+  const uword n_samples  = in.n_rows;
+  
+  const eT* src[N];
+        eT* y  [N];
+  
+  for(uword j=0; j < N; ++j)
+    {
+    src[j] = in.colptr(col + j);
+    y  [j] = out.colptr(col + j);
+    }
+  
+  // each section is applied to the whole block before the next section,
+  // so that the coefficients and delay elements stay in registers
+  
+  for(uword s=0; s < n_sections; ++s)
+    {
+    const eT b0 = sos.at(s,0);
+    const eT b1 = sos.at(s,1);
+    const eT b2 = sos.at(s,2);
+    const eT a1 = sos.at(s,4);
+    const eT a2 = sos.at(s,5);
+    
+    eT z1[N];
+    eT z2[N];
+    
+    for(uword j=0; j < N; ++j)
+      {
+      z1[j] = state.at(2*s,     col + j);
+      z2[j] = state.at(2*s + 1, col + j);
+      }
+    
+    for(uword i=0; i < n_samples; ++i)
+      {
+      for(uword j=0; j < N; ++j)
+        {
+        const eT xi = src[j][i];
+        const eT yi = b0*xi + z1[j];
+        
+        z1[j] = b1*xi - a1*yi + z2[j];
+        z2[j] = b2*xi - a2*yi;
+        
+        y[j][i] = yi;
+        }
+      }
+    
+    for(uword j=0; j < N; ++j)
+      {
+      state.at(2*s,     col + j) = z1[j];
+      state.at(2*s + 1, col + j) = z2[j];
+      
+      src[j] = y[j];
+      }
+    }
+  }
+
+
+
+//! @}
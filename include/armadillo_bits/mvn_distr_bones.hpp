@@ -0,0 +1,68 @@
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+//! \addtogroup mvn_distr
+//! @{
+
+
+
+//! multivariate normal distribution with one covariance matrix shared by one or more mean vectors;
+//! the Cholesky factor of the covariance matrix is computed once and reused for generating samples and evaluating densities
+template<typename eT>
+class mvn_distr
+  {
+  public:
+  
+  arma_aligned const Mat<eT> means;   //!< each column is a mean vector
+  arma_aligned const Mat<eT> cov;
+  
+  inline ~mvn_distr();
+  inline  mvn_distr();
+  
+  template<typename T1, typename T2> inline mvn_distr(const Base<eT,T1>& in_means, const Base<eT,T2>& in_cov);
+  
+  template<typename T1, typename T2> inline bool set_params(const Base<eT,T1>& in_means, const Base<eT,T2>& in_cov);
+  
+  template<typename T1> inline void set_means(const Base<eT,T1>& in_means);
+  template<typename T1> inline bool set_cov  (const Base<eT,T1>& in_cov  );
+  
+  inline uword n_dims()  const;
+  inline uword n_means() const;
+  
+  inline Mat<eT> generate()              const;
+  inline Mat<eT> generate(const uword N) const;
+  
+  template<typename T1> inline Mat<eT> log_p(const Base<eT,T1>& X)                      const;
+  template<typename T1> inline Row<eT> log_p(const Base<eT,T1>& X, const uword mean_id) const;
+  
+  
+  private:
+  
+  arma_aligned Mat<eT> chol_cov;         //!< lower triangular Cholesky factor L of the covariance matrix
+  arma_aligned Col<eT> centre;           //!< average of the mean vectors
+  arma_aligned Mat<eT> whitened_means;   //!< inv(L) * (means - centre)
+  arma_aligned Col<eT> whitened_norms;   //!< squared norms of the columns of whitened_means
+  
+  eT log_p_const;                        //!< -0.5 * (n_dims*log(2*pi) + log(det(cov)))
+  
+  inline void init_whitened_means();
+  
+  inline void whiten(Mat<eT>& out, const Mat<eT>& X) const;
+  };
+
+
+
+//! @}
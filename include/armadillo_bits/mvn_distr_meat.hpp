@@ -0,0 +1,390 @@
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+//! \addtogroup mvn_distr
+//! @{
+
+
+
+template<typename eT>
+inline
+mvn_distr<eT>::~mvn_distr()
+  {
+  arma_extra_debug_sigprint_this(this);
+  
+  arma_type_check(( is_real<eT>::value == false ));
+  }
+
+
+
+template<typename eT>
+inline
+mvn_distr<eT>::mvn_distr()
+  : log_p_const(eT(0))
+  {
+  arma_extra_debug_sigprint_this(this);
+  }
+
+
+
+template<typename eT>
+template<typename T1, typename T2>
+inline
+mvn_distr<eT>::mvn_distr(const Base<eT,T1>& in_means, const Base<eT,T2>& in_cov)
+  : log_p_const(eT(0))
+  {
+  arma_extra_debug_sigprint_this(this);
+  
+  const bool status = set_params(in_means, in_cov);
+  
+  if(status == false)
+    {
+    arma_stop_runtime_error("mvn_distr(): given covariance matrix is not symmetric positive definite");
+    }
+  }
+
+
+
+//! set the mean vectors and the covariance matrix;
+//! returns false (leaving the object unchanged) if the covariance matrix is not symmetric positive definite
+template<typename eT>
+template<typename T1, typename T2>
+inline
+bool
+mvn_distr<eT>::set_params(const Base<eT,T1>& in_means, const Base<eT,T2>& in_cov)
+  {
+  arma_extra_debug_sigprint();
+  
+  const quasi_unwrap<T1> UM(in_means.get_ref());
+  const quasi_unwrap<T2> UC(in_cov.get_ref()  );
+  
+  arma_debug_check( (UC.M.is_square() == false),  "mvn_distr::set_params(): given covariance matrix must be square sized"                   );
+  arma_debug_check( (UM.M.n_rows != UC.M.n_rows), "mvn_distr::set_params(): number of rows in given means and covariance matrix must match" );
+  
+  if((arma_config::debug) && (auxlib::rudimentary_sym_check(UC.M) == false))
+    {
+    arma_debug_warn("mvn_distr::set_params(): given covariance matrix is not symmetric");
+    }
+  
+  Mat<eT> L;
+  
+  const bool status = op_chol::apply_direct(L, UC.M, 1);  // '1' means "lower triangular"
+  
+  if(status == false)  { return false; }
+  
+  access::rw(means) = UM.M;
+  access::rw(cov)   = UC.M;
+  
+  chol_cov.steal_mem(L);
+  
+  init_whitened_means();
+  
+  return true;
+  }
+
+
+
+//! change the mean vectors, keeping the covariance matrix (and its factorisation)
+template<typename eT>
+template<typename T1>
+inline
+void
+mvn_distr<eT>::set_means(const Base<eT,T1>& in_means)
+  {
+  arma_extra_debug_sigprint();
+  
+  const quasi_unwrap<T1> UM(in_means.get_ref());
+  
+  arma_debug_check( (UM.M.n_rows != cov.n_rows), "mvn_distr::set_means(): number of rows in given means and covariance matrix must match" );
+  
+  access::rw(means) = UM.M;
+  
+  init_whitened_means();
+  }
+
+
+
+//! change the covariance matrix, keeping the mean vectors;
+//! returns false (leaving the object unchanged) if the covariance matrix is not symmetric positive definite
+template<typename eT>
+template<typename T1>
+inline
+bool
+mvn_distr<eT>::set_cov(const Base<eT,T1>& in_cov)
+  {
+  arma_extra_debug_sigprint();
+  
+  const quasi_unwrap<T1> UC(in_cov.get_ref());
+  
+  // a zero mean is used if the means have not been set
+  
+  const Mat<eT> tmp_means = (means.n_cols > 0) ? Mat<eT>(means) : Mat<eT>(UC.M.n_rows, 1, fill::zeros);
+  
+  return set_params(tmp_means, UC.M);
+  }
+
+
+
+template<typename eT>
+inline
+uword
+mvn_distr<eT>::n_dims() const
+  {
+  return cov.n_rows;
+  }
+
+
+
+template<typename eT>
+inline
+uword
+mvn_distr<eT>::n_means() const
+  {
+  return means.n_cols;
+  }
+
+
+
+template<typename eT>
+inline
+void
+mvn_distr<eT>::init_whitened_means()
+  {
+  arma_extra_debug_sigprint();
+  
+  const uword N_dims = chol_cov.n_rows;
+  
+  eT log_det = eT(0);
+  
+  for(uword i=0; i < N_dims; ++i)  { log_det += std::log( chol_cov.at(i,i) ); }
+  
+  log_det *= eT(2);
+  
+  log_p_const = eT(-0.5) * ( eT(N_dims) * std::log(eT(2) * Datum<eT>::pi) + log_det );
+  
+  // the squared Mahalanobis distance between x and mean k is || inv(L)*(x - centre) - whitened_means.col(k) ||^2;
+  // centring keeps the terms of its expansion small, which limits cancellation
+  
+  const uword N_means = means.n_cols;
+  
+  centre = (N_means > 0) ? Col<eT>(mean(means, 1)) : Col<eT>(N_dims, fill::zeros);
+  
+  Mat<eT> D = means;
+  
+  D.each_col() -= centre;
+  
+  whiten(whitened_means, D);
+  
+  whitened_norms.set_size(N_means);
+  
+  for(uword k=0; k < N_means; ++k)
+    {
+    const eT* colptr = whitened_means.colptr(k);
+    
+    whitened_norms[k] = op_dot::direct_dot(N_dims, colptr, colptr);
+    }
+  }
+
+
+
+//! out = inv(L) * X
+template<typename eT>
+inline
+void
+mvn_distr<eT>::whiten(Mat<eT>& out, const Mat<eT>& X) const
+  {
+  arma_extra_debug_sigprint();
+  
+  if(X.is_empty())  { out.set_size(X.n_rows, X.n_cols); return; }
+  
+  const bool status = auxlib::solve_trimat_fast(out, chol_cov, X, 1);  // '1' means "lower triangular"
+  
+  if(status == false)  { out.set_size(X.n_rows, X.n_cols); out.fill(Datum<eT>::nan); }
+  }
+
+
+
+//! one random vector for each mean
+template<typename eT>
+inline
+Mat<eT>
+mvn_distr<eT>::generate() const
+  {
+  arma_extra_debug_sigprint();
+  
+  return generate(1);
+  }
+
+
+
+//! N random vectors for each mean;
+//! columns [k*N, (k+1)*N) are drawn from the distribution with mean k
+template<typename eT>
+inline
+Mat<eT>
+mvn_distr<eT>::generate(const uword N) const
+  {
+  arma_extra_debug_sigprint();
+  
+  arma_debug_check( (chol_cov.is_empty()), "mvn_distr::generate(): parameters not set" );
+  
+  const uword N_dims  = chol_cov.n_rows;
+  const uword N_means = means.n_cols;
+  
+  // all samples are transformed by a single matrix multiplication
+  
+  Mat<eT> out = chol_cov * randn< Mat<eT> >(N_dims, N_means * N);
+  
+  if(N == 0)  { return out; }
+  
+  if(N_means == 1)
+    {
+    out.each_col() += means.col(0);
+    }
+  else
+    {
+    for(uword k=0; k < N_means; ++k)  { out.cols(k*N, k*N + N-1).each_col() += means.col(k); }
+    }
+  
+  return out;
+  }
+
+
+
+//! log-densities of the columns of X for each mean;
+//! element (k,i) is the log-density of X.col(i) under the distribution with mean k
+template<typename eT>
+template<typename T1>
+inline
+Mat<eT>
+mvn_distr<eT>::log_p(const Base<eT,T1>& X_expr) const
+  {
+  arma_extra_debug_sigprint();
+  
+  const quasi_unwrap<T1> U(X_expr.get_ref());
+  
+  const Mat<eT>& X = U.M;
+  
+  const uword N_dims  = chol_cov.n_rows;
+  const uword N_means = means.n_cols;
+  const uword N       = X.n_cols;
+  
+  arma_debug_check( (chol_cov.is_empty()), "mvn_distr::log_p(): parameters not set" );
+  arma_debug_check( (X.n_rows != N_dims),  "mvn_distr::log_p(): incompatible dimensions" );
+  
+  if(N_means == 1)  { return Mat<eT>( log_p(X, 0) ); }
+  
+  Mat<eT> out(N_means, N);
+  
+  if(N == 1)
+    {
+    // one point, many means: a single triangular solve with a right hand side for each mean
+    
+    Mat<eT> D = means;
+    
+    D.each_col() -= X.col(0);
+    
+    Mat<eT> Y;
+    
+    whiten(Y, D);
+    
+    for(uword k=0; k < N_means; ++k)
+      {
+      const eT* colptr = Y.colptr(k);
+      
+      out[k] = log_p_const - eT(0.5) * op_dot::direct_dot(N_dims, colptr, colptr);
+      }
+    
+    return out;
+    }
+  
+  // many points and many means:
+  // ||a - b||^2 = ||a||^2 + ||b||^2 - 2*a'*b, with the cross terms for all pairs obtained via one matrix multiplication
+  
+  Mat<eT> D = X;
+  
+  D.each_col() -= centre;
+  
+  Mat<eT> A;
+  
+  whiten(A, D);
+  
+  out = whitened_means.t() * A;
+  
+  for(uword i=0; i < N; ++i)
+    {
+    const eT* A_colptr = A.colptr(i);
+    
+    const eT A_norm = op_dot::direct_dot(N_dims, A_colptr, A_colptr);
+    
+    eT* out_colptr = out.colptr(i);
+    
+    for(uword k=0; k < N_means; ++k)
+      {
+      const eT dist = (std::max)( eT(0), (A_norm + whitened_norms[k] - eT(2)*out_colptr[k]) );
+      
+      out_colptr[k] = log_p_const - eT(0.5) * dist;
+      }
+    }
+  
+  return out;
+  }
+
+
+
+//! log-densities of the columns of X for the distribution with the given mean
+template<typename eT>
+template<typename T1>
+inline
+Row<eT>
+mvn_distr<eT>::log_p(const Base<eT,T1>& X_expr, const uword mean_id) const
+  {
+  arma_extra_debug_sigprint();
+  
+  const quasi_unwrap<T1> U(X_expr.get_ref());
+  
+  const Mat<eT>& X = U.M;
+  
+  const uword N_dims = chol_cov.n_rows;
+  const uword N      = X.n_cols;
+  
+  arma_debug_check( (chol_cov.is_empty()),     "mvn_distr::log_p(): parameters not set"  );
+  arma_debug_check( (X.n_rows != N_dims),      "mvn_distr::log_p(): incompatible dimensions" );
+  arma_debug_check( (mean_id >= means.n_cols), "mvn_distr::log_p(): specified mean is out of range" );
+  
+  Mat<eT> D = X;
+  
+  D.each_col() -= means.col(mean_id);
+  
+  Mat<eT> Y;
+  
+  whiten(Y, D);
+  
+  Row<eT> out(N);
+  
+  for(uword i=0; i < N; ++i)
+    {
+    const eT* colptr = Y.colptr(i);
+    
+    out[i] = log_p_const - eT(0.5) * op_dot::direct_dot(N_dims, colptr, colptr);
+    }
+  
+  return out;
+  }
+
+
+
+//! @}
@@ -27,6 +27,9 @@ class op_fft_real
   
   template<typename T1>
   inline static void apply( Mat< std::complex<typename T1::pod_type> >& out, const mtOp<std::complex<typename T1::pod_type>,T1,op_fft_real>& in );
+  
+  template<typename T1, typename worker_type>
+  inline static void apply_cols(Mat< std::complex<typename T1::pod_type> >& out, const Proxy<T1>& P, const worker_type& worker, const uword N_orig, const uword col_start, const uword col_end);
   };
 
 
@@ -41,6 +44,12 @@ class op_fft_cx
   
   template<typename T1, bool inverse>
   inline static void apply_noalias(Mat<typename T1::elem_type>& out, const Proxy<T1>& P, const uword a, const uword b);
+  
+  template<typename T1, typename worker_type>
+  inline static void apply_mat(Mat<typename T1::elem_type>& out, const Proxy<T1>& P, const worker_type& worker, const uword N_orig, const typename T1::elem_type* X_mem);
+  
+  template<typename T1, typename worker_type>
+  inline static void apply_cols(Mat<typename T1::elem_type>& out, const Proxy<T1>& P, const worker_type& worker, const uword N_orig, const typename T1::elem_type* X_mem, const uword col_start, const uword col_end);
 
   template<typename T1> arma_hot inline static void copy_vec       (typename Proxy<T1>::elem_type* dest, const Proxy<T1>& P, const uword N);
   template<typename T1> arma_hot inline static void copy_vec_proxy (typename Proxy<T1>::elem_type* dest, const Proxy<T1>& P, const uword N);
@@ -60,4 +69,48 @@ class op_ifft_cx
 
 
 
+class op_ifft_real
+  : public traits_op_passthru
+  {
+  public:
+  
+  template<typename T1>
+  inline static void apply( Mat<typename T1::pod_type>& out, const mtOp<typename T1::pod_type,T1,op_ifft_real>& in );
+  
+  template<typename T1, typename worker_type>
+  inline static void apply_cols(Mat<typename T1::pod_type>& out, const Proxy<T1>& P, const worker_type& worker, const uword N_orig, const uword col_start, const uword col_end);
+  };
+
+
+
+//! transforms along one dimension of a multi-dimensional array, stored as [n_inner x n_len x n_outer] with n_inner varying fastest;
+//! used by fft2(), ifft2(), fft3() and ifft3()
+class op_fft_dim
+  {
+  public:
+  
+  //! number of transforms gathered into a tile, so that elements along the inner dimension are read and written in contiguous runs
+  static constexpr uword tile_size = 8;
+  
+  template<typename eT, bool inverse>
+  inline static void apply(eT* mem, const uword n_inner, const uword n_len, const uword n_outer);
+  
+  template<typename eT, typename worker_type>
+  inline static void apply_range(eT* mem, const uword n_inner, const uword n_len, const worker_type& worker, const uword task_start, const uword task_end);
+  
+  template<typename T1>
+  inline static void apply_fft2(Mat< std::complex<typename T1::pod_type> >& out, const T1& A);
+  
+  template<typename T1>
+  inline static void apply_ifft2(Mat<typename T1::elem_type>& out, const T1& A);
+  
+  template<typename T1>
+  inline static void apply_fft3(Cube< std::complex<typename T1::pod_type> >& out, const T1& A);
+  
+  template<typename T1>
+  inline static void apply_ifft3(Cube<typename T1::elem_type>& out, const T1& A);
+  };
+
+
+
 //! @}
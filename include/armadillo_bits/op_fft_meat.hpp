@@ -46,8 +46,6 @@ op_fft_real::apply( Mat< std::complex<typename T1::pod_type> >& out, const mtOp<
   const uword N_orig = (is_vec)              ? n_elem         : n_rows;
   const uword N_user = (in.aux_uword_b == 0) ? in.aux_uword_a : N_orig;
   
-  fft_engine<out_eT,false> worker(N_user);
-  
   // no need to worry about aliasing, as we're going from a real object to complex complex, which by definition cannot alias
   
   if(is_vec)
@@ -66,9 +64,12 @@ op_fft_real::apply( Mat< std::complex<typename T1::pod_type> >& out, const mtOp<
       return;
       }
     
-    podarray<out_eT> data(N_user);
+    const std::shared_ptr< const fft_engine_real<out_eT,false> > worker = fft_engine_cache< out_eT, false, fft_engine_real<out_eT,false> >::get(N_user);
+    
+    podarray<in_eT>  data(N_user);
+    podarray<out_eT> buf (N_user);
     
-    out_eT* data_mem = data.memptr();
+    in_eT* data_mem = data.memptr();
     
     if(N_user > N_orig)  { arrayops::fill_zeros( &data_mem[N_orig], (N_user - N_orig) ); }
     
@@ -78,21 +79,21 @@ op_fft_real::apply( Mat< std::complex<typename T1::pod_type> >& out, const mtOp<
       {
       typename Proxy<T1>::ea_type X = P.get_ea();
       
-      for(uword i=0; i < N; ++i)  { data_mem[i] = out_eT( X[i], in_eT(0) ); }
+      for(uword i=0; i < N; ++i)  { data_mem[i] = X[i]; }
       }
     else
       {
       if(n_cols == 1)
         {
-        for(uword i=0; i < N; ++i)  { data_mem[i] = out_eT( P.at(i,0), in_eT(0) ); }
+        for(uword i=0; i < N; ++i)  { data_mem[i] = P.at(i,0); }
         }
       else
         {
-        for(uword i=0; i < N; ++i)  { data_mem[i] = out_eT( P.at(0,i), in_eT(0) ); }
+        for(uword i=0; i < N; ++i)  { data_mem[i] = P.at(0,i); }
         }
       }
     
-    worker.run( out.memptr(), data_mem );
+    worker->run_r2c( out.memptr(), data_mem, buf.memptr() );
     }
   else
     {
@@ -113,20 +114,61 @@ op_fft_real::apply( Mat< std::complex<typename T1::pod_type> >& out, const mtOp<
       return;
       }
     
-    podarray<out_eT> data(N_user);
-    
-    out_eT* data_mem = data.memptr();
+    const std::shared_ptr< const fft_engine_real<out_eT,false> > worker = fft_engine_cache< out_eT, false, fft_engine_real<out_eT,false> >::get(N_user);
     
-    if(N_user > N_orig)  { arrayops::fill_zeros( &data_mem[N_orig], (N_user - N_orig) ); }
-    
-    const uword N = (std::min)(N_user, N_orig);
-    
-    for(uword col=0; col < n_cols; ++col)
+    #if defined(ARMA_USE_OPENMP)
       {
-      for(uword i=0; i < N; ++i)  { data_mem[i] = P.at(i, col); }
-      
-      worker.run( out.colptr(col), data_mem );
+      if( (n_cols > 1) && mp_gate<out_eT>::eval(out.n_elem) )
+        {
+        const uword n_threads = (std::min)( uword(mp_thread_limit::get()), n_cols );
+        
+        #pragma omp parallel for schedule(static) num_threads(int(n_threads))
+        for(uword t=0; t < n_threads; ++t)
+          {
+          const uword col_start = (t    * n_cols) / n_threads;
+          const uword col_end   = ((t+1) * n_cols) / n_threads;
+          
+          op_fft_real::apply_cols(out, P, *worker, N_orig, col_start, col_end);
+          }
+        
+        return;
+        }
       }
+    #endif
+    
+    op_fft_real::apply_cols(out, P, *worker, N_orig, 0, n_cols);
+    }
+  }
+
+
+
+//! transform columns [col_start, col_end) of the input
+template<typename T1, typename worker_type>
+inline
+void
+op_fft_real::apply_cols(Mat< std::complex<typename T1::pod_type> >& out, const Proxy<T1>& P, const worker_type& worker, const uword N_orig, const uword col_start, const uword col_end)
+  {
+  arma_extra_debug_sigprint();
+  
+  typedef typename T1::pod_type         in_eT;
+  typedef typename std::complex<in_eT> out_eT;
+  
+  const uword N_user = out.n_rows;
+  
+  podarray<in_eT>  data(N_user);
+  podarray<out_eT> buf (N_user);
+  
+  in_eT* data_mem = data.memptr();
+  
+  if(N_user > N_orig)  { arrayops::fill_zeros( &data_mem[N_orig], (N_user - N_orig) ); }
+  
+  const uword N = (std::min)(N_user, N_orig);
+  
+  for(uword col=col_start; col < col_end; ++col)
+    {
+    for(uword i=0; i < N; ++i)  { data_mem[i] = P.at(i, col); }
+    
+    worker.run_r2c( out.colptr(col), data_mem, buf.memptr() );
     }
   }
 
@@ -181,8 +223,6 @@ op_fft_cx::apply_noalias(Mat<typename T1::elem_type>& out, const Proxy<T1>& P, c
   const uword N_orig = (is_vec) ? n_elem : n_rows;
   const uword N_user = (b == 0) ? a      : N_orig;
   
-  fft_engine<eT,inverse> worker(N_user);
-  
   if(is_vec)
     {
     (n_cols == 1) ? out.set_size(N_user, 1) : out.set_size(1, N_user);
@@ -199,6 +239,8 @@ op_fft_cx::apply_noalias(Mat<typename T1::elem_type>& out, const Proxy<T1>& P, c
       return;
       }
     
+    const std::shared_ptr< const fft_engine<eT,inverse> > worker = fft_engine_cache<eT,inverse>::get(N_user);
+    
     if( (N_user > N_orig) || (is_Mat<typename Proxy<T1>::stored_type>::value == false) )
       {
       podarray<eT> data(N_user);
@@ -209,13 +251,13 @@ op_fft_cx::apply_noalias(Mat<typename T1::elem_type>& out, const Proxy<T1>& P, c
       
       op_fft_cx::copy_vec( data_mem, P, (std::min)(N_user, N_orig) );
       
-      worker.run( out.memptr(), data_mem );
+      worker->run( out.memptr(), data_mem );
       }
     else
       {
       const unwrap< typename Proxy<T1>::stored_type > tmp(P.Q);
       
-      worker.run( out.memptr(), tmp.M.memptr() );
+      worker->run( out.memptr(), tmp.M.memptr() );
       }
     }
   else
@@ -237,34 +279,20 @@ op_fft_cx::apply_noalias(Mat<typename T1::elem_type>& out, const Proxy<T1>& P, c
       return;
       }
     
+    const std::shared_ptr< const fft_engine<eT,inverse> > worker = fft_engine_cache<eT,inverse>::get(N_user);
+    
     if( (N_user > N_orig) || (is_Mat<typename Proxy<T1>::stored_type>::value == false) )
       {
-      podarray<eT> data(N_user);
-      
-      eT* data_mem = data.memptr();
-      
-      if(N_user > N_orig)  { arrayops::fill_zeros( &data_mem[N_orig], (N_user - N_orig) ); }
-      
-      const uword N = (std::min)(N_user, N_orig);
-      
-      for(uword col=0; col < n_cols; ++col)
-        {
-        for(uword i=0; i < N; ++i)  { data_mem[i] = P.at(i, col); }
-        
-        worker.run( out.colptr(col), data_mem );
-        }
+      op_fft_cx::apply_mat(out, P, *worker, N_orig, nullptr);
       }
     else
       {
       const unwrap< typename Proxy<T1>::stored_type > tmp(P.Q);
       
-      for(uword col=0; col < n_cols; ++col)
-        {
-        worker.run( out.colptr(col), tmp.M.colptr(col) );
-        }
+      op_fft_cx::apply_mat(out, P, *worker, N_orig, tmp.M.memptr());
       }
     }
-    
+  
   
   // correct the scaling for the inverse transform
   if(inverse == true)
@@ -283,6 +311,84 @@ op_fft_cx::apply_noalias(Mat<typename T1::elem_type>& out, const Proxy<T1>& P, c
 
 
 
+//! transform each column of the input, in parallel if possible;
+//! if X_mem is not null, the columns are read directly from X_mem
+template<typename T1, typename worker_type>
+inline
+void
+op_fft_cx::apply_mat(Mat<typename T1::elem_type>& out, const Proxy<T1>& P, const worker_type& worker, const uword N_orig, const typename T1::elem_type* X_mem)
+  {
+  arma_extra_debug_sigprint();
+  
+  const uword n_cols = out.n_cols;
+  
+  #if defined(ARMA_USE_OPENMP)
+    {
+    typedef typename T1::elem_type eT;
+    
+    if( (n_cols > 1) && mp_gate<eT>::eval(out.n_elem) )
+      {
+      const uword n_threads = (std::min)( uword(mp_thread_limit::get()), n_cols );
+      
+      #pragma omp parallel for schedule(static) num_threads(int(n_threads))
+      for(uword t=0; t < n_threads; ++t)
+        {
+        const uword col_start = (t    * n_cols) / n_threads;
+        const uword col_end   = ((t+1) * n_cols) / n_threads;
+        
+        op_fft_cx::apply_cols(out, P, worker, N_orig, X_mem, col_start, col_end);
+        }
+      
+      return;
+      }
+    }
+  #endif
+  
+  op_fft_cx::apply_cols(out, P, worker, N_orig, X_mem, 0, n_cols);
+  }
+
+
+
+//! transform columns [col_start, col_end) of the input
+template<typename T1, typename worker_type>
+inline
+void
+op_fft_cx::apply_cols(Mat<typename T1::elem_type>& out, const Proxy<T1>& P, const worker_type& worker, const uword N_orig, const typename T1::elem_type* X_mem, const uword col_start, const uword col_end)
+  {
+  arma_extra_debug_sigprint();
+  
+  typedef typename T1::elem_type eT;
+  
+  if(X_mem != nullptr)
+    {
+    for(uword col=col_start; col < col_end; ++col)
+      {
+      worker.run( out.colptr(col), &(X_mem[col * N_orig]) );
+      }
+    
+    return;
+    }
+  
+  const uword N_user = out.n_rows;
+  
+  podarray<eT> data(N_user);
+  
+  eT* data_mem = data.memptr();
+  
+  if(N_user > N_orig)  { arrayops::fill_zeros( &data_mem[N_orig], (N_user - N_orig) ); }
+  
+  const uword N = (std::min)(N_user, N_orig);
+  
+  for(uword col=col_start; col < col_end; ++col)
+    {
+    for(uword i=0; i < N; ++i)  { data_mem[i] = P.at(i, col); }
+    
+    worker.run( out.colptr(col), data_mem );
+    }
+  }
+
+
+
 template<typename T1>
 arma_hot
 inline
@@ -378,4 +484,405 @@ op_ifft_cx::apply(Mat<typename T1::elem_type>& out, const Op<T1,op_ifft_cx>& in)
   
 
 
+//
+// op_ifft_real
+
+
+template<typename T1>
+inline
+void
+op_ifft_real::apply( Mat<typename T1::pod_type>& out, const mtOp<typename T1::pod_type,T1,op_ifft_real>& in )
+  {
+  arma_extra_debug_sigprint();
+  
+  typedef typename T1::elem_type in_eT;
+  typedef typename T1::pod_type  out_eT;
+  
+  const Proxy<T1> P(in.m);
+  
+  const uword n_rows = P.get_n_rows();
+  const uword n_cols = P.get_n_cols();
+  const uword n_elem = P.get_n_elem();
+  
+  const bool is_vec = ( (n_rows == 1) || (n_cols == 1) );
+  
+  const uword N_orig = (is_vec)              ? n_elem         : n_rows;
+  const uword N_user = (in.aux_uword_b == 0) ? in.aux_uword_a : N_orig;
+  
+  // no need to worry about aliasing, as we're going from a complex object to real, which by definition cannot alias
+  
+  if(is_vec)
+    {
+    (n_cols == 1) ? out.set_size(N_user, 1) : out.set_size(1, N_user);
+    
+    if( (out.n_elem == 0) || (N_orig == 0) )
+      {
+      out.zeros();
+      return;
+      }
+    
+    if( (N_user == 1) && (N_orig >= 1) )
+      {
+      out[0] = std::real( P[0] );
+      return;
+      }
+    
+    const std::shared_ptr< const fft_engine_real<in_eT,true> > worker = fft_engine_cache< in_eT, true, fft_engine_real<in_eT,true> >::get(N_user);
+    
+    podarray<in_eT> data(N_user);
+    podarray<in_eT> buf (N_user);
+    
+    in_eT* data_mem = data.memptr();
+    
+    if(N_user > N_orig)  { arrayops::fill_zeros( &data_mem[N_orig], (N_user - N_orig) ); }
+    
+    op_fft_cx::copy_vec( data_mem, P, (std::min)(N_user, N_orig) );
+    
+    worker->run_c2r( out.memptr(), data_mem, buf.memptr() );
+    
+    arrayops::inplace_mul( out.memptr(), out_eT(1) / out_eT(N_user), N_user );
+    }
+  else
+    {
+    // process each column seperately
+    
+    out.set_size(N_user, n_cols);
+    
+    if( (out.n_elem == 0) || (N_orig == 0) )
+      {
+      out.zeros();
+      return;
+      }
+    
+    if( (N_user == 1) && (N_orig >= 1) )
+      {
+      for(uword col=0; col < n_cols; ++col)  { out.at(0,col) = std::real( P.at(0,col) ); }
+      
+      return;
+      }
+    
+    const std::shared_ptr< const fft_engine_real<in_eT,true> > worker = fft_engine_cache< in_eT, true, fft_engine_real<in_eT,true> >::get(N_user);
+    
+    #if defined(ARMA_USE_OPENMP)
+      {
+      if( (n_cols > 1) && mp_gate<in_eT>::eval(out.n_elem) )
+        {
+        const uword n_threads = (std::min)( uword(mp_thread_limit::get()), n_cols );
+        
+        #pragma omp parallel for schedule(static) num_threads(int(n_threads))
+        for(uword t=0; t < n_threads; ++t)
+          {
+          const uword col_start = (t    * n_cols) / n_threads;
+          const uword col_end   = ((t+1) * n_cols) / n_threads;
+          
+          op_ifft_real::apply_cols(out, P, *worker, N_orig, col_start, col_end);
+          }
+        
+        return;
+        }
+      }
+    #endif
+    
+    op_ifft_real::apply_cols(out, P, *worker, N_orig, 0, n_cols);
+    }
+  }
+
+
+
+//! transform columns [col_start, col_end) of the input
+template<typename T1, typename worker_type>
+inline
+void
+op_ifft_real::apply_cols(Mat<typename T1::pod_type>& out, const Proxy<T1>& P, const worker_type& worker, const uword N_orig, const uword col_start, const uword col_end)
+  {
+  arma_extra_debug_sigprint();
+  
+  typedef typename T1::elem_type in_eT;
+  typedef typename T1::pod_type  out_eT;
+  
+  const uword N_user = out.n_rows;
+  
+  podarray<in_eT> data(N_user);
+  podarray<in_eT> buf (N_user);
+  
+  in_eT* data_mem = data.memptr();
+  
+  // only the first N_user/2 + 1 elements are used by the transform
+  
+  const uword N_used = (std::min)(N_user, (N_user/2) + 1);
+  
+  const uword N = (std::min)(N_used, N_orig);
+  
+  for(uword col=col_start; col < col_end; ++col)
+    {
+    // data_mem is overwritten by the transform, so the zero padding is redone for each column
+    
+    for(uword i=0; i < N; ++i)  { data_mem[i] = P.at(i, col); }
+    
+    if(N_used > N)  { arrayops::fill_zeros( &data_mem[N], (N_used - N) ); }
+    
+    out_eT* out_colmem = out.colptr(col);
+    
+    worker.run_c2r( out_colmem, data_mem, buf.memptr() );
+    
+    arrayops::inplace_mul( out_colmem, out_eT(1) / out_eT(N_user), N_user );
+    }
+  }
+
+
+
+//
+// op_fft_dim
+
+
+template<typename eT, bool inverse>
+inline
+void
+op_fft_dim::apply(eT* mem, const uword n_inner, const uword n_len, const uword n_outer)
+  {
+  arma_extra_debug_sigprint();
+  
+  if( (n_len <= 1) || (n_inner == 0) || (n_outer == 0) )  { return; }
+  
+  const std::shared_ptr< const fft_engine<eT,inverse> > worker = fft_engine_cache<eT,inverse>::get(n_len);
+  
+  // each task transforms one tile: up to tile_size consecutive positions along the inner dimension
+  
+  const uword n_tiles = (n_inner + tile_size - 1) / tile_size;
+  const uword n_tasks = n_tiles * n_outer;
+  
+  #if defined(ARMA_USE_OPENMP)
+    {
+    if( (n_tasks > 1) && mp_gate<eT>::eval(n_inner * n_len * n_outer) )
+      {
+      const uword n_threads = (std::min)( uword(mp_thread_limit::get()), n_tasks );
+      
+      #pragma omp parallel for schedule(static) num_threads(int(n_threads))
+      for(uword t=0; t < n_threads; ++t)
+        {
+        const uword task_start = (t    * n_tasks) / n_threads;
+        const uword task_end   = ((t+1) * n_tasks) / n_threads;
+        
+        op_fft_dim::apply_range(mem, n_inner, n_len, *worker, task_start, task_end);
+        }
+      
+      return;
+      }
+    }
+  #endif
+  
+  op_fft_dim::apply_range(mem, n_inner, n_len, *worker, 0, n_tasks);
+  }
+
+
+
+template<typename eT, typename worker_type>
+inline
+void
+op_fft_dim::apply_range(eT* mem, const uword n_inner, const uword n_len, const worker_type& worker, const uword task_start, const uword task_end)
+  {
+  arma_extra_debug_sigprint();
+  
+  const uword n_tiles = (n_inner + tile_size - 1) / tile_size;
+  
+  const uword tile_n_rows = (std::min)(n_inner, uword(tile_size));
+  
+  podarray<eT> tile_in ( (n_inner > 1) ? (tile_n_rows * n_len) : uword(0) );
+  podarray<eT> tile_out(                 tile_n_rows * n_len              );
+  
+  eT* tile_in_mem  = tile_in.memptr();
+  eT* tile_out_mem = tile_out.memptr();
+  
+  for(uword task=task_start; task < task_end; ++task)
+    {
+    const uword outer = task / n_tiles;
+    const uword inner = (task % n_tiles) * tile_size;
+    
+    const uword n_active = (std::min)(uword(tile_size), (n_inner - inner));
+    
+    eT* base = &mem[ (outer * n_len * n_inner) + inner ];
+    
+    if(n_inner == 1)
+      {
+      // contiguous transform
+      
+      worker.run(tile_out_mem, base);
+      
+      arrayops::copy(base, tile_out_mem, n_len);
+      
+      continue;
+      }
+    
+    // gather the tile, so that each transform has contiguous input
+    
+    for(uword l=0; l < n_len; ++l)
+      {
+      const eT* src = &base[l * n_inner];
+      
+      for(uword j=0; j < n_active; ++j)  { tile_in_mem[j*n_len + l] = src[j]; }
+      }
+    
+    for(uword j=0; j < n_active; ++j)  { worker.run( &tile_out_mem[j*n_len], &tile_in_mem[j*n_len] ); }
+    
+    for(uword l=0; l < n_len; ++l)
+      {
+      eT* dest = &base[l * n_inner];
+      
+      for(uword j=0; j < n_active; ++j)  { dest[j] = tile_out_mem[j*n_len + l]; }
+      }
+    }
+  }
+
+
+
+template<typename T1>
+inline
+void
+op_fft_dim::apply_fft2(Mat< std::complex<typename T1::pod_type> >& out, const T1& A)
+  {
+  arma_extra_debug_sigprint();
+  
+  typedef typename T1::elem_type         in_eT;
+  typedef typename T1::pod_type              T;
+  typedef typename std::complex<T>      out_eT;
+  
+  const quasi_unwrap<T1> U(A);
+  const Mat<in_eT>&      X = U.M;
+  
+  const uword n_rows = X.n_rows;
+  const uword n_cols = X.n_cols;
+  
+  // transform of each column, which is contiguous;
+  // for real input this uses the half length transform
+  
+  if(n_rows > 1)
+    {
+    out = fft(X);
+    }
+  else
+    {
+    out.set_size(n_rows, n_cols);
+    
+    const in_eT* X_mem   = X.memptr();
+        out_eT*  out_mem = out.memptr();
+    
+    for(uword i=0; i < X.n_elem; ++i)  { out_mem[i] = out_eT(X_mem[i]); }
+    }
+  
+  // transform of each row
+  
+  op_fft_dim::apply<out_eT,false>(out.memptr(), n_rows, n_cols, 1);
+  }
+
+
+
+template<typename T1>
+inline
+void
+op_fft_dim::apply_ifft2(Mat<typename T1::elem_type>& out, const T1& A)
+  {
+  arma_extra_debug_sigprint();
+  
+  typedef typename T1::elem_type eT;
+  typedef typename T1::pod_type   T;
+  
+  const quasi_unwrap<T1> U(A);
+  const Mat<eT>&         X = U.M;
+  
+  const uword n_rows = X.n_rows;
+  const uword n_cols = X.n_cols;
+  
+  if(n_rows > 1)  { out = ifft(X); } else { out = X; }
+  
+  op_fft_dim::apply<eT,true>(out.memptr(), n_rows, n_cols, 1);
+  
+  // the columns are already scaled by ifft()
+  
+  if(n_cols > 1)  { arrayops::inplace_mul( out.memptr(), eT(T(1) / T(n_cols)), out.n_elem ); }
+  }
+
+
+
+template<typename T1>
+inline
+void
+op_fft_dim::apply_fft3(Cube< std::complex<typename T1::pod_type> >& out, const T1& A)
+  {
+  arma_extra_debug_sigprint();
+  
+  typedef typename T1::elem_type         in_eT;
+  typedef typename T1::pod_type              T;
+  typedef typename std::complex<T>      out_eT;
+  
+  const unwrap_cube<T1> U(A);
+  const Cube<in_eT>&    X = U.M;
+  
+  const uword n_rows   = X.n_rows;
+  const uword n_cols   = X.n_cols;
+  const uword n_slices = X.n_slices;
+  
+  out.set_size(n_rows, n_cols, n_slices);
+  
+  if(out.n_elem == 0)  { return; }
+  
+  // the first dimension is transformed by treating the cube as a matrix with n_cols*n_slices columns
+  
+  if(n_rows > 1)
+    {
+    const Mat<in_eT> X_mat( const_cast<in_eT*>(X.memptr()), n_rows, (n_cols * n_slices), false, true );
+    
+    Mat<out_eT> out_mat( out.memptr(), n_rows, (n_cols * n_slices), false, true );
+    
+    out_mat = fft(X_mat);
+    }
+  else
+    {
+    const in_eT* X_mem   = X.memptr();
+        out_eT*  out_mem = out.memptr();
+    
+    for(uword i=0; i < X.n_elem; ++i)  { out_mem[i] = out_eT(X_mem[i]); }
+    }
+  
+  out_eT* out_mem = out.memptr();
+  
+  op_fft_dim::apply<out_eT,false>(out_mem, n_rows,            n_cols,   n_slices);
+  op_fft_dim::apply<out_eT,false>(out_mem, (n_rows * n_cols), n_slices, 1       );
+  }
+
+
+
+template<typename T1>
+inline
+void
+op_fft_dim::apply_ifft3(Cube<typename T1::elem_type>& out, const T1& A)
+  {
+  arma_extra_debug_sigprint();
+  
+  typedef typename T1::elem_type eT;
+  typedef typename T1::pod_type   T;
+  
+  const unwrap_cube<T1> U(A);
+  const Cube<eT>&       X = U.M;
+  
+  const uword n_rows   = X.n_rows;
+  const uword n_cols   = X.n_cols;
+  const uword n_slices = X.n_slices;
+  
+  out.set_size(n_rows, n_cols, n_slices);
+  
+  if(out.n_elem == 0)  { return; }
+  
+  eT* out_mem = out.memptr();
+  
+  arrayops::copy(out_mem, X.memptr(), X.n_elem);
+  
+  op_fft_dim::apply<eT,true>(out_mem, 1,                 n_rows,   (n_cols * n_slices));
+  op_fft_dim::apply<eT,true>(out_mem, n_rows,            n_cols,   n_slices           );
+  op_fft_dim::apply<eT,true>(out_mem, (n_rows * n_cols), n_slices, 1                  );
+  
+  arrayops::inplace_mul( out_mem, eT(T(1) / T(out.n_elem)), out.n_elem );
+  }
+
+
+
 //! @}
@@ -33,6 +33,40 @@ op_find_unique::apply_helper(Mat<uword>& out, const Proxy<T1>& P, const bool asc
   if(n_elem == 0)  { out.set_size(0,1);             return true; }
   if(n_elem == 1)  { out.set_size(1,1); out[0] = 0; return true; }
   
+  // for integer elements, the first occurrence of each distinct value is found via hashing (indices are always ascending),
+  // unless there are too many distinct values; integer elements can't be NaN
+  
+  if( hash_aux_eligible<eT>::value && (n_elem >= hash_aux::threshold) )
+    {
+    podarray<eT> vals(n_elem);
+    
+    eT* vals_mem = vals.memptr();
+    
+    if(Proxy<T1>::use_at == false)
+      {
+      typename Proxy<T1>::ea_type Pea = P.get_ea();
+      
+      for(uword i=0; i<n_elem; ++i)  { vals_mem[i] = Pea[i]; }
+      }
+    else
+      {
+      const uword n_rows = P.get_n_rows();
+      const uword n_cols = P.get_n_cols();
+      
+      uword i = 0;
+      
+      for(uword col=0; col < n_cols; ++col)
+      for(uword row=0; row < n_rows; ++row)
+        {
+        vals_mem[i] = P.at(row,col);
+        
+        ++i;
+        }
+      }
+    
+    if(hash_aux::first_occurrences(out, vals.memptr(), n_elem))  { return true; }
+    }
+  
   uvec indices(n_elem);
   
   std::vector< arma_find_unique_packet<eT> > packet_vec(n_elem);
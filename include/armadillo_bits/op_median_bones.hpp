@@ -49,6 +49,20 @@ class op_median
   template<typename T, typename T1>
   inline static void apply(Mat< std::complex<T> >& out, const Op<T1,op_median>& in);
   
+  template<typename eT>
+  inline static void apply_noalias(Mat<eT>& out, const Mat<eT>& X, const uword dim);
+  
+  template<typename eT>
+  inline static void apply_cols(eT* out_mem, const Mat<eT>& X, const uword col_start, const uword col_end, eT* scratch);
+  
+  template<typename eT>
+  inline static void apply_rows(eT* out_mem, const Mat<eT>& X, const uword row_start, const uword row_end, eT* scratch);
+  
+  template<typename T1>
+  inline static void apply(Cube<typename T1::elem_type>& out, const OpCube<T1,op_median>& in);
+  
+  static constexpr uword row_block_size = 16;  //!< number of rows copied together when finding the median of each row
+  
   //
   //
   
@@ -64,6 +78,9 @@ class op_median
   template<typename eT>
   inline static eT direct_median(std::vector<eT>& X);
   
+  template<typename eT>
+  inline static eT direct_median(eT* X, const uword n_elem);
+  
   template<typename T>
   inline static void direct_cx_median_index(uword& out_index1, uword& out_index2, std::vector< arma_cx_median_packet<T> >& X);
   };
@@ -47,22 +47,26 @@ op_median::apply(Mat<typename T1::elem_type>& out, const Op<T1,op_median>& in)
     
     const typename unwrap_check<P_stored_type>::stored_type& X = tmp.M;
     
-    const uword X_n_rows = X.n_rows;
-    const uword X_n_cols = X.n_cols;
+    op_median::apply_noalias(out, X, dim);
+    }
+  else
+    {
+    const uword P_n_rows = P.get_n_rows();
+    const uword P_n_cols = P.get_n_cols();
     
     if(dim == 0)  // in each column
       {
       arma_extra_debug_print("op_median::apply(): dim = 0");
       
-      out.set_size((X_n_rows > 0) ? 1 : 0, X_n_cols);
+      out.set_size((P_n_rows > 0) ? 1 : 0, P_n_cols);
       
-      if(X_n_rows > 0)
+      if(P_n_rows > 0)
         {
-        std::vector<eT> tmp_vec(X_n_rows);
+        std::vector<eT> tmp_vec(P_n_rows);
         
-        for(uword col=0; col < X_n_cols; ++col)
+        for(uword col=0; col < P_n_cols; ++col)
           {
-          arrayops::copy( &(tmp_vec[0]), X.colptr(col), X_n_rows );
+          for(uword row=0; row < P_n_rows; ++row)  { tmp_vec[row] = P.at(row,col); }
           
           out[col] = op_median::direct_median(tmp_vec);
           }
@@ -72,62 +76,229 @@ op_median::apply(Mat<typename T1::elem_type>& out, const Op<T1,op_median>& in)
       {
       arma_extra_debug_print("op_median::apply(): dim = 1");
       
-      out.set_size(X_n_rows, (X_n_cols > 0) ? 1 : 0);
+      out.set_size(P_n_rows, (P_n_cols > 0) ? 1 : 0);
       
-      if(X_n_cols > 0)
+      if(P_n_cols > 0)
         {
-        std::vector<eT> tmp_vec(X_n_cols);
+        std::vector<eT> tmp_vec(P_n_cols);
           
-        for(uword row=0; row < X_n_rows; ++row)
+        for(uword row=0; row < P_n_rows; ++row)
           {
-          for(uword col=0; col < X_n_cols; ++col)  { tmp_vec[col] = X.at(row,col); }
+          for(uword col=0; col < P_n_cols; ++col)  { tmp_vec[col] = P.at(row,col); }
           
           out[row] = op_median::direct_median(tmp_vec);
           }
         }
       }
     }
-  else
+  }
+
+
+
+//! find the median of each column (dim=0) or each row (dim=1);
+//! the columns or rows are split between threads, with each thread using its own scratch space
+template<typename eT>
+inline
+void
+op_median::apply_noalias(Mat<eT>& out, const Mat<eT>& X, const uword dim)
+  {
+  arma_extra_debug_sigprint();
+  
+  const uword X_n_rows = X.n_rows;
+  const uword X_n_cols = X.n_cols;
+  
+  if(dim == 0)  // in each column
     {
-    const uword P_n_rows = P.get_n_rows();
-    const uword P_n_cols = P.get_n_cols();
+    arma_extra_debug_print("op_median::apply(): dim = 0");
     
-    if(dim == 0)  // in each column
+    out.set_size((X_n_rows > 0) ? 1 : 0, X_n_cols);
+    
+    if(out.is_empty())  { return; }
+    
+    #if defined(ARMA_USE_OPENMP)
       {
-      arma_extra_debug_print("op_median::apply(): dim = 0");
-      
-      out.set_size((P_n_rows > 0) ? 1 : 0, P_n_cols);
-      
-      if(P_n_rows > 0)
+      if( (X_n_cols > 1) && mp_gate<eT>::eval(X.n_elem) )
         {
-        std::vector<eT> tmp_vec(P_n_rows);
+        const uword n_threads = (std::min)( uword(mp_thread_limit::get()), X_n_cols );
         
-        for(uword col=0; col < P_n_cols; ++col)
+        Mat<eT> scratch(X_n_rows, n_threads);
+        
+        eT* out_mem = out.memptr();
+        
+        #pragma omp parallel for schedule(static) num_threads(int(n_threads))
+        for(uword t=0; t < n_threads; ++t)
           {
-          for(uword row=0; row < P_n_rows; ++row)  { tmp_vec[row] = P.at(row,col); }
+          const uword col_start = (t    * X_n_cols) / n_threads;
+          const uword col_end   = ((t+1) * X_n_cols) / n_threads;
           
-          out[col] = op_median::direct_median(tmp_vec);
+          op_median::apply_cols(out_mem, X, col_start, col_end, scratch.colptr(t));
           }
+        
+        return;
         }
       }
-    else  // in each row
+    #endif
+    
+    podarray<eT> scratch(X_n_rows);
+    
+    op_median::apply_cols(out.memptr(), X, 0, X_n_cols, scratch.memptr());
+    }
+  else  // in each row
+    {
+    arma_extra_debug_print("op_median::apply(): dim = 1");
+    
+    out.set_size(X_n_rows, (X_n_cols > 0) ? 1 : 0);
+    
+    if(out.is_empty())  { return; }
+    
+    const uword scratch_n_elem = (std::min)(X_n_rows, uword(op_median::row_block_size)) * X_n_cols;
+    
+    #if defined(ARMA_USE_OPENMP)
       {
-      arma_extra_debug_print("op_median::apply(): dim = 1");
-      
-      out.set_size(P_n_rows, (P_n_cols > 0) ? 1 : 0);
-      
-      if(P_n_cols > 0)
+      if( (X_n_rows > 1) && mp_gate<eT>::eval(X.n_elem) )
         {
-        std::vector<eT> tmp_vec(P_n_cols);
-          
-        for(uword row=0; row < P_n_rows; ++row)
+        const uword n_threads = (std::min)( uword(mp_thread_limit::get()), X_n_rows );
+        
+        Mat<eT> scratch(scratch_n_elem, n_threads);
+        
+        eT* out_mem = out.memptr();
+        
+        #pragma omp parallel for schedule(static) num_threads(int(n_threads))
+        for(uword t=0; t < n_threads; ++t)
           {
-          for(uword col=0; col < P_n_cols; ++col)  { tmp_vec[col] = P.at(row,col); }
+          const uword row_start = (t    * X_n_rows) / n_threads;
+          const uword row_end   = ((t+1) * X_n_rows) / n_threads;
           
-          out[row] = op_median::direct_median(tmp_vec);
+          op_median::apply_rows(out_mem, X, row_start, row_end, scratch.colptr(t));
           }
+        
+        return;
         }
       }
+    #endif
+    
+    podarray<eT> scratch(scratch_n_elem);
+    
+    op_median::apply_rows(out.memptr(), X, 0, X_n_rows, scratch.memptr());
+    }
+  }
+
+
+
+template<typename eT>
+inline
+void
+op_median::apply_cols(eT* out_mem, const Mat<eT>& X, const uword col_start, const uword col_end, eT* scratch)
+  {
+  arma_extra_debug_sigprint();
+  
+  const uword X_n_rows = X.n_rows;
+  
+  for(uword col=col_start; col < col_end; ++col)
+    {
+    arrayops::copy( scratch, X.colptr(col), X_n_rows );
+    
+    out_mem[col] = op_median::direct_median(scratch, X_n_rows);
+    }
+  }
+
+
+
+//! the rows are copied in blocks, so that the elements of each column are read contiguously;
+//! scratch must have space for row_block_size rows
+template<typename eT>
+inline
+void
+op_median::apply_rows(eT* out_mem, const Mat<eT>& X, const uword row_start, const uword row_end, eT* scratch)
+  {
+  arma_extra_debug_sigprint();
+  
+  const uword X_n_cols = X.n_cols;
+  
+  for(uword blk_start=row_start; blk_start < row_end; blk_start += op_median::row_block_size)
+    {
+    const uword blk_n_rows = (std::min)(uword(op_median::row_block_size), row_end - blk_start);
+    
+    for(uword col=0; col < X_n_cols; ++col)
+      {
+      const eT* X_colptr = X.colptr(col) + blk_start;
+      
+      for(uword i=0; i < blk_n_rows; ++i)  { scratch[i*X_n_cols + col] = X_colptr[i]; }
+      }
+    
+    for(uword i=0; i < blk_n_rows; ++i)
+      {
+      out_mem[blk_start + i] = op_median::direct_median( &(scratch[i*X_n_cols]), X_n_cols );
+      }
+    }
+  }
+
+
+
+//! For each column (dim=0), each row (dim=1) or each tube (dim=2), find the median value.
+//! The slices of the cube are interpreted as matrices, so that the matrix implementation can be reused;
+//! for dim=2, each tube is a row of a matrix with one column per slice.
+template<typename T1>
+inline
+void
+op_median::apply(Cube<typename T1::elem_type>& out, const OpCube<T1,op_median>& in)
+  {
+  arma_extra_debug_sigprint();
+  
+  typedef typename T1::elem_type eT;
+  
+  arma_type_check(( is_cx<eT>::yes ));
+  
+  const uword dim = in.aux_uword_a;
+  arma_debug_check( (dim > 2), "median(): parameter 'dim' must be 0 or 1 or 2" );
+  
+  const unwrap_cube_check<T1> U(in.m, out);
+  const Cube<eT>& X = U.M;
+  
+  const uword X_n_rows   = X.n_rows;
+  const uword X_n_cols   = X.n_cols;
+  const uword X_n_slices = X.n_slices;
+  
+  if(dim == 0)
+    {
+    out.set_size((X_n_rows > 0) ? 1 : 0, X_n_cols, X_n_slices);
+    
+    if(out.is_empty())  { return; }
+    
+    const Mat<eT> X_mat( const_cast<eT*>(X.memptr()), X_n_rows, X_n_cols*X_n_slices, false, true );
+    
+    Mat<eT> out_mat( out.memptr(), 1, X_n_cols*X_n_slices, false, true );
+    
+    op_median::apply_noalias(out_mat, X_mat, 0);
+    }
+  else
+  if(dim == 1)
+    {
+    out.set_size(X_n_rows, (X_n_cols > 0) ? 1 : 0, X_n_slices);
+    
+    if(out.is_empty())  { return; }
+    
+    for(uword slice=0; slice < X_n_slices; ++slice)
+      {
+      const Mat<eT> X_mat( const_cast<eT*>(X.slice_memptr(slice)), X_n_rows, X_n_cols, false, true );
+      
+      Mat<eT> out_mat( out.slice_memptr(slice), X_n_rows, 1, false, true );
+      
+      op_median::apply_noalias(out_mat, X_mat, 1);
+      }
+    }
+  else
+  if(dim == 2)
+    {
+    out.set_size(X_n_rows, X_n_cols, (X_n_slices > 0) ? 1 : 0);
+    
+    if(out.is_empty())  { return; }
+    
+    const Mat<eT> X_mat( const_cast<eT*>(X.memptr()), X_n_rows*X_n_cols, X_n_slices, false, true );
+    
+    Mat<eT> out_mat( out.memptr(), X_n_rows*X_n_cols, 1, false, true );
+    
+    op_median::apply_noalias(out_mat, X_mat, 1);
     }
   }
 
@@ -385,22 +556,31 @@ op_median::direct_median(std::vector<eT>& X)
   {
   arma_extra_debug_sigprint();
   
-  const uword n_elem = uword(X.size());
-  const uword half   = n_elem/2;
+  return op_median::direct_median( &(X[0]), uword(X.size()) );
+  }
+
+
+
+//! find the median value of an array (contents is modified)
+template<typename eT>
+inline 
+eT
+op_median::direct_median(eT* X, const uword n_elem)
+  {
+  arma_extra_debug_sigprint();
   
-  typename std::vector<eT>::iterator first    = X.begin();
-  typename std::vector<eT>::iterator nth      = first + half;
-  typename std::vector<eT>::iterator pastlast = X.end();
+  const uword half = n_elem/2;
+  
+  eT* first    = X;
+  eT* nth      = first + half;
+  eT* pastlast = X + n_elem;
   
   std::nth_element(first, nth, pastlast);
   
   if((n_elem % 2) == 0)  // even number of elements
     {
-    typename std::vector<eT>::iterator start   = X.begin();
-    typename std::vector<eT>::iterator pastend = start + half;
-    
     const eT val1 = (*nth);
-    const eT val2 = (*(std::max_element(start, pastend)));
+    const eT val2 = (*(std::max_element(first, nth)));
     
     return op_mean::robust_mean(val1, val2);
     }
@@ -32,7 +32,9 @@ arma_sort_index_helper(Mat<uword>& out, const Proxy<T1>& P, const uword sort_typ
   
   out.set_size(n_elem, 1);
   
-  std::vector< arma_sort_index_packet<eT> > packet_vec(n_elem);
+  podarray<eT> vals(n_elem);
+  
+  eT* vals_mem = vals.memptr();
   
   if(Proxy<T1>::use_at == false)
     {
@@ -42,8 +44,7 @@ arma_sort_index_helper(Mat<uword>& out, const Proxy<T1>& P, const uword sort_typ
       
       if(arma_isnan(val))  { out.soft_reset(); return false; }
       
-      packet_vec[i].val   = val;
-      packet_vec[i].index = i;
+      vals_mem[i] = val;
       }
     }
   else
@@ -60,13 +61,27 @@ arma_sort_index_helper(Mat<uword>& out, const Proxy<T1>& P, const uword sort_typ
       
       if(arma_isnan(val))  { out.soft_reset(); return false; }
       
-      packet_vec[i].val   = val;
-      packet_vec[i].index = i;
+      vals_mem[i] = val;
       
       ++i;
       }
     }
   
+  // radix sorting is stable, so it is suitable for both sort_index() and stable_sort_index()
+  
+  if( (n_elem >= sort_aux::radix_index_threshold) && sort_aux::radix_sort_index(out.memptr(), vals_mem, n_elem, sort_type) )
+    {
+    return true;
+    }
+  
+  std::vector< arma_sort_index_packet<eT> > packet_vec(n_elem);
+  
+  for(uword i=0; i<n_elem; ++i)
+    {
+    packet_vec[i].val   = vals_mem[i];
+    packet_vec[i].index = i;
+    }
+  
   
   if(sort_type == 0)
     {
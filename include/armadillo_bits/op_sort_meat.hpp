@@ -19,6 +19,8 @@
 
 
 
+//! large arrays of integers or floating point numbers are radix sorted, and very large arrays are sorted by multiple threads;
+//! see sort_aux
 template<typename eT>
 inline 
 void
@@ -26,18 +28,7 @@ op_sort::direct_sort(eT* X, const uword n_elem, const uword sort_type)
   {
   arma_extra_debug_sigprint();
   
-  if(sort_type == 0)
-    {
-    arma_lt_comparator<eT> comparator;
-    
-    std::sort(&X[0], &X[n_elem], comparator);
-    }
-  else
-    {
-    arma_gt_comparator<eT> comparator;
-    
-    std::sort(&X[0], &X[n_elem], comparator);
-    }
+  sort_aux::direct_sort(X, n_elem, sort_type);
   }
 
 
@@ -49,9 +40,7 @@ op_sort::direct_sort_ascending(eT* X, const uword n_elem)
   {
   arma_extra_debug_sigprint();
   
-  arma_lt_comparator<eT> comparator;
-    
-  std::sort(&X[0], &X[n_elem], comparator);
+  sort_aux::direct_sort(X, n_elem, uword(0));
   }
 
 
@@ -119,7 +108,24 @@ op_sort::apply_noalias(Mat<eT>& out, const Mat<eT>& X, const uword sort_type, co
     
     const uword n_rows = out.n_rows;
     const uword n_cols = out.n_cols;
-      
+    
+    #if defined(ARMA_USE_OPENMP)
+      {
+      if( (n_cols > 1) && mp_gate<eT>::eval(out.n_elem) )
+        {
+        const int n_threads = mp_thread_limit::get();
+        
+        #pragma omp parallel for schedule(dynamic) num_threads(n_threads)
+        for(uword col=0; col < n_cols; ++col)
+          {
+          op_sort::direct_sort( out.colptr(col), n_rows, sort_type );
+          }
+        
+        return;
+        }
+      }
+    #endif
+    
     for(uword col=0; col < n_cols; ++col)
       {
       op_sort::direct_sort( out.colptr(col), n_rows, sort_type );
@@ -144,6 +150,37 @@ op_sort::apply_noalias(Mat<eT>& out, const Mat<eT>& X, const uword sort_type, co
       const uword n_rows = out.n_rows;
       const uword n_cols = out.n_cols;
       
+      #if defined(ARMA_USE_OPENMP)
+        {
+        if( mp_gate<eT>::eval(out.n_elem) )
+          {
+          const uword n_threads = (std::min)( uword(mp_thread_limit::get()), n_rows );
+          
+          Mat<eT> tmp(n_cols, n_threads);
+          
+          #pragma omp parallel for schedule(static) num_threads(int(n_threads))
+          for(uword t=0; t < n_threads; ++t)
+            {
+            const uword row_start = (t    * n_rows) / n_threads;
+            const uword row_end   = ((t+1) * n_rows) / n_threads;
+            
+            eT* tmp_mem = tmp.colptr(t);
+            
+            for(uword row=row_start; row < row_end; ++row)
+              {
+              op_sort::copy_row(tmp_mem, X, row);
+              
+              op_sort::direct_sort( tmp_mem, n_cols, sort_type );
+              
+              op_sort::copy_row(out, tmp_mem, row);
+              }
+            }
+          
+          return;
+          }
+        }
+      #endif
+      
       podarray<eT> tmp_array(n_cols);
       
       for(uword row=0; row < n_rows; ++row)
@@ -216,23 +253,7 @@ op_sort_vec::apply(Mat<typename T1::elem_type>& out, const Op<T1,op_sort_vec>& i
   
   if(out.n_elem <= 1)  { return; }
   
-  eT* out_mem = out.memptr();
-  
-  eT* start_ptr =  out_mem;
-  eT* endp1_ptr = &out_mem[out.n_elem];
-  
-  if(sort_type == 0)
-    {
-    arma_lt_comparator<eT> comparator;
-    
-    std::sort(start_ptr, endp1_ptr, comparator);
-    }
-  else
-    {
-    arma_gt_comparator<eT> comparator;
-    
-    std::sort(start_ptr, endp1_ptr, comparator);
-    }
+  op_sort::direct_sort(out.memptr(), out.n_elem, sort_type);
   }
 
 
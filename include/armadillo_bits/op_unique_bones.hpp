@@ -26,7 +26,10 @@ class op_unique
   public:
   
   template<typename T1>
-  inline static bool apply_helper(Mat<typename T1::elem_type>& out, const Proxy<T1>& P, const bool P_is_row);
+  inline static bool apply_helper(Mat<typename T1::elem_type>& out, const Proxy<T1>& P, const bool P_is_row, const bool stable = false);
+  
+  template<typename eT>
+  inline static void first_occurrences(uvec& out, const eT* X, const uword n_elem);
   
   template<typename T1>
   inline static void apply(Mat<typename T1::elem_type>& out, const Op<T1,op_unique>& in);
@@ -23,7 +23,7 @@
 template<typename T1>
 inline
 bool
-op_unique::apply_helper(Mat<typename T1::elem_type>& out, const Proxy<T1>& P, const bool P_is_row)
+op_unique::apply_helper(Mat<typename T1::elem_type>& out, const Proxy<T1>& P, const bool P_is_row, const bool stable)
   {
   arma_extra_debug_sigprint();
   
@@ -91,9 +91,53 @@ op_unique::apply_helper(Mat<typename T1::elem_type>& out, const Proxy<T1>& P, co
     X_mem = X.memptr();
     }
   
-  arma_unique_comparator<eT> comparator;
+  // for integer elements, the first occurrence of each distinct value is found via hashing,
+  // unless there are too many distinct values
   
-  std::sort( X.begin(), X.end(), comparator );
+  uvec first_indices;
+  
+  const bool hashed = (n_elem >= hash_aux::threshold) && hash_aux::first_occurrences(first_indices, X_mem, n_elem);
+  
+  if(hashed || stable)
+    {
+    if(hashed == false)  { op_unique::first_occurrences(first_indices, X_mem, n_elem); }
+    
+    const uword  N_unique           = first_indices.n_elem;
+    const uword* first_indices_mem = first_indices.memptr();
+    
+    if(P_is_row)
+      {
+      out.set_size(1, N_unique);
+      }
+    else
+      {
+      out.set_size(N_unique, 1);
+      }
+    
+    eT* out_mem = out.memptr();
+    
+    for(uword i=0; i < N_unique; ++i)  { out_mem[i] = X_mem[ first_indices_mem[i] ]; }
+    
+    if(stable == false)
+      {
+      arma_unique_comparator<eT> comparator;
+      
+      std::sort( out.begin(), out.end(), comparator );
+      }
+    
+    return true;
+    }
+  
+  if(is_cx<eT>::no)
+    {
+    op_sort::direct_sort(X_mem, n_elem, uword(0));
+    }
+  else
+    {
+    arma_unique_comparator<eT> comparator;
+    
+    std::sort( X.begin(), X.end(), comparator );
+    }
   
   uword N_unique = 1;
   
@@ -135,6 +179,49 @@ op_unique::apply_helper(Mat<typename T1::elem_type>& out, const Proxy<T1>& P, co
 
 
 
+//! find the index of the first occurrence of each distinct value in X, in ascending order of index,
+//! via a stable sort of the values
+template<typename eT>
+inline
+void
+op_unique::first_occurrences(uvec& out, const eT* X, const uword n_elem)
+  {
+  arma_extra_debug_sigprint();
+  
+  std::vector< arma_find_unique_packet<eT> > packet_vec(n_elem);
+  
+  for(uword i=0; i < n_elem; ++i)
+    {
+    packet_vec[i].val   = X[i];
+    packet_vec[i].index = i;
+    }
+  
+  arma_find_unique_comparator<eT> comparator;
+  
+  std::stable_sort( packet_vec.begin(), packet_vec.end(), comparator );
+  
+  out.set_size(n_elem);
+  
+  uword* out_mem = out.memptr();
+  
+  uword count = 0;
+  
+  for(uword i=0; i < n_elem; ++i)
+    {
+    if( (i == 0) || ((packet_vec[i-1].val - packet_vec[i].val) != eT(0)) )
+      {
+      out_mem[count] = packet_vec[i].index;
+      ++count;
+      }
+    }
+  
+  out.resize(count);
+  
+  op_sort::direct_sort(out.memptr(), count, uword(0));
+  }
+
+
+
 template<typename T1>
 inline
 void
@@ -144,7 +231,7 @@ op_unique::apply(Mat<typename T1::elem_type>& out, const Op<T1, op_unique>& in)
   
   const Proxy<T1> P(in.m);
   
-  const bool all_non_nan = op_unique::apply_helper(out, P, false);
+  const bool all_non_nan = op_unique::apply_helper(out, P, false, (in.aux_uword_a == uword(1)));
   
   arma_debug_check( (all_non_nan == false), "unique(): detected NaN" );
   }
@@ -162,7 +249,7 @@ op_unique_vec::apply(Mat<typename T1::elem_type>& out, const Op<T1, op_unique_ve
   
   const bool P_is_row = (T1::is_xvec) ? bool(P.get_n_rows() == 1) : bool(T1::is_row);
   
-  const bool all_non_nan = op_unique::apply_helper(out, P, P_is_row);
+  const bool all_non_nan = op_unique::apply_helper(out, P, P_is_row, (in.aux_uword_a == uword(1)));
   
   arma_debug_check( (all_non_nan == false), "unique(): detected NaN" );
   }
@@ -0,0 +1,151 @@
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+//! \addtogroup running_quantile
+//! @{
+
+
+
+template<typename eT>
+struct running_quantile_centroid
+  {
+  eT     mean;
+  double weight;
+  };
+
+
+
+template<typename eT>
+struct running_quantile_centroid_less
+  {
+  arma_inline bool operator() (const running_quantile_centroid<eT>& a, const running_quantile_centroid<eT>& b) const
+    {
+    return (a.mean < b.mean);
+    }
+  };
+
+
+
+//! Class for estimating quantiles (eg. median, 95th percentile) of a continuously sampled process / signal,
+//! without storing the individual samples.
+//! The samples are summarised by a t-digest, as per Dunning and Ertl,
+//! "Computing extremely accurate quantiles using t-digests", arXiv:1902.04023, 2019.
+//! Memory use is bounded by the compression parameter, and the estimates are most accurate for extreme quantiles.
+//! Instances can be merged, allowing separate parts of the data to be processed in parallel.
+template<typename eT>
+class running_quantile
+  {
+  public:
+  
+  inline ~running_quantile();
+  inline explicit running_quantile(const uword in_compression = 100);
+  
+  inline void operator() (const eT sample);
+  
+  template<typename T1> inline void batch_update(const Base<eT,T1>& X);
+  
+  inline void                    merge     (const running_quantile& in_rq);
+  inline const running_quantile& operator+=(const running_quantile& in_rq);
+  
+  inline void reset();
+  
+  inline eT quantile(const eT P);
+  
+  template<typename T1> inline Col<eT> quantile(const Base<eT,T1>& P);
+  
+  inline eT median();
+  
+  inline eT min() const;
+  inline eT max() const;
+  
+  inline eT count() const;
+  
+  inline uword n_centroids();
+  
+  
+  private:
+  
+  uword compression;
+  
+  std::vector< running_quantile_centroid<eT> > centroids;  //!< sorted in ascending order of mean
+  std::vector< eT >                            buffer;     //!< samples not yet included in the centroids
+  
+  double total_weight;
+  
+  eT min_val;
+  eT max_val;
+  
+  inline void flush();
+  inline void compress(const std::vector< running_quantile_centroid<eT> >& items);
+  
+  inline eT internal_quantile(const eT P) const;
+  
+  inline static double k_scale    (const double q, const double delta);
+  inline static double k_scale_inv(const double k, const double delta);
+  };
+
+
+
+//! Class for estimating quantiles of each dimension of a continuously sampled multi-dimensional process / signal;
+//! each dimension is summarised by a separate running_quantile
+template<typename obj_type>
+class running_quantile_vec
+  {
+  public:
+  
+  typedef typename rsv_get_elem_type<obj_type>::elem_type eT;
+  
+  typedef typename rsv_get_return_type1<obj_type>::return_type1 return_type1;
+  
+  inline ~running_quantile_vec();
+  inline explicit running_quantile_vec(const uword in_compression = 100);
+  
+  template<typename T1> inline void operator() (const Base<eT,T1>& X);
+  
+  template<typename T1> inline void batch_update(const Base<eT,T1>& X);
+  
+  inline void                        merge     (const running_quantile_vec& in_rqv);
+  inline const running_quantile_vec& operator+=(const running_quantile_vec& in_rqv);
+  
+  inline void reset();
+  
+  inline return_type1 quantile(const eT P);
+  
+  template<typename T1> inline Mat<eT> quantile(const Base<eT,T1>& P);
+  
+  inline return_type1 median();
+  
+  inline return_type1 min() const;
+  inline return_type1 max() const;
+  
+  inline eT count() const;
+  
+  
+  private:
+  
+  uword compression;
+  
+  uword s_n_rows;   //!< dimensions of the samples
+  uword s_n_cols;
+  
+  std::vector< running_quantile<eT> > digests;
+  
+  inline void init(const uword in_n_rows, const uword in_n_cols);
+  };
+
+
+
+//! @}
@@ -0,0 +1,911 @@
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+//! \addtogroup running_quantile
+//! @{
+
+
+
+template<typename eT>
+inline
+running_quantile<eT>::~running_quantile()
+  {
+  arma_extra_debug_sigprint_this(this);
+  }
+
+
+
+template<typename eT>
+inline
+running_quantile<eT>::running_quantile(const uword in_compression)
+  : compression (in_compression)
+  , total_weight(0.0)
+  , min_val     (eT(0))
+  , max_val     (eT(0))
+  {
+  arma_extra_debug_sigprint_this(this);
+  
+  arma_type_check(( is_cx<eT>::value ));
+  
+  arma_debug_check( (in_compression < 10), "running_quantile(): compression must be at least 10" );
+  
+  buffer.reserve(5*compression);
+  }
+
+
+
+//! update statistics to reflect new sample
+template<typename eT>
+inline
+void
+running_quantile<eT>::operator() (const eT sample)
+  {
+  arma_extra_debug_sigprint();
+  
+  if( arma_isfinite(sample) == false )
+    {
+    arma_debug_warn("running_quantile: sample ignored as it is non-finite" );
+    return;
+    }
+  
+  if(total_weight > 0.0)
+    {
+    min_val = (sample < min_val) ? sample : min_val;
+    max_val = (sample > max_val) ? sample : max_val;
+    }
+  else
+    {
+    min_val = sample;
+    max_val = sample;
+    }
+  
+  buffer.push_back(sample);
+  
+  total_weight += 1.0;
+  
+  if(buffer.size() >= 5*compression)  { flush(); }
+  }
+
+
+
+//! update statistics to reflect a set of samples, stored as the elements of X
+template<typename eT>
+template<typename T1>
+inline
+void
+running_quantile<eT>::batch_update(const Base<eT,T1>& X)
+  {
+  arma_extra_debug_sigprint();
+  
+  const quasi_unwrap<T1> tmp(X.get_ref());
+  const Mat<eT>& samples = tmp.M;
+  
+  if( samples.is_empty() )
+    {
+    return;
+    }
+  
+  if( samples.is_finite() == false )
+    {
+    arma_debug_warn("running_quantile: samples ignored as they have non-finite elements");
+    return;
+    }
+  
+  const eT*   X_mem = samples.memptr();
+  const uword N     = samples.n_elem;
+  
+  if(total_weight == 0.0)
+    {
+    min_val = X_mem[0];
+    max_val = X_mem[0];
+    }
+  
+  const uword buffer_limit = 5*compression;
+  
+  for(uword i=0; i < N; ++i)
+    {
+    const eT val = X_mem[i];
+    
+    min_val = (val < min_val) ? val : min_val;
+    max_val = (val > max_val) ? val : max_val;
+    
+    buffer.push_back(val);
+    
+    if(buffer.size() >= buffer_limit)  { flush(); }
+    }
+  
+  total_weight += double(N);
+  }
+
+
+
+//! update statistics to reflect the samples seen by another instance;
+//! this allows statistics to be obtained for separate parts of the data (eg. in separate threads) and then combined
+template<typename eT>
+inline
+void
+running_quantile<eT>::merge(const running_quantile<eT>& in_rq)
+  {
+  arma_extra_debug_sigprint();
+  
+  if(this == &in_rq)
+    {
+    const running_quantile<eT> tmp(in_rq);
+    
+    (*this).merge(tmp);
+    
+    return;
+    }
+  
+  if(in_rq.total_weight == 0.0)  { return; }
+  
+  if(total_weight > 0.0)
+    {
+    min_val = (in_rq.min_val < min_val) ? in_rq.min_val : min_val;
+    max_val = (in_rq.max_val > max_val) ? in_rq.max_val : max_val;
+    }
+  else
+    {
+    min_val = in_rq.min_val;
+    max_val = in_rq.max_val;
+    }
+  
+  std::vector< running_quantile_centroid<eT> > items;
+  
+  items.reserve(centroids.size() + buffer.size() + in_rq.centroids.size() + in_rq.buffer.size());
+  
+  items.insert(items.end(), centroids.begin(),       centroids.end()      );
+  items.insert(items.end(), in_rq.centroids.begin(), in_rq.centroids.end());
+  
+  running_quantile_centroid<eT> item;
+  
+  item.weight = 1.0;
+  
+  for(size_t i=0; i < buffer.size();       ++i)  { item.mean = buffer[i];       items.push_back(item); }
+  for(size_t i=0; i < in_rq.buffer.size(); ++i)  { item.mean = in_rq.buffer[i]; items.push_back(item); }
+  
+  buffer.clear();
+  
+  total_weight += in_rq.total_weight;
+  
+  running_quantile_centroid_less<eT> comparator;
+  
+  std::sort( items.begin(), items.end(), comparator );
+  
+  compress(items);
+  }
+
+
+
+template<typename eT>
+inline
+const running_quantile<eT>&
+running_quantile<eT>::operator+=(const running_quantile<eT>& in_rq)
+  {
+  arma_extra_debug_sigprint();
+  
+  (*this).merge(in_rq);
+  
+  return *this;
+  }
+
+
+
+//! set all statistics to zero
+template<typename eT>
+inline
+void
+running_quantile<eT>::reset()
+  {
+  arma_extra_debug_sigprint();
+  
+  centroids.clear();
+  buffer.clear();
+  
+  total_weight = 0.0;
+  
+  min_val = eT(0);
+  max_val = eT(0);
+  }
+
+
+
+//! estimate of the quantile at probability P, where P is in the [0,1] interval
+template<typename eT>
+inline
+eT
+running_quantile<eT>::quantile(const eT P)
+  {
+  arma_extra_debug_sigprint();
+  
+  arma_debug_check( ((P < eT(0)) || (P > eT(1)) || (arma_isnan(P))), "running_quantile::quantile(): P must be in the [0,1] interval" );
+  
+  flush();
+  
+  return internal_quantile(P);
+  }
+
+
+
+//! estimates of the quantiles at each of the probabilities in P
+template<typename eT>
+template<typename T1>
+inline
+Col<eT>
+running_quantile<eT>::quantile(const Base<eT,T1>& P)
+  {
+  arma_extra_debug_sigprint();
+  
+  const quasi_unwrap<T1> tmp(P.get_ref());
+  const Mat<eT>& PP = tmp.M;
+  
+  arma_debug_check( ((PP.is_vec() == false) && (PP.is_empty() == false)), "running_quantile::quantile(): parameter 'P' must be a vector" );
+  
+  const eT*   P_mem = PP.memptr();
+  const uword P_n   = PP.n_elem;
+  
+  for(uword i=0; i < P_n; ++i)
+    {
+    const eT P_i = P_mem[i];
+    
+    arma_debug_check( ((P_i < eT(0)) || (P_i > eT(1)) || (arma_isnan(P_i))), "running_quantile::quantile(): all elements in P must be in the [0,1] interval" );
+    }
+  
+  flush();
+  
+  Col<eT> out(P_n);
+  
+  eT* out_mem = out.memptr();
+  
+  for(uword i=0; i < P_n; ++i)  { out_mem[i] = internal_quantile(P_mem[i]); }
+  
+  return out;
+  }
+
+
+
+//! estimate of the median
+template<typename eT>
+inline
+eT
+running_quantile<eT>::median()
+  {
+  arma_extra_debug_sigprint();
+  
+  flush();
+  
+  return internal_quantile(eT(0.5));
+  }
+
+
+
+//! minimum value
+template<typename eT>
+inline
+eT
+running_quantile<eT>::min() const
+  {
+  return min_val;
+  }
+
+
+
+//! maximum value
+template<typename eT>
+inline
+eT
+running_quantile<eT>::max() const
+  {
+  return max_val;
+  }
+
+
+
+//! number of samples so far
+template<typename eT>
+inline
+eT
+running_quantile<eT>::count() const
+  {
+  return eT(total_weight);
+  }
+
+
+
+//! number of centroids used to summarise the samples
+template<typename eT>
+inline
+uword
+running_quantile<eT>::n_centroids()
+  {
+  arma_extra_debug_sigprint();
+  
+  flush();
+  
+  return uword(centroids.size());
+  }
+
+
+
+//! merge the buffered samples into the centroids
+template<typename eT>
+inline
+void
+running_quantile<eT>::flush()
+  {
+  arma_extra_debug_sigprint();
+  
+  if(buffer.empty())  { return; }
+  
+  std::vector< running_quantile_centroid<eT> > items;
+  
+  items.reserve(centroids.size() + buffer.size());
+  
+  // the centroids are already sorted, so only the buffer needs sorting before the two are interleaved
+  
+  std::sort( buffer.begin(), buffer.end() );
+  
+  const size_t n_c = centroids.size();
+  const size_t n_b = buffer.size();
+  
+  size_t i_c = 0;
+  size_t i_b = 0;
+  
+  running_quantile_centroid<eT> item;
+  
+  item.weight = 1.0;
+  
+  while( (i_c < n_c) || (i_b < n_b) )
+    {
+    if( (i_b >= n_b) || ((i_c < n_c) && (centroids[i_c].mean < buffer[i_b])) )
+      {
+      items.push_back(centroids[i_c]);  ++i_c;
+      }
+    else
+      {
+      item.mean = buffer[i_b];  ++i_b;
+      
+      items.push_back(item);
+      }
+    }
+  
+  buffer.clear();
+  
+  compress(items);
+  }
+
+
+
+//! replace the centroids with a compressed version of the given items, which must be sorted in ascending order of mean;
+//! adjacent items are combined as long as the combined centroid spans at most one unit of the scale function
+template<typename eT>
+inline
+void
+running_quantile<eT>::compress(const std::vector< running_quantile_centroid<eT> >& items)
+  {
+  arma_extra_debug_sigprint();
+  
+  centroids.clear();
+  
+  if(items.empty())  { return; }
+  
+  double W = 0.0;
+  
+  for(size_t i=0; i < items.size(); ++i)  { W += items[i].weight; }
+  
+  const double delta = double(compression);
+  
+  running_quantile_centroid<eT> cur = items[0];
+  
+  double cur_mean = double(cur.mean);
+  double w_before = 0.0;
+  double w_limit  = W * k_scale_inv( k_scale(0.0, delta) + 1.0, delta );
+  
+  for(size_t i=1; i < items.size(); ++i)
+    {
+    const running_quantile_centroid<eT>& item = items[i];
+    
+    if( (w_before + cur.weight + item.weight) <= w_limit )
+      {
+      cur.weight += item.weight;
+      cur_mean   += (double(item.mean) - cur_mean) * (item.weight / cur.weight);
+      }
+    else
+      {
+      cur.mean = eT(cur_mean);
+      
+      centroids.push_back(cur);
+      
+      w_before += cur.weight;
+      w_limit   = W * k_scale_inv( k_scale(w_before / W, delta) + 1.0, delta );
+      
+      cur      = item;
+      cur_mean = double(cur.mean);
+      }
+    }
+  
+  cur.mean = eT(cur_mean);
+  
+  centroids.push_back(cur);
+  }
+
+
+
+//! interpolate between the centroids;
+//! each centroid is taken to be located at the centre of its weight,
+//! while singleton centroids represent exact samples
+template<typename eT>
+inline
+eT
+running_quantile<eT>::internal_quantile(const eT P) const
+  {
+  arma_extra_debug_sigprint();
+  
+  const size_t n = centroids.size();
+  
+  if(n == 0)  { return Datum<eT>::nan; }
+  
+  const double W     = total_weight;
+  const double index = double(P) * W;
+  
+  if(index <  1.0    )  { return min_val; }
+  if(index > (W - 1.0))  { return max_val; }
+  
+  const running_quantile_centroid<eT>& c_first = centroids[0];
+  const running_quantile_centroid<eT>& c_last  = centroids[n-1];
+  
+  // between the minimum and the first centroid
+  
+  if( (c_first.weight > 2.0) && (index < (c_first.weight / 2.0)) )
+    {
+    const double frac = (index - 1.0) / (c_first.weight / 2.0 - 1.0);
+    
+    return eT( double(min_val) + frac * (double(c_first.mean) - double(min_val)) );
+    }
+  
+  // between the last centroid and the maximum
+  
+  if( (c_last.weight > 2.0) && ((W - index) <= (c_last.weight / 2.0)) )
+    {
+    const double frac = (W - index - 1.0) / (c_last.weight / 2.0 - 1.0);
+    
+    return eT( double(max_val) - frac * (double(max_val) - double(c_last.mean)) );
+    }
+  
+  double w_so_far = c_first.weight / 2.0;
+  
+  for(size_t i=0; (i+1) < n; ++i)
+    {
+    const running_quantile_centroid<eT>& c_a = centroids[i  ];
+    const running_quantile_centroid<eT>& c_b = centroids[i+1];
+    
+    const double dw = (c_a.weight + c_b.weight) / 2.0;
+    
+    if( (w_so_far + dw) > index )
+      {
+      double left_excl  = 0.0;
+      double right_excl = 0.0;
+      
+      if(c_a.weight == 1.0)
+        {
+        if( (index - w_so_far) < 0.5 )  { return c_a.mean; }
+        
+        left_excl = 0.5;
+        }
+      
+      if(c_b.weight == 1.0)
+        {
+        if( (w_so_far + dw - index) <= 0.5 )  { return c_b.mean; }
+        
+        right_excl = 0.5;
+        }
+      
+      const double z1 = index - w_so_far - left_excl;
+      const double z2 = w_so_far + dw - index - right_excl;
+      
+      if( (z1 + z2) <= 0.0 )  { return c_a.mean; }
+      
+      return eT( (double(c_a.mean) * z2 + double(c_b.mean) * z1) / (z1 + z2) );
+      }
+    
+    w_so_far += dw;
+    }
+  
+  return c_last.mean;
+  }
+
+
+
+//! k1 scale function: maps quantile q to the index k in [-delta/4, delta/4]
+template<typename eT>
+inline
+double
+running_quantile<eT>::k_scale(const double q, const double delta)
+  {
+  return (delta / (2.0 * Datum<double>::pi)) * std::asin(2.0*q - 1.0);
+  }
+
+
+
+//! inverse of the k1 scale function
+template<typename eT>
+inline
+double
+running_quantile<eT>::k_scale_inv(const double k, const double delta)
+  {
+  const double x = k * (2.0 * Datum<double>::pi) / delta;
+  
+  if(x >= ( Datum<double>::pi / 2.0))  { return 1.0; }
+  if(x <= (-Datum<double>::pi / 2.0))  { return 0.0; }
+  
+  return (std::sin(x) + 1.0) / 2.0;
+  }
+
+
+
+//
+
+
+
+template<typename obj_type>
+inline
+running_quantile_vec<obj_type>::~running_quantile_vec()
+  {
+  arma_extra_debug_sigprint_this(this);
+  }
+
+
+
+template<typename obj_type>
+inline
+running_quantile_vec<obj_type>::running_quantile_vec(const uword in_compression)
+  : compression(in_compression)
+  , s_n_rows   (0)
+  , s_n_cols   (0)
+  {
+  arma_extra_debug_sigprint_this(this);
+  
+  arma_type_check(( is_cx<eT>::value ));
+  
+  arma_debug_check( (in_compression < 10), "running_quantile_vec(): compression must be at least 10" );
+  }
+
+
+
+template<typename obj_type>
+inline
+void
+running_quantile_vec<obj_type>::init(const uword in_n_rows, const uword in_n_cols)
+  {
+  arma_extra_debug_sigprint();
+  
+  s_n_rows = in_n_rows;
+  s_n_cols = in_n_cols;
+  
+  digests.assign( size_t(in_n_rows * in_n_cols), running_quantile<eT>(compression) );
+  }
+
+
+
+//! update statistics to reflect new sample
+template<typename obj_type>
+template<typename T1>
+inline
+void
+running_quantile_vec<obj_type>::operator() (const Base<typename running_quantile_vec<obj_type>::eT, T1>& X)
+  {
+  arma_extra_debug_sigprint();
+  
+  const quasi_unwrap<T1> tmp(X.get_ref());
+  const Mat<eT>& sample = tmp.M;
+  
+  if( sample.is_empty() )
+    {
+    return;
+    }
+  
+  if( sample.is_finite() == false )
+    {
+    arma_debug_warn("running_quantile_vec: sample ignored as it has non-finite elements");
+    return;
+    }
+  
+  if(digests.empty())
+    {
+    arma_debug_check( (sample.is_vec() == false), "running_quantile_vec(): given sample is not a vector" );
+    
+    init(sample.n_rows, sample.n_cols);
+    }
+  else
+    {
+    arma_debug_assert_same_size(s_n_rows, s_n_cols, sample.n_rows, sample.n_cols, "running_quantile_vec(): dimensionality mismatch");
+    }
+  
+  const eT*   X_mem = sample.memptr();
+  const uword N     = sample.n_elem;
+  
+  for(uword i=0; i < N; ++i)  { digests[i](X_mem[i]); }
+  }
+
+
+
+//! update statistics to reflect a set of samples, with each sample stored as a column of X
+//! (or as a row of X, if the samples are row vectors);
+//! the dimensions are processed in parallel when OpenMP is enabled
+template<typename obj_type>
+template<typename T1>
+inline
+void
+running_quantile_vec<obj_type>::batch_update(const Base<typename running_quantile_vec<obj_type>::eT, T1>& X)
+  {
+  arma_extra_debug_sigprint();
+  
+  const quasi_unwrap<T1> tmp(X.get_ref());
+  const Mat<eT>& samples = tmp.M;
+  
+  if( samples.is_empty() )
+    {
+    return;
+    }
+  
+  if( samples.is_finite() == false )
+    {
+    arma_debug_warn("running_quantile_vec: samples ignored as they have non-finite elements");
+    return;
+    }
+  
+  const bool samples_in_rows = is_Row<return_type1>::value || ( (digests.empty() == false) && (s_n_rows == 1) && (s_n_cols > 1) );
+  
+  const uword n_dims = (samples_in_rows) ? samples.n_cols : samples.n_rows;
+  
+  if(digests.empty())
+    {
+    if(samples_in_rows)  { init(1, n_dims); }  else  { init(n_dims, 1); }
+    }
+  else
+    {
+    arma_debug_check( (n_dims != uword(digests.size())), "running_quantile_vec::batch_update(): dimensionality mismatch" );
+    }
+  
+  #if defined(ARMA_USE_OPENMP)
+    {
+    if( (n_dims > 1) && mp_gate<eT>::eval(samples.n_elem) )
+      {
+      const int n_threads = mp_thread_limit::get();
+      
+      #pragma omp parallel for schedule(dynamic) num_threads(n_threads)
+      for(uword d=0; d < n_dims; ++d)
+        {
+        if(samples_in_rows)
+          {
+          digests[d].batch_update( samples.col(d) );
+          }
+        else
+          {
+          const Row<eT> dim_samples = samples.row(d);
+          
+          digests[d].batch_update(dim_samples);
+          }
+        }
+      
+      return;
+      }
+    }
+  #endif
+  
+  for(uword d=0; d < n_dims; ++d)
+    {
+    if(samples_in_rows)
+      {
+      digests[d].batch_update( samples.col(d) );
+      }
+    else
+      {
+      const Row<eT> dim_samples = samples.row(d);
+      
+      digests[d].batch_update(dim_samples);
+      }
+    }
+  }
+
+
+
+//! update statistics to reflect the samples seen by another instance;
+//! this allows statistics to be obtained for separate parts of the data (eg. in separate threads) and then combined
+template<typename obj_type>
+inline
+void
+running_quantile_vec<obj_type>::merge(const running_quantile_vec<obj_type>& in_rqv)
+  {
+  arma_extra_debug_sigprint();
+  
+  if(this == &in_rqv)
+    {
+    const running_quantile_vec<obj_type> tmp(in_rqv);
+    
+    (*this).merge(tmp);
+    
+    return;
+    }
+  
+  if(in_rqv.digests.empty())  { return; }
+  
+  if(digests.empty())
+    {
+    s_n_rows = in_rqv.s_n_rows;
+    s_n_cols = in_rqv.s_n_cols;
+    
+    digests.assign( in_rqv.digests.size(), running_quantile<eT>(compression) );
+    }
+  else
+    {
+    arma_debug_check( (digests.size() != in_rqv.digests.size()), "running_quantile_vec::merge(): dimensionality mismatch" );
+    }
+  
+  for(size_t d=0; d < digests.size(); ++d)  { digests[d].merge(in_rqv.digests[d]); }
+  }
+
+
+
+template<typename obj_type>
+inline
+const running_quantile_vec<obj_type>&
+running_quantile_vec<obj_type>::operator+=(const running_quantile_vec<obj_type>& in_rqv)
+  {
+  arma_extra_debug_sigprint();
+  
+  (*this).merge(in_rqv);
+  
+  return *this;
+  }
+
+
+
+//! set all statistics to zero
+template<typename obj_type>
+inline
+void
+running_quantile_vec<obj_type>::reset()
+  {
+  arma_extra_debug_sigprint();
+  
+  digests.clear();
+  
+  s_n_rows = 0;
+  s_n_cols = 0;
+  }
+
+
+
+//! estimate of the quantile at probability P for each dimension
+template<typename obj_type>
+inline
+typename running_quantile_vec<obj_type>::return_type1
+running_quantile_vec<obj_type>::quantile(const typename running_quantile_vec<obj_type>::eT P)
+  {
+  arma_extra_debug_sigprint();
+  
+  arma_debug_check( ((P < eT(0)) || (P > eT(1)) || (arma_isnan(P))), "running_quantile_vec::quantile(): P must be in the [0,1] interval" );
+  
+  return_type1 out;
+  
+  out.set_size(s_n_rows, s_n_cols);
+  
+  eT* out_mem = out.memptr();
+  
+  for(size_t d=0; d < digests.size(); ++d)  { out_mem[d] = digests[d].quantile(P); }
+  
+  return out;
+  }
+
+
+
+//! estimates of the quantiles for each dimension at each of the probabilities in P;
+//! the output has one row per dimension, with column j holding the estimates for P(j)
+template<typename obj_type>
+template<typename T1>
+inline
+Mat<typename running_quantile_vec<obj_type>::eT>
+running_quantile_vec<obj_type>::quantile(const Base<typename running_quantile_vec<obj_type>::eT, T1>& P)
+  {
+  arma_extra_debug_sigprint();
+  
+  const quasi_unwrap<T1> tmp(P.get_ref());
+  const Mat<eT>& PP = tmp.M;
+  
+  arma_debug_check( ((PP.is_vec() == false) && (PP.is_empty() == false)), "running_quantile_vec::quantile(): parameter 'P' must be a vector" );
+  
+  Mat<eT> out(uword(digests.size()), PP.n_elem);
+  
+  for(size_t d=0; d < digests.size(); ++d)
+    {
+    const Col<eT> est = digests[d].quantile(PP);
+    
+    for(uword j=0; j < PP.n_elem; ++j)  { out.at(uword(d), j) = est[j]; }
+    }
+  
+  return out;
+  }
+
+
+
+//! estimate of the median for each dimension
+template<typename obj_type>
+inline
+typename running_quantile_vec<obj_type>::return_type1
+running_quantile_vec<obj_type>::median()
+  {
+  arma_extra_debug_sigprint();
+  
+  return (*this).quantile( eT(0.5) );
+  }
+
+
+
+//! vector of minimum values
+template<typename obj_type>
+inline
+typename running_quantile_vec<obj_type>::return_type1
+running_quantile_vec<obj_type>::min() const
+  {
+  arma_extra_debug_sigprint();
+  
+  return_type1 out;
+  
+  out.set_size(s_n_rows, s_n_cols);
+  
+  eT* out_mem = out.memptr();
+  
+  for(size_t d=0; d < digests.size(); ++d)  { out_mem[d] = digests[d].min(); }
+  
+  return out;
+  }
+
+
+
+//! vector of maximum values
+template<typename obj_type>
+inline
+typename running_quantile_vec<obj_type>::return_type1
+running_quantile_vec<obj_type>::max() const
+  {
+  arma_extra_debug_sigprint();
+  
+  return_type1 out;
+  
+  out.set_size(s_n_rows, s_n_cols);
+  
+  eT* out_mem = out.memptr();
+  
+  for(size_t d=0; d < digests.size(); ++d)  { out_mem[d] = digests[d].max(); }
+  
+  return out;
+  }
+
+
+
+//! number of samples so far
+template<typename obj_type>
+inline
+typename running_quantile_vec<obj_type>::eT
+running_quantile_vec<obj_type>::count() const
+  {
+  return (digests.empty()) ? eT(0) : digests[0].count();
+  }
+
+
+
+//! @}
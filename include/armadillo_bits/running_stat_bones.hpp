@@ -30,6 +30,9 @@ class arma_counter
   inline const arma_counter& operator++();
   inline void                operator++(int);
   
+  inline const arma_counter& operator+=(const arma_counter& x);
+  inline const arma_counter& operator+=(const uword         n);
+  
   inline void reset();
   inline eT   value()         const;
   inline eT   value_plus_1()  const;
@@ -62,6 +65,9 @@ class running_stat
   inline void operator() (const T sample);
   inline void operator() (const std::complex<T>& sample);
   
+  inline void                merge     (const running_stat& in_rs);
+  inline const running_stat& operator+=(const running_stat& in_rs);
+  
   inline void reset();
   
   inline eT mean() const;
@@ -112,6 +118,12 @@ class running_stat_aux
   
   template<typename eT>
   inline static void update_stats(running_stat<eT>& x, const eT& sample, const typename arma_cx_only<eT>::result* junk = nullptr);
+  
+  template<typename eT>
+  inline static void merge_stats(running_stat<eT>& x, const running_stat<eT>& y, const typename arma_not_cx<eT>::result* junk = nullptr);
+  
+  template<typename eT>
+  inline static void merge_stats(running_stat<eT>& x, const running_stat<eT>& y, const typename arma_cx_only<eT>::result* junk = nullptr);
   };
 
 
@@ -69,6 +69,40 @@ arma_counter<eT>::operator++(int)
 
 
 
+template<typename eT>
+inline
+const arma_counter<eT>&
+arma_counter<eT>::operator+=(const arma_counter<eT>& x)
+  {
+  d_count += x.d_count;
+  
+  (*this) += x.i_count;
+  
+  return *this;
+  }
+
+
+
+template<typename eT>
+inline
+const arma_counter<eT>&
+arma_counter<eT>::operator+=(const uword n)
+  {
+  if(n <= (ARMA_MAX_UWORD - i_count))
+    {
+    i_count += n;
+    }
+  else
+    {
+    d_count += eT(i_count);
+    i_count  = n;
+    }
+  
+  return *this;
+  }
+
+
+
 template<typename eT>
 inline
 void
@@ -190,6 +224,43 @@ running_stat<eT>::operator() (const std::complex< typename running_stat<eT>::T >
 
 
 
+//! update statistics to reflect the samples seen by another instance;
+//! this allows statistics to be obtained for separate parts of the data (eg. in separate threads) and then combined
+template<typename eT>
+inline
+void
+running_stat<eT>::merge(const running_stat<eT>& in_rs)
+  {
+  arma_extra_debug_sigprint();
+  
+  if(this == &in_rs)
+    {
+    const running_stat<eT> tmp(in_rs);
+    
+    running_stat_aux::merge_stats(*this, tmp);
+    }
+  else
+    {
+    running_stat_aux::merge_stats(*this, in_rs);
+    }
+  }
+
+
+
+template<typename eT>
+inline
+const running_stat<eT>&
+running_stat<eT>::operator+=(const running_stat<eT>& in_rs)
+  {
+  arma_extra_debug_sigprint();
+  
+  (*this).merge(in_rs);
+  
+  return *this;
+  }
+
+
+
 //! set all statistics to zero
 template<typename eT>
 inline
@@ -458,4 +529,84 @@ running_stat_aux::update_stats(running_stat<eT>& x, const eT& sample, const type
 
 
 
+//! merge statistics via the pairwise update in Chan, Golub, LeVeque, "Updating formulae and a pairwise algorithm for computing sample variances", 1979
+//! (version for non-complex numbers)
+template<typename eT>
+inline
+void
+running_stat_aux::merge_stats(running_stat<eT>& x, const running_stat<eT>& y, const typename arma_not_cx<eT>::result* junk)
+  {
+  arma_extra_debug_sigprint();
+  arma_ignore(junk);
+  
+  typedef typename running_stat<eT>::T T;
+  
+  const T N_x = x.counter.value();
+  const T N_y = y.counter.value();
+  
+  if(N_y == T(0))  { return; }
+  if(N_x == T(0))  { x = y; return; }
+  
+  const T N = N_x + N_y;
+  
+  if(y.min_val < x.min_val)  { x.min_val = y.min_val; }
+  if(y.max_val > x.max_val)  { x.max_val = y.max_val; }
+  
+  // r_var holds the sum of squared differences from the mean, divided by (count - 1)
+  
+  const eT delta = y.r_mean - x.r_mean;
+  
+  const T sum_sq = (N_x - T(1)) * x.r_var + (N_y - T(1)) * y.r_var + (delta*delta) * ((N_x * N_y) / N);
+  
+  x.r_var  = sum_sq / (N - T(1));
+  x.r_mean = x.r_mean + delta * (N_y / N);
+  
+  x.counter += y.counter;
+  }
+
+
+
+//! merge statistics (version for complex numbers)
+template<typename eT>
+inline
+void
+running_stat_aux::merge_stats(running_stat<eT>& x, const running_stat<eT>& y, const typename arma_cx_only<eT>::result* junk)
+  {
+  arma_extra_debug_sigprint();
+  arma_ignore(junk);
+  
+  typedef typename eT::value_type T;
+  
+  const T N_x = x.counter.value();
+  const T N_y = y.counter.value();
+  
+  if(N_y == T(0))  { return; }
+  if(N_x == T(0))  { x = y; return; }
+  
+  const T N = N_x + N_y;
+  
+  if(y.min_val_norm < x.min_val_norm)
+    {
+    x.min_val_norm = y.min_val_norm;
+    x.min_val      = y.min_val;
+    }
+  
+  if(y.max_val_norm > x.max_val_norm)
+    {
+    x.max_val_norm = y.max_val_norm;
+    x.max_val      = y.max_val;
+    }
+  
+  const eT delta = y.r_mean - x.r_mean;
+  
+  const T sum_sq = (N_x - T(1)) * x.r_var + (N_y - T(1)) * y.r_var + std::norm(delta) * ((N_x * N_y) / N);
+  
+  x.r_var  = sum_sq / (N - T(1));
+  x.r_mean = x.r_mean + delta * (N_y / N);
+  
+  x.counter += y.counter;
+  }
+
+
+
 //! @}
@@ -65,6 +65,12 @@ class running_stat_vec
   template<typename T1> arma_hot inline void operator() (const Base<              T, T1>& X);
   template<typename T1> arma_hot inline void operator() (const Base<std::complex<T>, T1>& X);
   
+  template<typename T1> inline void batch_update(const Base<              T, T1>& X);
+  template<typename T1> inline void batch_update(const Base<std::complex<T>, T1>& X);
+  
+  inline void                    merge     (const running_stat_vec& in_rsv);
+  inline const running_stat_vec& operator+=(const running_stat_vec& in_rsv);
+  
   inline void reset();
   
   inline const return_type1&  mean() const;
@@ -148,6 +154,62 @@ class running_stat_vec_aux
     const                   Mat<typename running_stat_vec<obj_type>::eT>& sample,
     const typename arma_cx_only<typename running_stat_vec<obj_type>::eT>::result* junk = nullptr
     );
+  
+  template<typename obj_type, typename sample_eT>
+  inline static void
+  batch_stats
+    (
+    running_stat_vec<obj_type>& x,
+    const Mat<sample_eT>&       samples,
+    const bool                  samples_in_rows
+    );
+  
+  template<typename obj_type>
+  inline static void
+  batch_min_max
+    (
+    running_stat_vec<obj_type>& x,
+    const                  Mat<typename running_stat_vec<obj_type>::eT>& X,
+    const bool                                                           samples_in_rows,
+    const typename arma_not_cx<typename running_stat_vec<obj_type>::eT>::result* junk = nullptr
+    );
+  
+  template<typename obj_type>
+  inline static void
+  batch_min_max
+    (
+    running_stat_vec<obj_type>& x,
+    const                   Mat<typename running_stat_vec<obj_type>::eT>& X,
+    const bool                                                            samples_in_rows,
+    const typename arma_cx_only<typename running_stat_vec<obj_type>::eT>::result* junk = nullptr
+    );
+  
+  template<typename obj_type>
+  inline static void
+  merge_stats
+    (
+    running_stat_vec<obj_type>& x,
+    const running_stat_vec<obj_type>& y,
+    const typename arma_not_cx<typename running_stat_vec<obj_type>::eT>::result* junk = nullptr
+    );
+  
+  template<typename obj_type>
+  inline static void
+  merge_stats
+    (
+    running_stat_vec<obj_type>& x,
+    const running_stat_vec<obj_type>& y,
+    const typename arma_cx_only<typename running_stat_vec<obj_type>::eT>::result* junk = nullptr
+    );
+  
+  template<typename obj_type>
+  inline static void
+  merge_cov
+    (
+    running_stat_vec<obj_type>& x,
+    const running_stat_vec<obj_type>& y,
+    const Mat<typename running_stat_vec<obj_type>::eT>& delta
+    );
   };
 
 
@@ -137,6 +137,113 @@ running_stat_vec<obj_type>::operator() (const Base< std::complex<typename runnin
 
 
 
+//! update statistics to reflect a set of samples, with each sample stored as a column of X
+//! (or as a row of X, if the samples are row vectors);
+//! the covariance matrix of the set is obtained via one matrix multiply, and is then merged with the existing statistics
+template<typename obj_type>
+template<typename T1>
+inline
+void
+running_stat_vec<obj_type>::batch_update(const Base<typename running_stat_vec<obj_type>::T, T1>& X)
+  {
+  arma_extra_debug_sigprint();
+  
+  const quasi_unwrap<T1> tmp(X.get_ref());
+  const Mat<T>& samples = tmp.M;
+  
+  if( samples.is_empty() )
+    {
+    return;
+    }
+  
+  if( samples.is_finite() == false )
+    {
+    arma_debug_warn("running_stat_vec: samples ignored as they have non-finite elements");
+    return;
+    }
+  
+  const bool samples_in_rows = is_Row<return_type1>::value || ( (counter.value() > T(0)) && (r_mean.n_rows == 1) && (r_mean.n_cols > 1) );
+  
+  running_stat_vec<obj_type> batch(calc_cov);
+  
+  running_stat_vec_aux::batch_stats(batch, samples, samples_in_rows);
+  
+  running_stat_vec_aux::merge_stats(*this, batch);
+  }
+
+
+
+template<typename obj_type>
+template<typename T1>
+inline
+void
+running_stat_vec<obj_type>::batch_update(const Base< std::complex<typename running_stat_vec<obj_type>::T>, T1>& X)
+  {
+  arma_extra_debug_sigprint();
+  
+  const quasi_unwrap<T1> tmp(X.get_ref());
+  
+  const Mat< std::complex<T> >& samples = tmp.M;
+  
+  if( samples.is_empty() )
+    {
+    return;
+    }
+  
+  if( samples.is_finite() == false )
+    {
+    arma_debug_warn("running_stat_vec: samples ignored as they have non-finite elements");
+    return;
+    }
+  
+  const bool samples_in_rows = is_Row<return_type1>::value || ( (counter.value() > T(0)) && (r_mean.n_rows == 1) && (r_mean.n_cols > 1) );
+  
+  running_stat_vec<obj_type> batch(calc_cov);
+  
+  running_stat_vec_aux::batch_stats(batch, samples, samples_in_rows);
+  
+  running_stat_vec_aux::merge_stats(*this, batch);
+  }
+
+
+
+//! update statistics to reflect the samples seen by another instance;
+//! this allows statistics to be obtained for separate parts of the data (eg. in separate threads) and then combined
+template<typename obj_type>
+inline
+void
+running_stat_vec<obj_type>::merge(const running_stat_vec<obj_type>& in_rsv)
+  {
+  arma_extra_debug_sigprint();
+  
+  if(this == &in_rsv)
+    {
+    const running_stat_vec<obj_type> tmp(in_rsv);
+    
+    running_stat_vec_aux::merge_stats(*this, tmp);
+    }
+  else
+    {
+    running_stat_vec_aux::merge_stats(*this, in_rsv);
+    }
+  }
+
+
+
+template<typename obj_type>
+inline
+const running_stat_vec<obj_type>&
+running_stat_vec<obj_type>::operator+=(const running_stat_vec<obj_type>& in_rsv)
+  {
+  arma_extra_debug_sigprint();
+  
+  (*this).merge(in_rsv);
+  
+  return *this;
+  }
+
+
+
 //! set all statistics to zero
 template<typename obj_type>
 inline
@@ -633,4 +740,361 @@ running_stat_vec_aux::update_stats
 
 
 
+//! statistics for a set of samples, stored in an empty instance
+template<typename obj_type, typename sample_eT>
+inline
+void
+running_stat_vec_aux::batch_stats
+  (
+  running_stat_vec<obj_type>& x,
+  const Mat<sample_eT>&       samples,
+  const bool                  samples_in_rows
+  )
+  {
+  arma_extra_debug_sigprint();
+  
+  typedef typename running_stat_vec<obj_type>::eT eT;
+  typedef typename running_stat_vec<obj_type>::T   T;
+  
+  // each column of D is a sample
+  
+  Mat<eT> D = conv_to< Mat<eT> >::from(samples);
+  
+  if(samples_in_rows)  { op_strans::apply_mat_inplace(D); }
+  
+  const uword N_samples = D.n_cols;
+  
+  running_stat_vec_aux::batch_min_max(x, D, samples_in_rows);
+  
+  const Col<eT> r_mean = mean(D, 1);
+  
+  D.each_col() -= r_mean;
+  
+  const T norm_val = (N_samples > 1) ? T(N_samples - 1) : T(1);
+  
+  const Col<T> r_var = sum(square(abs(D)), 1) / norm_val;
+  
+  if(x.calc_cov)
+    {
+    x.r_cov = conj(D) * strans(D);
+    x.r_cov /= norm_val;
+    }
+  
+  if(samples_in_rows)
+    {
+    x.r_mean = strans(r_mean);
+    x.r_var  = strans(r_var);
+    }
+  else
+    {
+    x.r_mean = r_mean;
+    x.r_var  = r_var;
+    }
+  
+  x.counter += N_samples;
+  }
+
+
+
+//! minimum and maximum values for a set of samples, with each sample stored as a column of X (version for non-complex numbers)
+template<typename obj_type>
+inline
+void
+running_stat_vec_aux::batch_min_max
+  (
+  running_stat_vec<obj_type>& x,
+  const                  Mat<typename running_stat_vec<obj_type>::eT>& X,
+  const bool                                                           samples_in_rows,
+  const typename arma_not_cx<typename running_stat_vec<obj_type>::eT>::result* junk
+  )
+  {
+  arma_extra_debug_sigprint();
+  arma_ignore(junk);
+  
+  typedef typename running_stat_vec<obj_type>::eT eT;
+  
+  const Col<eT> min_val = min(X, 1);
+  const Col<eT> max_val = max(X, 1);
+  
+  if(samples_in_rows)
+    {
+    x.min_val = strans(min_val);
+    x.max_val = strans(max_val);
+    }
+  else
+    {
+    x.min_val = min_val;
+    x.max_val = max_val;
+    }
+  }
+
+
+
+//! minimum and maximum values for a set of samples, with each sample stored as a column of X (version for complex numbers)
+template<typename obj_type>
+inline
+void
+running_stat_vec_aux::batch_min_max
+  (
+  running_stat_vec<obj_type>& x,
+  const                   Mat<typename running_stat_vec<obj_type>::eT>& X,
+  const bool                                                            samples_in_rows,
+  const typename arma_cx_only<typename running_stat_vec<obj_type>::eT>::result* junk
+  )
+  {
+  arma_extra_debug_sigprint();
+  arma_ignore(junk);
+  
+  typedef typename running_stat_vec<obj_type>::eT eT;
+  typedef typename running_stat_vec<obj_type>::T   T;
+  
+  const uword N_dims    = X.n_rows;
+  const uword N_samples = X.n_cols;
+  
+  Col<eT> min_val = X.col(0);
+  Col<eT> max_val = X.col(0);
+  
+  Col<T> min_val_norm(N_dims);
+  Col<T> max_val_norm(N_dims);
+  
+  for(uword d=0; d < N_dims; ++d)
+    {
+    min_val_norm[d] = std::norm(min_val[d]);
+    max_val_norm[d] = min_val_norm[d];
+    }
+  
+  for(uword i=1; i < N_samples; ++i)
+    {
+    const eT* X_colptr = X.colptr(i);
+    
+    for(uword d=0; d < N_dims; ++d)
+      {
+      const eT& val      = X_colptr[d];
+      const  T  val_norm = std::norm(val);
+      
+      if(val_norm < min_val_norm[d])  { min_val_norm[d] = val_norm; min_val[d] = val; }
+      if(val_norm > max_val_norm[d])  { max_val_norm[d] = val_norm; max_val[d] = val; }
+      }
+    }
+  
+  if(samples_in_rows)
+    {
+    x.min_val      = strans(min_val);
+    x.max_val      = strans(max_val);
+    x.min_val_norm = strans(min_val_norm);
+    x.max_val_norm = strans(max_val_norm);
+    }
+  else
+    {
+    x.min_val      = min_val;
+    x.max_val      = max_val;
+    x.min_val_norm = min_val_norm;
+    x.max_val_norm = max_val_norm;
+    }
+  }
+
+
+
+//! merge statistics via the pairwise update in Chan, Golub, LeVeque, "Updating formulae and a pairwise algorithm for computing sample variances", 1979
+//! (version for non-complex numbers)
+template<typename obj_type>
+inline
+void
+running_stat_vec_aux::merge_stats
+  (
+  running_stat_vec<obj_type>& x,
+  const running_stat_vec<obj_type>& y,
+  const typename arma_not_cx<typename running_stat_vec<obj_type>::eT>::result* junk
+  )
+  {
+  arma_extra_debug_sigprint();
+  arma_ignore(junk);
+  
+  typedef typename running_stat_vec<obj_type>::eT eT;
+  typedef typename running_stat_vec<obj_type>::T   T;
+  
+  const T N_x = x.counter.value();
+  const T N_y = y.counter.value();
+  
+  if(N_y == T(0))  { return; }
+  
+  arma_debug_check( (x.calc_cov && (y.calc_cov == false)), "running_stat_vec::merge(): given object does not have a covariance matrix" );
+  
+  if(N_x == T(0))
+    {
+    const bool calc_cov = x.calc_cov;
+    
+    x = y;
+    
+    access::rw(x.calc_cov) = calc_cov;
+    
+    if(calc_cov == false)  { x.r_cov.reset(); }
+    
+    return;
+    }
+  
+  arma_debug_assert_same_size(x.r_mean, y.r_mean, "running_stat_vec::merge(): dimensionality mismatch");
+  
+  const T N = N_x + N_y;
+  
+  const Mat<eT> delta = y.r_mean - x.r_mean;
+  
+  if(x.calc_cov)  { running_stat_vec_aux::merge_cov(x, y, delta); }
+  
+  const uword n_elem        = delta.n_elem;
+  const eT*   delta_mem     = delta.memptr();
+  const eT*   y_r_var_mem   = y.r_var.memptr();
+  const eT*   y_min_val_mem = y.min_val.memptr();
+  const eT*   y_max_val_mem = y.max_val.memptr();
+        eT*   r_mean_mem    = x.r_mean.memptr();
+         T*   r_var_mem     = x.r_var.memptr();
+        eT*   min_val_mem   = x.min_val.memptr();
+        eT*   max_val_mem   = x.max_val.memptr();
+  
+  const T w_delta = (N_x * N_y) / N;
+  
+  for(uword i=0; i<n_elem; ++i)
+    {
+    if(y_min_val_mem[i] < min_val_mem[i])  { min_val_mem[i] = y_min_val_mem[i]; }
+    if(y_max_val_mem[i] > max_val_mem[i])  { max_val_mem[i] = y_max_val_mem[i]; }
+    
+    const eT d = delta_mem[i];
+    
+    r_var_mem[i] = ( (N_x - T(1)) * r_var_mem[i] + (N_y - T(1)) * y_r_var_mem[i] + (d*d) * w_delta ) / (N - T(1));
+    
+    r_mean_mem[i] += d * (N_y / N);
+    }
+  
+  x.counter += y.counter;
+  }
+
+
+
+//! merge statistics (version for complex numbers)
+template<typename obj_type>
+inline
+void
+running_stat_vec_aux::merge_stats
+  (
+  running_stat_vec<obj_type>& x,
+  const running_stat_vec<obj_type>& y,
+  const typename arma_cx_only<typename running_stat_vec<obj_type>::eT>::result* junk
+  )
+  {
+  arma_extra_debug_sigprint();
+  arma_ignore(junk);
+  
+  typedef typename running_stat_vec<obj_type>::eT eT;
+  typedef typename running_stat_vec<obj_type>::T   T;
+  
+  const T N_x = x.counter.value();
+  const T N_y = y.counter.value();
+  
+  if(N_y == T(0))  { return; }
+  
+  arma_debug_check( (x.calc_cov && (y.calc_cov == false)), "running_stat_vec::merge(): given object does not have a covariance matrix" );
+  
+  if(N_x == T(0))
+    {
+    const bool calc_cov = x.calc_cov;
+    
+    x = y;
+    
+    access::rw(x.calc_cov) = calc_cov;
+    
+    if(calc_cov == false)  { x.r_cov.reset(); }
+    
+    return;
+    }
+  
+  arma_debug_assert_same_size(x.r_mean, y.r_mean, "running_stat_vec::merge(): dimensionality mismatch");
+  
+  const T N = N_x + N_y;
+  
+  const Mat<eT> delta = y.r_mean - x.r_mean;
+  
+  if(x.calc_cov)  { running_stat_vec_aux::merge_cov(x, y, delta); }
+  
+  const uword n_elem             = delta.n_elem;
+  const eT*   delta_mem          = delta.memptr();
+  const  T*   y_r_var_mem        = y.r_var.memptr();
+  const eT*   y_min_val_mem      = y.min_val.memptr();
+  const eT*   y_max_val_mem      = y.max_val.memptr();
+  const  T*   y_min_val_norm_mem = y.min_val_norm.memptr();
+  const  T*   y_max_val_norm_mem = y.max_val_norm.memptr();
+        eT*   r_mean_mem         = x.r_mean.memptr();
+         T*   r_var_mem          = x.r_var.memptr();
+        eT*   min_val_mem        = x.min_val.memptr();
+        eT*   max_val_mem        = x.max_val.memptr();
+         T*   min_val_norm_mem   = x.min_val_norm.memptr();
+         T*   max_val_norm_mem   = x.max_val_norm.memptr();
+  
+  const T w_delta = (N_x * N_y) / N;
+  
+  for(uword i=0; i<n_elem; ++i)
+    {
+    if(y_min_val_norm_mem[i] < min_val_norm_mem[i])
+      {
+      min_val_norm_mem[i] = y_min_val_norm_mem[i];
+      min_val_mem[i]      = y_min_val_mem[i];
+      }
+    
+    if(y_max_val_norm_mem[i] > max_val_norm_mem[i])
+      {
+      max_val_norm_mem[i] = y_max_val_norm_mem[i];
+      max_val_mem[i]      = y_max_val_mem[i];
+      }
+    
+    const eT& d = delta_mem[i];
+    
+    r_var_mem[i] = ( (N_x - T(1)) * r_var_mem[i] + (N_y - T(1)) * y_r_var_mem[i] + std::norm(d) * w_delta ) / (N - T(1));
+    
+    r_mean_mem[i] += d * (N_y / N);
+    }
+  
+  x.counter += y.counter;
+  }
+
+
+
+//! covariance matrix for the union of the samples seen by x and y;
+//! delta is the difference between the means of y and x
+template<typename obj_type>
+inline
+void
+running_stat_vec_aux::merge_cov
+  (
+  running_stat_vec<obj_type>& x,
+  const running_stat_vec<obj_type>& y,
+  const Mat<typename running_stat_vec<obj_type>::eT>& delta
+  )
+  {
+  arma_extra_debug_sigprint();
+  
+  typedef typename running_stat_vec<obj_type>::eT eT;
+  typedef typename running_stat_vec<obj_type>::T   T;
+  
+  const T N_x = x.counter.value();
+  const T N_y = y.counter.value();
+  const T N   = N_x + N_y;
+  
+  Mat<eT> tmp;
+  
+  if(delta.n_cols == 1)
+    {
+    tmp = conj(delta) * strans(delta);
+    }
+  else
+    {
+    tmp = trans(delta) * delta;
+    }
+  
+  x.r_cov *= (N_x - T(1));
+  x.r_cov += (N_y - T(1)) * y.r_cov;
+  x.r_cov += ((N_x * N_y) / N) * tmp;
+  x.r_cov /= (N - T(1));
+  }
+
+
+
 //! @}
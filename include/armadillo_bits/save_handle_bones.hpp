@@ -0,0 +1,82 @@
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+//! \addtogroup save_handle
+//! @{
+
+
+//! Class for tracking a save operation running in the background; obtained via .save_async()
+class save_handle
+  {
+  public:
+  
+  inline  save_handle();
+  inline ~save_handle();
+  
+  inline save_handle(save_handle&& in);
+  inline save_handle& operator=(save_handle&& in);
+  
+  save_handle(const save_handle&)            = delete;
+  save_handle& operator=(const save_handle&) = delete;
+  
+  inline arma_warn_unused bool is_valid() const;  //!< true if the handle refers to a save operation
+  inline arma_warn_unused bool is_ready() const;  //!< true if the save operation has finished (does not block)
+  
+  inline void wait();                             //!< block until the save operation has finished
+  inline bool status();                           //!< block until finished; return true if the save succeeded
+  inline const std::string& err_msg();            //!< block until finished; return a description of the failure, if any
+  
+  
+  private:
+  
+  bool        finished = false;
+  bool        save_okay = false;
+  std::string msg;
+  
+  #if !defined(ARMA_DONT_USE_STD_MUTEX)
+    std::future<bool>            fut;
+    std::shared_ptr<std::string> fut_msg;
+  #endif
+  
+  inline void finish();
+  
+  inline static const std::string& spec_filename(const std::string& spec);
+  inline static const std::string& spec_filename(const   hdf5_name& spec);
+  
+  template<typename eT> inline static bool save_obj(const  Mat<eT>& obj, const std::string& spec, const file_type type, std::string& err_msg);
+  template<typename eT> inline static bool save_obj(const  Mat<eT>& obj, const   hdf5_name& spec, const file_type type, std::string& err_msg);
+  template<typename eT> inline static bool save_obj(const Cube<eT>& obj, const std::string& spec, const file_type type, std::string& err_msg);
+  template<typename eT> inline static bool save_obj(const Cube<eT>& obj, const   hdf5_name& spec, const file_type type, std::string& err_msg);
+  template<typename oT> inline static bool save_obj(const field<oT>& obj, const std::string& spec, const file_type type, std::string& err_msg);
+  
+  template<typename obj_type, typename spec_type>
+  inline static bool worker(const obj_type& obj, const spec_type& spec, const file_type type, std::string& out_msg);
+  
+  #if !defined(ARMA_DONT_USE_STD_MUTEX)
+  template<typename obj_type, typename spec_type>
+  inline static bool worker_async(const std::shared_ptr<obj_type> obj, const spec_type& spec, const file_type type, const std::shared_ptr<std::string> out_msg);
+  #endif
+  
+  template<typename obj_type, typename spec_type>
+  inline static save_handle launch(obj_type&& snapshot, const spec_type& spec, const file_type type);
+  
+  template<typename eT> friend class  Mat;
+  template<typename eT> friend class Cube;
+  template<typename oT> friend class field;
+  };
+
+
+//! @}
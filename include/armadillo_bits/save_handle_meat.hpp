@@ -0,0 +1,351 @@
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+//! \addtogroup save_handle
+//! @{
+
+
+inline
+save_handle::save_handle()
+  {
+  arma_extra_debug_sigprint();
+  }
+
+
+
+inline
+save_handle::~save_handle()
+  {
+  arma_extra_debug_sigprint();
+  
+  // the snapshot is owned by the background task; wait for it so that the task doesn't outlive the handle
+  wait();
+  }
+
+
+
+inline
+save_handle::save_handle(save_handle&& in)
+  : finished (in.finished )
+  , save_okay(in.save_okay)
+  , msg      (std::move(in.msg))
+  #if !defined(ARMA_DONT_USE_STD_MUTEX)
+  , fut      (std::move(in.fut    ))
+  , fut_msg  (std::move(in.fut_msg))
+  #endif
+  {
+  arma_extra_debug_sigprint();
+  
+  in.finished  = false;
+  in.save_okay = false;
+  }
+
+
+
+inline
+save_handle&
+save_handle::operator=(save_handle&& in)
+  {
+  arma_extra_debug_sigprint();
+  
+  if(this != &in)
+    {
+    wait();
+    
+    finished  = in.finished;
+    save_okay = in.save_okay;
+    msg       = std::move(in.msg);
+    
+    #if !defined(ARMA_DONT_USE_STD_MUTEX)
+      fut     = std::move(in.fut    );
+      fut_msg = std::move(in.fut_msg);
+    #endif
+    
+    in.finished  = false;
+    in.save_okay = false;
+    }
+  
+  return *this;
+  }
+
+
+
+inline
+bool
+save_handle::is_valid() const
+  {
+  arma_extra_debug_sigprint();
+  
+  #if !defined(ARMA_DONT_USE_STD_MUTEX)
+    return (finished || fut.valid());
+  #else
+    return finished;
+  #endif
+  }
+
+
+
+inline
+bool
+save_handle::is_ready() const
+  {
+  arma_extra_debug_sigprint();
+  
+  #if !defined(ARMA_DONT_USE_STD_MUTEX)
+    if(fut.valid())  { return (fut.wait_for(std::chrono::seconds(0)) == std::future_status::ready); }
+  #endif
+  
+  return finished;
+  }
+
+
+
+inline
+void
+save_handle::finish()
+  {
+  arma_extra_debug_sigprint();
+  
+  #if !defined(ARMA_DONT_USE_STD_MUTEX)
+    if(fut.valid())
+      {
+      save_okay = fut.get();
+      finished  = true;
+      
+      if(fut_msg)  { msg = (*fut_msg); fut_msg.reset(); }
+      }
+  #endif
+  }
+
+
+
+inline
+void
+save_handle::wait()
+  {
+  arma_extra_debug_sigprint();
+  
+  finish();
+  }
+
+
+
+inline
+bool
+save_handle::status()
+  {
+  arma_extra_debug_sigprint();
+  
+  finish();
+  
+  return save_okay;
+  }
+
+
+
+inline
+const std::string&
+save_handle::err_msg()
+  {
+  arma_extra_debug_sigprint();
+  
+  finish();
+  
+  return msg;
+  }
+
+
+
+inline
+const std::string&
+save_handle::spec_filename(const std::string& spec)
+  {
+  return spec;
+  }
+
+
+
+inline
+const std::string&
+save_handle::spec_filename(const hdf5_name& spec)
+  {
+  return spec.filename;
+  }
+
+
+
+//! the save_obj() functions save as per .save(), but store the description of a failure (if any) in err_msg rather than printing it;
+//! saving a Mat or Cube in formats other than HDF5 only reports success or failure, in which case err_msg is left empty
+
+template<typename eT>
+inline
+bool
+save_handle::save_obj(const Mat<eT>& obj, const std::string& spec, const file_type type, std::string& err_msg)
+  {
+  arma_extra_debug_sigprint();
+  
+  if(type == hdf5_binary      )  { return obj.save_hdf5(hdf5_name(spec),                                  type, err_msg); }
+  if(type == hdf5_binary_trans)  { return obj.save_hdf5(hdf5_name(spec, std::string(), hdf5_opts::trans), type, err_msg); }
+  
+  return obj.save(spec, type, false);
+  }
+
+
+
+template<typename eT>
+inline
+bool
+save_handle::save_obj(const Mat<eT>& obj, const hdf5_name& spec, const file_type type, std::string& err_msg)
+  {
+  arma_extra_debug_sigprint();
+  
+  return obj.save_hdf5(spec, type, err_msg);
+  }
+
+
+
+template<typename eT>
+inline
+bool
+save_handle::save_obj(const Cube<eT>& obj, const std::string& spec, const file_type type, std::string& err_msg)
+  {
+  arma_extra_debug_sigprint();
+  
+  if(type == hdf5_binary      )  { return obj.save_hdf5(hdf5_name(spec),                                  type, err_msg); }
+  if(type == hdf5_binary_trans)  { return obj.save_hdf5(hdf5_name(spec, std::string(), hdf5_opts::trans), type, err_msg); }
+  
+  return obj.save(spec, type, false);
+  }
+
+
+
+template<typename eT>
+inline
+bool
+save_handle::save_obj(const Cube<eT>& obj, const hdf5_name& spec, const file_type type, std::string& err_msg)
+  {
+  arma_extra_debug_sigprint();
+  
+  return obj.save_hdf5(spec, type, err_msg);
+  }
+
+
+
+template<typename oT>
+inline
+bool
+save_handle::save_obj(const field<oT>& obj, const std::string& spec, const file_type type, std::string& err_msg)
+  {
+  arma_extra_debug_sigprint();
+  
+  return field_aux::save(obj, spec, type, err_msg);
+  }
+
+
+
+//! the description of a failure has the same form as the warning printed by .save()
+template<typename obj_type, typename spec_type>
+inline
+bool
+save_handle::worker(const obj_type& obj, const spec_type& spec, const file_type type, std::string& out_msg)
+  {
+  arma_extra_debug_sigprint();
+  
+  bool save_okay = false;
+  
+  try
+    {
+    std::string err_msg;
+    
+    save_okay = save_handle::save_obj(obj, spec, type, err_msg);
+    
+    if(save_okay == false)
+      {
+      out_msg = ( (err_msg.length() > 0) ? err_msg : std::string("couldn't write to ") ) + spec_filename(spec);
+      }
+    }
+  catch(const std::exception& e)
+    {
+    save_okay = false;
+    out_msg   = e.what();
+    }
+  
+  return save_okay;
+  }
+
+
+
+#if !defined(ARMA_DONT_USE_STD_MUTEX)
+
+template<typename obj_type, typename spec_type>
+inline
+bool
+save_handle::worker_async(const std::shared_ptr<obj_type> obj, const spec_type& spec, const file_type type, const std::shared_ptr<std::string> out_msg)
+  {
+  arma_extra_debug_sigprint();
+  
+  // saves in HDF5 format are serialised with all other HDF5 operations by the diskio functions (see hdf5_misc::hdf5_lock)
+  
+  return save_handle::worker(*obj, spec, type, *out_msg);
+  }
+
+#endif
+
+
+
+template<typename obj_type, typename spec_type>
+inline
+save_handle
+save_handle::launch(obj_type&& snapshot, const spec_type& spec, const file_type type)
+  {
+  arma_extra_debug_sigprint();
+  
+  save_handle out;
+  
+  #if !defined(ARMA_DONT_USE_STD_MUTEX)
+    {
+    typedef typename std::decay<obj_type>::type snapshot_type;
+    
+    const std::shared_ptr<snapshot_type> snapshot_ptr = std::make_shared<snapshot_type>(std::move(snapshot));
+    
+    out.fut_msg = std::make_shared<std::string>();
+    
+    try
+      {
+      out.fut = std::async(std::launch::async, &save_handle::worker_async<snapshot_type, spec_type>, snapshot_ptr, spec, type, out.fut_msg);
+      }
+    catch(const std::system_error&)
+      {
+      // unable to start a new thread; fall back to saving in the calling thread
+      
+      out.fut_msg.reset();
+      
+      out.save_okay = save_handle::worker(*snapshot_ptr, spec, type, out.msg);
+      out.finished  = true;
+      }
+    }
+  #else
+    {
+    out.save_okay = save_handle::worker(snapshot, spec, type, out.msg);
+    out.finished  = true;
+    }
+  #endif
+  
+  return out;
+  }
+
+
+//! @}
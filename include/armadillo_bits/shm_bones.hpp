@@ -0,0 +1,136 @@
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+//! \addtogroup shm
+//! @{
+
+
+//! header stored at the start of each shared memory segment;
+//! the element data starts at data_offset, which keeps it aligned
+struct shm_header
+  {
+  char magic[32];    //!< eg. ARMA_MAT_SHM_FN008, as per the arma_binary headers
+  u64  n_rows;
+  u64  n_cols;
+  u64  n_slices;
+  u64  n_elem;
+  u64  data_offset;
+  
+  static constexpr uword data_offset_default = 128;
+  };
+
+
+
+//! named POSIX shared memory segment, mapped into the address space of the process - INTERNAL USE ONLY!
+class shm_segment
+  {
+  public:
+  
+  inline  shm_segment();
+  inline ~shm_segment();
+  
+  inline bool create(const std::string& in_name, const uword in_n_bytes);
+  inline bool attach(const std::string& in_name, const bool read_only);
+  inline void detach();
+  inline bool remove();
+  
+  inline bool create_obj(const std::string& in_name, const std::string& magic, const uword in_n_rows, const uword in_n_cols, const uword in_n_slices, const uword elem_size, const void* src);
+  inline bool attach_obj(const std::string& in_name, const std::string& magic, const bool read_only, const uword elem_size, uword& out_n_rows, uword& out_n_cols, uword& out_n_slices);
+  
+  inline void* data() const;
+  
+  inline static std::string gen_name(const std::string& in_name);
+  
+  void*       mem          = nullptr;
+  uword       n_bytes      = 0;
+  uword       data_offset  = 0;       //!< offset of the element data, as per the header of the segment
+  bool        is_read_only = false;
+  std::string name;
+  
+  
+  private:
+  
+  shm_segment(const shm_segment&)            = delete;
+  shm_segment& operator=(const shm_segment&) = delete;
+  };
+
+
+
+//! dense matrix stored in a named POSIX shared memory segment;
+//! other processes can attach to the segment and use the matrix without copying it
+template<typename eT>
+class shm_mat
+  {
+  public:
+  
+  inline  shm_mat();
+  inline ~shm_mat();
+  
+  inline bool create(const std::string& name, const uword n_rows, const uword n_cols);
+  inline bool create(const std::string& name, const Mat<eT>& X);
+  inline bool attach(const std::string& name, const bool read_only = true);
+  inline void detach();
+  inline bool remove();
+  
+  inline bool is_attached() const;
+  
+  inline const Mat<eT>& get() const;
+  inline       Mat<eT>& get_rw();
+  
+  
+  private:
+  
+  shm_segment seg;
+  Mat<eT>*    obj = nullptr;
+  
+  shm_mat(const shm_mat&)            = delete;
+  shm_mat& operator=(const shm_mat&) = delete;
+  };
+
+
+
+//! cube stored in a named POSIX shared memory segment
+template<typename eT>
+class shm_cube
+  {
+  public:
+  
+  inline  shm_cube();
+  inline ~shm_cube();
+  
+  inline bool create(const std::string& name, const uword n_rows, const uword n_cols, const uword n_slices);
+  inline bool create(const std::string& name, const Cube<eT>& X);
+  inline bool attach(const std::string& name, const bool read_only = true);
+  inline void detach();
+  inline bool remove();
+  
+  inline bool is_attached() const;
+  
+  inline const Cube<eT>& get() const;
+  inline       Cube<eT>& get_rw();
+  
+  
+  private:
+  
+  shm_segment seg;
+  Cube<eT>*   obj = nullptr;
+  
+  shm_cube(const shm_cube&)            = delete;
+  shm_cube& operator=(const shm_cube&) = delete;
+  };
+
+
+//! @}
@@ -0,0 +1,674 @@
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+//! \addtogroup shm
+//! @{
+
+
+
+inline
+shm_segment::shm_segment()
+  {
+  arma_extra_debug_sigprint();
+  }
+
+
+
+//! unmap the segment; the segment itself persists until remove() is called (by any process)
+inline
+shm_segment::~shm_segment()
+  {
+  arma_extra_debug_sigprint();
+  
+  (*this).detach();
+  }
+
+
+
+//! POSIX requires the names of shared memory objects to start with a slash
+inline
+std::string
+shm_segment::gen_name(const std::string& in_name)
+  {
+  return ( (in_name.length() > 0) && (in_name[0] == '/') ) ? in_name : (std::string("/") + in_name);
+  }
+
+
+
+inline
+bool
+shm_segment::create(const std::string& in_name, const uword in_n_bytes)
+  {
+  arma_extra_debug_sigprint();
+  
+  (*this).detach();
+  
+  #if defined(ARMA_HAVE_POSIX_SHM)
+    {
+    const std::string shm_name = shm_segment::gen_name(in_name);
+    
+    const int fd = ::shm_open(shm_name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    
+    if(fd < 0)  { return false; }
+    
+    // the new segment is zero filled
+    if(::ftruncate(fd, off_t(in_n_bytes)) != 0)
+      {
+      ::close(fd);
+      ::shm_unlink(shm_name.c_str());
+      return false;
+      }
+    
+    void* ptr = ::mmap(nullptr, size_t(in_n_bytes), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    
+    // the mapping stays valid after the descriptor is closed
+    ::close(fd);
+    
+    if(ptr == MAP_FAILED)
+      {
+      ::shm_unlink(shm_name.c_str());
+      return false;
+      }
+    
+    mem          = ptr;
+    n_bytes      = in_n_bytes;
+    data_offset  = 0;
+    is_read_only = false;
+    name         = shm_name;
+    
+    return true;
+    }
+  #else
+    {
+    arma_ignore(in_name);
+    arma_ignore(in_n_bytes);
+    
+    return false;
+    }
+  #endif
+  }
+
+
+
+inline
+bool
+shm_segment::attach(const std::string& in_name, const bool read_only)
+  {
+  arma_extra_debug_sigprint();
+  
+  (*this).detach();
+  
+  #if defined(ARMA_HAVE_POSIX_SHM)
+    {
+    const std::string shm_name = shm_segment::gen_name(in_name);
+    
+    const int fd = ::shm_open(shm_name.c_str(), (read_only) ? O_RDONLY : O_RDWR, 0);
+    
+    if(fd < 0)  { return false; }
+    
+    struct stat info;
+    
+    if( (::fstat(fd, &info) != 0) || (info.st_size <= 0) )  { ::close(fd); return false; }
+    
+    const uword seg_n_bytes = uword(info.st_size);
+    
+    void* ptr = ::mmap(nullptr, size_t(seg_n_bytes), (read_only) ? PROT_READ : (PROT_READ | PROT_WRITE), MAP_SHARED, fd, 0);
+    
+    ::close(fd);
+    
+    if(ptr == MAP_FAILED)  { return false; }
+    
+    mem          = ptr;
+    n_bytes      = seg_n_bytes;
+    data_offset  = 0;
+    is_read_only = read_only;
+    name         = shm_name;
+    
+    return true;
+    }
+  #else
+    {
+    arma_ignore(in_name);
+    arma_ignore(read_only);
+    
+    return false;
+    }
+  #endif
+  }
+
+
+
+inline
+void
+shm_segment::detach()
+  {
+  arma_extra_debug_sigprint();
+  
+  #if defined(ARMA_HAVE_POSIX_SHM)
+    {
+    if(mem != nullptr)  { ::munmap(mem, size_t(n_bytes)); }
+    }
+  #endif
+  
+  mem          = nullptr;
+  n_bytes      = 0;
+  data_offset  = 0;
+  is_read_only = false;
+  }
+
+
+
+//! remove the name of the segment; processes which are still attached keep their mapping
+inline
+bool
+shm_segment::remove()
+  {
+  arma_extra_debug_sigprint();
+  
+  #if defined(ARMA_HAVE_POSIX_SHM)
+    {
+    return (name.length() > 0) && (::shm_unlink(name.c_str()) == 0);
+    }
+  #else
+    {
+    return false;
+    }
+  #endif
+  }
+
+
+
+//! create a segment holding a header and n_rows*n_cols*n_slices elements;
+//! the data is copied from src (if given) before the header is written,
+//! so a process attaching in the meantime sees an invalid header rather than partial data
+inline
+bool
+shm_segment::create_obj(const std::string& in_name, const std::string& magic, const uword in_n_rows, const uword in_n_cols, const uword in_n_slices, const uword elem_size, const void* src)
+  {
+  arma_extra_debug_sigprint();
+  
+  // check that neither n_elem nor the segment size overflow
+  
+  const uword max_uword = std::numeric_limits<uword>::max();
+  
+  const uword n_rows_cols = in_n_rows * in_n_cols;
+  const uword n_elem      = n_rows_cols * in_n_slices;
+  
+  bool size_ok = (in_n_cols == 0) || ( (n_rows_cols / in_n_cols) == in_n_rows );
+  
+  if(size_ok)  { size_ok = (in_n_slices == 0) || ( (n_elem / in_n_slices) == n_rows_cols ); }
+  
+  if(size_ok)  { size_ok = ( n_elem <= ((max_uword - shm_header::data_offset_default) / elem_size) ); }
+  
+  if(size_ok == false)
+    {
+    arma_debug_warn("shm_segment::create_obj(): requested size is too large");
+    return false;
+    }
+  
+  if((*this).create(in_name, shm_header::data_offset_default + n_elem*elem_size) == false)  { return false; }
+  
+  unsigned char* seg_mem = static_cast<unsigned char*>(mem);
+  
+  if( (src != nullptr) && (n_elem > 0) )  { std::memcpy(seg_mem + shm_header::data_offset_default, src, n_elem*elem_size); }
+  
+  shm_header header;
+  
+  std::memset(&header, 0, sizeof(shm_header));
+  
+  header.n_rows      = u64(in_n_rows);
+  header.n_cols      = u64(in_n_cols);
+  header.n_slices    = u64(in_n_slices);
+  header.n_elem      = u64(n_elem);
+  header.data_offset = u64(shm_header::data_offset_default);
+  
+  std::memcpy(seg_mem + sizeof(header.magic), reinterpret_cast<const unsigned char*>(&header) + sizeof(header.magic), sizeof(shm_header) - sizeof(header.magic));
+  
+  std::strncpy(header.magic, magic.c_str(), sizeof(header.magic) - 1);
+  
+  // the magic is written last, and the fence keeps the data and the remaining header fields from being reordered after it
+  std::atomic_thread_fence(std::memory_order_release);
+  
+  std::memcpy(seg_mem, header.magic, sizeof(header.magic));
+  
+  data_offset = shm_header::data_offset_default;
+  
+  return true;
+  }
+
+
+
+inline
+bool
+shm_segment::attach_obj(const std::string& in_name, const std::string& magic, const bool read_only, const uword elem_size, uword& out_n_rows, uword& out_n_cols, uword& out_n_slices)
+  {
+  arma_extra_debug_sigprint();
+  
+  if((*this).attach(in_name, read_only) == false)  { return false; }
+  
+  shm_header header;
+  
+  bool status = (n_bytes >= sizeof(shm_header));
+  
+  if(status)
+    {
+    std::memcpy(header.magic, mem, sizeof(header.magic));
+    
+    header.magic[sizeof(header.magic) - 1] = char(0);
+    
+    status = (magic == header.magic);
+    }
+  
+  if(status)
+    {
+    // pairs with the release fence in create_obj(): the remaining header fields and the data are read only after the magic has been seen
+    std::atomic_thread_fence(std::memory_order_acquire);
+    
+    std::memcpy(reinterpret_cast<unsigned char*>(&header) + sizeof(header.magic), reinterpret_cast<const unsigned char*>(mem) + sizeof(header.magic), sizeof(shm_header) - sizeof(header.magic));
+    }
+  
+  // the header may have been written by another process, so none of its fields are trusted;
+  // the checks are arranged so that they can't overflow
+  
+  if(status)
+    {
+    const u64 max_uword = u64(std::numeric_limits<uword>::max());
+    
+    status = (header.n_rows <= max_uword) && (header.n_cols <= max_uword) && (header.n_slices <= max_uword) && (header.n_elem <= max_uword);
+    }
+  
+  if(status)
+    {
+    // n_rows * n_cols * n_slices must equal n_elem
+    
+    const u64 n_rows_cols = header.n_rows * header.n_cols;
+    
+    status = (header.n_cols == 0) || ( (n_rows_cols / header.n_cols) == header.n_rows );
+    
+    if(status)  { status = (header.n_slices == 0) || ( ((header.n_elem / header.n_slices) == n_rows_cols) && ((header.n_elem % header.n_slices) == 0) ); }
+    
+    if(status)  { status = (header.n_slices != 0) || (header.n_elem == 0); }
+    }
+  
+  if(status)
+    {
+    // the element data must be aligned and must lie within the segment
+    
+    status = (header.data_offset >= sizeof(shm_header)) && ((header.data_offset % 16) == 0) && (header.data_offset <= u64(n_bytes));
+    
+    if(status)  { status = ( header.n_elem <= ((u64(n_bytes) - header.data_offset) / u64(elem_size)) ); }
+    }
+  
+  if(status)
+    {
+    out_n_rows   = uword(header.n_rows);
+    out_n_cols   = uword(header.n_cols);
+    out_n_slices = uword(header.n_slices);
+    data_offset  = uword(header.data_offset);
+    }
+  
+  if(status == false)  { (*this).detach(); }
+  
+  return status;
+  }
+
+
+
+inline
+void*
+shm_segment::data() const
+  {
+  return (mem != nullptr) ? static_cast<void*>(static_cast<unsigned char*>(mem) + data_offset) : nullptr;
+  }
+
+
+
+//
+// shm_mat
+
+
+
+template<typename eT>
+inline
+shm_mat<eT>::shm_mat()
+  {
+  arma_extra_debug_sigprint();
+  }
+
+
+
+template<typename eT>
+inline
+shm_mat<eT>::~shm_mat()
+  {
+  arma_extra_debug_sigprint();
+  
+  (*this).detach();
+  }
+
+
+
+//! create a new segment holding a zero initialised matrix
+template<typename eT>
+inline
+bool
+shm_mat<eT>::create(const std::string& name, const uword n_rows, const uword n_cols)
+  {
+  arma_extra_debug_sigprint();
+  
+  (*this).detach();
+  
+  const std::string magic = diskio::gen_shm_header(diskio::gen_bin_header(Mat<eT>()));
+  
+  if(seg.create_obj(name, magic, n_rows, n_cols, 1, sizeof(eT), nullptr) == false)
+    {
+    arma_debug_warn("shm_mat::create(): couldn't create shared memory segment ", name);
+    return false;
+    }
+  
+  obj = new Mat<eT>(static_cast<eT*>(seg.data()), n_rows, n_cols, false, true);
+  
+  return true;
+  }
+
+
+
+//! create a new segment holding a copy of X
+template<typename eT>
+inline
+bool
+shm_mat<eT>::create(const std::string& name, const Mat<eT>& X)
+  {
+  arma_extra_debug_sigprint();
+  
+  (*this).detach();
+  
+  const std::string magic = diskio::gen_shm_header(diskio::gen_bin_header(X));
+  
+  if(seg.create_obj(name, magic, X.n_rows, X.n_cols, 1, sizeof(eT), X.memptr()) == false)
+    {
+    arma_debug_warn("shm_mat::create(): couldn't create shared memory segment ", name);
+    return false;
+    }
+  
+  obj = new Mat<eT>(static_cast<eT*>(seg.data()), X.n_rows, X.n_cols, false, true);
+  
+  return true;
+  }
+
+
+
+//! attach to an existing segment; the matrix uses the shared memory directly (no copy is made);
+//! if read_only is true, only get() can be used to access the matrix
+template<typename eT>
+inline
+bool
+shm_mat<eT>::attach(const std::string& name, const bool read_only)
+  {
+  arma_extra_debug_sigprint();
+  
+  (*this).detach();
+  
+  const std::string magic = diskio::gen_shm_header(diskio::gen_bin_header(Mat<eT>()));
+  
+  uword n_rows   = 0;
+  uword n_cols   = 0;
+  uword n_slices = 0;
+  
+  if( (seg.attach_obj(name, magic, read_only, sizeof(eT), n_rows, n_cols, n_slices) == false) || (n_slices != 1) )
+    {
+    seg.detach();
+    arma_debug_warn("shm_mat::attach(): couldn't attach to shared memory segment ", name);
+    return false;
+    }
+  
+  obj = new Mat<eT>(static_cast<eT*>(seg.data()), n_rows, n_cols, false, true);
+  
+  return true;
+  }
+
+
+
+template<typename eT>
+inline
+void
+shm_mat<eT>::detach()
+  {
+  arma_extra_debug_sigprint();
+  
+  if(obj != nullptr)  { delete obj; obj = nullptr; }
+  
+  seg.detach();
+  }
+
+
+
+//! remove the segment name, so that no further processes can attach;
+//! the memory is released once all attached processes have detached
+template<typename eT>
+inline
+bool
+shm_mat<eT>::remove()
+  {
+  arma_extra_debug_sigprint();
+  
+  return seg.remove();
+  }
+
+
+
+template<typename eT>
+inline
+bool
+shm_mat<eT>::is_attached() const
+  {
+  return (obj != nullptr);
+  }
+
+
+
+template<typename eT>
+inline
+const Mat<eT>&
+shm_mat<eT>::get() const
+  {
+  arma_debug_check( (obj == nullptr), "shm_mat::get(): not attached to shared memory" );
+  
+  return (*obj);
+  }
+
+
+
+//! writable access; not allowed for segments attached in read-only mode, as they are mapped without write permission
+template<typename eT>
+inline
+Mat<eT>&
+shm_mat<eT>::get_rw()
+  {
+  arma_debug_check( (obj == nullptr), "shm_mat::get_rw(): not attached to shared memory" );
+  
+  arma_check( seg.is_read_only, "shm_mat::get_rw(): shared memory segment is attached in read-only mode" );
+  
+  return (*obj);
+  }
+
+
+
+//
+// shm_cube
+
+
+
+template<typename eT>
+inline
+shm_cube<eT>::shm_cube()
+  {
+  arma_extra_debug_sigprint();
+  }
+
+
+
+template<typename eT>
+inline
+shm_cube<eT>::~shm_cube()
+  {
+  arma_extra_debug_sigprint();
+  
+  (*this).detach();
+  }
+
+
+
+template<typename eT>
+inline
+bool
+shm_cube<eT>::create(const std::string& name, const uword n_rows, const uword n_cols, const uword n_slices)
+  {
+  arma_extra_debug_sigprint();
+  
+  (*this).detach();
+  
+  const std::string magic = diskio::gen_shm_header(diskio::gen_bin_header(Cube<eT>()));
+  
+  if(seg.create_obj(name, magic, n_rows, n_cols, n_slices, sizeof(eT), nullptr) == false)
+    {
+    arma_debug_warn("shm_cube::create(): couldn't create shared memory segment ", name);
+    return false;
+    }
+  
+  obj = new Cube<eT>(static_cast<eT*>(seg.data()), n_rows, n_cols, n_slices, false, true);
+  
+  return true;
+  }
+
+
+
+template<typename eT>
+inline
+bool
+shm_cube<eT>::create(const std::string& name, const Cube<eT>& X)
+  {
+  arma_extra_debug_sigprint();
+  
+  (*this).detach();
+  
+  const std::string magic = diskio::gen_shm_header(diskio::gen_bin_header(X));
+  
+  if(seg.create_obj(name, magic, X.n_rows, X.n_cols, X.n_slices, sizeof(eT), X.memptr()) == false)
+    {
+    arma_debug_warn("shm_cube::create(): couldn't create shared memory segment ", name);
+    return false;
+    }
+  
+  obj = new Cube<eT>(static_cast<eT*>(seg.data()), X.n_rows, X.n_cols, X.n_slices, false, true);
+  
+  return true;
+  }
+
+
+
+template<typename eT>
+inline
+bool
+shm_cube<eT>::attach(const std::string& name, const bool read_only)
+  {
+  arma_extra_debug_sigprint();
+  
+  (*this).detach();
+  
+  const std::string magic = diskio::gen_shm_header(diskio::gen_bin_header(Cube<eT>()));
+  
+  uword n_rows   = 0;
+  uword n_cols   = 0;
+  uword n_slices = 0;
+  
+  if(seg.attach_obj(name, magic, read_only, sizeof(eT), n_rows, n_cols, n_slices) == false)
+    {
+    arma_debug_warn("shm_cube::attach(): couldn't attach to shared memory segment ", name);
+    return false;
+    }
+  
+  obj = new Cube<eT>(static_cast<eT*>(seg.data()), n_rows, n_cols, n_slices, false, true);
+  
+  return true;
+  }
+
+
+
+template<typename eT>
+inline
+void
+shm_cube<eT>::detach()
+  {
+  arma_extra_debug_sigprint();
+  
+  if(obj != nullptr)  { delete obj; obj = nullptr; }
+  
+  seg.detach();
+  }
+
+
+
+template<typename eT>
+inline
+bool
+shm_cube<eT>::remove()
+  {
+  arma_extra_debug_sigprint();
+  
+  return seg.remove();
+  }
+
+
+
+template<typename eT>
+inline
+bool
+shm_cube<eT>::is_attached() const
+  {
+  return (obj != nullptr);
+  }
+
+
+
+template<typename eT>
+inline
+const Cube<eT>&
+shm_cube<eT>::get() const
+  {
+  arma_debug_check( (obj == nullptr), "shm_cube::get(): not attached to shared memory" );
+  
+  return (*obj);
+  }
+
+
+
+//! writable access; not allowed for segments attached in read-only mode, as they are mapped without write permission
+template<typename eT>
+inline
+Cube<eT>&
+shm_cube<eT>::get_rw()
+  {
+  arma_debug_check( (obj == nullptr), "shm_cube::get_rw(): not attached to shared memory" );
+  
+  arma_check( seg.is_read_only, "shm_cube::get_rw(): shared memory segment is attached in read-only mode" );
+  
+  return (*obj);
+  }
+
+
+
+//! @}
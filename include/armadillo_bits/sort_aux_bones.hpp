@@ -0,0 +1,98 @@
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+//! \addtogroup sort_aux
+//! @{
+
+
+
+template<uword n_bytes> struct sort_aux_uint    {                    };
+template<>              struct sort_aux_uint<1> { typedef u8  result; };
+template<>              struct sort_aux_uint<2> { typedef u16 result; };
+template<>              struct sort_aux_uint<4> { typedef u32 result; };
+template<>              struct sort_aux_uint<8> { typedef u64 result; };
+
+
+
+//! element types which can be sorted via their bit patterns (ie. integers and floating point numbers)
+template<typename eT>
+struct sort_aux_radix
+  {
+  static constexpr bool value = \
+       is_cx<eT>::no
+    && ( std::numeric_limits<eT>::is_integer || is_real<eT>::value )
+    && ( (sizeof(eT) == 1) || (sizeof(eT) == 2) || (sizeof(eT) == 4) || (sizeof(eT) == 8) );
+  };
+
+
+
+//! Helper functions for sorting large arrays:
+//! LSD radix sorting of integer and floating point elements,
+//! and parallel merge sorting when OpenMP is enabled
+class sort_aux
+  {
+  public:
+  
+  static constexpr uword radix_threshold       = 2048;   //!< minimum number of elements for radix sorting
+  static constexpr uword radix_index_threshold = 4096;   //!< minimum number of elements for radix sorting of indices
+  static constexpr uword parallel_threshold    = 65536;  //!< minimum number of elements for sorting one array with multiple threads
+  
+  static constexpr uword digit_bits = 11;               //!< number of bits of the keys processed in each radix sort pass
+  static constexpr uword n_buckets  = uword(1) << digit_bits;
+  
+  template<typename eT>
+  static constexpr uword n_passes() { return (8*uword(sizeof(eT)) + digit_bits - 1) / digit_bits; }
+  
+  template<typename eT>
+  inline static void direct_sort(eT* X, const uword N, const uword sort_type);
+  
+  template<typename eT>
+  inline static void serial_sort(eT* X, const uword N, const uword sort_type);
+  
+  template<typename eT>
+  inline static bool radix_sort(eT* X, const uword N, const uword sort_type, const typename enable_if< sort_aux_radix<eT>::value        >::result* junk = nullptr);
+  
+  template<typename eT>
+  inline static bool radix_sort(eT* X, const uword N, const uword sort_type, const typename enable_if< sort_aux_radix<eT>::value == false >::result* junk = nullptr);
+  
+  template<typename eT>
+  inline static bool radix_sort_index(uword* out, const eT* X, const uword N, const uword sort_type, const typename enable_if< sort_aux_radix<eT>::value        >::result* junk = nullptr);
+  
+  template<typename eT>
+  inline static bool radix_sort_index(uword* out, const eT* X, const uword N, const uword sort_type, const typename enable_if< sort_aux_radix<eT>::value == false >::result* junk = nullptr);
+  
+  
+  private:
+  
+  template<typename eT>
+  arma_inline static typename sort_aux_uint<sizeof(eT)>::result encode(const eT val, const uword sort_type);
+  
+  template<typename eT>
+  arma_inline static eT decode(const typename sort_aux_uint<sizeof(eT)>::result key, const uword sort_type);
+  
+  template<typename key_type>
+  inline static void radix_histograms(uword* hist, const key_type* keys, const uword N);
+  
+  template<typename eT, typename comparator>
+  inline static void parallel_sort(eT* X, const uword N, const uword sort_type, const comparator& comp);
+  
+  template<typename eT, typename comparator>
+  inline static uword merge_split(const eT* A, const uword A_n, const eT* B, const uword B_n, const uword pos, const comparator& comp);
+  };
+
+
+
+//! @}
@@ -0,0 +1,429 @@
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+//! \addtogroup sort_aux
+//! @{
+
+
+
+//! sort_type = 0: ascending; sort_type = 1: descending
+template<typename eT>
+inline
+void
+sort_aux::direct_sort(eT* X, const uword N, const uword sort_type)
+  {
+  arma_extra_debug_sigprint();
+  
+  #if defined(ARMA_USE_OPENMP)
+    {
+    if( (N >= sort_aux::parallel_threshold) && mp_gate<eT>::eval(N) && (mp_thread_limit::get() > 1) )
+      {
+      if(sort_type == 0)
+        {
+        arma_lt_comparator<eT> comparator;
+        
+        sort_aux::parallel_sort(X, N, sort_type, comparator);
+        }
+      else
+        {
+        arma_gt_comparator<eT> comparator;
+        
+        sort_aux::parallel_sort(X, N, sort_type, comparator);
+        }
+      
+      return;
+      }
+    }
+  #endif
+  
+  sort_aux::serial_sort(X, N, sort_type);
+  }
+
+
+
+template<typename eT>
+inline
+void
+sort_aux::serial_sort(eT* X, const uword N, const uword sort_type)
+  {
+  arma_extra_debug_sigprint();
+  
+  if( (N >= sort_aux::radix_threshold) && sort_aux::radix_sort(X, N, sort_type) )  { return; }
+  
+  if(sort_type == 0)
+    {
+    arma_lt_comparator<eT> comparator;
+    
+    std::sort(X, X+N, comparator);
+    }
+  else
+    {
+    arma_gt_comparator<eT> comparator;
+    
+    std::sort(X, X+N, comparator);
+    }
+  }
+
+
+
+//! LSD radix sort, using up to 11 bits per pass;
+//! passes where all elements have the same digit are skipped
+template<typename eT>
+inline
+bool
+sort_aux::radix_sort(eT* X, const uword N, const uword sort_type, const typename enable_if< sort_aux_radix<eT>::value >::result* junk)
+  {
+  arma_extra_debug_sigprint();
+  arma_ignore(junk);
+  
+  typedef typename sort_aux_uint<sizeof(eT)>::result key_type;
+  
+  static constexpr uword n_passes = sort_aux::n_passes<eT>();
+  
+  if(N < 2)  { return true; }
+  
+  podarray<key_type> keys(2*N);
+  
+  key_type* src = keys.memptr();
+  key_type* dst = src + N;
+  
+  for(uword i=0; i < N; ++i)  { src[i] = sort_aux::encode(X[i], sort_type); }
+  
+  podarray<uword> hist(sort_aux::n_buckets*n_passes);
+  
+  sort_aux::radix_histograms(hist.memptr(), src, N);
+  
+  for(uword pass=0; pass < n_passes; ++pass)
+    {
+    uword* pass_hist = hist.memptr() + sort_aux::n_buckets*pass;
+    
+    const uword shift = sort_aux::digit_bits*pass;
+    
+    if( pass_hist[ uword((src[0] >> shift) & key_type(sort_aux::n_buckets-1)) ] == N )  { continue; }
+    
+    uword offset = 0;
+    
+    for(uword d=0; d < sort_aux::n_buckets; ++d)  { const uword count = pass_hist[d]; pass_hist[d] = offset; offset += count; }
+    
+    for(uword i=0; i < N; ++i)
+      {
+      const key_type key = src[i];
+      
+      dst[ pass_hist[ uword((key >> shift) & key_type(sort_aux::n_buckets-1)) ]++ ] = key;
+      }
+    
+    std::swap(src, dst);
+    }
+  
+  for(uword i=0; i < N; ++i)  { X[i] = sort_aux::decode<eT>(src[i], sort_type); }
+  
+  return true;
+  }
+
+
+
+template<typename eT>
+inline
+bool
+sort_aux::radix_sort(eT* X, const uword N, const uword sort_type, const typename enable_if< sort_aux_radix<eT>::value == false >::result* junk)
+  {
+  arma_extra_debug_sigprint();
+  arma_ignore(X);
+  arma_ignore(N);
+  arma_ignore(sort_type);
+  arma_ignore(junk);
+  
+  return false;
+  }
+
+
+
+//! stable LSD radix sort of indices, using up to 11 bits per pass;
+//! elements with equal values (including -0 and +0) retain their relative order;
+//! X must not contain NaN
+template<typename eT>
+inline
+bool
+sort_aux::radix_sort_index(uword* out, const eT* X, const uword N, const uword sort_type, const typename enable_if< sort_aux_radix<eT>::value >::result* junk)
+  {
+  arma_extra_debug_sigprint();
+  arma_ignore(junk);
+  
+  typedef typename sort_aux_uint<sizeof(eT)>::result key_type;
+  
+  static constexpr uword n_passes = sort_aux::n_passes<eT>();
+  
+  podarray<key_type> keys(2*N);
+  podarray<uword>    indices(2*N);
+  
+  key_type* src = keys.memptr();
+  key_type* dst = src + N;
+  
+  uword* src_index = indices.memptr();
+  uword* dst_index = src_index + N;
+  
+  for(uword i=0; i < N; ++i)
+    {
+    const eT val = X[i];
+    
+    src[i]       = sort_aux::encode( ((val == eT(0)) ? eT(0) : val), sort_type );
+    src_index[i] = i;
+    }
+  
+  podarray<uword> hist(sort_aux::n_buckets*n_passes);
+  
+  sort_aux::radix_histograms(hist.memptr(), src, N);
+  
+  for(uword pass=0; pass < n_passes; ++pass)
+    {
+    uword* pass_hist = hist.memptr() + sort_aux::n_buckets*pass;
+    
+    const uword shift = sort_aux::digit_bits*pass;
+    
+    if( (N == 0) || (pass_hist[ uword((src[0] >> shift) & key_type(sort_aux::n_buckets-1)) ] == N) )  { continue; }
+    
+    uword offset = 0;
+    
+    for(uword d=0; d < sort_aux::n_buckets; ++d)  { const uword count = pass_hist[d]; pass_hist[d] = offset; offset += count; }
+    
+    for(uword i=0; i < N; ++i)
+      {
+      const key_type key = src[i];
+      
+      const uword pos = pass_hist[ uword((key >> shift) & key_type(sort_aux::n_buckets-1)) ]++;
+      
+      dst[pos]       = key;
+      dst_index[pos] = src_index[i];
+      }
+    
+    std::swap(src,       dst      );
+    std::swap(src_index, dst_index);
+    }
+  
+  arrayops::copy(out, src_index, N);
+  
+  return true;
+  }
+
+
+
+template<typename eT>
+inline
+bool
+sort_aux::radix_sort_index(uword* out, const eT* X, const uword N, const uword sort_type, const typename enable_if< sort_aux_radix<eT>::value == false >::result* junk)
+  {
+  arma_extra_debug_sigprint();
+  arma_ignore(out);
+  arma_ignore(X);
+  arma_ignore(N);
+  arma_ignore(sort_type);
+  arma_ignore(junk);
+  
+  return false;
+  }
+
+
+
+//! map a value to an unsigned integer key, such that the ordering of keys matches the requested ordering of values
+template<typename eT>
+arma_inline
+typename sort_aux_uint<sizeof(eT)>::result
+sort_aux::encode(const eT val, const uword sort_type)
+  {
+  typedef typename sort_aux_uint<sizeof(eT)>::result key_type;
+  
+  const key_type sign_bit = key_type( key_type(1) << (8*sizeof(eT) - 1) );
+  
+  key_type bits;
+  
+  std::memcpy(&bits, &val, sizeof(eT));
+  
+  key_type key = bits;
+  
+  if(is_real<eT>::value)
+    {
+    key = (bits & sign_bit) ? key_type(~bits) : key_type(bits | sign_bit);
+    }
+  else
+  if(std::numeric_limits<eT>::is_signed)
+    {
+    key = key_type(bits ^ sign_bit);
+    }
+  
+  return (sort_type == 0) ? key : key_type(~key);
+  }
+
+
+
+template<typename eT>
+arma_inline
+eT
+sort_aux::decode(const typename sort_aux_uint<sizeof(eT)>::result in_key, const uword sort_type)
+  {
+  typedef typename sort_aux_uint<sizeof(eT)>::result key_type;
+  
+  const key_type sign_bit = key_type( key_type(1) << (8*sizeof(eT) - 1) );
+  
+  const key_type key = (sort_type == 0) ? in_key : key_type(~in_key);
+  
+  key_type bits = key;
+  
+  if(is_real<eT>::value)
+    {
+    bits = (key & sign_bit) ? key_type(key ^ sign_bit) : key_type(~key);
+    }
+  else
+  if(std::numeric_limits<eT>::is_signed)
+    {
+    bits = key_type(key ^ sign_bit);
+    }
+  
+  eT val;
+  
+  std::memcpy(&val, &bits, sizeof(eT));
+  
+  return val;
+  }
+
+
+
+//! obtain the histograms of the digits for all passes, via one read of the keys
+template<typename key_type>
+inline
+void
+sort_aux::radix_histograms(uword* hist, const key_type* keys, const uword N)
+  {
+  arma_extra_debug_sigprint();
+  
+  static constexpr uword n_passes = sort_aux::n_passes<key_type>();
+  
+  arrayops::fill_zeros(hist, sort_aux::n_buckets*n_passes);
+  
+  for(uword i=0; i < N; ++i)
+    {
+    const key_type key = keys[i];
+    
+    for(uword pass=0; pass < n_passes; ++pass)
+      {
+      hist[sort_aux::n_buckets*pass + uword((key >> (sort_aux::digit_bits*pass)) & key_type(sort_aux::n_buckets-1))]++;
+      }
+    }
+  }
+
+
+
+//! sort contiguous chunks in parallel, then merge pairs of sorted chunks until one remains;
+//! each merge is split into parts of equal size via merge_split(), so that all threads are used in each round
+template<typename eT, typename comparator>
+inline
+void
+sort_aux::parallel_sort(eT* X, const uword N, const uword sort_type, const comparator& comp)
+  {
+  arma_extra_debug_sigprint();
+  
+  #if defined(ARMA_USE_OPENMP)
+    {
+    const uword n_threads = uword(mp_thread_limit::get());
+    const uword n_chunks  = n_threads;
+    
+    podarray<uword> bounds(n_chunks+1);
+    
+    for(uword c=0; c <= n_chunks; ++c)  { bounds[c] = (c * N) / n_chunks; }
+    
+    #pragma omp parallel for schedule(static) num_threads(int(n_threads))
+    for(uword c=0; c < n_chunks; ++c)
+      {
+      sort_aux::serial_sort(X + bounds[c], bounds[c+1] - bounds[c], sort_type);
+      }
+    
+    podarray<eT> tmp(N);
+    
+    eT* src = X;
+    eT* dst = tmp.memptr();
+    
+    for(uword width=1; width < n_chunks; width *= 2)
+      {
+      const uword n_pairs        = (n_chunks + 2*width - 1) / (2*width);
+      const uword parts_per_pair = (std::max)(uword(1), n_threads / n_pairs);
+      const uword n_tasks        = n_pairs * parts_per_pair;
+      
+      #pragma omp parallel for schedule(dynamic) num_threads(int(n_threads))
+      for(uword task=0; task < n_tasks; ++task)
+        {
+        const uword pair = task / parts_per_pair;
+        const uword part = task % parts_per_pair;
+        
+        const uword c   = pair * 2 * width;
+        const uword lo  = bounds[c];
+        const uword mid = bounds[(std::min)(c +   width, n_chunks)];
+        const uword hi  = bounds[(std::min)(c + 2*width, n_chunks)];
+        
+        const eT* A = src + lo;
+        const eT* B = src + mid;
+        
+        const uword A_n = mid - lo;
+        const uword B_n = hi  - mid;
+        
+        const uword pos_start = ( part    * (A_n + B_n)) / parts_per_pair;
+        const uword pos_end   = ((part+1) * (A_n + B_n)) / parts_per_pair;
+        
+        const uword A_start = sort_aux::merge_split(A, A_n, B, B_n, pos_start, comp);
+        const uword A_end   = sort_aux::merge_split(A, A_n, B, B_n, pos_end,   comp);
+        
+        std::merge( A + A_start, A + A_end, B + (pos_start - A_start), B + (pos_end - A_end), dst + lo + pos_start, comp );
+        }
+      
+      std::swap(src, dst);
+      }
+    
+    if(src != X)  { arrayops::copy(X, src, N); }
+    }
+  #else
+    {
+    arma_ignore(comp);
+    
+    sort_aux::serial_sort(X, N, sort_type);
+    }
+  #endif
+  }
+
+
+
+//! find how many elements of A precede position pos in the merge of A and B (as performed by std::merge)
+template<typename eT, typename comparator>
+inline
+uword
+sort_aux::merge_split(const eT* A, const uword A_n, const eT* B, const uword B_n, const uword pos, const comparator& comp)
+  {
+  uword lo = (pos > B_n) ? (pos - B_n) : uword(0);
+  uword hi = (std::min)(pos, A_n);
+  
+  while(lo < hi)
+    {
+    const uword i = (lo + hi) / 2;
+    const uword k = pos - i;
+    
+    // std::merge takes A[i] before B[k-1] unless B[k-1] < A[i]
+    
+    if( comp(B[k-1], A[i]) )  { hi = i; }  else  { lo = i+1; }
+    }
+  
+  return lo;
+  }
+
+
+
+//! @}
@@ -34,6 +34,7 @@
   
   namespace arma
     {
+    #include "armadillo_bits/arma_rng_ziggurat.hpp"
     #include "armadillo_bits/arma_rng_cxx11.hpp"
     thread_local arma_rng_cxx11 arma_rng_cxx11_instance;
     }
@@ -1755,6 +1756,11 @@ extern "C"
       return H5Dread(dataset_id, mem_type_id, mem_space_id, file_space_id, xfer_plist_id, buf);
       }
     
+    herr_t arma_H5Dset_extent(hid_t dataset_id, const hsize_t* size)
+      {
+      return H5Dset_extent(dataset_id, size);
+      }
+    
     int arma_H5Sget_simple_extent_ndims(hid_t space_id)
       {
       return H5Sget_simple_extent_ndims(space_id);
@@ -1775,6 +1781,11 @@ extern "C"
       return H5Screate_simple(rank, current_dims, maximum_dims);
       }
     
+    herr_t arma_H5Sselect_hyperslab(hid_t space_id, H5S_seloper_t op, const hsize_t* start, const hsize_t* stride, const hsize_t* count, const hsize_t* block)
+      {
+      return H5Sselect_hyperslab(space_id, op, start, stride, count, block);
+      }
+    
     herr_t arma_H5Ovisit(hid_t object_id, H5_index_t index_type, H5_iter_order_t order, H5O_iterate_t op, void* op_data)
       {
       return H5Ovisit(object_id, index_type, order, op, op_data);
@@ -1835,6 +1846,26 @@ extern "C"
       return H5Ldelete(loc_id, name, lapl_id);
       }
     
+    hid_t arma_H5Pcreate(hid_t cls_id)
+      {
+      return H5Pcreate(cls_id);
+      }
+    
+    herr_t arma_H5Pset_chunk(hid_t plist_id, int ndims, const hsize_t* dim)
+      {
+      return H5Pset_chunk(plist_id, ndims, dim);
+      }
+    
+    herr_t arma_H5Pset_deflate(hid_t plist_id, unsigned level)
+      {
+      return H5Pset_deflate(plist_id, level);
+      }
+    
+    herr_t arma_H5Pclose(hid_t plist_id)
+      {
+      return H5Pclose(plist_id);
+      }
+    
     
     // H5T_NATIVE_* types.  The rhs here expands to some macros.
     hid_t arma_H5T_NATIVE_UCHAR  = H5T_NATIVE_UCHAR;
@@ -1849,6 +1880,8 @@ extern "C"
     hid_t arma_H5T_NATIVE_ULLONG = H5T_NATIVE_ULLONG;
     hid_t arma_H5T_NATIVE_FLOAT  = H5T_NATIVE_FLOAT;
     hid_t arma_H5T_NATIVE_DOUBLE = H5T_NATIVE_DOUBLE;
+    
+    hid_t arma_H5P_DATASET_CREATE = H5P_DATASET_CREATE;
 
   #endif
   
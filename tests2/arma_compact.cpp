@@ -0,0 +1,171 @@
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+#include <cstdio>
+#include <sstream>
+#include <armadillo>
+#include "catch.hpp"
+
+using namespace arma;
+
+
+TEST_CASE("arma_compact_mat")
+  {
+  mat A(300, 200, fill::randn);
+  
+  REQUIRE( A.save("arma_compact_A.bin", arma_compact) );
+  
+  mat B;
+  REQUIRE( B.load("arma_compact_A.bin", arma_compact) );
+  REQUIRE( approx_equal(A, B, "absdiff", 0.0) );
+  
+  mat C;
+  REQUIRE( C.load("arma_compact_A.bin") );  // auto detection
+  REQUIRE( approx_equal(A, C, "absdiff", 0.0) );
+  
+  std::remove("arma_compact_A.bin");
+  
+  // low entropy data must compress
+  imat D = randi<imat>(1000, 1000, distr_param(0, 3));
+  
+  std::stringstream ss1;
+  std::stringstream ss2;
+  
+  REQUIRE( D.save(ss1, arma_binary ) );
+  REQUIRE( D.save(ss2, arma_compact) );
+  REQUIRE( ss2.str().size() < ss1.str().size() / 3 );
+  
+  imat E;
+  REQUIRE( E.load(ss2, arma_compact) );
+  REQUIRE( all(vectorise(D == E)) );
+  
+  cx_mat F(50, 60, fill::randu);
+  
+  std::stringstream ss3;
+  REQUIRE( F.save(ss3, arma_compact) );
+  
+  cx_mat G;
+  REQUIRE( G.load(ss3, arma_compact) );
+  REQUIRE( approx_equal(F, G, "absdiff", 0.0) );
+  
+  mat H;
+  std::stringstream ss4;
+  REQUIRE( H.save(ss4, arma_compact) );
+  REQUIRE( A.load(ss4, arma_compact) );
+  REQUIRE( A.n_elem == 0 );
+  }
+
+
+
+TEST_CASE("arma_compact_cube_spmat")
+  {
+  cube A = round(10 * randu<cube>(40, 50, 60));
+  
+  std::stringstream ss1;
+  REQUIRE( A.save(ss1, arma_compact) );
+  
+  cube B;
+  REQUIRE( B.load(ss1) );
+  REQUIRE( approx_equal(A, B, "absdiff", 0.0) );
+  
+  sp_mat C = sprandu<sp_mat>(1000, 800, 0.01);
+  
+  std::stringstream ss2;
+  REQUIRE( C.save(ss2, arma_compact) );
+  
+  sp_mat D;
+  REQUIRE( D.load(ss2, arma_compact) );
+  REQUIRE( D.n_nonzero == C.n_nonzero );
+  REQUIRE( approx_equal(mat(C), mat(D), "absdiff", 0.0) );
+  }
+
+
+
+TEST_CASE("arma_compact_corrupt")
+  {
+  umat A = randi<umat>(500, 400, distr_param(0, 100));
+  
+  std::stringstream ss;
+  REQUIRE( A.save(ss, arma_compact) );
+  
+  std::string data = ss.str();
+  
+  data[data.size() - 100] ^= 0x55;
+  
+  std::stringstream ss2(data);
+  
+  umat B;
+  REQUIRE( B.load(ss2, arma_compact) == false );
+  
+  // truncated
+  std::stringstream ss3( data.substr(0, data.size()/2) );
+  REQUIRE( B.load(ss3, arma_compact) == false );
+  }
+
+
+
+TEST_CASE("arma_compact_reader")
+  {
+  mat A(1000, 700, fill::randu);  // several blocks of whole columns
+  
+  REQUIRE( A.save("arma_compact_R.bin", arma_compact) );
+  
+  compact_reader<double> reader("arma_compact_R.bin");
+  
+  REQUIRE( reader.is_open() );
+  REQUIRE( reader.n_rows() == A.n_rows );
+  REQUIRE( reader.n_cols() == A.n_cols );
+  REQUIRE( reader.n_blocks() > 1 );
+  
+  mat B;
+  REQUIRE( reader.read_block(B, 1) );
+  
+  const uword N = reader.block_n_cols();
+  REQUIRE( approx_equal(B, A.cols(N, 2*N-1), "absdiff", 0.0) );
+  
+  mat C;
+  REQUIRE( reader.read_cols(C, N-3, 2*N+5) );
+  REQUIRE( approx_equal(C, A.cols(N-3, 2*N+5), "absdiff", 0.0) );
+  
+  REQUIRE( reader.read_cols(C, 0, A.n_cols-1) );
+  REQUIRE( approx_equal(C, A, "absdiff", 0.0) );
+  
+  reader.close();
+  
+  // no rows, so no blocks
+  mat D(0, 5);
+  
+  REQUIRE( D.save("arma_compact_R.bin", arma_compact) );
+  REQUIRE( reader.open("arma_compact_R.bin") );
+  REQUIRE( reader.n_rows() == 0 );
+  REQUIRE( reader.n_cols() == 5 );
+  
+  mat E;
+  REQUIRE( reader.read_cols(E, 0, 0) );
+  REQUIRE( E.n_rows == 0 );
+  REQUIRE( E.n_cols == 1 );
+  
+  REQUIRE( reader.read_cols(E, 1, 4) );
+  REQUIRE( E.n_cols == 4 );
+  
+  REQUIRE( E.load("arma_compact_R.bin", arma_compact) );
+  REQUIRE( E.n_rows == 0 );
+  REQUIRE( E.n_cols == 5 );
+  
+  reader.close();
+  
+  std::remove("arma_compact_R.bin");
+  }
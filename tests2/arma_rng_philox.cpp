@@ -0,0 +1,155 @@
+// Copyright 2015 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2015 National ICT Australia (NICTA)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+#include <armadillo>
+#include "catch.hpp"
+
+using namespace arma;
+
+
+TEST_CASE("arma_rng_philox_1")
+  {
+  // known answers from the Random123 test vectors
+  
+  const u32 key_a[2] = { 0x00000000, 0x00000000 };
+  const u32 ctr_a[4] = { 0x00000000, 0x00000000, 0x00000000, 0x00000000 };
+  
+  const u32 key_b[2] = { 0xa4093822, 0x299f31d0 };
+  const u32 ctr_b[4] = { 0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344 };
+  
+  u32 out_a[4];
+  u32 out_b[4];
+  
+  arma_rng_philox::generate(out_a, key_a, ctr_a, 1);
+  arma_rng_philox::generate(out_b, key_b, ctr_b, 1);
+  
+  REQUIRE( out_a[0] == u32(0x6627e8d5) );
+  REQUIRE( out_a[1] == u32(0xe169c58d) );
+  REQUIRE( out_a[2] == u32(0xbc57ac4c) );
+  REQUIRE( out_a[3] == u32(0x9b00dbd8) );
+  
+  REQUIRE( out_b[0] == u32(0xd16cfe09) );
+  REQUIRE( out_b[1] == u32(0x94fdcceb) );
+  REQUIRE( out_b[2] == u32(0x5001e420) );
+  REQUIRE( out_b[3] == u32(0x24126ea1) );
+  
+  // consecutive blocks are the same when generated one at a time
+  
+  u32 out_c[4*19];
+  
+  arma_rng_philox::generate(out_c, key_b, ctr_b, 19);
+  
+  for(uword k=0; k < 19; ++k)
+    {
+    u32 ctr_k[4] = { ctr_b[0] + u32(k), ctr_b[1], ctr_b[2], ctr_b[3] };
+    u32 out_k[4];
+    
+    arma_rng_philox::generate(out_k, key_b, ctr_k, 1);
+    
+    REQUIRE( out_k[0] == out_c[4*k+0] );
+    REQUIRE( out_k[3] == out_c[4*k+3] );
+    }
+  }
+
+
+
+TEST_CASE("arma_rng_philox_2")
+  {
+  // a large fill (split across threads when OpenMP is enabled)
+  // must equal a sequence of small fills (generated serially)
+  
+  const uword N = 200000;
+  
+  arma_rng_philox rng_a;
+  arma_rng_philox rng_b;
+  
+  rng_a.set_seed(123);
+  rng_b.set_seed(123);
+  
+  vec A(N);
+  vec B(N);
+  
+  rng_a.randn_fill(A.memptr(), N);
+  
+  for(uword i=0; i < N; i += 1000)  { rng_b.randn_fill(B.memptr() + i, 1000); }
+  
+  REQUIRE( accu(A != B) == uword(0) );
+  
+  fvec C(N);
+  fvec D(N);
+  
+  rng_a.randu_fill(C.memptr(), N);
+  
+  for(uword i=0; i < N; i += 4000)  { rng_b.randu_fill(D.memptr() + i, 4000); }
+  
+  REQUIRE( accu(C != D) == uword(0) );
+  
+  // a different seed gives a different stream
+  
+  rng_b.set_seed(124);
+  
+  rng_b.randn_fill(B.memptr(), N);
+  
+  REQUIRE( accu(A == B) < uword(10) );
+  }
+
+
+
+TEST_CASE("arma_rng_philox_3")
+  {
+  const uword N = 200000;
+  
+  arma_rng_philox rng;
+  
+  rng.set_seed(42);
+  
+  vec  U(N);
+  fvec V(N);
+  vec  G(N);
+  ivec I(N);
+  
+  rng.randu_fill(U.memptr(), N);
+  rng.randu_fill(V.memptr(), N);
+  rng.randn_fill(G.memptr(), N);
+  rng.randi_fill(I.memptr(), N, -3, 5);
+  
+  REQUIRE( U.min() >= 0.0 );
+  REQUIRE( U.max() <  1.0 );
+  
+  REQUIRE( mean(U) == Approx(0.5     ).epsilon(0.01) );
+  REQUIRE( var (U) == Approx(1.0/12.0).epsilon(0.02) );
+  
+  REQUIRE( V.min() >= 0.0f );
+  REQUIRE( V.max() <  1.0f );
+  
+  REQUIRE( mean(V) == Approx(0.5f).epsilon(0.01) );
+  
+  REQUIRE( mean(G) == Approx(0.0).margin(0.01) );
+  REQUIRE( var (G) == Approx(1.0).epsilon(0.02) );
+  
+  REQUIRE( I.min() == -3 );
+  REQUIRE( I.max() ==  5 );
+  
+  REQUIRE( double(accu(I == 0)) / double(N) == Approx(1.0/9.0).epsilon(0.05) );
+  
+  // single values
+  
+  double acc = 0.0;
+  
+  for(uword i=0; i < 10000; ++i)  { acc += rng.randu_val(); }
+  
+  REQUIRE( (acc / 10000.0) == Approx(0.5).epsilon(0.02) );
+  
+  REQUIRE( rng.randi_val() >= 0 );
+  }
@@ -0,0 +1,128 @@
+// Copyright 2015 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2015 National ICT Australia (NICTA)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+#include <armadillo>
+#include "catch.hpp"
+
+using namespace arma;
+
+
+namespace
+  {
+  // Kolmogorov-Smirnov statistic of sorted samples against the standard normal distribution
+  double
+  ks_normal(const vec& sorted_x)
+    {
+    const double N = double(sorted_x.n_elem);
+    
+    double D = 0.0;
+    
+    for(uword i=0; i < sorted_x.n_elem; ++i)
+      {
+      const double F = 0.5 * std::erfc( -sorted_x(i) / std::sqrt(2.0) );
+      
+      D = (std::max)( D, (std::max)( F - double(i)/N, double(i+1)/N - F ) );
+      }
+    
+    return D;
+    }
+  }
+
+
+
+TEST_CASE("arma_rng_ziggurat_1")
+  {
+  const uword N = 1000000;
+  
+  const arma_rng_ziggurat& zig = arma_rng_ziggurat::get_tables();
+  
+  std::mt19937_64 engine(12345);
+  
+  vec X(N);
+  
+  zig.fill(X.memptr(), N, engine);
+  
+  const double m  = mean(X);
+  const double v  = var(X);
+  const double sk = mean(pow(X - m, 3)) / std::pow(v, 1.5);
+  const double ku = mean(pow(X - m, 4)) / (v*v);
+  
+  REQUIRE( m  == Approx(0.0).margin(0.005) );
+  REQUIRE( v  == Approx(1.0).epsilon(0.01) );
+  REQUIRE( sk == Approx(0.0).margin(0.02) );
+  REQUIRE( ku == Approx(3.0).epsilon(0.02) );
+  
+  // 1.63/sqrt(N) is the critical value at the 1% level
+  
+  REQUIRE( ks_normal(sort(X)) < (1.63 / std::sqrt(double(N))) );
+  
+  // the tail beyond the base layer (|x| > 3.654) is generated by a separate path
+  
+  const double tail = double(accu(abs(X) > 3.6541528853610088)) / double(N);
+  
+  REQUIRE( tail == Approx(2.58e-4).epsilon(0.25) );
+  
+  // the same distribution is obtained one value at a time
+  
+  vec Y(N/10);
+  
+  for(uword i=0; i < Y.n_elem; ++i)  { Y(i) = zig.sample(engine); }
+  
+  REQUIRE( ks_normal(sort(Y)) < (1.63 / std::sqrt(double(Y.n_elem))) );
+  }
+
+
+
+TEST_CASE("arma_rng_ziggurat_2")
+  {
+  const uword N = 1000000;
+  
+  arma_rng_philox rng;
+  
+  rng.set_seed(2020);
+  
+  vec X(N);
+  
+  rng.randn_fill(X.memptr(), N);
+  
+  REQUIRE( mean(X) == Approx(0.0).margin(0.005) );
+  REQUIRE( var (X) == Approx(1.0).epsilon(0.01) );
+  
+  REQUIRE( ks_normal(sort(X)) < (1.63 / std::sqrt(double(N))) );
+  
+  // uniform numbers from the bits of the generator
+  
+  vec U(N);
+  
+  rng.randu_fill(U.memptr(), N);
+  
+  const vec U_sorted = sort(U);
+  
+  double D = 0.0;
+  
+  for(uword i=0; i < N; ++i)
+    {
+    D = (std::max)( D, (std::max)( U_sorted(i) - double(i)/double(N), double(i+1)/double(N) - U_sorted(i) ) );
+    }
+  
+  REQUIRE( D < (1.63 / std::sqrt(double(N))) );
+  
+  // randn() through the default generator
+  
+  arma_rng::set_seed(7);
+  
+  vec Z = randn<vec>(N);
+  
+  REQUIRE( ks_normal(sort(Z)) < (1.63 / std::sqrt(double(N))) );
+  }
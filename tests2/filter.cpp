@@ -0,0 +1,161 @@
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+#include <armadillo>
+#include "catch.hpp"
+
+using namespace arma;
+
+
+
+TEST_CASE("fir_filter_1")
+  {
+  const uword n_samples = 2000;
+  const uword n_chans   = 5;
+  
+  mat X(n_samples, n_chans, fill::randn);
+  vec h(37, fill::randn);
+  
+  mat Y_ref(n_samples, n_chans);
+  
+  for(uword c=0; c < n_chans; ++c)
+    {
+    const vec tmp = conv(X.col(c), h);
+    
+    Y_ref.col(c) = tmp.head(n_samples);
+    }
+  
+  // blocks of varying size, including blocks shorter than the filter
+  
+  fir_filter<double> F(h);
+  
+  mat Y(n_samples, n_chans);
+  mat out;
+  
+  const uword block_sizes[] = { 1, 10, 36, 37, 500, 16, 1400 };
+  
+  uword start = 0;
+  
+  for(const uword block_size : block_sizes)
+    {
+    F.process(out, X.rows(start, start + block_size - 1));
+    
+    Y.rows(start, start + block_size - 1) = out;
+    
+    start += block_size;
+    }
+  
+  REQUIRE( start == n_samples );
+  REQUIRE( F.n_channels() == n_chans );
+  
+  REQUIRE( approx_equal(Y, Y_ref, "absdiff", 1e-10) );
+  
+  // in-place processing, after clearing the state
+  
+  F.reset();
+  
+  mat Z = X;
+  
+  F.process(Z, Z);
+  
+  REQUIRE( approx_equal(Z, Y_ref, "absdiff", 1e-10) );
+  
+  // complex data
+  
+  cx_vec cx_x(300, fill::randn);
+  cx_vec cx_h(  8, fill::randn);
+  
+  fir_filter<cx_double> G(cx_h);
+  
+  cx_mat cx_a;
+  cx_mat cx_b;
+  
+  G.process(cx_a, cx_x.head(100));
+  G.process(cx_b, cx_x.tail(200));
+  
+  const cx_vec cx_ref = conv(cx_x, cx_h);
+  
+  REQUIRE( approx_equal(join_cols(cx_a, cx_b), cx_mat(cx_ref.head(300)), "absdiff", 1e-10) );
+  }
+
+
+
+TEST_CASE("iir_filter_1")
+  {
+  // two sections, each with poles inside the unit circle
+  mat sos =
+    {
+    { 0.2, 0.4, 0.2, 2.0, -1.0, 0.4 },
+    { 1.0, 2.0, 1.0, 1.0, -0.9, 0.5 }
+    };
+  
+  const uword n_samples = 1000;
+  const uword n_chans   = 11;
+  
+  mat X(n_samples, n_chans, fill::randn);
+  
+  // reference: difference equation of each section, applied in turn
+  
+  mat Y_ref = X;
+  
+  for(uword s=0; s < sos.n_rows; ++s)
+    {
+    const double a0 = sos(s,3);
+    
+    const mat in = Y_ref;
+    
+    for(uword c=0; c < n_chans; ++c)
+    for(uword i=0; i < n_samples; ++i)
+      {
+      double acc = sos(s,0) * in(i,c);
+      
+      if(i >= 1)  { acc += sos(s,1) * in(i-1,c) - sos(s,4) * Y_ref(i-1,c); }
+      if(i >= 2)  { acc += sos(s,2) * in(i-2,c) - sos(s,5) * Y_ref(i-2,c); }
+      
+      Y_ref(i,c) = acc / a0;
+      }
+    }
+  
+  iir_filter<double> F(sos);
+  
+  REQUIRE( F.coeffs()(0,3) == Approx(1.0) );
+  
+  mat A;
+  mat B;
+  
+  F.process(A, X.rows(  0, 399));
+  F.process(B, X.rows(400, 999));
+  
+  REQUIRE( approx_equal(join_cols(A,B), Y_ref, "absdiff", 1e-10) );
+  
+  F.reset();
+  
+  mat Z = X;
+  
+  F.process(Z, Z);
+  
+  REQUIRE( approx_equal(Z, Y_ref, "absdiff", 1e-10) );
+  
+  // single precision, single channel
+  
+  iir_filter<float> G( conv_to<fmat>::from(sos) );
+  
+  fvec y;
+  
+  G.process(y, conv_to<fvec>::from(X.col(0)));
+  
+  REQUIRE( approx_equal(y, conv_to<fvec>::from(Y_ref.col(0)), "absdiff", 1e-4) );
+  }
@@ -44,3 +44,181 @@ TEST_CASE("fn_conv_1")
   
   REQUIRE( accu(abs(c - d)) == Approx(0.0) );
   }
+
+
+
+TEST_CASE("fn_conv_2")
+  {
+  // long filters are done via FFT; compare against the definition
+  for(const uword h_n_elem : { uword(1), uword(7), uword(200), uword(1500) })
+    {
+    vec x(3001, fill::randn);
+    vec h(h_n_elem, fill::randn);
+    
+    vec y_ref(x.n_elem + h.n_elem - 1, fill::zeros);
+    
+    for(uword i=0; i < x.n_elem; ++i)
+    for(uword j=0; j < h.n_elem; ++j)
+      {
+      y_ref(i+j) += x(i) * h(j);
+      }
+    
+    REQUIRE( approx_equal(conv(x,h), y_ref, "absdiff", 1e-9) );
+    REQUIRE( approx_equal(conv(h,x), y_ref, "absdiff", 1e-9) );
+    
+    rowvec xt = x.t();
+    rowvec y2 = conv(xt, h, "same");
+    
+    REQUIRE( approx_equal(y2, rowvec(y_ref.subvec(h.n_elem/2, arma::size(x)).t()), "absdiff", 1e-9) );
+    
+    cx_vec cx_x(x, vec(x.n_elem, fill::randn));
+    cx_vec cx_h(h, vec(h.n_elem, fill::randn));
+    
+    cx_vec cx_y_ref(x.n_elem + h.n_elem - 1, fill::zeros);
+    
+    for(uword i=0; i < x.n_elem; ++i)
+    for(uword j=0; j < h.n_elem; ++j)
+      {
+      cx_y_ref(i+j) += cx_x(i) * cx_h(j);
+      }
+    
+    REQUIRE( approx_equal(conv(cx_x,cx_h), cx_y_ref, "absdiff", 1e-9) );
+    }
+  
+  ivec a = { 1, 2, 3 };
+  ivec b = { 1, 1 };
+  ivec c = { 1, 3, 5, 3 };
+  
+  REQUIRE( all(conv(a,b) == c) );
+  }
+
+
+
+TEST_CASE("fn_conv2_1")
+  {
+  // large kernels are done via FFT; compare against the definition
+  for(const uword k : { uword(3), uword(12), uword(25) })
+    {
+    mat A(90, 70, fill::randn);
+    mat B(k, k+2, fill::randn);
+    
+    mat C_ref(A.n_rows + B.n_rows - 1, A.n_cols + B.n_cols - 1, fill::zeros);
+    
+    for(uword c=0; c < A.n_cols; ++c)
+    for(uword r=0; r < A.n_rows; ++r)
+      {
+      C_ref( r, c, arma::size(B) ) += A(r,c) * B;
+      }
+    
+    REQUIRE( approx_equal(conv2(A,B), C_ref, "absdiff", 1e-9) );
+    
+    mat D = conv2(A, B, "same");
+    
+    REQUIRE( approx_equal(D, mat(C_ref(B.n_rows/2, B.n_cols/2, arma::size(A))), "absdiff", 1e-9) );
+    
+    cx_mat CA(A, mat(A.n_rows, A.n_cols, fill::randn));
+    cx_mat CB(B, mat(B.n_rows, B.n_cols, fill::randn));
+    
+    cx_mat CC_ref(A.n_rows + B.n_rows - 1, A.n_cols + B.n_cols - 1, fill::zeros);
+    
+    for(uword c=0; c < A.n_cols; ++c)
+    for(uword r=0; r < A.n_rows; ++r)
+      {
+      CC_ref( r, c, arma::size(B) ) += CA(r,c) * CB;
+      }
+    
+    REQUIRE( approx_equal(conv2(CA,CB), CC_ref, "absdiff", 1e-9) );
+    }
+  
+  // single row image with a long filter
+  rowvec x(2000, fill::randn);
+  rowvec h(300,  fill::randn);
+  
+  REQUIRE( approx_equal(conv2(x,h), rowvec(conv(x,h)), "absdiff", 1e-9) );
+  }
+
+
+
+TEST_CASE("fn_conv_non_finite")
+  {
+  // a NaN or Inf only affects the outputs which depend on it, even when the FFT would be used for finite data
+  
+  vec x(100000, fill::randn);
+  vec h(256,    fill::randn);
+  
+  x(5000) = Datum<double>::inf;
+  
+  const vec y = conv(x, h);
+  
+  const uvec y_bad = find_nonfinite(y);
+  
+  REQUIRE( y_bad.n_elem == h.n_elem );
+  REQUIRE( y_bad(0)                == 5000 );
+  REQUIRE( y_bad(y_bad.n_elem - 1) == 5000 + h.n_elem - 1 );
+  
+  mat A(300, 300, fill::randn);
+  mat B( 31,  31, fill::randn);
+  
+  A(100,150) = Datum<double>::nan;
+  
+  const mat C = conv2(A, B);
+  
+  umat C_bad(C.n_rows, C.n_cols, fill::zeros);
+  
+  C_bad( 100, 150, arma::size(B) ).ones();
+  
+  REQUIRE( all(vectorise(umat(C != C) == C_bad)) );
+  }
+
+
+
+TEST_CASE("fn_conv_alias")
+  {
+  // the output may be one of the inputs; short filters use direct convolution, long filters use the FFT
+  for(const uword h_n_elem : { uword(7), uword(1500) })
+    {
+    const vec x(3001,     fill::randn);
+    const vec h(h_n_elem, fill::randn);
+    
+    const vec y_ref = conv(x, h);
+    
+    vec a = x;
+    vec b = h;
+    
+    a = conv(a, b);
+    
+    REQUIRE( approx_equal(a, y_ref, "absdiff", 1e-9) );
+    
+    a = x;
+    b = conv(a, b);
+    
+    REQUIRE( approx_equal(b, y_ref, "absdiff", 1e-9) );
+    
+    vec c = join_cols(x, h);
+    
+    c = conv(c.head(x.n_elem), h);
+    
+    REQUIRE( approx_equal(c, y_ref, "absdiff", 1e-9) );
+    }
+  
+  // small kernels use direct convolution, large kernels use the FFT
+  for(const uword k : { uword(3), uword(25) })
+    {
+    const mat A(90, 70,  fill::randn);
+    const mat B(k,  k+2, fill::randn);
+    
+    const mat C_ref = conv2(A, B);
+    
+    mat X = A;
+    mat Y = B;
+    
+    X = conv2(X, Y);
+    
+    REQUIRE( approx_equal(X, C_ref, "absdiff", 1e-9) );
+    
+    X = A;
+    Y = conv2(X, Y);
+    
+    REQUIRE( approx_equal(Y, C_ref, "absdiff", 1e-9) );
+    }
+  }
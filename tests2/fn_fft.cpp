@@ -0,0 +1,270 @@
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+#include <armadillo>
+#include "catch.hpp"
+
+using namespace arma;
+
+
+
+namespace
+  {
+  cx_vec
+  naive_dft(const cx_vec& x, const bool inverse = false)
+    {
+    const uword N = x.n_elem;
+    
+    const double s = (inverse) ? +2.0 : -2.0;
+    
+    cx_vec y(N, fill::zeros);
+    
+    for(uword k=0; k < N; ++k)
+    for(uword n=0; n < N; ++n)
+      {
+      y(k) += x(n) * std::exp( cx_double(0.0, s * datum::pi * double((k*n) % N) / double(N)) );
+      }
+    
+    return (inverse) ? cx_vec(y / double(N)) : y;
+    }
+  }
+
+
+
+TEST_CASE("fn_fft_1")
+  {
+  // lengths with radix 2, 3, 4, 5 and generic (prime) factors
+  const uword lengths[] = { 1, 2, 3, 4, 5, 6, 7, 8, 12, 15, 16, 17, 20, 24, 30, 32, 40, 49, 60, 64, 97, 100, 128, 256, 512, 1024 };
+  
+  for(const uword N : lengths)
+    {
+    cx_vec x(N, fill::randu);
+    
+    const cx_vec y = fft(x);
+    
+    REQUIRE( approx_equal(y, naive_dft(x), "absdiff", 1e-9) );
+    
+    REQUIRE( approx_equal(ifft(y), x, "absdiff", 1e-9) );
+    
+    // repeated calls use a cached plan and must give the same result
+    REQUIRE( approx_equal(fft(x), y, "absdiff", 0.0) );
+    
+    // real input
+    vec xr(N, fill::randu);
+    
+    REQUIRE( approx_equal(fft(xr), naive_dft(conv_to<cx_vec>::from(xr)), "absdiff", 1e-9) );
+    }
+  }
+
+
+
+TEST_CASE("fn_fft_2")
+  {
+  // more lengths than the plan cache holds, so that plans are evicted and rebuilt
+  for(uword rep=0; rep < 2; ++rep)
+  for(uword N=20; N < 60; ++N)
+    {
+    cx_vec x(N, fill::randu);
+    
+    REQUIRE( approx_equal(fft(x), naive_dft(x), "absdiff", 1e-9) );
+    }
+  }
+
+
+
+TEST_CASE("fn_fft_3")
+  {
+  // column-wise transforms of matrices, large enough to use multiple threads
+  const uword N      = 60;
+  const uword n_cols = 37;
+  
+  cx_mat X(N, n_cols, fill::randu);
+     mat Z(N, n_cols, fill::randu);
+  
+  const cx_mat Y  = fft(X);
+  const cx_mat YP = fft(X, N+4);      // zero padding
+  const cx_mat YT = fft(X, N-4);      // truncation
+  const cx_mat YE = fft(2.0*X);       // expression
+  const cx_mat YZ = fft(Z);           // real input
+  const cx_mat YI = ifft(X);
+  
+  REQUIRE( Y.n_rows  == N   );
+  REQUIRE( Y.n_cols  == n_cols );
+  REQUIRE( YP.n_rows == N+4 );
+  REQUIRE( YT.n_rows == N-4 );
+  
+  for(uword c=0; c < n_cols; ++c)
+    {
+    const cx_vec x = X.col(c);
+    
+    REQUIRE( approx_equal(cx_vec(Y.col(c)),  naive_dft(x), "absdiff", 1e-9) );
+    REQUIRE( approx_equal(cx_vec(YE.col(c)), naive_dft(2.0*x), "absdiff", 1e-9) );
+    REQUIRE( approx_equal(cx_vec(YI.col(c)), naive_dft(x, true), "absdiff", 1e-9) );
+    
+    REQUIRE( approx_equal(cx_vec(YP.col(c)), naive_dft(join_cols(x, cx_vec(4, fill::zeros))), "absdiff", 1e-9) );
+    REQUIRE( approx_equal(cx_vec(YT.col(c)), naive_dft(cx_vec(x.head(N-4))), "absdiff", 1e-9) );
+    
+    REQUIRE( approx_equal(cx_vec(YZ.col(c)), naive_dft(conv_to<cx_vec>::from(vec(Z.col(c)))), "absdiff", 1e-9) );
+    }
+  
+  // in-place (aliased) transform
+  cx_mat W = X;
+  
+  W = fft(W);
+  
+  REQUIRE( approx_equal(W, Y, "absdiff", 0.0) );
+  }
+
+
+
+TEST_CASE("fn_fft_4")
+  {
+  // lengths with large prime factors, which use the Bluestein algorithm
+  const uword lengths[] = { 61, 127, 251, 1009, 2018 };
+  
+  for(const uword N : lengths)
+    {
+    cx_vec x(N, fill::randu);
+    
+    const cx_vec y = fft(x);
+    
+    REQUIRE( approx_equal(y, naive_dft(x), "absdiff", 1e-8) );
+    
+    REQUIRE( approx_equal(ifft(y), x, "absdiff", 1e-10) );
+    
+    REQUIRE( approx_equal(ifft(x), naive_dft(x, true), "absdiff", 1e-10) );
+    
+    cx_fvec xf = conv_to<cx_fvec>::from(x);
+    
+    REQUIRE( approx_equal(conv_to<cx_vec>::from(fft(xf)), y, "absdiff", 1e-2) );
+    }
+  
+  // transform of a shifted impulse is a complex exponential
+  const uword N = 10007;
+  const uword j = 1234;
+  
+  cx_vec x(N, fill::zeros);
+  
+  x(j) = cx_double(1.0, 0.0);
+  
+  const cx_vec y = fft(x);
+  
+  cx_vec z(N);
+  
+  for(uword k=0; k < N; ++k)  { z(k) = std::exp( cx_double(0.0, -2.0 * datum::pi * double((j*k) % N) / double(N)) ); }
+  
+  REQUIRE( approx_equal(y, z, "absdiff", 1e-9) );
+  
+  // matrix with columns of prime length
+  cx_mat X(1009, 5, fill::randu);
+  
+  const cx_mat Y = fft(X);
+  
+  for(uword c=0; c < X.n_cols; ++c)
+    {
+    REQUIRE( approx_equal(cx_vec(Y.col(c)), naive_dft(X.col(c)), "absdiff", 1e-8) );
+    }
+  }
+
+
+
+TEST_CASE("fn_fft_5")
+  {
+  // real input: even lengths use a half length complex transform
+  const uword lengths[] = { 2, 3, 4, 6, 8, 10, 12, 14, 16, 18, 30, 64, 98, 100, 122, 254, 2018 };
+  
+  for(const uword N : lengths)
+    {
+    vec x(N, fill::randn);
+    
+    const cx_vec y = fft(x);
+    
+    REQUIRE( y.n_elem == N );
+    
+    REQUIRE( approx_equal(y, naive_dft(conv_to<cx_vec>::from(x)), "absdiff", 1e-8) );
+    
+    REQUIRE( approx_equal(ifft_real(y), x, "absdiff", 1e-10) );
+    
+    // row vector, float, zero padding and truncation
+    rowvec r = x.t();
+    
+    REQUIRE( approx_equal(fft(r), cx_rowvec(y.st()), "absdiff", 1e-12) );
+    
+    fvec xf = conv_to<fvec>::from(x);
+    
+    REQUIRE( approx_equal(conv_to<cx_vec>::from(fft(xf)), y, "absdiff", 1e-3) );
+    
+    REQUIRE( approx_equal(fft(x, N+2), naive_dft(conv_to<cx_vec>::from(vec(join_cols(x, vec(2, fill::zeros))))), "absdiff", 1e-9) );
+    REQUIRE( approx_equal(fft(x, N/2+1), naive_dft(conv_to<cx_vec>::from(vec(x.head(N/2+1)))), "absdiff", 1e-9) );
+    }
+  }
+
+
+
+TEST_CASE("fn_fft_6")
+  {
+  // real output inverse transform, which assumes a conjugate symmetric spectrum
+  for(const uword N : { uword(1), uword(2), uword(5), uword(8), uword(9), uword(40), uword(61), uword(128) })
+    {
+    cx_vec y(N, fill::randu);
+    
+    // make y conjugate symmetric
+    y(0) = cx_double(y(0).real(), 0.0);
+    
+    for(uword k=1; k < N; ++k)  { if(k > N-k) { y(k) = std::conj(y(N-k)); } }
+    
+    if((N % 2) == 0)  { y(N/2) = cx_double(y(N/2).real(), 0.0); }
+    
+    const vec z = ifft_real(y);
+    
+    REQUIRE( z.n_elem == N );
+    
+    REQUIRE( approx_equal(z, vec(real(ifft(y))), "absdiff", 1e-12) );
+    
+    // only the first N/2+1 elements of the input are used
+    cx_vec w = y;
+    
+    for(uword k=N/2+1; k < N; ++k)  { w(k) = cx_double(123.0, 456.0); }
+    
+    REQUIRE( approx_equal(vec(ifft_real(w)), z, "absdiff", 1e-12) );
+    }
+  
+  // matrices are processed column by column
+  mat X(40, 21, fill::randn);
+  
+  const cx_mat Y = fft(X);
+  
+  for(uword c=0; c < X.n_cols; ++c)
+    {
+    REQUIRE( approx_equal(cx_vec(Y.col(c)), naive_dft(conv_to<cx_vec>::from(vec(X.col(c)))), "absdiff", 1e-9) );
+    }
+  
+  REQUIRE( approx_equal(mat(ifft_real(Y)), X, "absdiff", 1e-12) );
+  
+  const mat Z = ifft_real(fft(X, 50));
+  
+  REQUIRE( Z.n_rows == 50 );
+  REQUIRE( approx_equal(Z, mat(real(ifft(fft(X, 50)))), "absdiff", 1e-12) );
+  
+  // odd length matrices
+  mat A(41, 21, fill::randn);
+  
+  REQUIRE( approx_equal(mat(ifft_real(fft(A))), A, "absdiff", 1e-12) );
+  
+  fmat B(64, 3, fill::randn);
+  
+  REQUIRE( approx_equal(fmat(ifft_real(fft(B))), B, "absdiff", 1e-5) );
+  }
@@ -0,0 +1,116 @@
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+#include <armadillo>
+#include "catch.hpp"
+
+using namespace arma;
+
+
+
+TEST_CASE("fn_fft2_1")
+  {
+  // separable definition: transform the columns, then the rows
+  for(const uword n_rows : { uword(1), uword(3), uword(16), uword(37) })
+  for(const uword n_cols : { uword(1), uword(8), uword(30) })
+    {
+    cx_mat X(n_rows, n_cols, fill::randu);
+       mat Z(n_rows, n_cols, fill::randu);
+    
+    cx_mat Y_ref(n_rows, n_cols);
+    
+    for(uword c=0; c < n_cols; ++c)  { Y_ref.col(c) = (n_rows > 1) ? cx_mat(fft(cx_vec(X.col(c)))) : cx_mat(X.col(c)); }
+    for(uword r=0; r < n_rows; ++r)  { Y_ref.row(r) = (n_cols > 1) ? cx_mat(fft(cx_rowvec(Y_ref.row(r)))) : cx_mat(Y_ref.row(r)); }
+    
+    const cx_mat Y = fft2(X);
+    
+    REQUIRE( Y.n_rows == n_rows );
+    REQUIRE( Y.n_cols == n_cols );
+    
+    REQUIRE( approx_equal(Y, Y_ref, "absdiff", 1e-10) );
+    
+    REQUIRE( approx_equal(ifft2(Y), X, "absdiff", 1e-12) );
+    
+    // real input
+    REQUIRE( approx_equal(fft2(Z), fft2(cx_mat(conv_to<cx_mat>::from(Z))), "absdiff", 1e-10) );
+    }
+  
+  // vectors are transformed once along their length
+  rowvec r = { 1.0, 2.0, 3.0, 4.0 };
+  
+  REQUIRE( approx_equal(cx_mat(fft2(r)), cx_mat(fft(r)), "absdiff", 1e-12) );
+  REQUIRE( approx_equal(cx_mat(fft2(r.t())), cx_mat(fft(vec(r.t()))), "absdiff", 1e-12) );
+  
+  // zero padding
+  mat A(10, 12, fill::randu);
+  
+  mat B(16, 16, fill::zeros);
+  
+  B.submat(0, 0, 9, 11) = A;
+  
+  REQUIRE( approx_equal(fft2(A, 16, 16), fft2(B), "absdiff", 1e-10) );
+  
+  // large enough to use multiple threads when OpenMP is enabled
+  cx_mat C(128, 96, fill::randu);
+  
+  REQUIRE( approx_equal(ifft2(fft2(C)), C, "absdiff", 1e-12) );
+  }
+
+
+
+TEST_CASE("fn_fft3_1")
+  {
+  for(const uword n_rows   : { uword(1), uword(4), uword(9) })
+  for(const uword n_cols   : { uword(1), uword(6) })
+  for(const uword n_slices : { uword(1), uword(5), uword(16) })
+    {
+    cx_cube Q(n_rows, n_cols, n_slices, fill::randu);
+    
+    // reference: 2D transform of each slice, then transform along the slices
+    cx_cube R(n_rows, n_cols, n_slices);
+    
+    for(uword s=0; s < n_slices; ++s)  { R.slice(s) = fft2(Q.slice(s)); }
+    
+    if(n_slices > 1)
+      {
+      for(uword r=0; r < n_rows; ++r)
+      for(uword c=0; c < n_cols; ++c)
+        {
+        cx_vec tube = R.tube(r,c);
+        
+        R.tube(r,c) = fft(tube);
+        }
+      }
+    
+    const cx_cube F = fft3(Q);
+    
+    REQUIRE( approx_equal(F, R, "absdiff", 1e-10) );
+    
+    REQUIRE( approx_equal(ifft3(F), Q, "absdiff", 1e-12) );
+    
+    cube P(n_rows, n_cols, n_slices, fill::randu);
+    
+    cx_cube Pc(n_rows, n_cols, n_slices);
+    
+    for(uword i=0; i < P.n_elem; ++i)  { Pc[i] = cx_double(P[i], 0.0); }
+    
+    REQUIRE( approx_equal(fft3(P), fft3(Pc), "absdiff", 1e-10) );
+    }
+  
+  fcube G(8, 8, 8, fill::randu);
+  
+  REQUIRE( approx_equal(real(ifft3(fft3(G))), G, "absdiff", 1e-5) );
+  }
@@ -96,3 +96,29 @@ TEST_CASE("fn_find_unique_2")
   
   // REQUIRE_THROWS(  );
   }
+
+
+
+TEST_CASE("fn_find_unique_3")
+  {
+  // large integer vector with few distinct values, which uses the hash-based implementation
+  
+  const uvec A = randi<uvec>(50000, distr_param(0, 999));
+  
+  const uvec indices = find_unique(A);
+  
+  REQUIRE( indices.n_elem == 1000 );
+  
+  REQUIRE( indices.is_sorted("strictascend") );
+  
+  REQUIRE( all(sort(A.elem(indices)) == regspace<uvec>(0, 999)) );
+  
+  // each index refers to the first occurrence
+  
+  for(uword i=0; i < indices.n_elem; ++i)
+    {
+    const uvec pos = find(A == A(indices(i)), 1);
+    
+    REQUIRE( indices(i) == pos(0) );
+    }
+  }
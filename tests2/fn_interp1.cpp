@@ -51,3 +51,158 @@ TEST_CASE("fn_interp1_1")
   
   // REQUIRE_THROWS(  );
   }
+
+
+
+TEST_CASE("fn_interp1_2")
+  {
+  // non-uniform grid with unsorted data
+  
+  vec x = { 0.0, 0.3, 1.1, 1.5, 2.6, 3.0, 4.2, 5.0 };
+  vec y = 0.5*pow(x,3) - x%x + 2.0*x - 1.0;
+  
+  uvec perm = { 3, 0, 7, 5, 1, 6, 2, 4 };
+  
+  vec xs = x(perm);
+  vec ys = y(perm);
+  
+  vec xi = linspace<vec>(-0.5, 5.5, 601);
+  
+  uvec idx = sort_index(randu<vec>(xi.n_elem));
+  
+  vec xi_shuffled = xi(idx);
+  
+  vec ref = 0.5*pow(xi,3) - xi%xi + 2.0*xi - 1.0;
+  
+  const uvec inside = find( (xi >= 0.0) && (xi <= 5.0) );
+  const uvec outside = find( (xi <  0.0) || (xi >  5.0) );
+  
+  // spline with not-a-knot end conditions reproduces a cubic polynomial
+  
+  vec yi;
+  
+  interp1(xs, ys, xi, yi, "spline");
+  
+  REQUIRE( max(abs( yi(inside) - ref(inside) )) == Approx(0.0).margin(1e-10) );
+  
+  REQUIRE( yi(outside).is_finite() == false );
+  
+  // query order does not matter
+  
+  for(const char* method : { "nearest", "linear", "cubic", "spline" })
+    {
+    vec yi_a;
+    vec yi_b;
+    vec yi_c;
+    
+    interp1(x,  y,  xi,          yi_a, method, 0.0);
+    interp1(xs, ys, xi_shuffled, yi_b, method, 0.0);
+    interp1(x,  y,  xi_shuffled, yi_c, method, 0.0);
+    
+    REQUIRE( yi_a(inside).is_finite() );
+    
+    REQUIRE( accu(abs( yi_b - yi_c )) == Approx(0.0).margin(1e-12) );
+    
+    REQUIRE( accu(abs( yi_c - yi_a(idx) )) == Approx(0.0).margin(1e-12) );
+    
+    REQUIRE( accu(abs( yi_a(outside) )) == Approx(0.0) );
+    }
+  
+  // linear interpolation is exact at the grid points and midway between them
+  
+  vec yi_l;
+  
+  interp1(x, y, x, yi_l, "linear");
+  
+  REQUIRE( accu(abs( yi_l - y )) == Approx(0.0).margin(1e-12) );
+  
+  vec xm = 0.5 * (x.head(7) + x.tail(7));
+  
+  interp1(x, y, xm, yi_l, "*linear");
+  
+  REQUIRE( accu(abs( yi_l - 0.5*(y.head(7) + y.tail(7)) )) == Approx(0.0).margin(1e-12) );
+  
+  // nearest neighbour
+  
+  vec yi_n;
+  
+  interp1(x, y, vec({ 0.1, 0.2, 1.4, 4.9 }), yi_n, "nearest");
+  
+  REQUIRE( yi_n(0) == Approx(y(0)) );
+  REQUIRE( yi_n(1) == Approx(y(1)) );
+  REQUIRE( yi_n(2) == Approx(y(3)) );
+  REQUIRE( yi_n(3) == Approx(y(7)) );
+  }
+
+
+
+TEST_CASE("fn_interp1_3")
+  {
+  // pchip preserves monotonicity of the data
+  
+  vec x = { 1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0 };
+  vec y = { 0.0, 0.1, 0.1, 5.0, 5.1, 5.1, 9.0, 9.0 };
+  
+  vec xi = linspace<vec>(1.0, 8.0, 1001);
+  
+  vec yi_p;
+  vec yi_s;
+  
+  interp1(x, y, xi, yi_p, "pchip");
+  interp1(x, y, xi, yi_s, "spline");
+  
+  REQUIRE( all( diff(yi_p) >= -1e-12 ) );
+  REQUIRE( any( diff(yi_s) <  -1e-3  ) );  // spline overshoots
+  
+  REQUIRE( yi_p.min() >= -1e-12 );
+  REQUIRE( yi_p.max() <= (9.0 + 1e-12) );
+  
+  // interpolants pass through the data
+  
+  vec yi;
+  
+  interp1(x, y, x, yi, "pchip");
+  
+  REQUIRE( accu(abs( yi - y )) == Approx(0.0).margin(1e-12) );
+  
+  interp1(x, y, x, yi, "spline");
+  
+  REQUIRE( accu(abs( yi - y )) == Approx(0.0).margin(1e-12) );
+  
+  // two points: all methods reduce to linear interpolation
+  
+  vec x2 = { 1.0, 3.0 };
+  vec y2 = { 2.0, 6.0 };
+  
+  interp1(x2, y2, vec({ 1.5, 2.0 }), yi, "spline");
+  
+  REQUIRE( yi(0) == Approx(3.0) );
+  REQUIRE( yi(1) == Approx(4.0) );
+  
+  interp1(x2, y2, vec({ 1.5, 2.0 }), yi, "pchip");
+  
+  REQUIRE( yi(0) == Approx(3.0) );
+  REQUIRE( yi(1) == Approx(4.0) );
+  }
+
+
+
+TEST_CASE("fn_interp1_4")
+  {
+  // X with NaN is rejected rather than treated as sorted
+  
+  vec x  = { 1.0, 2.0, 3.0, datum::nan };
+  vec y  = { 10.0, 20.0, 30.0, 40.0 };
+  vec xi = { 1.0, 1.5, 2.5 };
+  
+  vec yi;
+  
+  // throws unless ARMA_NO_DEBUG is defined
+  REQUIRE_THROWS( interp1(x, y, xi, yi) );
+  
+  // NaN in the middle of X
+  
+  vec x2 = { 1.0, 2.0, datum::nan, 3.0 };
+  
+  REQUIRE_THROWS( interp1(x2, y, xi, yi) );
+  }
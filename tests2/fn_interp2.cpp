@@ -0,0 +1,105 @@
+// Copyright 2015 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2015 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+#include <armadillo>
+#include "catch.hpp"
+
+using namespace arma;
+
+
+TEST_CASE("fn_interp2_1")
+  {
+  vec x = { 0.0, 0.5, 1.2, 2.0, 2.5, 3.1, 4.0 };
+  vec y = linspace<vec>(-1.0, 2.0, 9);
+  
+  // Z(r,c) = f(y(r), x(c))
+  
+  mat Z(y.n_elem, x.n_elem);
+  
+  for(uword c=0; c < x.n_elem; ++c)
+  for(uword r=0; r < y.n_elem; ++r)
+    {
+    Z(r,c) = 1.0 + 2.0*x(c) - y(r) + 0.5*x(c)*y(r);
+    }
+  
+  vec xi = linspace<vec>(-0.5, 4.5, 37);
+  vec yi = linspace<vec>(-1.5, 2.5, 23);
+  
+  mat ref(yi.n_elem, xi.n_elem);
+  
+  for(uword c=0; c < xi.n_elem; ++c)
+  for(uword r=0; r < yi.n_elem; ++r)
+    {
+    const bool inside = (xi(c) >= 0.0) && (xi(c) <= 4.0) && (yi(r) >= -1.0) && (yi(r) <= 2.0);
+    
+    ref(r,c) = (inside) ? (1.0 + 2.0*xi(c) - yi(r) + 0.5*xi(c)*yi(r)) : -7.0;
+    }
+  
+  // bilinear surface is reproduced exactly by linear, cubic and spline interpolation
+  
+  for(const char* method : { "linear", "cubic", "spline" })
+    {
+    mat zi;
+    
+    interp2(x, y, Z, xi, yi, zi, method, -7.0);
+    
+    REQUIRE( zi.n_rows == yi.n_elem );
+    REQUIRE( zi.n_cols == xi.n_elem );
+    
+    REQUIRE( max(max(abs( zi - ref ))) == Approx(0.0).margin(1e-10) );
+    }
+  
+  // query points in arbitrary order
+  
+  vec xi_r = flipud(xi);
+  
+  mat zi_r;
+  
+  interp2(x, y, Z, xi_r, yi, zi_r, "spline", -7.0);
+  
+  REQUIRE( max(max(abs( fliplr(zi_r) - ref ))) == Approx(0.0).margin(1e-10) );
+  
+  // nearest neighbour at the grid points
+  
+  mat zi_n;
+  
+  interp2(x, y, Z, x, y, zi_n, "nearest");
+  
+  REQUIRE( accu(abs( zi_n - Z )) == Approx(0.0) );
+  }
+
+
+
+TEST_CASE("fn_interp2_2")
+  {
+  // grids with NaN are not monotonically increasing
+  
+  vec x = { 0.0, 1.0, datum::nan, 3.0 };
+  vec y = { 0.0, 1.0, 2.0 };
+  
+  mat Z(y.n_elem, x.n_elem, fill::randu);
+  
+  vec xi = { 0.5, 1.5 };
+  vec yi = { 0.5, 1.5 };
+  
+  mat zi;
+  
+  // throws unless ARMA_NO_DEBUG is defined
+  REQUIRE_THROWS( interp2(x, y, Z, xi, yi, zi) );
+  
+  vec x2 = { 0.0, 1.0, 2.0, 3.0 };
+  vec y2 = { 0.0, 1.0, datum::nan };
+  
+  REQUIRE_THROWS( interp2(x2, y2, Z, xi, yi, zi) );
+  }
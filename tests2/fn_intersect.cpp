@@ -99,3 +99,47 @@ TEST_CASE("fn_intersect_3")
   
   REQUIRE_THROWS( C = intersect(A,B) );
   }
+
+
+
+TEST_CASE("fn_intersect_4")
+  {
+  // large integer vectors with few distinct values, which use the hash-based implementation
+  
+  const ivec A = randi<ivec>(20000, distr_param(-100, 300));
+  const ivec B = randi<ivec>(30000, distr_param( 200, 900));
+  
+  ivec C;
+  uvec iA;
+  uvec iB;
+  
+  intersect(C, iA, iB, A, B);
+  
+  REQUIRE( C.n_elem == 101 );
+  
+  REQUIRE( all(C == regspace<ivec>(200, 300)) );
+  
+  REQUIRE( all(A.elem(iA) == C) );
+  REQUIRE( all(B.elem(iB) == C) );
+  
+  // indices refer to the first occurrences
+  
+  for(uword i=0; i < C.n_elem; ++i)
+    {
+    const uvec A_pos = find(A == C(i), 1);
+    const uvec B_pos = find(B == C(i), 1);
+    
+    REQUIRE( iA(i) == A_pos(0) );
+    REQUIRE( iB(i) == B_pos(0) );
+    }
+  
+  const ivec D = intersect(A, B);
+  
+  REQUIRE( all(D == C) );
+  
+  // same result as the sort-based implementation for floating point elements
+  
+  const vec E = intersect( conv_to<vec>::from(A), conv_to<vec>::from(B) );
+  
+  REQUIRE( all(E == conv_to<vec>::from(C)) );
+  }
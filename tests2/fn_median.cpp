@@ -0,0 +1,123 @@
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+#include <armadillo>
+#include "catch.hpp"
+
+using namespace arma;
+
+
+TEST_CASE("fn_median_1")
+  {
+  const mat A =
+    "\
+     0.061198   0.201990   0.019678  -0.493936  -0.126745;\
+     0.437242   0.058956  -0.149362  -0.045465   0.296153;\
+    -0.492474  -0.031309   0.314156   0.419733   0.068317;\
+     0.336352   0.411541   0.458476  -0.393139  -0.135040;\
+    ";
+  
+  const rowvec med_cols = median(A);
+  const colvec med_rows = median(A,1);
+  
+  const rowvec med_cols_ref = { 0.1987750,  0.1304730,  0.1669170, -0.2193020, -0.0292140 };
+  const colvec med_rows_ref = { 0.019678, 0.058956, 0.068317, 0.336352 };
+  
+  REQUIRE( approx_equal(med_cols, med_cols_ref, "absdiff", 1e-6) );
+  REQUIRE( approx_equal(med_rows, med_rows_ref, "absdiff", 1e-6) );
+  
+  REQUIRE( median(A.col(1)) == Approx(0.1304730) );
+  }
+
+
+
+TEST_CASE("fn_median_2")
+  {
+  // large enough to use multiple threads, if available
+  
+  mat A = randn<mat>(1001, 300);
+  
+  rowvec med_cols = median(A);
+  colvec med_rows = median(A,1);
+  
+  REQUIRE( med_cols.n_elem == A.n_cols );
+  REQUIRE( med_rows.n_elem == A.n_rows );
+  
+  for(uword col=0; col < A.n_cols; ++col)
+    {
+    const vec tmp = sort(A.col(col));
+    
+    REQUIRE( med_cols(col) == Approx(tmp(500)) );
+    }
+  
+  for(uword row=0; row < A.n_rows; ++row)
+    {
+    const rowvec tmp = sort(A.row(row));
+    
+    REQUIRE( med_rows(row) == Approx(0.5*(tmp(149) + tmp(150))) );
+    }
+  
+  // aliasing
+  
+  mat B = A;
+  
+  B = median(B,1);
+  
+  REQUIRE( approx_equal(vectorise(B), med_rows, "absdiff", 1e-12) );
+  }
+
+
+
+TEST_CASE("fn_median_cube")
+  {
+  cube C = randn<cube>(20, 30, 7);
+  
+  const cube med_0 = median(C);
+  const cube med_1 = median(C,1);
+  const cube med_2 = median(C,2);
+  
+  REQUIRE( med_0.n_rows   ==  1 );
+  REQUIRE( med_0.n_cols   == 30 );
+  REQUIRE( med_0.n_slices ==  7 );
+  
+  REQUIRE( med_1.n_rows   == 20 );
+  REQUIRE( med_1.n_cols   ==  1 );
+  REQUIRE( med_1.n_slices ==  7 );
+  
+  REQUIRE( med_2.n_rows   == 20 );
+  REQUIRE( med_2.n_cols   == 30 );
+  REQUIRE( med_2.n_slices ==  1 );
+  
+  for(uword s=0; s < C.n_slices; ++s)
+    {
+    REQUIRE( approx_equal(med_0.slice(s), mat(median(C.slice(s))),   "absdiff", 1e-12) );
+    REQUIRE( approx_equal(med_1.slice(s), mat(median(C.slice(s),1)), "absdiff", 1e-12) );
+    }
+  
+  for(uword r=0; r < C.n_rows; ++r)
+  for(uword c=0; c < C.n_cols; ++c)
+    {
+    const vec tube = C.tube(r,c);
+    
+    REQUIRE( med_2(r,c,0) == Approx(median(tube)) );
+    }
+  
+  // aliasing
+  
+  C = median(C,2);
+  
+  REQUIRE( approx_equal(C, med_2, "absdiff", 1e-12) );
+  }
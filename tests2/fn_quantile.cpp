@@ -0,0 +1,129 @@
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+#include <armadillo>
+#include "catch.hpp"
+
+using namespace arma;
+
+
+TEST_CASE("fn_quantile_1")
+  {
+  const vec V = linspace<vec>(1, 10, 10);
+  
+  const vec P = { 0.0, 0.25, 0.5, 0.75, 1.0 };
+  
+  const vec Q = quantile(V, P);
+  
+  const vec Q_ref = { 1.0, 3.0, 5.5, 8.0, 10.0 };
+  
+  REQUIRE( approx_equal(Q, Q_ref, "absdiff", 1e-12) );
+  
+  // order of P does not matter
+  
+  const vec P2 = { 0.75, 0.0, 0.5, 1.0, 0.25 };
+  
+  const vec Q2 = quantile(V, P2);
+  
+  const vec Q2_ref = { 8.0, 1.0, 5.5, 10.0, 3.0 };
+  
+  REQUIRE( approx_equal(Q2, Q2_ref, "absdiff", 1e-12) );
+  
+  // P exactly at the upper limit of interpolation: (N - 0.5)/N
+  
+  const vec P3 = { 0.95 };
+  
+  const vec Q3 = quantile(V, P3);
+  
+  REQUIRE( Q3(0) == Approx(10.0) );
+  }
+
+
+
+TEST_CASE("fn_quantile_2")
+  {
+  const mat A = randn<mat>(501, 200);
+  
+  const vec P = { 0.9, 0.1, 0.5, 0.5, 0.3, 0.31, 0.999, 0.0 };
+  
+  const mat Q0 = quantile(A, P);
+  const mat Q1 = quantile(A, P, 1);
+  
+  REQUIRE( Q0.n_rows == P.n_elem );
+  REQUIRE( Q0.n_cols == A.n_cols );
+  
+  REQUIRE( Q1.n_rows == A.n_rows );
+  REQUIRE( Q1.n_cols == P.n_elem );
+  
+  // compare with quantiles of each column or row obtained separately, one element of P at a time
+  
+  for(uword i=0; i < P.n_elem; ++i)
+    {
+    const vec P_i = { P(i) };
+    
+    for(uword col=0; col < A.n_cols; ++col)
+      {
+      const vec tmp = quantile(A.col(col), P_i);
+      
+      REQUIRE( Q0(i,col) == Approx(tmp(0)) );
+      }
+    
+    for(uword row=0; row < A.n_rows; ++row)
+      {
+      const rowvec tmp = quantile(A.row(row), P_i);
+      
+      REQUIRE( Q1(row,i) == Approx(tmp(0)) );
+      }
+    }
+  
+  REQUIRE( approx_equal(Q0.row(2), median(A), "absdiff", 1e-12) );
+  }
+
+
+
+TEST_CASE("fn_quantile_nan")
+  {
+  // all quantiles of a column or row with NaN are NaN; the other columns or rows are not affected
+  
+  mat A = randn<mat>(300, 40);
+  
+  A(7,  1) = datum::nan;
+  A(3,  2) = datum::nan;
+  A(299,2) = datum::nan;
+  
+  const vec P = { 0.0, 0.1, 0.5, 0.9, 1.0 };
+  
+  const mat Q0 = quantile(A,     P);
+  const mat Q1 = quantile(A.t(), P, 1);
+  
+  for(uword col=0; col < A.n_cols; ++col)
+    {
+    const uword n_nan_expected = ((col == 1) || (col == 2)) ? P.n_elem : uword(0);
+    
+    const uvec nan_Q0 = find_nonfinite(Q0.col(col));
+    const uvec nan_Q1 = find_nonfinite(Q1.row(col));
+    
+    REQUIRE( nan_Q0.n_elem == n_nan_expected );
+    REQUIRE( nan_Q1.n_elem == n_nan_expected );
+    }
+  
+  const vec V = A.col(1);
+  
+  const vec Q = quantile(V, P);
+  
+  REQUIRE( Q.has_nan() );
+  REQUIRE( all(Q != Q) );
+  }
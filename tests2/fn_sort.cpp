@@ -0,0 +1,176 @@
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+#include <armadillo>
+#include "catch.hpp"
+
+using namespace arma;
+
+
+template<typename eT>
+static
+bool
+check_sorted_vs_std(const Col<eT>& A)
+  {
+  std::vector<eT> ref_asc(A.begin(), A.end());
+  std::vector<eT> ref_dsc(A.begin(), A.end());
+  
+  std::sort(ref_asc.begin(), ref_asc.end());
+  std::sort(ref_dsc.begin(), ref_dsc.end(), std::greater<eT>());
+  
+  const Col<eT> B = sort(A);
+  const Col<eT> C = sort(A, "descend");
+  
+  bool ok = (B.n_elem == A.n_elem) && (C.n_elem == A.n_elem);
+  
+  for(uword i=0; ok && (i < A.n_elem); ++i)
+    {
+    ok = (B(i) == ref_asc[i]) && (C(i) == ref_dsc[i]);
+    }
+  
+  return ok;
+  }
+
+
+
+TEST_CASE("fn_sort_1")
+  {
+  const vec A = { 3.0, -1.0, 2.0, 0.0, -5.0, 4.0 };
+  
+  const vec B = sort(A);
+  const vec C = sort(A, "descend");
+  
+  const vec B_ref = { -5.0, -1.0, 0.0, 2.0, 3.0, 4.0 };
+  const vec C_ref = { 4.0, 3.0, 2.0, 0.0, -1.0, -5.0 };
+  
+  REQUIRE( approx_equal(B, B_ref, "absdiff", 0.0) );
+  REQUIRE( approx_equal(C, C_ref, "absdiff", 0.0) );
+  }
+
+
+
+TEST_CASE("fn_sort_radix")
+  {
+  // large enough to use radix sorting
+  
+  vec A = 1000.0 * randn<vec>(10000);
+  
+  A(0) =  Datum<double>::inf;
+  A(1) = -Datum<double>::inf;
+  A(2) =  0.0;
+  A(3) = -0.0;
+  A(4) =  std::numeric_limits<double>::denorm_min();
+  A(5) = -std::numeric_limits<double>::denorm_min();
+  
+  REQUIRE( check_sorted_vs_std(A) );
+  
+  REQUIRE( check_sorted_vs_std( conv_to<fvec>::from(A)            ) );
+  REQUIRE( check_sorted_vs_std( randi<ivec>(10000, distr_param(-50000, 50000)) ) );
+  REQUIRE( check_sorted_vs_std( randi<uvec>(10000, distr_param(0, 1000000)) ) );
+  REQUIRE( check_sorted_vs_std( conv_to< Col<s32> >::from(randi<ivec>(10000, distr_param(-1000, 1000))) ) );
+  REQUIRE( check_sorted_vs_std( conv_to< Col<u8>  >::from(randi<uvec>(10000, distr_param(0, 255)))      ) );
+  
+  // very large vector, which may be sorted by multiple threads
+  
+  const vec D = randu<vec>(200001);
+  
+  REQUIRE( check_sorted_vs_std(D) );
+  
+  const cx_vec E = randu<cx_vec>(200001);
+  
+  const cx_vec E_sorted = sort(E);
+  
+  REQUIRE( abs(E_sorted).eval().is_sorted() );
+  }
+
+
+
+TEST_CASE("fn_sort_dim")
+  {
+  const mat A = randn<mat>(300, 200);
+  
+  const mat B = sort(A);
+  const mat C = sort(A, "descend", 1);
+  
+  for(uword col=0; col < A.n_cols; ++col)
+    {
+    REQUIRE( approx_equal(B.col(col), sort(A.col(col)), "absdiff", 0.0) );
+    }
+  
+  for(uword row=0; row < A.n_rows; ++row)
+    {
+    REQUIRE( approx_equal(C.row(row), sort(A.row(row), "descend"), "absdiff", 0.0) );
+    }
+  }
+
+
+
+TEST_CASE("fn_sort_index_radix")
+  {
+  // many ties, to check that the order of equal elements is retained
+  
+  const uvec A = randi<uvec>(5000, distr_param(0, 50));
+  const vec  B = conv_to<vec>::from(A) - 25.0;
+  
+  std::vector<uword> ref(A.n_elem);
+  
+  for(uword i=0; i < A.n_elem; ++i)  { ref[i] = i; }
+  
+  std::vector<uword> ref_asc = ref;
+  std::vector<uword> ref_dsc = ref;
+  
+  std::stable_sort(ref_asc.begin(), ref_asc.end(), [&](const uword a, const uword b) { return B(a) < B(b); });
+  std::stable_sort(ref_dsc.begin(), ref_dsc.end(), [&](const uword a, const uword b) { return B(a) > B(b); });
+  
+  const uvec idx_asc   = stable_sort_index(B);
+  const uvec idx_dsc   = stable_sort_index(B, "descend");
+  const uvec idx_asc_u = stable_sort_index(A);
+  
+  REQUIRE( idx_asc.n_elem == A.n_elem );
+  
+  bool ok = true;
+  
+  for(uword i=0; i < A.n_elem; ++i)
+    {
+    ok = ok && (idx_asc(i) == ref_asc[i]) && (idx_dsc(i) == ref_dsc[i]) && (idx_asc_u(i) == ref_asc[i]);
+    }
+  
+  REQUIRE( ok );
+  
+  const uvec idx = sort_index(B);
+  
+  REQUIRE( B.elem(idx).eval().is_sorted() );
+  
+  // -0 and +0 are equal
+  
+  vec C(1000, fill::zeros);
+  
+  for(uword i=0; i < C.n_elem; i += 2)  { C(i) = -0.0; }
+  
+  const uvec idx_C = stable_sort_index(C);
+  
+  REQUIRE( all(idx_C == regspace<uvec>(0, C.n_elem-1)) );
+  
+  // NaN is detected
+  
+  vec D = randu<vec>(1000);
+  
+  D(500) = Datum<double>::nan;
+  
+  uvec idx_D;
+  
+  REQUIRE_THROWS( idx_D = sort_index(D) );
+  }
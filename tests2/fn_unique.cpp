@@ -0,0 +1,118 @@
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+#include <armadillo>
+#include "catch.hpp"
+
+using namespace arma;
+
+
+TEST_CASE("fn_unique_1")
+  {
+  const vec A = { 3.0, 1.0, 2.0, 3.0, 1.0, 5.0 };
+  
+  const vec B = unique(A);
+  const vec C = unique(A, "stable");
+  
+  const vec B_ref = { 1.0, 2.0, 3.0, 5.0 };
+  const vec C_ref = { 3.0, 1.0, 2.0, 5.0 };
+  
+  REQUIRE( all(B == B_ref) );
+  REQUIRE( all(C == C_ref) );
+  
+  const rowvec D = unique(A.t(), "stable");
+  
+  REQUIRE( all(D == C_ref.t()) );
+  
+  const mat X = { { 4.0, 2.0 }, { 2.0, 3.0 } };
+  
+  const vec Y = unique(X, "stable");
+  
+  const vec Y_ref = { 4.0, 2.0, 3.0 };
+  
+  REQUIRE( all(Y == Y_ref) );
+  }
+
+
+
+TEST_CASE("fn_unique_2")
+  {
+  // large integer vectors; few distinct values use the hash-based implementation,
+  // while many distinct values use the sort-based implementation
+  
+  const ivec A = randi<ivec>(100000, distr_param(-500, 500));
+  const ivec B = randi<ivec>(100000, distr_param(-100000000, 100000000));
+  
+  const ivec A_uniq = unique(A);
+  const ivec B_uniq = unique(B);
+  
+  REQUIRE( all(A_uniq == regspace<ivec>(-500, 500)) );
+  
+  REQUIRE( B_uniq.is_sorted("strictascend") );
+  
+  REQUIRE( all(B_uniq == unique(conv_to<vec>::from(B))) );
+  
+  // first-occurrence order
+  
+  const ivec A_stable = unique(A, "stable");
+  
+  REQUIRE( A_stable.n_elem == A_uniq.n_elem );
+  
+  uvec first_pos(A_stable.n_elem);
+  
+  for(uword i=0; i < A_stable.n_elem; ++i)
+    {
+    const uvec pos = find(A == A_stable(i), 1);
+    
+    first_pos(i) = pos(0);
+    }
+  
+  REQUIRE( first_pos.is_sorted("strictascend") );
+  
+  const vec A_stable_f = unique(conv_to<vec>::from(A), "stable");
+  
+  REQUIRE( all(A_stable_f == conv_to<vec>::from(A_stable)) );
+  }
+
+
+
+TEST_CASE("fn_unique_3")
+  {
+  // default order must be sorted, even when the input is large and in non-sorted first-occurrence order
+  
+  const ivec r = regspace<ivec>(50000, -1, 0);
+  const ivec J = join_cols(r, r);
+  
+  REQUIRE( J.n_elem > uword(hash_aux::threshold) );
+  
+  const ivec J_uniq = unique(J);
+  
+  REQUIRE( J_uniq.is_sorted("strictascend") );
+  REQUIRE( all(J_uniq == regspace<ivec>(0, 50000)) );
+  
+  const ivec K = randi<ivec>(100000, distr_param(-50, 50));
+  
+  const ivec K_uniq = unique(K);
+  
+  REQUIRE( all(K_uniq == unique(K, "sorted")) );
+  REQUIRE( K_uniq.is_sorted("strictascend") );
+  
+  const imat M = reshape(J, 1000, 101);
+  
+  const ivec M_uniq = unique(M);
+  
+  REQUIRE( all(M_uniq == regspace<ivec>(0, 50000)) );
+  }
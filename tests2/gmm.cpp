@@ -205,3 +205,391 @@ TEST_CASE("gmm_diag_1")
   
   REQUIRE( success == true );
   }
+
+
+
+/**
+ * Make sure that the blocked evaluation used for matrices in gmm_full
+ * matches the evaluation of individual vectors.
+ */
+TEST_CASE("gmm_full_blocked_log_p")
+  {
+  const uword dims      = 5;
+  const uword gaussians = 4;
+  
+  mat means(dims, gaussians, fill::randn);
+  
+  cube fcovs(dims, dims, gaussians);
+  
+  for(uword g = 0; g < gaussians; ++g)
+    {
+    const mat A(dims, dims, fill::randu);
+    
+    fcovs.slice(g) = A * A.t() + 0.5 * eye<mat>(dims, dims);
+    }
+  
+  rowvec hefts = { 0.1, 0.2, 0.3, 0.4 };
+  
+  gmm_full model;
+  model.set_params(means, fcovs, hefts);
+  
+  // more samples than a single block, and not a multiple of the block size
+  mat data(dims, 1000, fill::randn);
+  data *= 2.0;
+  
+  const rowvec log_p   = model.log_p(data);
+  const rowvec log_p_2 = model.log_p(data, uword(2));
+  const urowvec labels = model.assign(data, prob_dist);
+  
+  REQUIRE( log_p.n_elem == data.n_cols );
+  
+  for(uword i = 0; i < data.n_cols; ++i)
+    {
+    const vec x = data.col(i);
+    
+    REQUIRE( log_p(i)   == Approx(model.log_p(x)) );
+    REQUIRE( log_p_2(i) == Approx(model.log_p(x, uword(2))) );
+    REQUIRE( labels(i)  == model.assign(x, prob_dist) );
+    }
+  
+  REQUIRE( model.sum_log_p(data) == Approx(accu(log_p)) );
+  REQUIRE( model.avg_log_p(data) == Approx(mean(log_p)) );
+  
+  const urowvec hist = model.raw_hist(data, prob_dist);
+  
+  for(uword g = 0; g < gaussians; ++g)
+    {
+    REQUIRE( hist(g) == uword(accu(labels == g)) );
+    }
+  }
+
+
+
+/**
+ * Make sure that the blocked evaluation used for matrices in gmm_diag
+ * matches the evaluation of individual vectors.
+ */
+TEST_CASE("gmm_diag_blocked_log_p")
+  {
+  const uword dims      = 7;
+  const uword gaussians = 12;
+  
+  // offset from the origin, to exercise the centring of the blocked expansion
+  mat means(dims, gaussians, fill::randn);
+  means += 100.0;
+  
+  mat dcovs(dims, gaussians, fill::randu);
+  dcovs += 0.1;
+  
+  rowvec hefts(gaussians, fill::randu);
+  hefts /= accu(hefts);
+  
+  gmm_diag model;
+  model.set_params(means, dcovs, hefts);
+  
+  // more samples than a single block, and not a multiple of the block size
+  mat data(dims, 1000, fill::randn);
+  data *= 2.0;
+  data += 100.0;
+  
+  const rowvec  log_p        = model.log_p(data);
+  const urowvec labels_prob  = model.assign(data, prob_dist);
+  const urowvec labels_eucl  = model.assign(data, eucl_dist);
+  
+  REQUIRE( log_p.n_elem == data.n_cols );
+  
+  for(uword i = 0; i < data.n_cols; ++i)
+    {
+    const vec x = data.col(i);
+    
+    REQUIRE( log_p(i)       == Approx(model.log_p(x)) );
+    REQUIRE( labels_prob(i) == model.assign(x, prob_dist) );
+    REQUIRE( labels_eucl(i) == model.assign(x, eucl_dist) );
+    }
+  
+  REQUIRE( model.sum_log_p(data) == Approx(accu(log_p)) );
+  REQUIRE( model.avg_log_p(data) == Approx(mean(log_p)) );
+  
+  const urowvec hist_prob = model.raw_hist(data, prob_dist);
+  const urowvec hist_eucl = model.raw_hist(data, eucl_dist);
+  
+  for(uword g = 0; g < gaussians; ++g)
+    {
+    REQUIRE( hist_prob(g) == uword(accu(labels_prob == g)) );
+    REQUIRE( hist_eucl(g) == uword(accu(labels_eucl == g)) );
+    }
+  
+  // fewer samples than needed for the blocked evaluation
+  
+  const mat small = data.cols(0, 9);
+  
+  REQUIRE( approx_equal(model.log_p(small), log_p.cols(0, 9), "reldiff", 1e-10) );
+  }
+
+
+
+/**
+ * Make sure that stepwise EM over batches recovers the parameters of two
+ * well separated Gaussians, and that a saved model can resume training.
+ */
+TEST_CASE("gmm_learn_batch")
+  {
+  const uword dims      = 4;
+  const uword batchSize = 500;
+  
+  vec mean0(dims, fill::zeros);
+  vec mean1(dims, fill::zeros);  mean1 += 6.0;
+  
+  // each batch has 1/4 of the samples from mean0, and 3/4 from mean1
+  auto gen_batch = [&]()
+    {
+    mat batch(dims, batchSize, fill::randn);
+    
+    for(uword i = 0; i < batchSize; ++i)
+      {
+      batch.col(i) += ((i % 4) == 0) ? mean0 : mean1;
+      }
+    
+    return batch;
+    };
+  
+  gmm_diag model_diag;
+  gmm_full model_full;
+  
+  const mat first = gen_batch();
+  
+  REQUIRE( model_diag.learn(first, 2, maha_dist, static_subset, 5, 0, 1e-10, false) );
+  REQUIRE( model_full.learn(first, 2, maha_dist, static_subset, 5, 0, 1e-10, false) );
+  
+  for(uword batch_id = 0; batch_id < 50; ++batch_id)
+    {
+    const mat batch = gen_batch();
+    
+    REQUIRE( model_diag.learn_batch(batch, batch_id, 1e-10) );
+    REQUIRE( model_full.learn_batch(batch, batch_id, 1e-10) );
+    }
+  
+  const uword g0_diag = (model_diag.means(0,0) < model_diag.means(0,1)) ? 0 : 1;
+  const uword g0_full = (model_full.means(0,0) < model_full.means(0,1)) ? 0 : 1;
+  
+  REQUIRE( model_diag.hefts(g0_diag) == Approx(0.25).epsilon(0.05) );
+  REQUIRE( model_full.hefts(g0_full) == Approx(0.25).epsilon(0.05) );
+  
+  for(uword d = 0; d < dims; ++d)
+    {
+    REQUIRE( model_diag.means(d,   g0_diag) == Approx(0.0).margin(0.2) );
+    REQUIRE( model_diag.means(d, 1-g0_diag) == Approx(6.0).margin(0.2) );
+    REQUIRE( model_diag.dcovs(d,   g0_diag) == Approx(1.0).epsilon(0.2) );
+    
+    REQUIRE( model_full.means(d,   g0_full) == Approx(0.0).margin(0.2) );
+    REQUIRE( model_full.means(d, 1-g0_full) == Approx(6.0).margin(0.2) );
+    REQUIRE( model_full.fcovs(d,d, g0_full) == Approx(1.0).epsilon(0.2) );
+    }
+  
+  // the model parameters are sufficient to resume training
+  
+  REQUIRE( model_diag.save("gmm_learn_batch.gmm") );
+  
+  gmm_diag model_resumed;
+  REQUIRE( model_resumed.load("gmm_learn_batch.gmm") );
+  
+  const mat batch = gen_batch();
+  
+  REQUIRE( model_diag.learn_batch(batch, 50, 1e-10) );
+  REQUIRE( model_resumed.learn_batch(batch, 50, 1e-10) );
+  
+  REQUIRE( approx_equal(model_diag.means, model_resumed.means, "absdiff", 1e-10) );
+  REQUIRE( approx_equal(model_diag.dcovs, model_resumed.dcovs, "absdiff", 1e-10) );
+  REQUIRE( approx_equal(model_diag.hefts, model_resumed.hefts, "absdiff", 1e-10) );
+  
+  std::remove("gmm_learn_batch.gmm");
+  }
+
+
+
+/**
+ * Make sure that the bounds used by kmeans() to skip distance calculations
+ * give the same means as a direct implementation of Lloyd's algorithm.
+ */
+TEST_CASE("kmeans_accelerated")
+  {
+  const uword dims    = 3;
+  const uword n_means = 40;
+  const uword n_iter  = 8;
+  
+  const mat centres = 20.0 * randu<mat>(dims, 10);
+  
+  mat data(dims, 2000, fill::randn);
+  
+  for(uword i = 0; i < data.n_cols; ++i)  { data.col(i) += centres.col(i % 10); }
+  
+  mat initial = data.cols(0, n_means-1);
+  
+  // Lloyd's algorithm, with ties resolved in favour of the mean with the lowest index
+  mat expected = initial;
+  
+  for(uword iter = 0; iter < n_iter; ++iter)
+    {
+    mat  sums(dims, n_means, fill::zeros);
+    uvec counts(n_means, fill::zeros);
+    
+    for(uword i = 0; i < data.n_cols; ++i)
+      {
+      uword  best = 0;
+      double best_dist = datum::inf;
+      
+      for(uword g = 0; g < n_means; ++g)
+        {
+        const double dist = accu(square(data.col(i) - expected.col(g)));
+        
+        if(dist < best_dist)  { best_dist = dist; best = g; }
+        }
+      
+      sums.col(best) += data.col(i);
+      counts(best)++;
+      }
+    
+    REQUIRE( all(counts > 0) );
+    
+    for(uword g = 0; g < n_means; ++g)  { expected.col(g) = sums.col(g) / double(counts(g)); }
+    }
+  
+  mat means = initial;
+  
+  REQUIRE( kmeans(means, data, n_means, keep_existing, n_iter, false) );
+  
+  REQUIRE( approx_equal(means, expected, "absdiff", 1e-10) );
+  }
+
+
+
+/**
+ * Make sure that k-means++ and k-means|| seeding find well separated clusters.
+ */
+TEST_CASE("kmeans_seed_plusplus")
+  {
+  const uword dims    = 2;
+  const uword n_means = 5;
+  
+  mat centres(dims, n_means);
+  
+  for(uword g = 0; g < n_means; ++g)  { centres(0,g) = 100.0 * g;  centres(1,g) = -50.0 * g; }
+  
+  mat data(dims, 1000, fill::randn);
+  
+  for(uword i = 0; i < data.n_cols; ++i)  { data.col(i) += centres.col(i % n_means); }
+  
+  mat means_pp;
+  mat means_scalable;
+  
+  REQUIRE( kmeans(means_pp,       data, n_means, random_plusplus, 10, false) );
+  REQUIRE( kmeans(means_scalable, data, n_means, random_scalable, 10, false) );
+  
+  for(uword g = 0; g < n_means; ++g)
+    {
+    double min_pp       = datum::inf;
+    double min_scalable = datum::inf;
+    
+    for(uword h = 0; h < n_means; ++h)
+      {
+      min_pp       = (std::min)(min_pp,       norm(centres.col(g) - means_pp.col(h)));
+      min_scalable = (std::min)(min_scalable, norm(centres.col(g) - means_scalable.col(h)));
+      }
+    
+    REQUIRE( min_pp       < 0.5 );
+    REQUIRE( min_scalable < 0.5 );
+    }
+  
+  gmm_diag model;
+  
+  REQUIRE( model.learn(data, n_means, eucl_dist, random_plusplus, 10, 0, 1e-10, false) );
+  REQUIRE( model.n_gaus() == n_means );
+  }
+
+
+
+/**
+ * Make sure that mini-batch k-means finds well separated clusters, with
+ * batches drawn from a matrix, from a file in arma_compact format and from
+ * a user supplied function.
+ */
+TEST_CASE("kmeans_minibatch")
+  {
+  const uword dims    = 4;
+  const uword n_means = 4;
+  
+  mat centres(dims, n_means, fill::zeros);
+  
+  for(uword g = 0; g < n_means; ++g)  { centres(g,g) = 50.0; }
+  
+  mat data(dims, 100000, fill::randn);
+  
+  for(uword i = 0; i < data.n_cols; ++i)  { data.col(i) += centres.col(i % n_means); }
+  
+  auto check_means = [&](const mat& means)
+    {
+    REQUIRE( means.n_rows == dims    );
+    REQUIRE( means.n_cols == n_means );
+    
+    for(uword g = 0; g < n_means; ++g)
+      {
+      double min_dist = datum::inf;
+      
+      for(uword h = 0; h < n_means; ++h)  { min_dist = (std::min)(min_dist, norm(centres.col(g) - means.col(h))); }
+      
+      REQUIRE( min_dist < 0.2 );
+      }
+    };
+  
+  mat means_mat;
+  
+  REQUIRE( kmeans_minibatch(means_mat, data, n_means, random_plusplus, 100, 500, false) );
+  
+  check_means(means_mat);
+  
+  REQUIRE( data.save("kmeans_minibatch.bin", arma_compact) );
+  
+  compact_reader<double> reader("kmeans_minibatch.bin");
+  
+  REQUIRE( reader.is_open() );
+  
+  mat means_reader;
+  
+  REQUIRE( kmeans_minibatch(means_reader, reader, n_means, random_plusplus, 100, 500, false) );
+  
+  check_means(means_reader);
+  
+  reader.close();
+  
+  std::remove("kmeans_minibatch.bin");
+  
+  // consecutive batches of 1000 samples, until the data is exhausted
+  
+  uword next_col = 0;
+  
+  auto get_batch = [&](mat& batch)
+    {
+    if(next_col >= data.n_cols)  { return false; }
+    
+    batch = data.cols(next_col, next_col + 999);
+    
+    next_col += 1000;
+    
+    return true;
+    };
+  
+  mat means_func;
+  
+  REQUIRE( kmeans_minibatch(means_func, get_batch, n_means, random_plusplus, 1000, false) );
+  REQUIRE( next_col == data.n_cols );
+  
+  check_means(means_func);
+  
+  // continuing from existing means
+  
+  mat means_keep = centres + 1.0;
+  
+  REQUIRE( kmeans_minibatch(means_keep, data, n_means, keep_existing, 100, 500, false) );
+  
+  REQUIRE( approx_equal(means_keep, centres, "absdiff", 0.2) );
+  }
@@ -844,4 +844,119 @@ TEST_CASE("hdf5_dataset_same_dataset_twice_test")
   std::remove("file.h5");
   }
 
+
+
+
+TEST_CASE("hdf5_subset_mat_test")
+  {
+  arma::Mat<double> a;
+  a.randu(30, 40);
+
+  a.save( hdf5_name("file.h5", "dataset") );
+
+  // Load a block of rows and columns.
+  arma::Mat<double> b;
+  REQUIRE( b.load( hdf5_name("file.h5", "dataset", hdf5_opts::subset(span(2,9), span(5,14))) ) );
+
+  REQUIRE( b.n_rows == 8  );
+  REQUIRE( b.n_cols == 10 );
+  REQUIRE( approx_equal(b, a.submat(2,5,9,14), "absdiff", 0.0) );
+
+  // Load a set of whole columns, with conversion to another element type.
+  arma::Mat<float> c;
+  REQUIRE( c.load( hdf5_name("file.h5", "dataset", hdf5_opts::subset(span::all, span(20,39))) ) );
+
+  REQUIRE( c.n_rows == 30 );
+  REQUIRE( c.n_cols == 20 );
+  REQUIRE( approx_equal(conv_to<mat>::from(c), a.cols(20,39), "absdiff", 1e-6) );
+
+  // Subset outside of the dataset.
+  arma::Mat<double> d;
+  REQUIRE_FALSE( d.load( hdf5_name("file.h5", "dataset", hdf5_opts::subset(span(0,30), span::all)) ) );
+  REQUIRE( d.n_elem == 0 );
+
+  std::remove("file.h5");
+  }
+
+
+
+TEST_CASE("hdf5_subset_cube_test")
+  {
+  arma::Cube<double> a;
+  a.randu(6, 7, 8);
+
+  a.save( hdf5_name("file.h5", "dataset") );
+
+  arma::Cube<double> b;
+  REQUIRE( b.load( hdf5_name("file.h5", "dataset", hdf5_opts::subset(span(1,3), span::all, span(2,4))) ) );
+
+  REQUIRE( b.n_rows   == 3 );
+  REQUIRE( b.n_cols   == 7 );
+  REQUIRE( b.n_slices == 3 );
+  REQUIRE( approx_equal(b, a.subcube(span(1,3), span::all, span(2,4)), "absdiff", 0.0) );
+
+  std::remove("file.h5");
+  }
+
+
+
+TEST_CASE("hdf5_chunked_deflate_test")
+  {
+  arma::Mat<double> a(100, 50);
+  a.zeros();
+  a.col(3).fill(1.0);
+
+  REQUIRE( a.save( hdf5_name("file.h5", "dataset", hdf5_opts::chunk(100, 10) + hdf5_opts::deflate(9)) ) );
+
+  arma::Mat<double> b;
+  REQUIRE( b.load( hdf5_name("file.h5", "dataset") ) );
+  REQUIRE( approx_equal(a, b, "absdiff", 0.0) );
+
+  arma::Cube<float> c(5, 6, 7, fill::randu);
+
+  REQUIRE( c.save( hdf5_name("file.h5", "dataset", hdf5_opts::deflate()) ) );
+
+  arma::Cube<float> d;
+  REQUIRE( d.load( hdf5_name("file.h5", "dataset") ) );
+  REQUIRE( approx_equal(c, d, "absdiff", 0.0f) );
+
+  std::remove("file.h5");
+  }
+
+
+
+TEST_CASE("hdf5_extend_test")
+  {
+  arma::Mat<double> a(10, 3, fill::randu);
+  arma::Mat<double> b(10, 4, fill::randu);
+  arma::Mat<double> c(11, 4, fill::randu);
+
+  // First save creates an extendible dataset; second save extends it.
+  REQUIRE( a.save( hdf5_name("file.h5", "dataset", hdf5_opts::extend) ) );
+  REQUIRE( b.save( hdf5_name("file.h5", "dataset", hdf5_opts::extend) ) );
+
+  // Incompatible number of rows.
+  REQUIRE_FALSE( c.save( hdf5_name("file.h5", "dataset", hdf5_opts::extend) ) );
+
+  arma::Mat<double> d;
+  REQUIRE( d.load( hdf5_name("file.h5", "dataset") ) );
+  REQUIRE( approx_equal(d, join_rows(a, b), "absdiff", 0.0) );
+
+  // Extend a cube dataset stored alongside the matrix.
+  arma::Cube<double> e(3, 4, 2, fill::randu);
+  arma::Cube<double> f(3, 4, 5, fill::randu);
+
+  REQUIRE( e.save( hdf5_name("file.h5", "cube", hdf5_opts::extend + hdf5_opts::deflate()) ) );
+  REQUIRE( f.save( hdf5_name("file.h5", "cube", hdf5_opts::extend) ) );
+
+  arma::Cube<double> g;
+  REQUIRE( g.load( hdf5_name("file.h5", "cube", hdf5_opts::subset(span::all, span::all, span(2,6))) ) );
+  REQUIRE( approx_equal(g, f, "absdiff", 0.0) );
+
+  // Chunks of 4 GB or more are rejected.
+  REQUIRE_FALSE( a.save( hdf5_name("file.h5", "big_chunk", hdf5_opts::chunk(10, uword(1) << 30) + hdf5_opts::extend) ) );
+
+  std::remove("file.h5");
+  }
+
 #endif
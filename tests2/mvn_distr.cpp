@@ -0,0 +1,152 @@
+// Copyright 2015 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2015 National ICT Australia (NICTA)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+#include <armadillo>
+#include "catch.hpp"
+
+using namespace arma;
+
+
+namespace
+  {
+  double
+  ref_log_p(const vec& x, const vec& m, const mat& C)
+    {
+    const vec d = x - m;
+    
+    return -0.5 * ( double(x.n_elem) * std::log(2.0 * datum::pi) + std::log(det(C)) + as_scalar(d.t() * solve(C, d)) );
+    }
+  }
+
+
+
+TEST_CASE("mvn_distr_1")
+  {
+  arma_rng::set_seed(1);
+  
+  const uword d = 4;
+  
+  mat B(d, d, fill::randu);
+  mat C = B.t() * B + 0.5 * eye(d,d);
+  
+  mat M(d, 7, fill::randn);
+  
+  M.col(3) += 20.0;  // a mean far from the others
+  
+  mvn_distr<double> mvn(M, C);
+  
+  REQUIRE( mvn.n_dims()  == d );
+  REQUIRE( mvn.n_means() == 7 );
+  
+  mat X(d, 11, fill::randn);
+  
+  X.col(5) = M.col(3) + 0.01;
+  
+  // batch evaluation for all pairs of points and means
+  
+  const mat L = mvn.log_p(X);
+  
+  REQUIRE( L.n_rows == 7  );
+  REQUIRE( L.n_cols == 11 );
+  
+  for(uword k=0; k < M.n_cols; ++k)
+  for(uword i=0; i < X.n_cols; ++i)
+    {
+    REQUIRE( L(k,i) == Approx(ref_log_p(X.col(i), M.col(k), C)).epsilon(1e-10) );
+    }
+  
+  // one point with many means, and many points with one mean
+  
+  const mat L1 = mvn.log_p(X.col(5));
+  
+  REQUIRE( L1.n_rows == 7 );
+  REQUIRE( L1.n_cols == 1 );
+  
+  REQUIRE( accu(abs( L1 - L.col(5) )) == Approx(0.0).margin(1e-9) );
+  
+  const rowvec L2 = mvn.log_p(X, 3);
+  
+  REQUIRE( accu(abs( L2 - L.row(3) )) == Approx(0.0).margin(1e-9) );
+  
+  // changing the means keeps the covariance
+  
+  mvn.set_means(M.col(0));
+  
+  const rowvec L3 = mvn.log_p(X);
+  
+  REQUIRE( accu(abs( L3 - L.row(0) )) == Approx(0.0).margin(1e-9) );
+  
+  // covariance which is not positive definite
+  
+  mat C_bad = C;
+  
+  C_bad(0,0) = -1.0;
+  
+  REQUIRE( mvn.set_cov(C_bad) == false );
+  
+  REQUIRE( accu(abs( mvn.cov - C )) == Approx(0.0) );
+  
+  REQUIRE_THROWS( mvn_distr<double>(M, C_bad) );
+  }
+
+
+
+TEST_CASE("mvn_distr_2")
+  {
+  arma_rng::set_seed(2);
+  
+  mat C = { { 2.0, 0.6, -0.3 },
+            { 0.6, 1.0,  0.2 },
+            {-0.3, 0.2,  0.5 } };
+  
+  mat M = { { 1.0, -5.0 },
+            { 2.0,  0.0 },
+            { 3.0,  5.0 } };
+  
+  mvn_distr<double> mvn(M, C);
+  
+  const uword N = 100000;
+  
+  const mat X = mvn.generate(N);
+  
+  REQUIRE( X.n_rows == 3     );
+  REQUIRE( X.n_cols == 2*N   );
+  
+  for(uword k=0; k < 2; ++k)
+    {
+    const mat Xk = X.cols(k*N, k*N + N-1);
+    
+    REQUIRE( accu(abs( mean(Xk,1) - M.col(k) )) == Approx(0.0).margin(0.03) );
+    
+    REQUIRE( abs(cov(Xk.t()) - C).max() == Approx(0.0).margin(0.03) );
+    }
+  
+  const mat Y = mvn.generate();
+  
+  REQUIRE( Y.n_rows == 3 );
+  REQUIRE( Y.n_cols == 2 );
+  
+  // float
+  
+  mvn_distr<float> mvn_f( conv_to<fmat>::from(M), conv_to<fmat>::from(C) );
+  
+  const fmat XF = mvn_f.generate(10);
+  
+  const fmat LF = mvn_f.log_p(XF);
+  
+  REQUIRE( LF.n_rows == 2  );
+  REQUIRE( LF.n_cols == 20 );
+  
+  REQUIRE( LF(0,3) == Approx(ref_log_p(conv_to<vec>::from(XF.col(3)), M.col(0), C)).epsilon(1e-4) );
+  }
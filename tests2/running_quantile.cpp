@@ -0,0 +1,171 @@
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+#include <armadillo>
+#include "catch.hpp"
+
+using namespace arma;
+
+
+TEST_CASE("running_quantile_accuracy")
+  {
+  const uword N = 100000;
+  
+  const vec A = randn<vec>(N);
+  
+  running_quantile<double> rq;
+  
+  for(uword i=0; i < N; ++i)  { rq(A(i)); }
+  
+  REQUIRE( rq.count() == Approx(double(N)) );
+  REQUIRE( rq.min()   == Approx(A.min()) );
+  REQUIRE( rq.max()   == Approx(A.max()) );
+  
+  REQUIRE( rq.n_centroids() <= 200 );
+  
+  const vec P = { 0.01, 0.1, 0.5, 0.9, 0.99 };
+  
+  const vec Q = rq.quantile(P);
+  
+  // compare ranks rather than values
+  
+  for(uword i=0; i < P.n_elem; ++i)
+    {
+    const double rank = double(accu(A <= Q(i))) / double(N);
+    
+    REQUIRE( std::abs(rank - P(i)) < 0.005 );
+    }
+  
+  const double rank_median = double(accu(A <= rq.median())) / double(N);
+  
+  REQUIRE( std::abs(rank_median - 0.5) < 0.005 );
+  
+  REQUIRE( rq.quantile(0.0) == Approx(A.min()) );
+  REQUIRE( rq.quantile(1.0) == Approx(A.max()) );
+  }
+
+
+
+TEST_CASE("running_quantile_merge")
+  {
+  const uword N = 40000;
+  
+  const vec A = 5.0 * randu<vec>(N);
+  const vec B = 5.0 * randu<vec>(N) + 2.0;
+  
+  running_quantile<double> rq_a;
+  running_quantile<double> rq_b;
+  
+  rq_a.batch_update(A);
+  rq_b.batch_update(B);
+  
+  rq_a += rq_b;
+  
+  const vec AB = join_cols(A, B);
+  
+  REQUIRE( rq_a.count() == Approx(double(2*N)) );
+  REQUIRE( rq_a.min()   == Approx(AB.min()) );
+  REQUIRE( rq_a.max()   == Approx(AB.max()) );
+  
+  const vec P = { 0.05, 0.25, 0.5, 0.75, 0.95 };
+  
+  const vec Q = rq_a.quantile(P);
+  
+  for(uword i=0; i < P.n_elem; ++i)
+    {
+    const double rank = double(accu(AB <= Q(i))) / double(2*N);
+    
+    REQUIRE( std::abs(rank - P(i)) < 0.005 );
+    }
+  
+  // small number of samples are kept exactly
+  
+  running_quantile<double> rq_c;
+  
+  rq_c(3.0);
+  rq_c(1.0);
+  rq_c(2.0);
+  
+  REQUIRE( rq_c.median() == Approx(2.0) );
+  
+  rq_c.reset();
+  
+  REQUIRE( rq_c.count() == Approx(0.0) );
+  }
+
+
+
+TEST_CASE("running_quantile_vec_batch")
+  {
+  const uword N = 20000;
+  
+  mat X = randn<mat>(4, N);
+  
+  X.row(1) *= 3.0;
+  X.row(2) += 10.0;
+  
+  running_quantile_vec<vec> rqv_a;
+  running_quantile_vec<vec> rqv_b;
+  
+  rqv_a.batch_update( X.cols(0, N/2-1) );
+  
+  for(uword i=N/2; i < N; ++i)  { rqv_b( X.col(i) ); }
+  
+  rqv_a.merge(rqv_b);
+  
+  REQUIRE( rqv_a.count() == Approx(double(N)) );
+  
+  const vec med = rqv_a.median();
+  
+  REQUIRE( med.n_elem == 4 );
+  
+  const vec exact_min = min(X, 1);
+  const vec exact_max = max(X, 1);
+  
+  REQUIRE( approx_equal(rqv_a.min(), exact_min, "absdiff", 1e-12) );
+  REQUIRE( approx_equal(rqv_a.max(), exact_max, "absdiff", 1e-12) );
+  
+  const vec P = { 0.1, 0.5, 0.9 };
+  
+  const mat Q = rqv_a.quantile(P);
+  
+  REQUIRE( Q.n_rows == 4 );
+  REQUIRE( Q.n_cols == 3 );
+  
+  for(uword d=0; d < 4; ++d)
+    {
+    REQUIRE( Q(d,1) == Approx(med(d)) );
+    
+    for(uword j=0; j < P.n_elem; ++j)
+      {
+      const double rank = double(accu(X.row(d) <= Q(d,j))) / double(N);
+      
+      REQUIRE( std::abs(rank - P(j)) < 0.01 );
+      }
+    }
+  
+  // row vector samples
+  
+  running_quantile_vec<rowvec> rqv_r;
+  
+  rqv_r.batch_update( X.t() );
+  
+  const rowvec med_r = rqv_r.median();
+  
+  REQUIRE( med_r.n_cols == 4 );
+  
+  REQUIRE( approx_equal(rqv_r.min(), exact_min.t(), "absdiff", 1e-12) );
+  }
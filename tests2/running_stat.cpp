@@ -0,0 +1,144 @@
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+#include <armadillo>
+#include "catch.hpp"
+
+using namespace arma;
+
+
+TEST_CASE("running_stat_merge")
+  {
+  const vec A = 10.0 * randn<vec>(1000) + 3.0;
+  
+  running_stat<double> stats_all;
+  running_stat<double> stats_1;
+  running_stat<double> stats_2;
+  running_stat<double> stats_3;
+  
+  for(uword i=0; i < A.n_elem; ++i)
+    {
+    stats_all(A(i));
+    
+         if(i <  100)  { stats_1(A(i)); }
+    else if(i <  101)  { stats_2(A(i)); }
+    else               { stats_3(A(i)); }
+    }
+  
+  running_stat<double> stats_empty;
+  
+  stats_1.merge(stats_empty);
+  stats_1 += stats_2;
+  stats_1 += stats_3;
+  
+  REQUIRE( stats_1.count()  == Approx(stats_all.count())  );
+  REQUIRE( stats_1.mean()   == Approx(stats_all.mean())   );
+  REQUIRE( stats_1.var()    == Approx(stats_all.var())    );
+  REQUIRE( stats_1.var(1)   == Approx(stats_all.var(1))   );
+  REQUIRE( stats_1.min()    == Approx(stats_all.min())    );
+  REQUIRE( stats_1.max()    == Approx(stats_all.max())    );
+  
+  REQUIRE( stats_1.mean()   == Approx(mean(A))  );
+  REQUIRE( stats_1.var()    == Approx(var(A))   );
+  
+  stats_empty += stats_1;
+  
+  REQUIRE( stats_empty.count() == Approx(stats_all.count()) );
+  REQUIRE( stats_empty.var()   == Approx(stats_all.var())   );
+  }
+
+
+
+TEST_CASE("running_stat_vec_merge")
+  {
+  const mat A = 10.0 * randn<mat>(5, 1000) + 3.0;
+  
+  running_stat_vec<vec> stats_all(true);
+  running_stat_vec<vec> stats_1(true);
+  running_stat_vec<vec> stats_2(true);
+  
+  for(uword i=0; i < A.n_cols; ++i)
+    {
+    stats_all(A.col(i));
+    
+    if(i < 300)  { stats_1(A.col(i)); }  else  { stats_2(A.col(i)); }
+    }
+  
+  stats_1 += stats_2;
+  
+  REQUIRE( stats_1.count() == Approx(stats_all.count()) );
+  
+  REQUIRE( approx_equal(stats_1.mean(), stats_all.mean(), "reldiff", 1e-10) );
+  REQUIRE( approx_equal(stats_1.var(),  stats_all.var(),  "reldiff", 1e-10) );
+  REQUIRE( approx_equal(stats_1.cov(),  stats_all.cov(),  "absdiff", 1e-8 ) );
+  REQUIRE( approx_equal(stats_1.min(),  stats_all.min(),  "reldiff", 1e-10) );
+  REQUIRE( approx_equal(stats_1.max(),  stats_all.max(),  "reldiff", 1e-10) );
+  
+  REQUIRE( approx_equal(stats_1.cov(),  cov(A.t()),       "absdiff", 1e-8 ) );
+  }
+
+
+
+TEST_CASE("running_stat_vec_batch_update")
+  {
+  const mat A = 10.0 * randn<mat>(4, 500) + 3.0;
+  
+  running_stat_vec<vec> stats_1(true);
+  running_stat_vec<vec> stats_2(true);
+  
+  for(uword i=0; i < 10; ++i)  { stats_1(A.col(i)); }
+  
+  stats_1.batch_update(A.cols(10, A.n_cols-1));
+  
+  stats_2.batch_update(A);
+  
+  REQUIRE( stats_1.count() == Approx(double(A.n_cols)) );
+  REQUIRE( stats_2.count() == Approx(double(A.n_cols)) );
+  
+  REQUIRE( approx_equal(stats_1.mean(),  vec(mean(A, 1)),  "reldiff", 1e-10) );
+  REQUIRE( approx_equal(stats_1.var(),   vec(var(A, 0, 1)), "reldiff", 1e-10) );
+  REQUIRE( approx_equal(stats_1.cov(),   cov(A.t()),       "absdiff", 1e-8 ) );
+  REQUIRE( approx_equal(stats_1.min(),   vec(min(A, 1)),   "reldiff", 1e-10) );
+  REQUIRE( approx_equal(stats_1.max(),   vec(max(A, 1)),   "reldiff", 1e-10) );
+  REQUIRE( approx_equal(stats_1.cov(),   stats_2.cov(),    "absdiff", 1e-8 ) );
+  
+  // samples as rows
+  
+  running_stat_vec<rowvec> stats_3(true);
+  
+  stats_3.batch_update(A.t());
+  
+  REQUIRE( approx_equal(stats_3.mean(),  rowvec(mean(A, 1).t()), "reldiff", 1e-10) );
+  REQUIRE( approx_equal(stats_3.cov(),   cov(A.t()),             "absdiff", 1e-8 ) );
+  
+  // complex samples
+  
+  const cx_mat C(randn<mat>(3, 200), randn<mat>(3, 200));
+  
+  running_stat_vec<cx_vec> stats_cx_1(true);
+  running_stat_vec<cx_vec> stats_cx_2(true);
+  
+  for(uword i=0; i < C.n_cols; ++i)  { stats_cx_1(C.col(i)); }
+  
+  stats_cx_2.batch_update(C.cols(0, 99));
+  stats_cx_2.batch_update(C.cols(100, C.n_cols-1));
+  
+  REQUIRE( approx_equal(stats_cx_1.mean(), stats_cx_2.mean(), "absdiff", 1e-10) );
+  REQUIRE( approx_equal(stats_cx_1.var(),  stats_cx_2.var(),  "absdiff", 1e-10) );
+  REQUIRE( approx_equal(stats_cx_1.cov(),  stats_cx_2.cov(),  "absdiff", 1e-10) );
+  REQUIRE( approx_equal(stats_cx_1.min(),  stats_cx_2.min(),  "absdiff", 1e-10) );
+  REQUIRE( approx_equal(stats_cx_1.max(),  stats_cx_2.max(),  "absdiff", 1e-10) );
+  }
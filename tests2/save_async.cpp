@@ -0,0 +1,148 @@
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+#include <cstdio>
+#include <armadillo>
+#include "catch.hpp"
+
+using namespace arma;
+
+
+TEST_CASE("save_async_mat")
+  {
+  mat A(40, 30, fill::randu);
+  mat B = A;
+  
+  save_handle h1 = A.save_async("save_async_A.bin");
+  save_handle h2 = A.save_async("save_async_A.raw", raw_binary);
+  
+  // the snapshot is taken before save_async() returns
+  A.zeros();
+  
+  REQUIRE( h1.status() == true );
+  REQUIRE( h2.status() == true );
+  REQUIRE( h1.is_ready() );
+  REQUIRE( h1.err_msg().empty() );
+  
+  mat C;
+  REQUIRE( C.load("save_async_A.bin") );
+  REQUIRE( approx_equal(B, C, "absdiff", 0.0) );
+  
+  mat D;
+  REQUIRE( D.load("save_async_A.raw", raw_binary) );
+  REQUIRE( D.n_elem == B.n_elem );
+  REQUIRE( approx_equal(vectorise(B), D, "absdiff", 0.0) );
+  
+  std::remove("save_async_A.bin");
+  std::remove("save_async_A.raw");
+  }
+
+
+
+TEST_CASE("save_async_cube_field")
+  {
+  cube A(5, 6, 7, fill::randu);
+  
+  field<mat> F(2, 1);
+  F(0) = randu<mat>(3,4);
+  F(1) = randu<mat>(5,2);
+  
+  save_handle h1 = A.save_async("save_async_C.bin");
+  save_handle h2 = F.save_async("save_async_F.bin");
+  
+  REQUIRE( h1.status() == true );
+  REQUIRE( h2.status() == true );
+  
+  cube B;
+  REQUIRE( B.load("save_async_C.bin") );
+  REQUIRE( approx_equal(A, B, "absdiff", 0.0) );
+  
+  field<mat> G;
+  REQUIRE( G.load("save_async_F.bin") );
+  REQUIRE( G.n_elem == 2 );
+  REQUIRE( approx_equal(F(1), G(1), "absdiff", 0.0) );
+  
+  std::remove("save_async_C.bin");
+  std::remove("save_async_F.bin");
+  }
+
+
+
+TEST_CASE("save_async_failure")
+  {
+  mat A(4, 5, fill::randu);
+  
+  save_handle h0;
+  
+  REQUIRE( h0.is_valid() == false );
+  
+  h0 = A.save_async("nonexistent_dir/save_async_A.bin");
+  
+  REQUIRE( h0.is_valid() );
+  REQUIRE( h0.status() == false );
+  REQUIRE( h0.err_msg().empty() == false );
+  
+  // the description of the failure from the file format code is kept
+  
+  field<int> F(2, 1);
+  
+  save_handle h1 = F.save_async("save_async_F_int.bin");
+  
+  REQUIRE( h1.status() == false );
+  REQUIRE( h1.err_msg().find("not supported") != std::string::npos );
+  REQUIRE( h1.err_msg().find("save_async_F_int.bin") != std::string::npos );
+  
+  std::remove("save_async_F_int.bin");
+  }
+
+
+
+#if defined(ARMA_USE_HDF5)
+
+TEST_CASE("save_async_hdf5")
+  {
+  mat A(20, 10, fill::randu);
+  
+  save_handle h = A.save_async( hdf5_name("save_async_A.h5", "my_data") );
+  
+  REQUIRE( h.status() == true );
+  
+  mat B;
+  REQUIRE( B.load( hdf5_name("save_async_A.h5", "my_data") ) );
+  REQUIRE( approx_equal(A, B, "absdiff", 0.0) );
+  
+  // foreground HDF5 loads and saves while background HDF5 saves are running
+  
+  std::vector<save_handle> handles;
+  
+  for(uword i=0; i < 8; ++i)  { handles.push_back( A.save_async( hdf5_name("save_async_C.h5", "data" + std::to_string(i), hdf5_opts::append) ) ); }
+  
+  for(uword i=0; i < 8; ++i)
+    {
+    REQUIRE( A.save( hdf5_name("save_async_D.h5", "data") ) );
+    REQUIRE( B.load( hdf5_name("save_async_A.h5", "my_data") ) );
+    }
+  
+  for(save_handle& h_i : handles)  { h_i.wait(); }
+  
+  REQUIRE( approx_equal(A, B, "absdiff", 0.0) );
+  
+  std::remove("save_async_A.h5");
+  std::remove("save_async_C.h5");
+  std::remove("save_async_D.h5");
+  }
+
+#endif
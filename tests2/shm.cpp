@@ -0,0 +1,190 @@
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+#include <armadillo>
+#include "catch.hpp"
+
+using namespace arma;
+
+#if defined(ARMA_HAVE_POSIX_SHM)
+
+
+TEST_CASE("shm_mat_create_attach")
+  {
+  mat A(50, 40, fill::randu);
+  
+  shm_mat<double> S1;
+  
+  REQUIRE( S1.create("arma_test_shm_mat", A) );
+  REQUIRE( S1.is_attached() );
+  REQUIRE( approx_equal(S1.get(), A, "absdiff", 0.0) );
+  
+  // creating a segment with an existing name fails
+  shm_mat<double> S0;
+  REQUIRE( S0.create("arma_test_shm_mat", 2, 2) == false );
+  
+  shm_mat<double> S2;
+  
+  REQUIRE( S2.attach("arma_test_shm_mat", false) );
+  REQUIRE( S2.get().n_rows == A.n_rows );
+  REQUIRE( S2.get().n_cols == A.n_cols );
+  REQUIRE( approx_equal(S2.get(), A, "absdiff", 0.0) );
+  
+  // both objects use the same memory
+  S1.get_rw()(3,4) = 123.0;
+  REQUIRE( S2.get()(3,4) == 123.0 );
+  
+  // the element type must match
+  shm_mat<float> S3;
+  REQUIRE( S3.attach("arma_test_shm_mat") == false );
+  
+  // the size can't be changed
+  REQUIRE_THROWS( S2.get_rw().set_size(10, 10) );
+  
+  REQUIRE( S1.remove() );
+  
+  // still usable after the name is removed
+  REQUIRE( S2.get()(3,4) == 123.0 );
+  
+  shm_mat<double> S4;
+  REQUIRE( S4.attach("arma_test_shm_mat") == false );
+  }
+
+
+
+TEST_CASE("shm_cube_create_attach")
+  {
+  shm_cube<s32> S1;
+  
+  REQUIRE( S1.create("arma_test_shm_cube", 4, 5, 6) );
+  REQUIRE( accu(S1.get() != 0) == 0 );
+  
+  S1.get_rw().slice(2).fill(7);
+  REQUIRE( S1.get().n_slices == 6 );
+  
+  shm_cube<s32> S2;
+  
+  REQUIRE( S2.attach("arma_test_shm_cube") );
+  REQUIRE( S2.get().n_rows   == 4 );
+  REQUIRE( S2.get().n_cols   == 5 );
+  REQUIRE( S2.get().n_slices == 6 );
+  REQUIRE( accu(S2.get()) == 7*20 );
+  
+  // writable access isn't allowed in read-only mode
+  REQUIRE_THROWS( S2.get_rw() );
+  
+  shm_mat<s32> S3;
+  REQUIRE( S3.attach("arma_test_shm_cube") == false );
+  
+  S2.detach();
+  REQUIRE( S2.is_attached() == false );
+  
+  REQUIRE( S1.remove() );
+  }
+
+
+
+//! header of the segment used by S, which precedes the element data
+template<typename obj_type>
+inline
+shm_header&
+get_header(obj_type& S)
+  {
+  unsigned char* data = reinterpret_cast<unsigned char*>(S.get_rw().memptr());
+  
+  return *reinterpret_cast<shm_header*>(data - shm_header::data_offset_default);
+  }
+
+
+
+TEST_CASE("shm_mat_data_offset")
+  {
+  mat A(6, 5, fill::randu);
+  
+  // write a segment by hand, with the data placed further from the header than usual
+  const uword offset = 2*shm_header::data_offset_default;
+  
+  shm_mat<double> S1;
+  REQUIRE( S1.create("arma_test_shm_offset", A.n_elem + (offset - shm_header::data_offset_default)/sizeof(double), 1) );
+  
+  shm_header& header = get_header(S1);
+  
+  header.n_rows      = A.n_rows;
+  header.n_cols      = A.n_cols;
+  header.n_elem      = A.n_elem;
+  header.data_offset = offset;
+  
+  std::memcpy(reinterpret_cast<unsigned char*>(&header) + offset, A.memptr(), A.n_elem*sizeof(double));
+  
+  shm_mat<double> S2;
+  REQUIRE( S2.attach("arma_test_shm_offset") );
+  REQUIRE( approx_equal(S2.get(), A, "absdiff", 0.0) );
+  
+  REQUIRE( S1.remove() );
+  }
+
+
+
+TEST_CASE("shm_malformed_header")
+  {
+  // segments with inconsistent sizes or offsets are rejected, including ones where the size checks could overflow
+  
+  const u64 big = u64(1) << 61;  // big * sizeof(double) wraps around to zero
+  
+  for(uword trial=0; trial < 6; ++trial)
+    {
+    shm_cube<double> S1;
+    REQUIRE( S1.create("arma_test_shm_malformed", 4, 5, 6) );
+    
+    shm_header& header = get_header(S1);
+    
+    if(trial == 0)  { header.n_rows = big;  header.n_cols = 1;  header.n_slices = 1;  header.n_elem = big; }
+    if(trial == 1)  { header.n_rows = u64(1) << 32;  header.n_cols = u64(1) << 32;  header.n_slices = 1;  header.n_elem = 0; }
+    if(trial == 2)  { header.n_slices = 0; }
+    if(trial == 3)  { header.n_elem = header.n_elem + 1; }
+    if(trial == 4)  { header.data_offset = ~u64(0) - 15; }
+    if(trial == 5)  { header.data_offset = 2*shm_header::data_offset_default; }
+    
+    shm_cube<double> S2;
+    REQUIRE( S2.attach("arma_test_shm_malformed") == false );
+    REQUIRE( S2.is_attached() == false );
+    
+    REQUIRE( S1.remove() );
+    }
+  }
+
+
+
+TEST_CASE("shm_create_too_large")
+  {
+  // sizes where n_elem or the number of bytes would wrap around
+  
+  const uword half = uword(1) << (4*sizeof(uword));
+  
+  shm_mat<double> S1;
+  REQUIRE( S1.create("arma_test_shm_large", half, half) == false );
+  REQUIRE( S1.is_attached() == false );
+  
+  REQUIRE( S1.create("arma_test_shm_large", std::numeric_limits<uword>::max() / 4, 1) == false );
+  REQUIRE( S1.is_attached() == false );
+  
+  shm_cube<double> S2;
+  REQUIRE( S2.create("arma_test_shm_large", half, 1, half) == false );
+  REQUIRE( S2.is_attached() == false );
+  }
+
+
+#endif
@@ -0,0 +1,160 @@
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+#include <cstdio>
+#include <sstream>
+#include <armadillo>
+#include "catch.hpp"
+
+using namespace arma;
+
+
+TEST_CASE("spmat_mtx_save_load")
+  {
+  sp_mat A = sprandu<sp_mat>(100, 80, 0.05);
+  
+  A(99,79) = 0.0;  // last element must not be needed to work out the size
+  
+  REQUIRE( A.save("spmat_mtx_A.mtx", mtx_ascii) );
+  
+  sp_mat B;
+  REQUIRE( B.load("spmat_mtx_A.mtx", mtx_ascii) );
+  
+  REQUIRE( B.n_rows    == A.n_rows    );
+  REQUIRE( B.n_cols    == A.n_cols    );
+  REQUIRE( B.n_nonzero == A.n_nonzero );
+  REQUIRE( approx_equal(mat(A), mat(B), "reldiff", 1e-12) );
+  
+  std::remove("spmat_mtx_A.mtx");
+  
+  sp_cx_mat C = sprandu<sp_cx_mat>(30, 40, 0.1);
+  
+  std::stringstream ss;
+  REQUIRE( C.save(ss, mtx_ascii) );
+  
+  sp_cx_mat D;
+  REQUIRE( D.load(ss, mtx_ascii) );
+  REQUIRE( approx_equal(cx_mat(C), cx_mat(D), "reldiff", 1e-12) );
+  
+  // complex data can't be loaded into a real matrix
+  std::stringstream ss2(ss.str());
+  sp_mat E;
+  REQUIRE( E.load(ss2, mtx_ascii) == false );
+  }
+
+
+
+TEST_CASE("spmat_mtx_symmetry_duplicates")
+  {
+  std::stringstream ss;
+  
+  ss << "%%MatrixMarket matrix coordinate real symmetric\n"
+     << "% comment line\n"
+     << "\n"
+     << "4 4 5\n"
+     << "1 1 1.5\n"
+     << "3 1 2.0\n"
+     << "4 2 -1\n"
+     << "3 1 0.5\n"
+     << "4 4 3\n";
+  
+  sp_mat A;
+  REQUIRE( A.load(ss, mtx_ascii) );
+  
+  mat B(4, 4, fill::zeros);
+  B(0,0) =  1.5;
+  B(2,0) =  2.5;  B(0,2) =  2.5;
+  B(3,1) = -1.0;  B(1,3) = -1.0;
+  B(3,3) =  3.0;
+  
+  REQUIRE( A.n_nonzero == 6 );
+  REQUIRE( approx_equal(mat(A), B, "absdiff", 0.0) );
+  
+  std::stringstream ss2;
+  
+  ss2 << "%%MatrixMarket matrix coordinate pattern skew-symmetric\n"
+      << "3 3 2\n"
+      << "2 1\n"
+      << "3 3\n";
+  
+  sp_imat C;
+  REQUIRE( C.load(ss2, mtx_ascii) );
+  REQUIRE( C.n_nonzero == 2 );
+  REQUIRE( C(1,0) ==  1 );
+  REQUIRE( C(0,1) == -1 );
+  REQUIRE( C(2,2) ==  0 );
+  
+  std::stringstream ss3;
+  
+  ss3 << "%%MatrixMarket matrix coordinate complex hermitian\n"
+      << "2 2 1\n"
+      << "2 1 1.0 2.0\n";
+  
+  sp_cx_mat D;
+  REQUIRE( D.load(ss3, mtx_ascii) );
+  REQUIRE( cx_double(D(1,0)) == cx_double(1.0,  2.0) );
+  REQUIRE( cx_double(D(0,1)) == cx_double(1.0, -2.0) );
+  }
+
+
+
+TEST_CASE("spmat_mtx_errors")
+  {
+  sp_mat A;
+  
+  std::stringstream ss1("%%MatrixMarket matrix array real general\n2 2\n1\n2\n3\n4\n");
+  REQUIRE( A.load(ss1, mtx_ascii) == false );
+  
+  std::stringstream ss2("%%MatrixMarket matrix coordinate real general\n2 2 1\n3 1 1.0\n");
+  REQUIRE( A.load(ss2, mtx_ascii) == false );
+  
+  std::stringstream ss3("%%MatrixMarket matrix coordinate real general\n2 2 2\n1 1 1.0\n");
+  REQUIRE( A.load(ss3, mtx_ascii) == false );
+  
+  std::stringstream ss4("%%MatrixMarket matrix coordinate real general\n2 2 2\n1 1\n2 2 1.0\n");
+  REQUIRE( A.load(ss4, mtx_ascii) == false );
+  }
+
+
+
+TEST_CASE("spmat_mtx_large")
+  {
+  // large enough to be parsed in parallel when OpenMP is enabled
+  sp_mat A = sprandn<sp_mat>(2000, 1500, 0.02);
+  
+  std::stringstream ss;
+  REQUIRE( A.save(ss, mtx_ascii) );
+  
+  // shuffle the entry lines, so the columns are no longer in order
+  std::string line;
+  std::string header;
+  std::getline(ss, line);  header += line + '\n';
+  std::getline(ss, line);  header += line + '\n';
+  
+  std::vector<std::string> lines;
+  while(std::getline(ss, line))  { lines.push_back(line); }
+  
+  const uvec perm = randperm(lines.size());
+  
+  std::stringstream ss2;
+  ss2 << header;
+  for(uword i=0; i < perm.n_elem; ++i)  { ss2 << lines[perm(i)] << '\n'; }
+  
+  sp_mat B;
+  REQUIRE( B.load(ss2, mtx_ascii) );
+  REQUIRE( B.n_nonzero == A.n_nonzero );
+  REQUIRE( approx_equal(mat(A), mat(B), "reldiff", 1e-12) );
+  }